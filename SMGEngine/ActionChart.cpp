@@ -11,36 +11,22 @@
 
 ActionBranch::ActionBranch(const XMLReaderNode& node)
 {
-	node.loadAttribute("State", _actionState);
+	std::string actionStateName;
+	node.loadAttribute("State", actionStateName);
+	_actionState = NameTable::getNameId(actionStateName);
 	std::string conditionStrings;
 	node.loadAttribute("Condition", conditionStrings);
-	
-	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	_actionConditions.reserve(conditionTokenized.size());
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<ActionCondition> condition = ActionCondition::parseConditionString(c);
-		
-		if (nullptr != condition) //  Ǹ ..
-		{
-			_actionConditions.push_back(std::move(condition));
-		}
-	}
+	_conditionProgram.compile(conditionStrings);
 }
 
-bool ActionBranch::checkBranchCondition(const Actor& actor) const noexcept
+bool ActionBranch::checkBranchCondition(const Actor& actor, bool& stableInputFailed) const noexcept
 {
-	for (const auto& condition : _actionConditions)
-	{
-		if (condition->isNotCondition() == condition->checkCondition(actor))
-		{
-			return false;
-		}
-	}
-	return true;
+	return _conditionProgram.evaluate(actor, stableInputFailed);
 }
 
 ActionChart::ActionChart(const XMLReaderNode& node)
+	: _actionStatesByNameId(nullptr)
+	, _variableIndices(-1)
 {
 	const auto& childNodes = node.getChildNodesWithName();
 	auto childIter = childNodes.find("ActionStates");
@@ -63,26 +49,20 @@ ActionChart::~ActionChart()
 
 }
 
-ActionState* ActionChart::getActionState(const std::string& name) const noexcept
+const ActionState* ActionChart::getActionState(NameId nameId) const noexcept
 {
-	auto it = _actionStates.find(name);
-	if (it == _actionStates.end())
-	{
-		return nullptr;
-	}
-	return it->second.get();
+	return _actionStatesByNameId.get(nameId);
 }
 
 void ActionChart::checkValid(void) const
 {
-	auto it = _actionStates.find("IDLE");
-	if (it == _actionStates.end())
+	if (nullptr == getActionState(NameTable::findNameId("IDLE")))
 	{
 		ThrowErrCode(ErrCode::ActionChartLoadFail, "IDLE ׼ ϴ.");
 	}
 	for (const auto& actionState : _actionStates)
 	{
-		actionState.second->checkValid(this);
+		actionState->checkValid(this);
 	}
 	for (const auto& collisionHandler : _collisionHandlers)
 	{
@@ -102,11 +82,16 @@ void ActionChart::processCollisionHandlers(Actor& selfActor, const Actor& target
 	}
 }
 
-const std::unordered_map<std::string, int>& ActionChart::getVariables(void) const noexcept
+const std::vector<int>& ActionChart::getVariables(void) const noexcept
 {
 	return _variables;
 }
 
+int ActionChart::getVariableIndex(NameId nameId) const noexcept
+{
+	return _variableIndices.get(nameId);
+}
+
 bool ActionChart::getChildEffectInfo(int key, ChildEffectInfo& outInfo) const noexcept
 {
 	auto it = _childEffects.find(key);
@@ -129,13 +114,16 @@ const DirectX::XMFLOAT3 ActionChart::getChildEffectOffset(int key) const noexcep
 void ActionChart::loadXMLActionStates(const XMLReaderNode& node)
 {
 	const auto& actionStates = node.getChildNodes();
+	_actionStates.reserve(actionStates.size());
 	for (const auto& actionState : actionStates)
 	{
-		auto it = _actionStates.emplace(actionState.getNodeName(), std::make_unique<ActionState>(actionState));
-		if (it.second == false)
+		const NameId nameId = NameTable::getNameId(actionState.getNodeName());
+		if (nullptr != getActionState(nameId))
 		{
 			ThrowErrCode(ErrCode::ActionChartLoadFail, actionState.getNodeName());
 		}
+		_actionStates.emplace_back(std::make_unique<ActionState>(actionState));
+		_actionStatesByNameId.set(nameId, _actionStates.back().get());
 	}
 }
 
@@ -157,11 +145,13 @@ void ActionChart::loadXMLVariables(const XMLReaderNode& node)
 		variable.loadAttribute("Name", name);
 		int value;
 		variable.loadAttribute("Value", value);
-		auto it = _variables.emplace(name, value);
-		if (it.second == false)
+		const NameId nameId = NameTable::getNameId(name);
+		if (getVariableIndex(nameId) != -1)
 		{
 			ThrowErrCode(ErrCode::ActionChartLoadFail, name);
 		}
+		_variableIndices.set(nameId, static_cast<int>(_variables.size()));
+		_variables.push_back(value);
 	}
 }
 
@@ -183,6 +173,7 @@ void ActionChart::loadXMLChildEffects(const XMLReaderNode& node)
 }
 
 ActionState::ActionState(const XMLReaderNode& node)
+	: _frameEventStartCursor(0)
 {
 	node.loadAttribute("Animation", _animationName);
 	node.loadAttribute("BlendTick", _blendTick);
@@ -204,40 +195,78 @@ ActionState::ActionState(const XMLReaderNode& node)
 			ThrowErrCode(ErrCode::InvalidXmlData, nodeName);
 		}
 	}
+
+	if (std::numeric_limits<uint16_t>::max() < _frameEvents.size())
+	{
+		ThrowErrCode(ErrCode::ActionChartLoadFail, "frame event ʹ ϴ.");
+	}
+	//  tick ̺Ʈ xml   óǵ stable_sort
+	std::stable_sort(_frameEvents.begin(), _frameEvents.end(),
+		[](const std::unique_ptr<FrameEvent>& lhs, const std::unique_ptr<FrameEvent>& rhs)
+		{
+			return lhs->getProcessTick() < rhs->getProcessTick();
+		});
+	auto startIt = std::lower_bound(_frameEvents.begin(), _frameEvents.end(), 0,
+		[](const std::unique_ptr<FrameEvent>& frameEvent, TickCount64 tick)
+		{
+			return frameEvent->getProcessTick() < tick;
+		});
+	_frameEventStartCursor = static_cast<uint16_t>(startIt - _frameEvents.begin());
 }
 
-bool ActionState::checkBranch(Actor& actor, std::string& nextState) const noexcept
+bool ActionState::checkBranch(Actor& actor, NameId& nextState) const noexcept
 {
-	for (const auto& branch : _branches)
+	uint64_t skippedBranchMask = actor.getSkippedBranchMask();
+	for (int i = 0; i < _branches.size(); ++i)
 	{
-		if (branch.checkBranchCondition(actor))
+		const uint64_t branchBit = (i < 64) ? (1ull << i) : 0;
+		if (skippedBranchMask & branchBit)
 		{
-			nextState = branch.getActionState();
+			ActionConditionProgram::countSkippedBranch();
+			continue;
+		}
+		bool stableInputFailed;
+		if (_branches[i].checkBranchCondition(actor, stableInputFailed))
+		{
+			nextState = _branches[i].getActionState();
 			return true;
 		}
+		if (stableInputFailed)
+		{
+			skippedBranchMask |= branchBit;
+		}
 	}
+	actor.setSkippedBranchMask(skippedBranchMask);
 	return false;
 }
 
-void ActionState::processFrameEvents(Actor& actor, const TickCount64& lastProcessedTick, const TickCount64& progressedTick) const noexcept
+bool ActionState::isAllBranchSkipped(uint64_t skippedBranchMask) const noexcept
 {
-	check(lastProcessedTick < progressedTick);
-	// ̳ʸġ Ұ [4/29/2021 qwerwy]
-	for (const auto& frameEvent : _frameEvents)
+	if (64 < _branches.size())
 	{
-		TickCount64 tick = frameEvent->getProcessTick();
-		if (lastProcessedTick < tick)
+		return false;
+	}
+	const uint64_t allBranchMask = (_branches.size() == 64) ? ~0ull : ((1ull << _branches.size()) - 1);
+	return (skippedBranchMask & allBranchMask) == allBranchMask;
+}
+
+void ActionState::processFrameEvents(Actor& actor, const TickCount64& progressedTick) const noexcept
+{
+	uint16_t cursor = actor.getFrameEventCursor();
+	check(cursor <= _frameEvents.size());
+	for (; cursor < _frameEvents.size(); ++cursor)
+	{
+		const auto& frameEvent = _frameEvents[cursor];
+		if (progressedTick < frameEvent->getProcessTick())
+		{
+			break;
+		}
+		if (frameEvent->checkConditions(actor))
 		{
-			if (progressedTick < tick)
-			{
-				continue;
-			}
-			if (frameEvent->checkConditions(actor))
-			{
-				frameEvent->process(actor);
-			}
+			frameEvent->process(actor);
 		}
 	}
+	actor.setFrameEventCursor(cursor);
 }
 
 std::string ActionState::getAnimationName(void) const noexcept
@@ -258,7 +287,7 @@ void ActionState::checkValid(const ActionChart* actionChart) const
 	{
 		if (nullptr == actionChart->getActionState(branch.getActionState()))
 		{
-			ThrowErrCode(ErrCode::ActionChartLoadFail, branch.getActionState());
+			ThrowErrCode(ErrCode::ActionChartLoadFail, NameTable::getName(branch.getActionState()));
 		}
 	}
 }
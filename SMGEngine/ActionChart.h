@@ -1,10 +1,11 @@
 #pragma once
 #include "TypeCommon.h"
 #include "TypeAction.h"
+#include "NameTable.h"
+#include "ActionCondition.h"
 
 class Actor;
 class XMLReaderNode;
-class ActionCondition;
 class FrameEvent;
 class CollisionHandler;
 
@@ -14,24 +15,36 @@ class ActionBranch
 {
 public:
 	ActionBranch(const XMLReaderNode& node);
-	std::string getActionState() const noexcept { return _actionState; }
-	bool checkBranchCondition(const Actor& actor) const noexcept;
+	NameId getActionState() const noexcept { return _actionState; }
+	bool checkBranchCondition(const Actor& actor, bool& stableInputFailed) const noexcept;
 private:
-	std::string _actionState;
-	std::vector<std::unique_ptr<ActionCondition>> _actionConditions;
+	NameId _actionState;
+	ActionConditionProgram _conditionProgram;
 };
 
 class ActionState
 {
+	// Ŀ  ü ȴ İ ϱ  _frameEvents Ѵ.
+	friend class StageBenchmark;
 public:
 	ActionState(const XMLReaderNode& node);
-	bool checkBranch(Actor& actor, std::string& nextState) const noexcept;
-	void processFrameEvents(Actor& actor, const TickCount64& lastProcessedTick, const TickCount64& progressedTick) const noexcept;
+	//  Է ǿ  branch Actor صΰ Է ٲ𶧱  ʴ´.
+	bool checkBranch(Actor& actor, NameId& nextState) const noexcept;
+	// ¿ ö Actor frame event Ŀ  ġ. 0tick  ̺Ʈ ó ʴ´.
+	uint16_t getFrameEventStartCursor(void) const noexcept { return _frameEventStartCursor; }
+	// Actor Ŀ progressedTick ̺Ʈ óϰ Ŀ ű.
+	void processFrameEvents(Actor& actor, const TickCount64& progressedTick) const noexcept;
+	// Ŀ ڿ ó frame event   true
+	bool isFrameEventEnd(uint16_t cursor) const noexcept { return _frameEvents.size() <= cursor; }
+	//  branch  Է ǿ ؼ ǰ  true
+	bool isAllBranchSkipped(uint64_t skippedBranchMask) const noexcept;
 	std::string getAnimationName(void) const noexcept;
 	TickCount64 getBlendTick(void) const noexcept;
 	void checkValid(const ActionChart* actionChart) const;
 private:
+	// tick  ĵǾ ִ.
 	std::vector<std::unique_ptr<FrameEvent>> _frameEvents;
+	uint16_t _frameEventStartCursor;
 	std::vector<ActionBranch> _branches;
 
 	std::string _animationName;
@@ -51,10 +64,13 @@ public:
 	ActionChart(const XMLReaderNode& node);
 	~ActionChart();
 	
-	ActionState* getActionState(const std::string& name) const noexcept;
+	const ActionState* getActionState(NameId nameId) const noexcept;
 	void checkValid(void) const;
 	void processCollisionHandlers(Actor& selfActor, const Actor& targetActor, CollisionCase collisionCase) const noexcept;
-	const std::unordered_map<std::string, int>& getVariables(void) const noexcept;
+	//  ʱⰪ. getVariableIndex ã ε Ѵ.
+	const std::vector<int>& getVariables(void) const noexcept;
+	//   -1
+	int getVariableIndex(NameId nameId) const noexcept;
 	bool getChildEffectInfo(int key, ChildEffectInfo& outInfo) const noexcept;
 	const DirectX::XMFLOAT3 getChildEffectOffset(int key) const noexcept;
 private:
@@ -63,8 +79,10 @@ private:
 	void loadXMLVariables(const XMLReaderNode& node);
 	void loadXMLChildEffects(const XMLReaderNode& node);
 private:
-	std::unordered_map<std::string, std::unique_ptr<ActionState>> _actionStates;
+	std::vector<std::unique_ptr<ActionState>> _actionStates;
+	NameIdMap<const ActionState*> _actionStatesByNameId;
 	std::vector<std::unique_ptr<CollisionHandler>> _collisionHandlers;
-	std::unordered_map<std::string, int> _variables;
+	std::vector<int> _variables;
+	NameIdMap<int> _variableIndices;
 	std::unordered_map<int, ChildEffectInfo> _childEffects;
 };
\ No newline at end of file
@@ -8,253 +8,402 @@
 #include "MathHelper.h"
 #include "ActionChart.h"
 #include "CharacterInfoManager.h"
+#include "NameTable.h"
 
-ActionCondition_Tick::ActionCondition_Tick(const std::string& args)
-{
-	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
-	if (tokenized.size() != 2)
-	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_Tick" + args);
-	}
-	_tickStart = std::stoi(tokenized[0]);
-	_tickEnd = std::stoi(tokenized[1]);
-}
-
-bool ActionCondition_Tick::checkCondition(const Actor& actor) const noexcept
-{
-	TickCount64 current = actor.getLocalTickCount();
-	if (_tickStart <= current && current < _tickEnd)
-	{
-		return true;
-	}
-	return false;
-}
-
-bool ActionCondition_End::checkCondition(const Actor& actor) const noexcept
-{
-	if (actor.isActionEnd())
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_Key::ActionCondition_Key(const std::string& args)
-{
-	 const auto& tokenized = D3DUtil::tokenizeString(args, '_');
-	 if (tokenized.size() != 2)
-	 {
-		 ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_Key" + args);
-	 }
-
-	 if (tokenized[0] == "Down")
-	 {
-		 _buttonState = ButtonState::Down;
-	 }
-	 else if (tokenized[0] == "Press")
-	 {
-		 _buttonState = ButtonState::Press;
-	 }
-	 else if (tokenized[0] == "Up")
-	 {
-		 _buttonState = ButtonState::Up;
-	 }
-	 else if (tokenized[0] == "None")
-	 {
-		 _buttonState = ButtonState::None;
-	 }
-	 else
-	 {
-		 static_assert(static_cast<int>(ButtonState::None) == 3, "Ÿ ߰ Ȯ");
-		 ThrowErrCode(ErrCode::ActionChartLoadFail, tokenized[0]);
-	 }
-
-	 if (tokenized[1] == "AB")
-	 {
-		 _buttonType = ButtonInputType::AB;
-	 }
-	 else if (tokenized[1] == "XY")
-	 {
-		 _buttonType = ButtonInputType::XY;
-	 }
-	 else if (tokenized[1] == "ZL")
-	 {
-		 _buttonType = ButtonInputType::ZL;
-	 }
-	 else if (tokenized[1] == "ZR")
-	 {
-		 _buttonType = ButtonInputType::ZR;
-	 }
-	 else if (tokenized[1] == "L")
-	 {
-		 _buttonType = ButtonInputType::L;
-	 }
-	 else if (tokenized[1] == "R")
-	 {
-		 _buttonType = ButtonInputType::R;
-	 }
-	 else if (tokenized[1] == "LStickButton")
-	 {
-		 _buttonType = ButtonInputType::LStickButton;
-	 }
-	 else if (tokenized[1] == "RStickButton")
-	 {
-		 _buttonType = ButtonInputType::RStickButton;
-	 }
-	 else
-	 {
-		 static_assert(static_cast<int>(ButtonInputType::Count) == 8, "Ÿ ߰ Ȯ");
-		 ThrowErrCode(ErrCode::ActionChartLoadFail, tokenized[1]);
-	 }
-}
-
-bool ActionCondition_Key::checkCondition(const Actor& actor) const noexcept
-{
-	if (_buttonState == SMGFramework::Get().getButtonInput(_buttonType))
-	{
-		return true;
-	}
+ActionConditionStatistics ActionConditionProgram::_statistics;
 
-	return false;
-}
-
-ActionCondition::ActionCondition()
-	: _not(false)
+ActionCondition::ActionCondition() noexcept
+	: _type(ActionConditionType::Count)
+	, _not(false)
+	, _stageVariable{ UNDEFINED_NAME_ID, OperatorType::Count, 0 }
 {
 
 }
 
-std::unique_ptr<ActionCondition> ActionCondition::parseConditionString(const std::string& input)
+bool ActionCondition::parseConditionString(const std::string& input, ActionCondition& outCondition)
 {
-	bool notCondition;
 	std::string conditionString;
 	if (input.at(0) == '!')
 	{
 		conditionString = input.substr(1);
-		notCondition = true;
+		outCondition._not = true;
 	}
 	else
 	{
 		conditionString = input;
-		notCondition = false;
+		outCondition._not = false;
 	}
-	std::unique_ptr<ActionCondition> condition = nullptr;
 
 	size_t cursor = std::min(conditionString.find('_'), conditionString.length());
 	std::string conditionTypeString = conditionString.substr(0, cursor);
 	std::string conditionArgs = (cursor < conditionString.length()) ? conditionString.substr(cursor + 1) : "";
 
-	//  switch case.. [3/25/2021 qwerwy]
 	if (conditionTypeString == "Tick")
 	{
-		condition = std::make_unique<ActionCondition_Tick>(conditionArgs);
+		outCondition._type = ActionConditionType::Tick;
+		outCondition.parseTick(conditionArgs);
 	}
 	else if (conditionTypeString == "End")
 	{
-		condition = std::make_unique<ActionCondition_End>();
+		outCondition._type = ActionConditionType::End;
 	}
 	else if (conditionTypeString == "Key")
 	{
-		condition = std::make_unique<ActionCondition_Key>(conditionArgs);
+		outCondition._type = ActionConditionType::Key;
+		outCondition.parseKey(conditionArgs);
 	}
 	else if (conditionTypeString == "Stick")
 	{
-		condition = std::make_unique<ActionCondition_Stick>(conditionArgs);
+		outCondition._type = ActionConditionType::Stick;
+		outCondition.parseStick(conditionArgs);
 	}
 	else if (conditionTypeString == "OnGround")
 	{
-		condition = std::make_unique<ActionCondition_OnGround>(conditionArgs);
+		outCondition._type = ActionConditionType::OnGround;
 	}
 	else if (conditionTypeString == "GroundEdge")
 	{
-		return nullptr;
+		return false;
 	}
 	else if (conditionTypeString == "IsStop")
 	{
-		condition = std::make_unique<ActionCondition_IsStop>(conditionArgs);
+		outCondition._type = ActionConditionType::IsStop;
 	}
 	else if (conditionTypeString == "Falling")
 	{
-		condition = std::make_unique<ActionCondition_Falling>(conditionArgs);
+		outCondition._type = ActionConditionType::Falling;
 	}
 	else if (conditionTypeString == "Random")
 	{
-		condition = std::make_unique<ActionCondition_Random>(conditionArgs);
+		outCondition._type = ActionConditionType::Random;
+		outCondition._probability = std::stoi(conditionArgs);
 	}
 	else if (conditionTypeString == "CheckPlayerDistance")
 	{
-		condition = std::make_unique<ActionCondition_CheckPlayerDistance>(conditionArgs);
+		outCondition._type = ActionConditionType::CheckPlayerDistance;
+		outCondition.parseIntRange(conditionArgs);
 	}
 	else if (conditionTypeString == "CheckPlayerAltitude")
 	{
-		condition = std::make_unique<ActionCondition_CheckPlayerAltitude>(conditionArgs);
+		outCondition._type = ActionConditionType::CheckPlayerAltitude;
+		outCondition.parseIntRange(conditionArgs);
 	}
 	else if (conditionTypeString == "CheckAction")
 	{
-		condition = std::make_unique<ActionCondition_CheckAction>(conditionArgs);
+		outCondition._type = ActionConditionType::CheckAction;
+		outCondition._actionState = NameTable::getNameId(conditionArgs);
 	}
 	else if (conditionTypeString == "CharacterType")
 	{
-		condition = std::make_unique<ActionCondition_CharacterType>(conditionArgs);
+		outCondition._type = ActionConditionType::CharacterType;
+		outCondition.parseCharacterType(conditionArgs);
 	}
 	else if (conditionTypeString == "CheckSpeed")
 	{
-		condition = std::make_unique<ActionCondition_CheckSpeed>(conditionArgs);
+		outCondition._type = ActionConditionType::CheckSpeed;
+		outCondition.parseFloatRange(conditionArgs);
 	}
 	else if (conditionTypeString == "Variable")
 	{
-		condition = std::make_unique<ActionCondition_Variable>(conditionArgs);
+		outCondition._type = ActionConditionType::Variable;
+		outCondition.parseVariable(conditionArgs);
 	}
 	else if (conditionTypeString == "CheckVerticalSpeed")
 	{
-		condition = std::make_unique<ActionCondition_CheckVerticalSpeed>(conditionArgs);
+		outCondition._type = ActionConditionType::CheckVerticalSpeed;
+		outCondition.parseFloatRange(conditionArgs);
 	}
 	else if (conditionTypeString == "ActionIndex")
 	{
-		condition = std::make_unique<ActionCondition_ActionIndex>(conditionArgs);
+		outCondition._type = ActionConditionType::ActionIndex;
+		outCondition._actionIndex = std::stoi(conditionArgs);
 	}
 	else if (conditionTypeString == "HasPath")
 	{
-		condition = std::make_unique<ActionCondition_HasPath>(conditionArgs);
+		outCondition._type = ActionConditionType::HasPath;
 	}
 	else if (conditionTypeString == "PathEnd")
 	{
-		condition = std::make_unique<ActionCondition_PathEnd>(conditionArgs);
+		outCondition._type = ActionConditionType::PathEnd;
 	}
 	else if (conditionTypeString == "TargetPositionArrive")
 	{
-		condition = std::make_unique<ActionCondition_TargetPositionArrive>(conditionArgs);
+		outCondition._type = ActionConditionType::TargetPositionArrive;
 	}
 	else if (conditionTypeString == "StageVariable")
 	{
-		condition = std::make_unique<ActionCondition_StageVariable>(conditionArgs);
+		outCondition._type = ActionConditionType::StageVariable;
+		outCondition.parseStageVariable(conditionArgs);
 	}
 	else if (conditionTypeString == "PointerPicked")
 	{
-		condition = std::make_unique<ActionCondition_PointerPicked>(conditionArgs);
+		outCondition._type = ActionConditionType::PointerPicked;
 	}
 	else if (conditionTypeString == "OnWall")
 	{
-		condition = std::make_unique<ActionCondition_OnWall>(conditionArgs);
+		outCondition._type = ActionConditionType::OnWall;
 	}
 	else if (conditionTypeString == "IsPointerActive")
 	{
-		condition = std::make_unique<ActionCondition_IsPointerActive>(conditionArgs);
+		outCondition._type = ActionConditionType::IsPointerActive;
 	}
 	else
 	{
-		static_assert(static_cast<int>(ActionConditionType::Count) == 22, "Ÿ ߰Ǹ ۾Ǿ մϴ.");
+		static_assert(static_cast<int>(ActionConditionType::Count) == 23, "Ÿ ߰Ǹ ۾Ǿ մϴ.");
 		ThrowErrCode(ErrCode::UndefinedType, "conditionString : " + conditionString);
 	}
+	return true;
+}
 
-	if (notCondition)
+bool ActionCondition::checkCondition(const Actor& actor) const noexcept
+{
+	switch (_type)
+	{
+		case ActionConditionType::Tick:
+		{
+			const TickCount64 current = actor.getLocalTickCount();
+			return _tick._start <= current && current < _tick._end;
+		}
+		case ActionConditionType::Key:
+		{
+			return _key._buttonState == SMGFramework::Get().getButtonInput(_key._buttonType);
+		}
+		case ActionConditionType::Stick:
+		{
+			check(&actor == SMGFramework::getStageManager()->getPlayerActor());
+			return (SMGFramework::Get().getStickInputState(_stick._stickType) & _stick._stickInputState) != StickInputState::None;
+		}
+		case ActionConditionType::End:
+		{
+			return actor.isActionEnd();
+		}
+		case ActionConditionType::IsStop:
+		{
+			return MathHelper::equal(actor.getSpeed(), 0) && MathHelper::equal(actor.getVerticalSpeed(), 0);
+		}
+		case ActionConditionType::OnGround:
+		{
+			return actor.isOnGround();
+		}
+		case ActionConditionType::Falling:
+		{
+			return actor.getVerticalSpeed() > 0 && !actor.isOnGround();
+		}
+		case ActionConditionType::Random:
+		{
+			return MathHelper::Rand(0, 99) < _probability;
+		}
+		case ActionConditionType::CheckPlayerDistance:
+		{
+			return checkPlayerDistance(actor);
+		}
+		case ActionConditionType::CheckPlayerAltitude:
+		{
+			return checkPlayerAltitude(actor);
+		}
+		case ActionConditionType::CheckAction:
+		{
+			return actor.getActionChart()->getActionState(_actionState) == actor.getCurrentActionState();
+		}
+		case ActionConditionType::CharacterType:
+		{
+			return actor.getCharacterInfo()->getCharacterType() == _characterType;
+		}
+		case ActionConditionType::CheckSpeed:
+		{
+			return !(actor.getSpeed() < _floatRange._min || actor.getSpeed() > _floatRange._max);
+		}
+		case ActionConditionType::Variable:
+		{
+			return _variable._value == actor.getActionChartVariable(_variable._name);
+		}
+		case ActionConditionType::CheckVerticalSpeed:
+		{
+			return !(actor.getVerticalSpeed() < _floatRange._min || actor.getVerticalSpeed() > _floatRange._max);
+		}
+		case ActionConditionType::ActionIndex:
+		{
+			return actor.getActionIndex() == _actionIndex;
+		}
+		case ActionConditionType::HasPath:
+		{
+			return actor.getPath() != nullptr;
+		}
+		case ActionConditionType::PathEnd:
+		{
+			return actor.isPathEnd();
+		}
+		case ActionConditionType::TargetPositionArrive:
+		{
+			using namespace MathHelper;
+			return equal(length(sub(actor.getTargetPosition(), actor.getPosition())), 0.f);
+		}
+		case ActionConditionType::StageVariable:
+		{
+			int variable = SMGFramework::getStageManager()->getStageScriptVariable(_stageVariable._name);
+			return D3DUtil::compare(_stageVariable._operator, variable, _stageVariable._value);
+		}
+		case ActionConditionType::PointerPicked:
+		{
+			return &actor == SMGFramework::getStageManager()->getPointerPickedActor();
+		}
+		case ActionConditionType::OnWall:
+		{
+			return actor.isOnWall();
+		}
+		case ActionConditionType::IsPointerActive:
+		{
+			return SMGFramework::Get().isPointerActive();
+		}
+		default:
+		{
+			static_assert(static_cast<int>(ActionConditionType::Count) == 23, "Ÿ ߰ Ȯ");
+			check(false, "Ÿ ߰ Ȯ");
+			return false;
+		}
+	}
+}
+
+int ActionCondition::getCost(void) const noexcept
+{
+	switch (_type)
+	{
+		case ActionConditionType::Tick:
+		case ActionConditionType::OnGround:
+		case ActionConditionType::OnWall:
+		case ActionConditionType::ActionIndex:
+		case ActionConditionType::HasPath:
+			return 0;
+		case ActionConditionType::Key:
+		case ActionConditionType::Stick:
+		case ActionConditionType::IsStop:
+		case ActionConditionType::Falling:
+		case ActionConditionType::CheckSpeed:
+		case ActionConditionType::CheckVerticalSpeed:
+		case ActionConditionType::PathEnd:
+		case ActionConditionType::IsPointerActive:
+		case ActionConditionType::CharacterType:
+		case ActionConditionType::Variable:
+			return 1;
+		case ActionConditionType::End:
+		case ActionConditionType::CheckAction:
+		case ActionConditionType::StageVariable:
+		case ActionConditionType::PointerPicked:
+			return 2;
+		case ActionConditionType::TargetPositionArrive:
+		case ActionConditionType::CheckPlayerDistance:
+		case ActionConditionType::CheckPlayerAltitude:
+			return 3;
+		case ActionConditionType::Random:
+			return 4;
+		default:
+		{
+			static_assert(static_cast<int>(ActionConditionType::Count) == 23, "Ÿ ߰ Ȯ");
+			check(false, "Ÿ ߰ Ȯ");
+			return 0;
+		}
+	}
+}
+
+bool ActionCondition::isStableInput(void) const noexcept
+{
+	// , ,   ٲ Actor/StageManager  ö󰣴.
+	// ׼ ´ ° ٲ   ʱȭϹǷ  ȿ ̴.
+	switch (_type)
+	{
+		case ActionConditionType::CheckAction:
+		case ActionConditionType::CharacterType:
+		case ActionConditionType::Variable:
+		case ActionConditionType::ActionIndex:
+		case ActionConditionType::HasPath:
+		case ActionConditionType::StageVariable:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void ActionCondition::parseTick(const std::string& args)
+{
+	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
+	if (tokenized.size() != 2)
 	{
-		condition->setNotCondition();
+		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_Tick" + args);
 	}
-	return condition;
+	_tick._start = std::stoi(tokenized[0]);
+	_tick._end = std::stoi(tokenized[1]);
+}
+
+void ActionCondition::parseKey(const std::string& args)
+{
+	 const auto& tokenized = D3DUtil::tokenizeString(args, '_');
+	 if (tokenized.size() != 2)
+	 {
+		 ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_Key" + args);
+	 }
+
+	 if (tokenized[0] == "Down")
+	 {
+		 _key._buttonState = ButtonState::Down;
+	 }
+	 else if (tokenized[0] == "Press")
+	 {
+		 _key._buttonState = ButtonState::Press;
+	 }
+	 else if (tokenized[0] == "Up")
+	 {
+		 _key._buttonState = ButtonState::Up;
+	 }
+	 else if (tokenized[0] == "None")
+	 {
+		 _key._buttonState = ButtonState::None;
+	 }
+	 else
+	 {
+		 static_assert(static_cast<int>(ButtonState::None) == 3, "Ÿ ߰ Ȯ");
+		 ThrowErrCode(ErrCode::ActionChartLoadFail, tokenized[0]);
+	 }
+
+	 if (tokenized[1] == "AB")
+	 {
+		 _key._buttonType = ButtonInputType::AB;
+	 }
+	 else if (tokenized[1] == "XY")
+	 {
+		 _key._buttonType = ButtonInputType::XY;
+	 }
+	 else if (tokenized[1] == "ZL")
+	 {
+		 _key._buttonType = ButtonInputType::ZL;
+	 }
+	 else if (tokenized[1] == "ZR")
+	 {
+		 _key._buttonType = ButtonInputType::ZR;
+	 }
+	 else if (tokenized[1] == "L")
+	 {
+		 _key._buttonType = ButtonInputType::L;
+	 }
+	 else if (tokenized[1] == "R")
+	 {
+		 _key._buttonType = ButtonInputType::R;
+	 }
+	 else if (tokenized[1] == "LStickButton")
+	 {
+		 _key._buttonType = ButtonInputType::LStickButton;
+	 }
+	 else if (tokenized[1] == "RStickButton")
+	 {
+		 _key._buttonType = ButtonInputType::RStickButton;
+	 }
+	 else
+	 {
+		 static_assert(static_cast<int>(ButtonInputType::Count) == 8, "Ÿ ߰ Ȯ");
+		 ThrowErrCode(ErrCode::ActionChartLoadFail, tokenized[1]);
+	 }
 }
 
-ActionCondition_Stick::ActionCondition_Stick(const std::string& args)
+void ActionCondition::parseStick(const std::string& args)
 {
 	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
 	if (tokenized.size() != 2)
@@ -264,11 +413,11 @@ ActionCondition_Stick::ActionCondition_Stick(const std::string& args)
 
 	if (tokenized[0] == "L")
 	{
-		_stickType = StickInputType::LStick;
+		_stick._stickType = StickInputType::LStick;
 	}
 	else if (tokenized[0] == "R")
 	{
-		_stickType = StickInputType::RStick;
+		_stick._stickType = StickInputType::RStick;
 	}
 	else
 	{
@@ -278,63 +427,63 @@ ActionCondition_Stick::ActionCondition_Stick(const std::string& args)
 
 	if (tokenized[1] == "FrontLong")
 	{
-		_stickInputState = StickInputState::FrontLong;
+		_stick._stickInputState = StickInputState::FrontLong;
 	}
 	else if (tokenized[1] == "LeftLong")
 	{
-		_stickInputState = StickInputState::LeftLong;
+		_stick._stickInputState = StickInputState::LeftLong;
 	}
 	else if (tokenized[1] == "BackLong")
 	{
-		_stickInputState = StickInputState::BackLong;
+		_stick._stickInputState = StickInputState::BackLong;
 	}
 	else if (tokenized[1] == "RightLong")
 	{
-		_stickInputState = StickInputState::RightLong;
+		_stick._stickInputState = StickInputState::RightLong;
 	}
 	else if (tokenized[1] == "FrontShort")
 	{
-		_stickInputState = StickInputState::FrontShort;
+		_stick._stickInputState = StickInputState::FrontShort;
 	}
 	else if (tokenized[1] == "LeftShort")
 	{
-		_stickInputState = StickInputState::LeftShort;
+		_stick._stickInputState = StickInputState::LeftShort;
 	}
 	else if (tokenized[1] == "BackShort")
 	{
-		_stickInputState = StickInputState::BackShort;
+		_stick._stickInputState = StickInputState::BackShort;
 	}
 	else if (tokenized[1] == "RightShort")
 	{
-		_stickInputState = StickInputState::RightShort;
+		_stick._stickInputState = StickInputState::RightShort;
 	}
 	else if (tokenized[1] == "Front")
 	{
-		_stickInputState = StickInputState::Front;
+		_stick._stickInputState = StickInputState::Front;
 	}
 	else if (tokenized[1] == "Left")
 	{
-		_stickInputState = StickInputState::Left;
+		_stick._stickInputState = StickInputState::Left;
 	}
 	else if (tokenized[1] == "Back")
 	{
-		_stickInputState = StickInputState::Back;
+		_stick._stickInputState = StickInputState::Back;
 	}
 	else if (tokenized[1] == "Right")
 	{
-		_stickInputState = StickInputState::Right;
+		_stick._stickInputState = StickInputState::Right;
 	}
 	else if (tokenized[1] == "Long")
 	{
-		_stickInputState = StickInputState::Long;
+		_stick._stickInputState = StickInputState::Long;
 	}
 	else if (tokenized[1] == "Short")
 	{
-		_stickInputState = StickInputState::Short;
+		_stick._stickInputState = StickInputState::Short;
 	}
 	else if (tokenized[1] == "Move")
 	{
-		_stickInputState = StickInputState::Move;
+		_stick._stickInputState = StickInputState::Move;
 	}
 	else
 	{
@@ -342,146 +491,29 @@ ActionCondition_Stick::ActionCondition_Stick(const std::string& args)
 	}
 }
 
-bool ActionCondition_Stick::checkCondition(const Actor& actor) const noexcept
-{
-	check(&actor == SMGFramework::getStageManager()->getPlayerActor());
-
-	if ((SMGFramework::Get().getStickInputState(_stickType) & _stickInputState) != StickInputState::None)
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_IsStop::ActionCondition_IsStop(const std::string& args)
-{
-
-}
-
-bool ActionCondition_IsStop::checkCondition(const Actor& actor) const noexcept
-{
-	if (MathHelper::equal(actor.getSpeed(), 0) && MathHelper::equal(actor.getVerticalSpeed(), 0))
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_OnGround::ActionCondition_OnGround(const std::string& args)
-{
-
-}
-
-bool ActionCondition_OnGround::checkCondition(const Actor& actor) const noexcept
-{
-	return actor.isOnGround();
-}
-
-ActionCondition_Falling::ActionCondition_Falling(const std::string& args)
-{
-
-}
-
-bool ActionCondition_Falling::checkCondition(const Actor& actor) const noexcept
-{
-	if (actor.getVerticalSpeed() > 0 && !actor.isOnGround())
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_Random::ActionCondition_Random(const std::string& args)
-{
-	_probability = std::stoi(args);
-}
-
-bool ActionCondition_Random::checkCondition(const Actor& actor) const noexcept
-{
-	return MathHelper::Rand(0, 99) < _probability;
-}
-
-ActionCondition_CheckPlayerDistance::ActionCondition_CheckPlayerDistance(const std::string& args)
+void ActionCondition::parseIntRange(const std::string& args)
 {
 	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
 	if (tokenized.size() != 2)
 	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_CheckPlayerDistance" + args);
+		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_IntRange" + args);
 	}
-	_min = std::stoi(tokenized[0]);
-	_max = std::stoi(tokenized[1]);
+	_intRange._min = std::stoi(tokenized[0]);
+	_intRange._max = std::stoi(tokenized[1]);
 }
 
-bool ActionCondition_CheckPlayerDistance::checkCondition(const Actor& actor) const noexcept
-{
-	check(&actor != SMGFramework::getStageManager()->getPlayerActor());
-	check(nullptr != SMGFramework::getStageManager()->getPlayerActor());
-
-	const Actor* player = SMGFramework::getStageManager()->getPlayerActor();
-	if (player == nullptr)
-	{
-		return false;
-	}
-	const auto& playerPosition = player->getPosition();
-	const auto& actorPosition = actor.getPosition();
-
-	float lengthSq = MathHelper::lengthSq(MathHelper::sub(playerPosition, actorPosition));
-	if (_min * _min < lengthSq && lengthSq < _max * _max)
-	{
-		return true;
-	}
-	return false;
-}
-ActionCondition_CheckPlayerAltitude::ActionCondition_CheckPlayerAltitude(const std::string& args)
+void ActionCondition::parseFloatRange(const std::string& args)
 {
 	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
 	if (tokenized.size() != 2)
 	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_CheckPlayerAltitude" + args);
+		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_FloatRange" + args);
 	}
-	_min = std::stoi(tokenized[0]);
-	_max = std::stoi(tokenized[1]);
+	_floatRange._min = std::stof(tokenized[0]);
+	_floatRange._max = std::stof(tokenized[1]);
 }
 
-bool ActionCondition_CheckPlayerAltitude::checkCondition(const Actor& actor) const noexcept
-{
-	check(&actor != SMGFramework::getStageManager()->getPlayerActor());
-	check(nullptr != SMGFramework::getStageManager()->getPlayerActor());
-
-	const Actor* player = SMGFramework::getStageManager()->getPlayerActor();
-	if (player == nullptr)
-	{
-		return false;
-	}
-	const auto& playerPosition = player->getPosition();
-	const auto& actorPosition = actor.getPosition();
-	const auto& actorUpVector = actor.getUpVector();
-
-	float altitude = MathHelper::dot(MathHelper::sub(playerPosition, actorPosition), actorUpVector);
-
-	if (_min < altitude && altitude < _max)
-	{
-		return true;
-	}
-	return false;
-	
-}
-
-ActionCondition_CheckAction::ActionCondition_CheckAction(const std::string& args)
-{
-	_actionStateName = args;
-}
-
-bool ActionCondition_CheckAction::checkCondition(const Actor& actor) const noexcept
-{
-	if (actor.getActionChart()->getActionState(_actionStateName) == actor.getCurrentActionState())
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_CharacterType::ActionCondition_CharacterType(const std::string& args)
+void ActionCondition::parseCharacterType(const std::string& args)
 {
 	if (args == "Player")
 	{
@@ -510,162 +542,148 @@ ActionCondition_CharacterType::ActionCondition_CharacterType(const std::string&
 	}
 }
 
-bool ActionCondition_CharacterType::checkCondition(const Actor& actor) const noexcept
-{
-	if (actor.getCharacterInfo()->getCharacterType() == _characterType)
-	{
-		return true;
-	}
-	return false;
-}
-
-ActionCondition_CheckSpeed::ActionCondition_CheckSpeed(const std::string& args)
+void ActionCondition::parseVariable(const std::string& args)
 {
 	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
 	if (tokenized.size() != 2)
 	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_CheckSpeed" + args);
+		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_Variable" + args);
 	}
-	_min = std::stof(tokenized[0]);
-	_max = std::stof(tokenized[1]);
+	_variable._name = NameTable::getNameId(tokenized[0]);
+	_variable._value = std::stoi(tokenized[1]);
 }
 
-bool ActionCondition_CheckSpeed::checkCondition(const Actor& actor) const noexcept
+void ActionCondition::parseStageVariable(const std::string& args)
 {
-	if (actor.getSpeed() < _min || actor.getSpeed() > _max)
+	std::string variableName;
+	bool rv = D3DUtil::parseComparison(args, variableName, _stageVariable._operator, _stageVariable._value);
+	if (!rv)
 	{
-		return false;
+		ThrowErrCode(ErrCode::ActionChartLoadFail, args);
 	}
-	return true;
+	_stageVariable._name = NameTable::getNameId(variableName);
 }
 
-ActionCondition_Variable::ActionCondition_Variable(const std::string& args)
+bool ActionCondition::checkPlayerDistance(const Actor& actor) const noexcept
 {
-	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
-	if (tokenized.size() != 2)
+	check(&actor != SMGFramework::getStageManager()->getPlayerActor());
+	check(nullptr != SMGFramework::getStageManager()->getPlayerActor());
+
+	const Actor* player = SMGFramework::getStageManager()->getPlayerActor();
+	if (player == nullptr)
 	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_CheckSpeed" + args);
+		return false;
 	}
-	_name = tokenized[0];
-	_value = std::stoi(tokenized[1]);
-}
+	const auto& playerPosition = player->getPosition();
+	const auto& actorPosition = actor.getPosition();
 
-bool ActionCondition_Variable::checkCondition(const Actor& actor) const noexcept
-{
-	if (_value == actor.getActionChartVariable(_name))
+	float lengthSq = MathHelper::lengthSq(MathHelper::sub(playerPosition, actorPosition));
+	if (_intRange._min * _intRange._min < lengthSq && lengthSq < _intRange._max * _intRange._max)
 	{
 		return true;
 	}
 	return false;
 }
 
-ActionCondition_CheckVerticalSpeed::ActionCondition_CheckVerticalSpeed(const std::string& args)
+bool ActionCondition::checkPlayerAltitude(const Actor& actor) const noexcept
 {
-	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
-	if (tokenized.size() != 2)
-	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, "ActionCondition_CheckSpeed" + args);
-	}
-	_min = std::stof(tokenized[0]);
-	_max = std::stof(tokenized[1]);
-
-}
+	check(&actor != SMGFramework::getStageManager()->getPlayerActor());
+	check(nullptr != SMGFramework::getStageManager()->getPlayerActor());
 
-bool ActionCondition_CheckVerticalSpeed::checkCondition(const Actor& actor) const noexcept
-{
-	if (actor.getVerticalSpeed() < _min || actor.getVerticalSpeed() > _max)
+	const Actor* player = SMGFramework::getStageManager()->getPlayerActor();
+	if (player == nullptr)
 	{
 		return false;
 	}
-	return true;
-}
-
-ActionCondition_ActionIndex::ActionCondition_ActionIndex(const std::string& args)
-{
-	_actionIndex = std::stoi(args);
-}
-
-bool ActionCondition_ActionIndex::checkCondition(const Actor& actor) const noexcept
-{
-	return (actor.getActionIndex() == _actionIndex);
-}
-
-ActionCondition_HasPath::ActionCondition_HasPath(const std::string& args)
-{
-
-}
-
-bool ActionCondition_HasPath::checkCondition(const Actor& actor) const noexcept
-{
-	return (actor.getPath() != nullptr);
-}
-
-ActionCondition_PathEnd::ActionCondition_PathEnd(const std::string& args)
-{
-
-}
-
-bool ActionCondition_PathEnd::checkCondition(const Actor& actor) const noexcept
-{
-	return actor.isPathEnd();
-}
-
-ActionCondition_TargetPositionArrive::ActionCondition_TargetPositionArrive(const std::string& args)
-{
-
-}
+	const auto& playerPosition = player->getPosition();
+	const auto& actorPosition = actor.getPosition();
+	const auto& actorUpVector = actor.getUpVector();
 
-bool ActionCondition_TargetPositionArrive::checkCondition(const Actor& actor) const noexcept
-{
-	using namespace MathHelper;
-	return equal(length(sub(actor.getTargetPosition(), actor.getPosition())), 0.f);
-}
+	float altitude = MathHelper::dot(MathHelper::sub(playerPosition, actorPosition), actorUpVector);
 
-ActionCondition_StageVariable::ActionCondition_StageVariable(const std::string& args)
-{
-	bool rv = D3DUtil::parseComparison(args, _variableName, _operator, _value);
-	if (!rv)
+	if (_intRange._min < altitude && altitude < _intRange._max)
 	{
-		ThrowErrCode(ErrCode::ActionChartLoadFail, args);
+		return true;
 	}
+	return false;
 }
 
-bool ActionCondition_StageVariable::checkCondition(const Actor& actor) const noexcept
+ActionConditionProgram::ActionConditionProgram(void) noexcept
+	: _stableConditionCount(0)
 {
-	int variable = SMGFramework::getStageManager()->getStageScriptVariable(_variableName);
-	return D3DUtil::compare(_operator, variable, _value);
-}
 
-ActionCondition_PointerPicked::ActionCondition_PointerPicked(const std::string& args)
-{
-	
 }
 
-bool ActionCondition_PointerPicked::checkCondition(const Actor& actor) const noexcept
+void ActionConditionProgram::compile(const std::string& conditionStrings)
 {
-	if (&actor == SMGFramework::getStageManager()->getPointerPickedActor())
+	check(_conditions.empty());
+	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
+	_conditions.reserve(conditionTokenized.size());
+	for (const auto& c : conditionTokenized)
 	{
-		return true;
+		ActionCondition condition;
+		if (ActionCondition::parseConditionString(c, condition)) //  Ǹ ..
+		{
+			_conditions.push_back(condition);
+		}
+	}
+	if (std::numeric_limits<uint8_t>::max() < _conditions.size())
+	{
+		ThrowErrCode(ErrCode::ActionChartLoadFail, " ʹ ϴ. " + conditionStrings);
 	}
-	return false;
-}
-
-ActionCondition_OnWall::ActionCondition_OnWall(const std::string& args)
-{
 
+	//   ̾ ϹǷ  ٲ㵵  .  Է  տ,  ȿ  .
+	std::stable_sort(_conditions.begin(), _conditions.end(),
+		[](const ActionCondition& lhs, const ActionCondition& rhs)
+		{
+			if (lhs.isStableInput() != rhs.isStableInput())
+			{
+				return lhs.isStableInput();
+			}
+			return lhs.getCost() < rhs.getCost();
+		});
+	_stableConditionCount = static_cast<uint8_t>(std::count_if(_conditions.begin(), _conditions.end(),
+		[](const ActionCondition& condition) { return condition.isStableInput(); }));
 }
 
-bool ActionCondition_OnWall::checkCondition(const Actor& actor) const noexcept
+bool ActionConditionProgram::evaluate(const Actor& actor) const noexcept
 {
-	return actor.isOnWall();
+	bool stableInputFailed;
+	return evaluate(actor, stableInputFailed);
 }
 
-ActionCondition_IsPointerActive::ActionCondition_IsPointerActive(const std::string& args)
+bool ActionConditionProgram::evaluate(const Actor& actor, bool& stableInputFailed) const noexcept
 {
-
+#if defined DEBUG | defined _DEBUG
+	++_statistics._programCheckCount;
+#endif
+	stableInputFailed = false;
+	for (size_t i = 0; i < _conditions.size(); ++i)
+	{
+#if defined DEBUG | defined _DEBUG
+		++_statistics._conditionCheckCount;
+#endif
+		const ActionCondition& condition = _conditions[i];
+		if (condition.isNotCondition() == condition.checkCondition(actor))
+		{
+			stableInputFailed = (i < _stableConditionCount);
+			return false;
+		}
+	}
+	return true;
 }
 
-bool ActionCondition_IsPointerActive::checkCondition(const Actor& actor) const noexcept
+void ActionConditionProgram::logStatistics(void) noexcept
 {
-	return SMGFramework::Get().isPointerActive();
+	if (_statistics._programCheckCount == 0 && _statistics._branchSkipCount == 0)
+	{
+		return;
+	}
+	const uint64_t totalCount = _statistics._programCheckCount + _statistics._branchSkipCount;
+	const std::string text = "[ActionCondition] programCheck: " + std::to_string(_statistics._programCheckCount) +
+		" branchSkip: " + std::to_string(_statistics._branchSkipCount) +
+		" (" + std::to_string(_statistics._branchSkipCount * 100 / totalCount) + "%)" +
+		" conditionCheck: " + std::to_string(_statistics._conditionCheckCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_statistics = ActionConditionStatistics();
 }
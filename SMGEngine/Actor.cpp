@@ -7,6 +7,7 @@
 #include "MathHelper.h"
 #include "CharacterInfoManager.h"
 #include "StageInfo.h"
+#include "Terrain.h"
 #include "SMGFramework.h"
 #include "StageManager.h"
 #include <algorithm>
@@ -15,6 +16,7 @@
 #include "Path.h"
 #include "ObjectInfo.h"
 #include "Effect.h"
+#include "NameTable.h"
 
 Actor::Actor(const SpawnInfo& spawnInfo)
 	: _position(spawnInfo.getPosition())
@@ -33,6 +35,7 @@ Actor::Actor(const SpawnInfo& spawnInfo)
 	, _sectorCoord(0, 0, 0)
 	, _path(nullptr)
 	, _pathTime(0)
+	, _pathPosition(0, 0, 0)
 	, _targetPosition(0, 0, 0)
 	, _rotateType(RotateType::Fixed)
 	, _rotateAngleOffset(0.f)
@@ -41,10 +44,19 @@ Actor::Actor(const SpawnInfo& spawnInfo)
 	, _isGravityOn(true)
 	, _actionChart(nullptr)
 	, _currentActionState(nullptr)
+	, _frameEventCursor(0)
+	, _nextActionState(UNDEFINED_NAME_ID)
 	, _actionIndex(0)
+	, _conditionInputVersion(0)
+	, _skippedBranchMask(0)
+	, _skippedBranchVersion(0)
 	, _localTickCount(0)
 	, _onGround(false)
+	, _groundTerrain(nullptr)
+	, _groundNodeIndex(0)
 	, _isCollisionOn(true)
+	, _pendingDeltaTick(0)
+	, _activityPhase(0)
 {
 	_characterInfo = SMGFramework::getCharacterInfoManager()->getInfo(spawnInfo.getCharacterKey());
 	// Ҷ ѹ ϴ κ  Űܾ. [5/20/2021 qwerw]
@@ -53,8 +65,8 @@ Actor::Actor(const SpawnInfo& spawnInfo)
 		ThrowErrCode(ErrCode::InvalidXmlData, "ĳŰ Դϴ. " + spawnInfo.getCharacterKey());
 	}
 	_actionChart = SMGFramework::getStageManager()->loadActionChartFromXML(_characterInfo->getActionChartFileName());
-	const auto& idleAction = _actionChart->getActionState("IDLE");
-	if (nullptr == idleAction)
+	const NameId idleActionState = NameTable::getNameId("IDLE");
+	if (nullptr == _actionChart->getActionState(idleActionState))
 	{
 		ThrowErrCode(ErrCode::InvalidXmlData, _characterInfo->getActionChartFileName() + " : IDLE  ϴ.");
 	}
@@ -63,10 +75,10 @@ Actor::Actor(const SpawnInfo& spawnInfo)
 	
 	_gameObject = SMGFramework::getD3DApp()->createObjectFromXML(_characterInfo->getObjectFileName());
 
-	_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(_position);
+	_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(_position, _gravityPointCandidates);
 	_sectorCoord = SMGFramework::getStageManager()->getSectorCoord(_position);
 	updateObjectWorldMatrix();
-	setActionState("IDLE");
+	setActionState(idleActionState);
 	if (_currentActionState == nullptr)
 	{
 		ThrowErrCode(ErrCode::ActionChartLoadFail, "⺻׼ IDLE ϴ. " + _characterInfo->getActionChartFileName());
@@ -191,6 +203,7 @@ void Actor::setPath(int key) noexcept
 	{
 		_path = nullptr;
 		_pathTime = 0;
+		++_conditionInputVersion;
 		return;
 	}
 	auto path = SMGFramework::getStageManager()->getStageInfo()->getPath(key);
@@ -202,6 +215,7 @@ void Actor::setPath(int key) noexcept
 
 	_path = path;
 	_pathTime = 0;
+	++_conditionInputVersion;
 }
 
 const Path* Actor::getPath(void) const noexcept
@@ -209,6 +223,21 @@ const Path* Actor::getPath(void) const noexcept
 	return _path;
 }
 
+bool Actor::isPathMove(void) const noexcept
+{
+	return _moveType == MoveType::Path && _path != nullptr;
+}
+
+const TickCount64& Actor::getPathTime(void) const noexcept
+{
+	return _pathTime;
+}
+
+void Actor::setPathPosition(const DirectX::XMFLOAT3& position) noexcept
+{
+	_pathPosition = position;
+}
+
 bool Actor::isPathEnd(void) const noexcept
 {
 	if (_path == nullptr || _path->getMoveTick() < _pathTime)
@@ -223,10 +252,10 @@ void Actor::setAnimationSpeed(float speed) noexcept
 	_gameObject->setAnimationSpeed(speed);
 }
 
-void Actor::setNextActionState(const std::string& actionStateName) noexcept
+void Actor::setNextActionState(NameId actionState) noexcept
 {
-	check(!actionStateName.empty());
-	_nextActionStateName = actionStateName;
+	check(actionState != UNDEFINED_NAME_ID);
+	_nextActionState = actionState;
 }
 
 float Actor::getRotateAngleDelta(const TickCount64& deltaTick) const noexcept
@@ -765,10 +794,7 @@ DirectX::XMFLOAT3 Actor::getMoveVector(const TickCount64& deltaTick) const noexc
 			check(_path != nullptr);
 			applySpeed = false;
 
-			XMFLOAT3 position;
-			_path->getPathPositionAtTime(_pathTime, position, InterpolationType::Linear);
-
-			direction = XMLoadFloat3(&position) - XMLoadFloat3(&_position);
+			direction = XMLoadFloat3(&_pathPosition) - XMLoadFloat3(&_position);
 		}
 		break;
 		case MoveType::ToPoint:
@@ -819,11 +845,12 @@ void Actor::setPosition(const DirectX::XMFLOAT3& toPosition) noexcept
 	_position = toPosition;
 	_additionalMoveVector = { 0, 0, 0 };
 	_sectorCoord = SMGFramework::getStageManager()->getSectorCoord(toPosition);
-	if (_gravityPoint == nullptr || MathHelper::length(MathHelper::sub(_gravityPoint->_position, toPosition)) > _gravityPoint->_radius)
+	if (_gravityPoint == nullptr ||
+		MathHelper::lengthSq(MathHelper::sub(_gravityPoint->_position, toPosition)) > _gravityPoint->_radius * _gravityPoint->_radius)
 	{
 		if (_isGravityOn)
 		{
-			_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(toPosition);
+			_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(toPosition, _gravityPointCandidates);
 			_verticalSpeed = 0.f;
 		}
 	}
@@ -853,27 +880,27 @@ bool Actor::isActionEnd() const noexcept
 void Actor::updateActionChart(const TickCount64& deltaTick) noexcept
 {
 	TickCount64 progressedTick = _localTickCount + deltaTick;
-	_currentActionState->processFrameEvents(*this, _localTickCount, progressedTick);
+	_currentActionState->processFrameEvents(*this, progressedTick);
 	_localTickCount = progressedTick;
 	
-	if (!_nextActionStateName.empty())
+	if (_nextActionState != UNDEFINED_NAME_ID)
 	{
-		setActionState(_nextActionStateName);
-		_nextActionStateName.clear();
+		setActionState(_nextActionState);
+		_nextActionState = UNDEFINED_NAME_ID;
 	}
 	else
 	{
-		std::string nextStateName;
-		if (_currentActionState->checkBranch(*this, nextStateName))
+		NameId nextState;
+		if (_currentActionState->checkBranch(*this, nextState))
 		{
-			setActionState(nextStateName);
+			setActionState(nextState);
 		}
 	}
 }
 
-void Actor::setActionState(const std::string& nextStateName) noexcept
+void Actor::setActionState(NameId nextStateId) noexcept
 {
-	ActionState* nextState = _actionChart->getActionState(nextStateName);
+	const ActionState* nextState = _actionChart->getActionState(nextStateId);
 	check(nullptr != nextState);
 
 	_localTickCount = 0;
@@ -882,8 +909,10 @@ void Actor::setActionState(const std::string& nextStateName) noexcept
 		_gameObject->setAnimation(nextState->getAnimationName(), nextState->getBlendTick());
 	}
 	_currentActionState = nextState;
+	_skippedBranchMask = 0;
+	_frameEventCursor = _currentActionState->getFrameEventStartCursor();
 
-	_currentActionState->processFrameEvents(*this, -1, 0);
+	_currentActionState->processFrameEvents(*this, 0);
 	//0tick frameevent 
 	updateObjectWorldMatrix();
 }
@@ -949,31 +978,151 @@ void Actor::processCollision(const Actor* collidingActor, CollisionCase collisio
 	_actionChart->processCollisionHandlers(*this, *collidingActor, collisionCase);
 }
 
-void Actor::setCulled(void) noexcept
+void Actor::addCullingBox(FrustumCuller& culler) noexcept
 {
-	_gameObject->setCulled();
+	_gameObject->addCullingBox(culler);
 }
 
-void Actor::setActionChartVariable(const std::string& name, int value) noexcept
+void Actor::setCulled(const FrustumCuller& culler) noexcept
 {
-	auto it = _actionChartVariables.find(name);
-	if (it == _actionChartVariables.end())
+	_gameObject->setCulled(culler);
+}
+
+void Actor::setActionChartVariable(NameId nameId, int value) noexcept
+{
+	const int index = _actionChart->getVariableIndex(nameId);
+	if (index == -1)
 	{
-		check(false, name);
+		check(false, NameTable::getName(nameId));
 		return;
 	}
-	it->second = value;
+	if (_actionChartVariables[index] != value)
+	{
+		_actionChartVariables[index] = value;
+		++_conditionInputVersion;
+	}
 }
 
-int Actor::getActionChartVariable(const std::string& name) const noexcept
+int Actor::getActionChartVariable(NameId nameId) const noexcept
 {
-	auto it = _actionChartVariables.find(name);
-	if (it == _actionChartVariables.end())
+	const int index = _actionChart->getVariableIndex(nameId);
+	if (index == -1)
 	{
-		check(false, name);
+		check(false, NameTable::getName(nameId));
 		return 0;
 	}
-	return it->second;
+	return _actionChartVariables[index];
+}
+
+uint64_t Actor::getConditionInputVersion(void) const noexcept
+{
+	return (static_cast<uint64_t>(_conditionInputVersion) << 32) | SMGFramework::getStageManager()->getStageScriptVariableVersion();
+}
+
+uint64_t Actor::getSkippedBranchMask(void) noexcept
+{
+	const uint64_t version = getConditionInputVersion();
+	if (_skippedBranchVersion != version)
+	{
+		_skippedBranchVersion = version;
+		_skippedBranchMask = 0;
+	}
+	return _skippedBranchMask;
+}
+
+void Actor::setSkippedBranchMask(uint64_t mask) noexcept
+{
+	_skippedBranchMask = mask;
+}
+
+TerrainContact Actor::getGroundContact(void) const noexcept
+{
+	TerrainContact contact;
+	contact._terrain = _groundTerrain;
+	contact._nodeIndex = _groundNodeIndex;
+	return contact;
+}
+
+void Actor::setGroundContact(const TerrainContact& contact) noexcept
+{
+	_groundTerrain = contact._terrain;
+	_groundNodeIndex = contact._nodeIndex;
+}
+
+bool Actor::isSleepable(void) const noexcept
+{
+	if (_path != nullptr || _nextActionState != UNDEFINED_NAME_ID)
+	{
+		return false;
+	}
+	if (_isGravityOn && !_onGround)
+	{
+		return false;
+	}
+	if (!MathHelper::equal(_speed, 0.f) || !MathHelper::equal(_targetSpeed, 0.f))
+	{
+		return false;
+	}
+	if (!MathHelper::equal(_additionalMoveVector, XMFLOAT3(0, 0, 0)))
+	{
+		return false;
+	}
+	if (isQuaternionRotate() || !MathHelper::equal(getRotateAngleDelta(1), 0.f))
+	{
+		return false;
+	}
+	if (!_currentActionState->isFrameEventEnd(_frameEventCursor))
+	{
+		return false;
+	}
+	if (_skippedBranchVersion != getConditionInputVersion())
+	{
+		return false;
+	}
+	return _currentActionState->isAllBranchSkipped(_skippedBranchMask);
+}
+
+bool Actor::consumeActivityTick(ActorActivityLevel level,
+								uint32_t frameCount,
+								const TickCount64& deltaTick,
+								TickCount64& outDeltaTick) noexcept
+{
+	switch (level)
+	{
+		case ActorActivityLevel::Full:
+		{
+			outDeltaTick = _pendingDeltaTick + deltaTick;
+			_pendingDeltaTick = 0;
+			return true;
+		}
+		case ActorActivityLevel::Reduced:
+		case ActorActivityLevel::Minimal:
+		{
+			_pendingDeltaTick += deltaTick;
+			const uint32_t interval = (level == ActorActivityLevel::Reduced) ? ACTIVITY_REDUCED_INTERVAL : ACTIVITY_MINIMAL_INTERVAL;
+			if ((frameCount + _activityPhase) % interval != 0)
+			{
+				return false;
+			}
+			outDeltaTick = _pendingDeltaTick;
+			_pendingDeltaTick = 0;
+			return true;
+		}
+		case ActorActivityLevel::Sleep:
+		{
+			// ° ٲ Ƿ tick Ѵ. tick   Է ƴ϶ sleep ߿ 򰡵  .
+			_localTickCount += _pendingDeltaTick + deltaTick;
+			_pendingDeltaTick = 0;
+			return false;
+		}
+		default:
+		{
+			static_assert(static_cast<int>(ActorActivityLevel::Count) == 4, "Ÿ ߰ Ȯ");
+			check(false, "Ÿ ߰ Ȯ");
+			outDeltaTick = deltaTick;
+			return true;
+		}
+	}
 }
 
 int Actor::getActionIndex(void) const noexcept
@@ -988,7 +1137,7 @@ void Actor::setGravityOn(bool on) noexcept
 	_isGravityOn = on;
 	if (on)
 	{
-		_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(_position);
+		_gravityPoint = SMGFramework::getStageManager()->getGravityPointAt(_position, _gravityPointCandidates);
 		_verticalSpeed = 0.f;
 	}
 	else
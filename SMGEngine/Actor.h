@@ -1,15 +1,18 @@
 #pragma once
 #include "TypeCommon.h"
 #include "TypeAction.h"
+#include "StageInfo.h"
 
 class CharacterInfo;
 class ActionChart;
 class ActionState;
 class SpawnInfo;
-struct GravityPoint;
 class GameObject;
 class Path;
 class ConstantEffectInstance;
+class FrustumCuller;
+class Terrain;
+struct TerrainContact;
 
 class Actor
 {
@@ -25,6 +28,9 @@ public:
 	float getVerticalSpeed() const noexcept;
 	void setActorOnGround(bool onGround) noexcept;
 	bool isOnGround(void) const noexcept;
+	//  ٴ 浹 üũ  ﰢ.  ʾ _terrain nullptr
+	TerrainContact getGroundContact(void) const noexcept;
+	void setGroundContact(const TerrainContact& contact) noexcept;
 	void setActorOnWall(bool onWall) noexcept;
 	bool isOnWall(void) const noexcept;
 	bool isQuaternionRotate(void) const noexcept;
@@ -33,8 +39,12 @@ public:
 	void setPath(int key) noexcept;
 	const Path* getPath(void) const noexcept;
 	bool isPathEnd(void) const noexcept;
+	// path ̵ ̸ true. ̵ ġ StageManager path Ƽ   setPathPosition ־ش.
+	bool isPathMove(void) const noexcept;
+	const TickCount64& getPathTime(void) const noexcept;
+	void setPathPosition(const DirectX::XMFLOAT3& position) noexcept;
 	void setAnimationSpeed(float speed) noexcept;
-	void setNextActionState(const std::string& actionStateName) noexcept;
+	void setNextActionState(NameId actionState) noexcept;
 public:
 	TickCount64 getLocalTickCount(void) const noexcept;
 	const DirectX::XMFLOAT3& getPosition(void) const noexcept;
@@ -69,7 +79,22 @@ public:
 
 	const ActionState* getCurrentActionState(void) const noexcept { return _currentActionState; }
 	const ActionChart* getActionChart(void) const noexcept { return _actionChart; }
-	void setActionState(const std::string& actionStateName) noexcept;
+	void setActionState(NameId actionState) noexcept;
+	uint16_t getFrameEventCursor(void) const noexcept { return _frameEventCursor; }
+	void setFrameEventCursor(uint16_t cursor) noexcept { _frameEventCursor = cursor; }
+	//  Է (ActionCondition::isStableInput) ϴ  ٲ𶧸 ޶.
+	uint64_t getConditionInputVersion(void) const noexcept;
+	//  ׼ ¿ Է ٲ   ʾƵ Ǵ branch . Է ٲ  ȯѴ.
+	uint64_t getSkippedBranchMask(void) noexcept;
+	void setSkippedBranchMask(uint64_t mask) noexcept;
+	// ְ  frame event   branch Ǵ ̸ true. 浹,  ,   û  ٷ false ȴ.
+	bool isSleepable(void) const noexcept;
+	void setActivityPhase(uint8_t phase) noexcept { _activityPhase = phase; }
+	// ̹ ӿ ùķ̼ ؾ ϸ ׾Ƶ tick outDeltaTick ְ true ȯѴ.
+	bool consumeActivityTick(ActorActivityLevel level,
+		uint32_t frameCount,
+		const TickCount64& deltaTick,
+		TickCount64& outDeltaTick) noexcept;
 
 	void updateObjectWorldMatrix() noexcept;
 
@@ -84,9 +109,10 @@ public:
 	const GameObject* getGameObject(void) const noexcept;
 	const DirectX::XMINT3& getSectorCoord(void) const noexcept;
 	void processCollision(const Actor* collidingActor, CollisionCase collisionCase) noexcept;
-	void setCulled(void) noexcept;
-	void setActionChartVariable(const std::string& name, int value) noexcept;
-	int getActionChartVariable(const std::string& name) const noexcept;
+	void addCullingBox(FrustumCuller& culler) noexcept;
+	void setCulled(const FrustumCuller& culler) noexcept;
+	void setActionChartVariable(NameId nameId, int value) noexcept;
+	int getActionChartVariable(NameId nameId) const noexcept;
 	int getActionIndex(void) const noexcept;
 	void setGravityOn(bool on) noexcept;
 	void setCollisionOn(bool on) noexcept;
@@ -121,6 +147,8 @@ private:
 
 	const Path* _path;
 	TickCount64 _pathTime;
+	// ̹  _pathTime path ġ
+	DirectX::XMFLOAT3 _pathPosition;
 
 	DirectX::XMFLOAT3 _targetPosition;
 
@@ -130,6 +158,7 @@ private:
 	float _rotateSpeed;
 
 	const GravityPoint* _gravityPoint;
+	GravityPointCandidates _gravityPointCandidates;
 	bool _isGravityOn;
 
 	GameObject* _gameObject;
@@ -138,15 +167,29 @@ private:
 
 	const ActionChart* _actionChart;
 	const ActionState* _currentActionState;
-	std::string _nextActionStateName;
-	std::unordered_map<std::string, int> _actionChartVariables;
+	//  ¿  ó frame event ε
+	uint16_t _frameEventCursor;
+	NameId _nextActionState;
+	// ActionChart::getVariableIndex ã ε 
+	std::vector<int> _actionChartVariables;
 	int _actionIndex;
+	uint32_t _conditionInputVersion;
+	uint64_t _skippedBranchMask;
+	uint64_t _skippedBranchVersion;
 	
 	TickCount64 _localTickCount;
 	bool _isCollisionOn;
 
+	// ùķ̼ ǳʶٴ   tick
+	TickCount64 _pendingDeltaTick;
+	//   actor  ӿ  ʵ ִ 
+	uint8_t _activityPhase;
+
 	bool _onGround;
 	bool _onWall;
+	//   ٴ ﰢ. TerrainContact  Ѵ.
+	const Terrain* _groundTerrain;
+	uint16_t _groundNodeIndex;
 
 	std::unordered_map<int, ConstantEffectInstance*> _childEffects;
 public:
@@ -25,7 +25,12 @@ BackgroundObject::~BackgroundObject()
 	}
 }
 
-void BackgroundObject::setCulled() noexcept
+void BackgroundObject::addCullingBox(FrustumCuller& culler) noexcept
 {
-	_gameObject->setCulledBackground();
+	_gameObject->addCullingBoxBackground(culler);
+}
+
+void BackgroundObject::setCulled(const FrustumCuller& culler) noexcept
+{
+	_gameObject->setCulled(culler);
 }
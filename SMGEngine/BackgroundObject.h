@@ -1,13 +1,15 @@
 #pragma once
 class GameObject;
 class BackgroundObjectInfo;
+class FrustumCuller;
 
 class BackgroundObject
 {
 public:
 	BackgroundObject(const BackgroundObjectInfo& backgroundObjectInfo);
 	~BackgroundObject();
-	void setCulled() noexcept;
+	void addCullingBox(FrustumCuller& culler) noexcept;
+	void setCulled(const FrustumCuller& culler) noexcept;
 private:
 	GameObject* _gameObject;
 };
\ No newline at end of file
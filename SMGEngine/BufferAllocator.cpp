@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "BufferAllocator.h"
+#include "Exception.h"
+#include <algorithm>
+
+PagedSlotAllocator::PagedSlotAllocator(uint32_t pageSize, uint32_t maxSlotCount) noexcept
+	: _pageSize(pageSize)
+	, _maxSlotCount(maxSlotCount)
+	, _pageCount(1)
+	, _nextSlot(0)
+	, _peakUsedCount(0)
+	, _failedCount(0)
+{
+	check(0 < pageSize);
+	check(pageSize <= maxSlotCount);
+}
+
+uint32_t PagedSlotAllocator::allocate(void) noexcept
+{
+	uint32_t slot;
+	if (!_freeSlots.empty())
+	{
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+	}
+	else
+	{
+		if (_nextSlot == _maxSlotCount)
+		{
+			++_failedCount;
+			return INVALID_SLOT;
+		}
+		slot = _nextSlot++;
+		if (getCapacity() < _nextSlot)
+		{
+			++_pageCount;
+		}
+	}
+	_peakUsedCount = std::max(_peakUsedCount, getUsedCount());
+	return slot;
+}
+
+void PagedSlotAllocator::release(uint32_t slot) noexcept
+{
+	check(slot < _nextSlot);
+#if defined DEBUG | defined _DEBUG
+	// ȯ ȣ ü ãǷ  忡 ȮѴ.
+	check(std::find(_freeSlots.begin(), _freeSlots.end(), slot) == _freeSlots.end(), "ߺ ȯ");
+#endif
+	_freeSlots.push_back(slot);
+}
+
+void PagedSlotAllocator::clear(void) noexcept
+{
+	// ۴ ̹ þ Ƿ   Ѵ.
+	_nextSlot = 0;
+	_freeSlots.clear();
+}
+
+void PagedSlotAllocator::logStatistics(const std::string& name) noexcept
+{
+	const std::string text = "[PagedSlotAllocator] " + name +
+		" used: " + std::to_string(getUsedCount()) +
+		" peak: " + std::to_string(_peakUsedCount) + "/" + std::to_string(getCapacity()) +
+		" page: " + std::to_string(_pageCount) +
+		" failed: " + std::to_string(_failedCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_peakUsedCount = getUsedCount();
+	_failedCount = 0;
+}
+
+LinearAllocator::LinearAllocator(void) noexcept
+	: _capacity(0)
+	, _usedCount(0)
+	, _frameCount(0)
+	, _totalUsedCount(0)
+	, _peakUsedCount(0)
+	, _failedCount(0)
+{
+}
+
+void LinearAllocator::reset(uint32_t capacity) noexcept
+{
+	if (0 < _usedCount)
+	{
+		++_frameCount;
+		_totalUsedCount += _usedCount;
+	}
+	_capacity = capacity;
+	_usedCount = 0;
+}
+
+uint32_t LinearAllocator::allocate(uint32_t count) noexcept
+{
+	if (_capacity - _usedCount < count)
+	{
+		++_failedCount;
+		return INVALID_OFFSET;
+	}
+	const uint32_t offset = _usedCount;
+	_usedCount += count;
+	_peakUsedCount = std::max(_peakUsedCount, _usedCount);
+	return offset;
+}
+
+void LinearAllocator::logStatistics(const std::string& name) noexcept
+{
+	if (_frameCount == 0)
+	{
+		return;
+	}
+	const std::string text = "[LinearAllocator] " + name +
+		" used/frame: " + std::to_string(static_cast<double>(_totalUsedCount) / _frameCount) +
+		" peak: " + std::to_string(_peakUsedCount) + "/" + std::to_string(_capacity) +
+		" failed: " + std::to_string(_failedCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_frameCount = 0;
+	_totalUsedCount = 0;
+	_peakUsedCount = 0;
+	_failedCount = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <limits>
+
+// constant buffer ȣ ִ Ҵ. D3D ġ  ȣ ϰ  ۴ FrameResource 뷮  ø.
+
+// Ʈó  ӵ  ȣ  Ϳ.   뷮 þ ȯ ȣ Ѵ.
+class PagedSlotAllocator
+{
+public:
+	static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+
+	// maxSlotCount ȣ ϴ Ÿ 
+	PagedSlotAllocator(uint32_t pageSize, uint32_t maxSlotCount) noexcept;
+	// ȣ maxSlotCount ٴٸ INVALID_SLOT ȯѴ.
+	uint32_t allocate(void) noexcept;
+	void release(uint32_t slot) noexcept;
+	void clear(void) noexcept;
+
+	// ۰ ּ  ϴ ũ
+	uint32_t getCapacity(void) const noexcept { return _pageCount * _pageSize; }
+	uint32_t getUsedCount(void) const noexcept { return _nextSlot - static_cast<uint32_t>(_freeSlots.size()); }
+	void logStatistics(const std::string& name) noexcept;
+private:
+	const uint32_t _pageSize;
+	const uint32_t _maxSlotCount;
+	uint32_t _pageCount;
+	uint32_t _nextSlot;
+	//  ȯ ȣ ؼ ȣ ʿ ̰ Ѵ.
+	std::vector<uint32_t> _freeSlots;
+
+	//  Ȯο
+	uint32_t _peakUsedCount;
+	uint32_t _failedCount;
+};
+
+//  ӵȸ  Ϳ. Ӹ  տ ӵ  ش.
+//  ҽ ۰  Ƿ FRAME_RESOURCE_COUNT ۸ ư  ring buffer ȴ.
+class LinearAllocator
+{
+public:
+	static constexpr uint32_t INVALID_OFFSET = std::numeric_limits<uint32_t>::max();
+
+	LinearAllocator(void) noexcept;
+	//  ۽   ҽ  뷮 ȣѴ.
+	void reset(uint32_t capacity) noexcept;
+	// 뷮  INVALID_OFFSET ȯѴ.
+	uint32_t allocate(uint32_t count) noexcept;
+
+	uint32_t getUsedCount(void) const noexcept { return _usedCount; }
+	uint32_t getCapacity(void) const noexcept { return _capacity; }
+	void logStatistics(const std::string& name) noexcept;
+private:
+	uint32_t _capacity;
+	uint32_t _usedCount;
+
+	//  Ȯο
+	uint32_t _frameCount;
+	uint64_t _totalUsedCount;
+	uint32_t _peakUsedCount;
+	uint32_t _failedCount;
+};
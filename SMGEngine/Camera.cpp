@@ -44,6 +44,7 @@ Camera::Camera()
 void Camera::releaseForStageLoad(void) noexcept
 {
 	_cameraPoint = nullptr;
+	_autoCameraPointCache = CameraPointCache();
 	_blendTick = 0;
 	_inputCameraPointKey = -1;
 }
@@ -292,7 +293,7 @@ void Camera::updateCameraPoint(void) noexcept
 	if (_inputCameraPointKey < 0)
 	{
 		XMFLOAT3 playerPosition = SMGFramework::getStageManager()->getPlayerActor()->getPosition();
-		cameraPoint = SMGFramework::getStageManager()->getStageInfo()->getNearestCameraPoint(playerPosition);
+		cameraPoint = SMGFramework::getStageManager()->getStageInfo()->getNearestCameraPoint(playerPosition, _autoCameraPointCache);
 	}
 	else
 	{
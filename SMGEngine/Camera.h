@@ -1,7 +1,7 @@
 #pragma once
 #include "TypeStage.h"
+#include "StageInfo.h"
 
-class CameraPoint;
 struct CameraPointData;
 
 class Camera
@@ -31,6 +31,7 @@ private:
 private:
 	// ī޶
 	const CameraPoint* _cameraPoint;
+	CameraPointCache _autoCameraPointCache;
 	DirectX::XMFLOAT3 _cameraBlendPosition;
 	DirectX::XMFLOAT4 _cameraBlendRotationQuat;
 	TickCount64 _blendTick;
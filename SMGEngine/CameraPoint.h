@@ -15,6 +15,8 @@ public:
 					DirectX::XMFLOAT4& rotationQuat) const noexcept = 0;
 	bool checkInRange(const DirectX::XMFLOAT3& position) const noexcept;
 	float getDistanceSq(const DirectX::XMFLOAT3& position) const noexcept;
+	const DirectX::XMFLOAT3& getPointPosition(void) const noexcept { return _pointPosition; }
+	float getRadius(void) const noexcept { return _radius; }
 	const TickCount64& getBlendTick(void) const noexcept;
 	static std::unique_ptr<CameraPoint> loadXMLCameraPoint(const XMLReaderNode& node, bool isAutoCamera);
 protected:
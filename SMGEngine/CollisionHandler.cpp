@@ -5,6 +5,7 @@
 #include "ActionCondition.h"
 #include "ActionChart.h"
 #include "MathHelper.h"
+#include "NameTable.h"
 
 CollisionEvent_RotateToTarget::CollisionEvent_RotateToTarget(const XMLReaderNode& node)
 {
@@ -47,7 +48,9 @@ std::unique_ptr<CollisionEvent> CollisionEvent::loadXMLCollisionEvent(const XMLR
 
 CollisionEvent_SetAction::CollisionEvent_SetAction(const XMLReaderNode& node)
 {
-	node.loadAttribute("State", _actionState);
+	std::string actionStateName;
+	node.loadAttribute("State", actionStateName);
+	_actionState = NameTable::getNameId(actionStateName);
 }
 
 void CollisionEvent_SetAction::process(Actor& selfActor, const Actor& targetActor) const noexcept
@@ -55,7 +58,7 @@ void CollisionEvent_SetAction::process(Actor& selfActor, const Actor& targetActo
 	selfActor.setNextActionState(_actionState);
 }
 
-std::string CollisionEvent_SetAction::getActionState(void) const noexcept
+NameId CollisionEvent_SetAction::getActionState(void) const noexcept
 {
 	return _actionState;
 }
@@ -88,29 +91,10 @@ CollisionHandler::CollisionHandler(const XMLReaderNode& node)
 	std::string conditionStrings;
 	node.loadAttribute("SelfCondition", conditionStrings);
 
-	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<ActionCondition> condition = ActionCondition::parseConditionString(c);
-
-		if (nullptr != condition) //  [8/10/2021 qwerw]  Ǹ ..
-		{
-			_selfConditions.push_back(std::move(condition));
-		}
-	}
+	_selfConditionProgram.compile(conditionStrings);
 
 	node.loadAttribute("TargetCondition", conditionStrings);
-
-	conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<ActionCondition> condition = ActionCondition::parseConditionString(c);
-
-		if (nullptr != condition) //  [8/10/2021 qwerw]  Ǹ ..
-		{
-			_targetConditions.push_back(std::move(condition));
-		}
-	}
+	_targetConditionProgram.compile(conditionStrings);
 
 	const auto& childNodes = node.getChildNodes();
 	for (const auto& childNode : childNodes)
@@ -131,7 +115,7 @@ void CollisionHandler::checkValid(const ActionChart* actionChart) const
 			const auto setActionEvent = static_cast<const CollisionEvent_SetAction*>(event.get());
 			if (nullptr == actionChart->getActionState(setActionEvent->getActionState()))
 			{
-				ThrowErrCode(ErrCode::ActionChartLoadFail, setActionEvent->getActionState());
+				ThrowErrCode(ErrCode::ActionChartLoadFail, NameTable::getName(setActionEvent->getActionState()));
 			}
 		}
 	}
@@ -144,20 +128,14 @@ bool CollisionHandler::checkHandler(Actor& selfActor, const Actor& targetActor,
 		return false;
 	}
 
-	for (const auto& condition : _selfConditions)
+	if (!_selfConditionProgram.evaluate(selfActor))
 	{
-		if (condition->isNotCondition() == condition->checkCondition(selfActor))
-		{
-			return false;
-		}
+		return false;
 	}
 
-	for (const auto& condition : _targetConditions)
+	if (!_targetConditionProgram.evaluate(targetActor))
 	{
-		if (condition->isNotCondition() == condition->checkCondition(targetActor))
-		{
-			return false;
-		}
+		return false;
 	}
 	return true;
 }
@@ -172,7 +150,9 @@ void CollisionHandler::processEvents(Actor& selfActor, const Actor& targetActor)
 
 CollisionEvent_SetVariableFromTarget::CollisionEvent_SetVariableFromTarget(const XMLReaderNode& node)
 {
-	node.loadAttribute("Name", _name);
+	std::string name;
+	node.loadAttribute("Name", name);
+	_name = NameTable::getNameId(name);
 }
 
 void CollisionEvent_SetVariableFromTarget::process(Actor& selfActor, const Actor& targetActor) const noexcept
@@ -1,9 +1,9 @@
 #pragma once
 #include "TypeAction.h"
+#include "ActionCondition.h"
 
 class XMLReaderNode;
 class Actor;
-class ActionCondition;
 class ActionChart;
 
 class CollisionEvent
@@ -34,9 +34,9 @@ public:
 	virtual ~CollisionEvent_SetAction() = default;
 	virtual void process(Actor& selfActor, const Actor& targetActor) const noexcept override;
 	virtual CollisionEventType getType(void) const noexcept { return CollisionEventType::SetAction; }
-	std::string getActionState(void) const noexcept;
+	NameId getActionState(void) const noexcept;
 private:
-	std::string _actionState;
+	NameId _actionState;
 };
 
 class CollisionEvent_SetVariableFromTarget : public CollisionEvent
@@ -47,7 +47,7 @@ public:
 	virtual void process(Actor& selfActor, const Actor& targetActor) const noexcept override;
 	virtual CollisionEventType getType(void) const noexcept { return CollisionEventType::SetVariableFromTarget; }
 private:
-	std::string _name;
+	NameId _name;
 };
 
 class CollisionHandler
@@ -61,6 +61,6 @@ public:
 private:
 	CollisionCase _case;
 	std::vector<std::unique_ptr<CollisionEvent>> _collisionEvents;
-	std::vector<std::unique_ptr<ActionCondition>> _selfConditions;
-	std::vector<std::unique_ptr<ActionCondition>> _targetConditions;
+	ActionConditionProgram _selfConditionProgram;
+	ActionConditionProgram _targetConditionProgram;
 };
\ No newline at end of file
@@ -59,12 +59,15 @@ void D3DApp::buildShaderResourceViews()
 }
 
 D3DApp::D3DApp()
-	: _currentFence(0)
+	: _objectCBAllocator(OBJECT_PAGE_SIZE, std::numeric_limits<uint16_t>::max())
+	, _skinnedCBAllocator(SKINNED_INSTANCE_PAGE_SIZE, SKINNED_UNDEFINED)
+	, _currentFence(0)
 	, _rtvDescriptorSize(0)
 	, _dsvDescriptorSize(0)
 	, _cbvSrcUavDescriptorSize(0)
 	, _frameIndex(0)
 	, _currentBackBuffer(0)
+	, _drawingSnapshot(nullptr)
 	, _textureLoadedCount(0)
 	, _projectionMatrix(MathHelper::Identity4x4)
 	, _aspectRatio(0)
@@ -74,11 +77,17 @@ D3DApp::D3DApp()
 	, _mainLightViewMatrix(MathHelper::Identity4x4)
 	, _mainLightProjectionMatrix(MathHelper::Identity4x4)
 	, _shadowTransform(MathHelper::Identity4x4)
+	, _isStaticShadowDirty(true)
 {
 	Initialize();
 }
 D3DApp::~D3DApp()
 {
+	_frameSnapshotQueue.stop();
+	if (_renderThread.joinable())
+	{
+		_renderThread.join();
+	}
 	if (_deviceD3d12 != nullptr)
 		flushCommandQueue();
 
@@ -251,7 +260,8 @@ void D3DApp::initDirect2D(void)
 {
 	D2D1_FACTORY_OPTIONS options;
 	options.debugLevel = D2D1_DEBUG_LEVEL_INFORMATION;
-	ThrowIfFailed(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, options, _d2dFactory.GetAddressOf()));
+	// UI  ̹ ùķ̼ 忡   忡 ׸.
+	ThrowIfFailed(D2D1CreateFactory(D2D1_FACTORY_TYPE_MULTI_THREADED, options, _d2dFactory.GetAddressOf()));
 	ThrowIfFailed(CoCreateInstance(
 		CLSID_WICImagingFactory,
 		nullptr,
@@ -330,24 +340,29 @@ void D3DApp::initDirect2D(void)
 
 void D3DApp::flushCommandQueue()
 {
-	_currentFence++;
+	const UINT64 fence = signalFence();
 
-	ThrowIfFailed(_commandQueue->Signal(_fence.Get(), _currentFence));
-
-	if (_fence->GetCompletedValue() < _currentFence)
+	if (_fence->GetCompletedValue() < fence)
 	{
 		HANDLE eventHandle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
 		if (eventHandle == nullptr)
 		{
 			ThrowIfFailed(E_OUTOFMEMORY, "CreateEventEX Fail");
 		}
-		ThrowIfFailed(_fence->SetEventOnCompletion(_currentFence, eventHandle));
+		ThrowIfFailed(_fence->SetEventOnCompletion(fence, eventHandle));
 
 		WaitForSingleObject(eventHandle, INFINITE);
 		CloseHandle(eventHandle);
 	}
 }
 
+UINT64 D3DApp::signalFence(void)
+{
+	std::lock_guard<std::mutex> lock(_fenceMutex);
+	ThrowIfFailed(_commandQueue->Signal(_fence.Get(), ++_currentFence));
+	return _currentFence;
+}
+
 void D3DApp::set4XMsaaState(bool value)
 {
 	if (_4xMsaaState != value)
@@ -370,6 +385,16 @@ void D3DApp::createCommandObjects(void)
 		IID_PPV_ARGS(_commandList.GetAddressOf())));
 
 	_commandList->Close();
+
+	// Draw ۾ ϳ Ѵ. allocator  ҽ ۾ ŭ ִ.
+	for (auto& recordCommandList : _recordCommandLists)
+	{
+		ThrowIfFailed(_deviceD3d12->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _commandAlloc.Get(), nullptr,
+			IID_PPV_ARGS(recordCommandList.GetAddressOf())));
+		recordCommandList->Close();
+	}
+	const uint32_t threadCount = std::clamp(std::thread::hardware_concurrency(), 1u, RECORD_THREAD_MAX);
+	_recordWorkerPool = std::make_unique<RecordWorkerPool>(threadCount);
 }
 
 void D3DApp::createSwapChain()
@@ -410,7 +435,7 @@ void D3DApp::createDescriptorHeaps(void)
 	ThrowIfFailed(_deviceD3d12->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(_rtvHeap.GetAddressOf())));
 
 	D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc;
-	dsvHeapDesc.NumDescriptors = 2;
+	dsvHeapDesc.NumDescriptors = 3;
 	dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
 	dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 	dsvHeapDesc.NodeMask = 0;
@@ -430,6 +455,9 @@ void D3DApp::OnResize(void)
 	check(_swapChain != nullptr, "swapChain nullԴϴ. ʱȭ Ȯϼ.");
 	check(_commandAlloc != nullptr, "commandAlloc nullԴϴ. ʱȭ Ȯϼ.");
 
+	// back buffer viewport  尡 ϰ   ִ.
+	waitRenderThreadIdle();
+
 	flushCommandQueue();
 	
 	// reset ui before resize
@@ -546,6 +574,56 @@ void D3DApp::OnResize(void)
 }
 
 void D3DApp::Update(void)
+{
+	FrameSnapshot& snapshot = _frameSnapshotQueue.getWriteSnapshot();
+	snapshot.clear();
+
+	updateObjectConstantBuffer(snapshot);
+	updateSkinnedConstantBuffer(snapshot);
+	updatePassConstantBuffer(snapshot);
+	updateShadowPassConstantBuffer(snapshot);
+	updateMaterialConstantBuffer(snapshot);
+	cullShadowCasters();
+	addDrawPackets(snapshot);
+
+	EffectManager* effectManager = SMGFramework::getEffectManager();
+	effectManager->updateEffectInstanceData(snapshot._effectInstances);
+	snapshot._effectMesh = effectManager->getMeshGeometry();
+	snapshot._backgroundColor = _backgroundColor;
+	SMGFramework::getUIManager()->addDrawCommands(snapshot._uiDrawCommands);
+
+	//  尡  snapshot   ٸ.
+	if (!_frameSnapshotQueue.publish())
+	{
+		check(_renderThreadException != nullptr);
+		std::rethrow_exception(_renderThreadException);
+	}
+}
+
+void D3DApp::waitRenderThreadIdle(void) noexcept
+{
+	_frameSnapshotQueue.waitIdle();
+}
+
+void D3DApp::renderThreadLoop(void) noexcept
+{
+	try
+	{
+		while (const FrameSnapshot* snapshot = _frameSnapshotQueue.acquire())
+		{
+			updateFrameResource(*snapshot);
+			drawFrame(*snapshot);
+			_frameSnapshotQueue.release();
+		}
+	}
+	catch (...)
+	{
+		_renderThreadException = std::current_exception();
+		_frameSnapshotQueue.stop();
+	}
+}
+
+void D3DApp::updateFrameResource(const FrameSnapshot& snapshot)
 {
 	_frameIndex = (_frameIndex + 1) % FRAME_RESOURCE_COUNT;
 	const UINT64& currentFrameFence = _frameResources[_frameIndex]->getFence();
@@ -561,87 +639,112 @@ void D3DApp::Update(void)
 		WaitForSingleObject(eventHandle, INFINITE);
 		CloseHandle(eventHandle);
 	}
-	updateObjectConstantBuffer();
-	updateSkinnedConstantBuffer();
-	updatePassConstantBuffer();
-	updateShadowPassConstantBuffer();
-	updateMaterialConstantBuffer();
+	FrameResource* frameResource = _frameResources[_frameIndex].get();
+	frameResource->releaseRetiredBuffers();
 
-	SMGFramework::getEffectManager()->updateEffectInstanceData(_frameResources[_frameIndex].get());
+	frameResource->setPassCB(0, snapshot._passConstants);
+	frameResource->setPassCB(1, snapshot._shadowPassConstants);
+
+	frameResource->reserveObjectCB(snapshot._objectCBCapacity);
+	for (const auto& e : snapshot._objectConstants)
+	{
+		frameResource->setObjectCB(e._index, e._constants);
+	}
+	frameResource->reserveMaterialCB(snapshot._materialCBCapacity);
+	for (const auto& e : snapshot._materialConstants)
+	{
+		frameResource->setMaterialCB(e._index, e._constants);
+	}
+	frameResource->reserveSkinnedCB(snapshot._skinnedCBCapacity);
+	for (const auto& e : snapshot._skinnedConstants)
+	{
+		frameResource->setSkinnedCB(e._index, e._constants);
+	}
+
+	const UINT effectInstanceCount = static_cast<UINT>(snapshot._effectInstances.size());
+	frameResource->reserveEffectBuffer(effectInstanceCount);
+	for (UINT i = 0; i < effectInstanceCount; ++i)
+	{
+		frameResource->setEffectBuffer(i, snapshot._effectInstances[i]);
+	}
 }
 
-void D3DApp::Draw(void)
+void D3DApp::drawFrame(const FrameSnapshot& snapshot)
 {
-	ID3D12CommandAllocator* cmdListAlloc = _frameResources[_frameIndex]->getCommandListAlloc();
-	ThrowIfFailed(cmdListAlloc->Reset(), "reset in Draw Failed");
+	_drawingSnapshot = &snapshot;
 
-	ThrowIfFailed(_commandList->Reset(cmdListAlloc, _pipelineStateObjectMap[PSOType::Shadow].Get()));
-	
-	ID3D12DescriptorHeap* descriptorHeaps[] = { _srvHeap.Get() };
-	_commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	LARGE_INTEGER buildStart, recordStart, recordEnd;
+	QueryPerformanceCounter(&buildStart);
+	buildRecordTasks(snapshot);
+	QueryPerformanceCounter(&recordStart);
 
-	_commandList->SetGraphicsRootSignature(_rootSignature.Get());
+	const uint32_t taskCount = static_cast<uint32_t>(_recordTasks.size());
+	_recordWorkerPool->run(taskCount, [this](uint32_t taskIndex) { recordTask(taskIndex); });
+	QueryPerformanceCounter(&recordEnd);
 
-	CD3DX12_GPU_DESCRIPTOR_HANDLE textureHandle(_srvHeap->GetGPUDescriptorHandleForHeapStart());
-	textureHandle.Offset(TEXTURE_SRV_INDEX, _cbvSrcUavDescriptorSize);
-	_commandList->SetGraphicsRootDescriptorTable(5, textureHandle);
-
-	drawSceneToShadowMap();
+	//  帶   ޶  ۾   Ѵ.
+	std::array<ID3D12CommandList*, RECORD_TASK_MAX> cmdLists;
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		cmdLists[i] = _recordCommandLists[i].Get();
+		_renderQueues[static_cast<int>(_recordTasks[i]._drawPass)].addStatistics(_recordTaskStatistics[i]);
+	}
+	_commandQueue->ExecuteCommandLists(taskCount, cmdLists.data());
 
-	_commandList->RSSetViewports(1, &_viewPort);
-	_commandList->RSSetScissorRects(1, &_scissorRect);
+	++_parallelRecordStatistics._frameCount;
+	_parallelRecordStatistics._taskCount += taskCount;
+	_parallelRecordStatistics._buildCounter += recordStart.QuadPart - buildStart.QuadPart;
+	_parallelRecordStatistics._recordCounter += recordEnd.QuadPart - recordStart.QuadPart;
 
-	const CD3DX12_RESOURCE_BARRIER& transitionBarrier1 = CD3DX12_RESOURCE_BARRIER::Transition(
-			getCurrentBackBuffer(),
-			D3D12_RESOURCE_STATE_PRESENT,
-			D3D12_RESOURCE_STATE_RENDER_TARGET);
-	_commandList->ResourceBarrier(1, &transitionBarrier1);
-	
+	//UI
+	drawUI(snapshot);
 	
-	const float backgroundColor[4] = { _backgroundColor.x, _backgroundColor.y, _backgroundColor.z, 1.f };
+	ThrowIfFailed(_swapChain->Present(0, 0));
+	_currentBackBuffer = (_currentBackBuffer + 1) % SWAP_CHAIN_BUFFER_COUNT;
 
-	_commandList->ClearRenderTargetView(getCurrentBackBufferView(), backgroundColor, 0, nullptr);
-	_commandList->ClearDepthStencilView(getDepthStencilView(), D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
+	_frameResources[_frameIndex]->setFence(signalFence());
+	_drawingSnapshot = nullptr;
+}
 
-	const D3D12_CPU_DESCRIPTOR_HANDLE backBufferView = getCurrentBackBufferView();
-	const D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = getDepthStencilView();
-	_commandList->OMSetRenderTargets(1, &backBufferView, true, &depthStencilView);
+void D3DApp::addDrawPackets(FrameSnapshot& snapshot)
+{
+	++_lodStatistics._frameCount;
 
-	_commandList->SetGraphicsRootConstantBufferView(3, _frameResources[_frameIndex]->getPassCBVirtualAddress());
-	CD3DX12_GPU_DESCRIPTOR_HANDLE shadowMapHandle(_srvHeap->GetGPUDescriptorHandleForHeapStart());
-	_commandList->SetGraphicsRootDescriptorTable(4, shadowMapHandle);
+	// lod main pass ī޶    ׸ڵ  lod Ƿ main pass  ߰Ѵ.
+	const XMFLOAT3& cameraPosition = SMGFramework::getCamera()->getPosition();
 	for (auto e : RenderLayers)
 	{
+		PSOType psoType = PSOType::Count;
 		switch (e)
 		{
 			case RenderLayer::Opaque:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Normal].Get());
+				psoType = PSOType::Normal;
 			}
 			break;
 			case RenderLayer::OpaqueSkinned:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Skinned].Get());
+				psoType = PSOType::Skinned;
 			}
 			break;
 			case RenderLayer::AlphaTested:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::BackSideNotCulling].Get());
+				psoType = PSOType::BackSideNotCulling;
 			}
 			break;
 			case RenderLayer::Transparent:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Transparent].Get());
+				psoType = PSOType::Transparent;
 			}
 			break;
 			case RenderLayer::Shadow:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Shadow].Get());
+				psoType = PSOType::Shadow;
 			}
 			break;
 			case RenderLayer::Background:
 			{
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Background].Get());
+				psoType = PSOType::Background;
 			}
 			break;
 			case RenderLayer::GameObjectDev:
@@ -651,7 +754,7 @@ void D3DApp::Draw(void)
 				{
 					continue;
 				}
-				_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::GameObjectDev].Get());
+				psoType = PSOType::GameObjectDev;
 #else
 				continue;
 #endif
@@ -665,29 +768,259 @@ void D3DApp::Draw(void)
 				ThrowErrCode(ErrCode::UndefinedType, "Դϴ");
 			}
 		}
-		drawRenderItems(e, true);
+		addRenderItems(e, psoType, DrawPass::Main, cameraPosition, snapshot);
  	}
-	drawEffects();
-	// drawUI   [2/16/2021 qwerwy]
-// 	const CD3DX12_RESOURCE_BARRIER& transitionBarrier2 = CD3DX12_RESOURCE_BARRIER::Transition(
-// 		getCurrentBackBuffer(),
-// 		D3D12_RESOURCE_STATE_RENDER_TARGET,
-// 		D3D12_RESOURCE_STATE_PRESENT);
-// 	_commandList->ResourceBarrier(1, &transitionBarrier2);
 
-	ThrowIfFailed(_commandList->Close());
+	// ̳  ʴ Ʈ ٲ ĳø ٽ ׸.
+	snapshot._isStaticShadowDirty = _isStaticShadowDirty;
+	_isStaticShadowDirty = false;
+	if (snapshot._isStaticShadowDirty)
+	{
+		addShadowCasters(DrawPass::StaticShadow, snapshot);
+	}
+	addShadowCasters(DrawPass::DynamicShadow, snapshot);
+}
 
-	ID3D12CommandList* cmdLists[] = { _commandList.Get() };
-	_commandQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+void D3DApp::buildRecordTasks(const FrameSnapshot& snapshot)
+{
+	for (int i = 0; i < static_cast<int>(DrawPass::Count); ++i)
+	{
+		_renderQueues[i].clear();
+		_renderQueues[i].addPackets(snapshot._drawPackets[i]);
+	}
 
-	//UI
-	drawUI();
-	
-	ThrowIfFailed(_swapChain->Present(0, 0));
-	_currentBackBuffer = (_currentBackBuffer + 1) % SWAP_CHAIN_BUFFER_COUNT;
+	// packet  pass  instance  ִ밪̴.
+	FrameResource* frameResource = _frameResources[_frameIndex].get();
+	UINT renderInstanceCount = 0;
+	for (auto& renderQueue : _renderQueues)
+	{
+		renderQueue.sort();
+		renderInstanceCount += static_cast<UINT>(renderQueue.getPackets().size());
+	}
+	frameResource->reserveRenderInstanceBuffer(renderInstanceCount);
+	_renderInstanceAllocator.reset(frameResource->getRenderInstanceBufferCapacity());
+
+	_recordTasks.clear();
+	const uint32_t threadCount = _recordWorkerPool->getThreadCount();
+	for (auto drawPass : RecordPassOrder)
+	{
+		if (drawPass == DrawPass::StaticShadow && !snapshot._isStaticShadowDirty)
+		{
+			continue;
+		}
+		const int passIndex = static_cast<int>(drawPass);
+		const RenderQueue& renderQueue = _renderQueues[passIndex];
+		const uint32_t packetCount = static_cast<uint32_t>(renderQueue.getPackets().size());
+		_renderInstanceOffsets[passIndex] = _renderInstanceAllocator.allocate(packetCount);
+		check(_renderInstanceOffsets[passIndex] != LinearAllocator::INVALID_OFFSET);
+
+		const uint32_t chunkCount = std::clamp(packetCount / RECORD_PACKET_MIN, 1u, threadCount);
+		renderQueue.split(chunkCount, _recordRanges);
+		for (size_t i = 0; i < _recordRanges.size(); ++i)
+		{
+			RecordTask task;
+			task._drawPass = drawPass;
+			task._range = _recordRanges[i];
+			task._isPassBegin = (i == 0);
+			task._isPassEnd = (i + 1 == _recordRanges.size());
+			_recordTasks.push_back(task);
+		}
+	}
+	check(_recordTasks.size() <= RECORD_TASK_MAX);
+	_recordTaskStatistics.assign(_recordTasks.size(), RenderQueueStatistics());
+}
+
+void D3DApp::recordTask(uint32_t taskIndex)
+{
+	check(taskIndex < _recordTasks.size());
+	const RecordTask& task = _recordTasks[taskIndex];
+	FrameResource* frameResource = _frameResources[_frameIndex].get();
+
+	ID3D12CommandAllocator* cmdListAlloc = frameResource->getCommandListAlloc(taskIndex);
+	ThrowIfFailed(cmdListAlloc->Reset(), "reset in recordTask Failed");
+	ID3D12GraphicsCommandList* commandList = _recordCommandLists[taskIndex].Get();
+	ThrowIfFailed(commandList->Reset(cmdListAlloc, nullptr));
+
+	if (task._isPassBegin)
+	{
+		recordPassBegin(commandList, task._drawPass);
+	}
+	setPassState(commandList, task._drawPass);
+
+	const int passIndex = static_cast<int>(task._drawPass);
+	D3DRenderBackend backend(commandList, _pipelineStateObjectMap, frameResource);
+	_renderQueues[passIndex].submit(backend, task._range, _renderInstanceOffsets[passIndex], _recordTaskStatistics[taskIndex]);
+
+	if (task._isPassEnd)
+	{
+		recordPassEnd(commandList, task._drawPass);
+	}
+	ThrowIfFailed(commandList->Close());
+}
+
+void D3DApp::setPassState(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const
+{
+	const FrameResource* frameResource = _frameResources[_frameIndex].get();
+	ID3D12DescriptorHeap* descriptorHeaps[] = { _srvHeap.Get() };
+	commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+
+	commandList->SetGraphicsRootSignature(_rootSignature.Get());
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE textureHandle(_srvHeap->GetGPUDescriptorHandleForHeapStart());
+	textureHandle.Offset(TEXTURE_SRV_INDEX, _cbvSrcUavDescriptorSize);
+	commandList->SetGraphicsRootDescriptorTable(5, textureHandle);
+
+	// object constant buffer structured buffer д´.
+	commandList->SetGraphicsRootShaderResourceView(0, frameResource->getObjectCBVirtualAddress());
+	commandList->SetGraphicsRootShaderResourceView(7, frameResource->getRenderInstanceBufferVirtualAddress());
+
+	switch (drawPass)
+	{
+		case DrawPass::Main:
+		{
+			commandList->RSSetViewports(1, &_viewPort);
+			commandList->RSSetScissorRects(1, &_scissorRect);
+
+			const D3D12_CPU_DESCRIPTOR_HANDLE backBufferView = getCurrentBackBufferView();
+			const D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = getDepthStencilView();
+			commandList->OMSetRenderTargets(1, &backBufferView, true, &depthStencilView);
+
+			commandList->SetGraphicsRootConstantBufferView(3, frameResource->getPassCBVirtualAddress());
+			CD3DX12_GPU_DESCRIPTOR_HANDLE shadowMapHandle(_srvHeap->GetGPUDescriptorHandleForHeapStart());
+			commandList->SetGraphicsRootDescriptorTable(4, shadowMapHandle);
+		}
+		break;
+		case DrawPass::StaticShadow:
+		case DrawPass::DynamicShadow:
+		{
+			commandList->RSSetViewports(1, &_shadowMap->getViewPort());
+			commandList->RSSetScissorRects(1, &_shadowMap->getScissorRect());
+
+			auto dsv = (drawPass == DrawPass::StaticShadow) ? _staticShadowMap->getDsv() : _shadowMap->getDsv();
+			commandList->OMSetRenderTargets(0, nullptr, false, &dsv);
+
+			UINT passCBByteSize = D3DUtil::CalcConstantBufferByteSize(sizeof(PassConstants));
+			auto shadowPassCBAddress = frameResource->getPassCBVirtualAddress() + 1 * passCBByteSize;
+			commandList->SetGraphicsRootConstantBufferView(3, shadowPassCBAddress);
+		}
+		break;
+		case DrawPass::Count:
+		default:
+		{
+			static_assert(static_cast<int>(DrawPass::Count) == 3, "Ÿ ߰ Ȯ");
+			check(false, "Դϴ");
+		}
+		break;
+	}
+}
+
+void D3DApp::recordPassBegin(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const
+{
+	switch (drawPass)
+	{
+		case DrawPass::StaticShadow:
+		{
+			CD3DX12_RESOURCE_BARRIER staticWriteBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_staticShadowMap->getResource(),
+				D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+			commandList->ResourceBarrier(1, &staticWriteBarrier);
+			commandList->ClearDepthStencilView(_staticShadowMap->getDsv(),
+				D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.f, 0, 0, nullptr);
+		}
+		break;
+		case DrawPass::DynamicShadow:
+		{
+			// GENERIC_READ COPY_SOURCE ԵǾ ־ ĳô ¸ ٲ ʰ Ѵ.
+			CD3DX12_RESOURCE_BARRIER copyDestBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_shadowMap->getResource(),
+				D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COPY_DEST);
+			commandList->ResourceBarrier(1, &copyDestBarrier);
+			commandList->CopyResource(_shadowMap->getResource(), _staticShadowMap->getResource());
+
+			CD3DX12_RESOURCE_BARRIER depthWriteBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_shadowMap->getResource(),
+				D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+			commandList->ResourceBarrier(1, &depthWriteBarrier);
+		}
+		break;
+		case DrawPass::Main:
+		{
+			const CD3DX12_RESOURCE_BARRIER& transitionBarrier1 = CD3DX12_RESOURCE_BARRIER::Transition(
+					getCurrentBackBuffer(),
+					D3D12_RESOURCE_STATE_PRESENT,
+					D3D12_RESOURCE_STATE_RENDER_TARGET);
+			commandList->ResourceBarrier(1, &transitionBarrier1);
+
+			const XMFLOAT3& color = _drawingSnapshot->_backgroundColor;
+			const float backgroundColor[4] = { color.x, color.y, color.z, 1.f };
+
+			commandList->ClearRenderTargetView(getCurrentBackBufferView(), backgroundColor, 0, nullptr);
+			commandList->ClearDepthStencilView(getDepthStencilView(), D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
+		}
+		break;
+		case DrawPass::Count:
+		default:
+		{
+			static_assert(static_cast<int>(DrawPass::Count) == 3, "Ÿ ߰ Ȯ");
+			check(false, "Դϴ");
+		}
+		break;
+	}
+}
 
-	_frameResources[_frameIndex]->setFence(++_currentFence);
-	_commandQueue->Signal(_fence.Get(), _currentFence);
+void D3DApp::recordPassEnd(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const
+{
+	switch (drawPass)
+	{
+		case DrawPass::StaticShadow:
+		{
+			CD3DX12_RESOURCE_BARRIER staticReadBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_staticShadowMap->getResource(),
+				D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_GENERIC_READ);
+			commandList->ResourceBarrier(1, &staticReadBarrier);
+		}
+		break;
+		case DrawPass::DynamicShadow:
+		{
+			CD3DX12_RESOURCE_BARRIER readBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_shadowMap->getResource(),
+				D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_GENERIC_READ);
+			commandList->ResourceBarrier(1, &readBarrier);
+		}
+		break;
+		case DrawPass::Main:
+		{
+			drawEffects(commandList);
+			// drawUI   [2/16/2021 qwerwy]
+// 			const CD3DX12_RESOURCE_BARRIER& transitionBarrier2 = CD3DX12_RESOURCE_BARRIER::Transition(
+// 				getCurrentBackBuffer(),
+// 				D3D12_RESOURCE_STATE_RENDER_TARGET,
+// 				D3D12_RESOURCE_STATE_PRESENT);
+// 			commandList->ResourceBarrier(1, &transitionBarrier2);
+		}
+		break;
+		case DrawPass::Count:
+		default:
+		{
+			static_assert(static_cast<int>(DrawPass::Count) == 3, "Ÿ ߰ Ȯ");
+			check(false, "Դϴ");
+		}
+		break;
+	}
+}
+
+void D3DApp::logParallelRecordStatistics(void) noexcept
+{
+	const auto& statistics = _parallelRecordStatistics;
+	if (statistics._frameCount == 0)
+	{
+		return;
+	}
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	const double counterToMicroSecond = 1000000.0 / frequency.QuadPart;
+
+	const std::string text = "[ParallelRecord] thread: " + std::to_string(_recordWorkerPool->getThreadCount()) +
+		" task/frame: " + std::to_string(static_cast<double>(statistics._taskCount) / statistics._frameCount) +
+		" build: " + std::to_string(statistics._buildCounter * counterToMicroSecond / statistics._frameCount) + "us" +
+		" record: " + std::to_string(statistics._recordCounter * counterToMicroSecond / statistics._frameCount) + "us\n";
+	OutputDebugStringA(text.c_str());
+	_parallelRecordStatistics = ParallelRecordStatistics();
 }
 
 void D3DApp::prepareCommandQueue(void)
@@ -727,7 +1060,7 @@ void D3DApp::buildFrameResources(void)
 {
 	for (int i = 0; i < FRAME_RESOURCE_COUNT; ++i)
 	{
-		auto frameResource = std::make_unique<FrameResource>(_deviceD3d12.Get(), 2, OBJECT_MAX, MATERIAL_MAX, SKINNED_INSTANCE_MAX, EFFECT_INSTANCE_MAX);
+		auto frameResource = std::make_unique<FrameResource>(_deviceD3d12.Get(), 2, OBJECT_PAGE_SIZE, MATERIAL_PAGE_SIZE, SKINNED_INSTANCE_PAGE_SIZE, EFFECT_INSTANCE_PAGE_SIZE, RENDER_INSTANCE_PAGE_SIZE, RECORD_TASK_MAX);
 		_frameResources.push_back(std::move(frameResource));
 	}
 }
@@ -742,6 +1075,12 @@ void D3DApp::initShadowMap()
 	_shadowMap->buildDescriptors(CD3DX12_CPU_DESCRIPTOR_HANDLE(srvCpuStart),
 								CD3DX12_GPU_DESCRIPTOR_HANDLE(srvGpuStart),
 								CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvCpuStart, 1, _dsvDescriptorSize));
+
+	_staticShadowMap = std::make_unique<ShadowMap>(_deviceD3d12.Get(), _shadowMap->getWidth(), _shadowMap->getHeight());
+	_staticShadowMap->buildDescriptors(CD3DX12_CPU_DESCRIPTOR_HANDLE(srvCpuStart, 1, _cbvSrcUavDescriptorSize),
+								CD3DX12_GPU_DESCRIPTOR_HANDLE(srvGpuStart, 1, _cbvSrcUavDescriptorSize),
+								CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvCpuStart, 2, _dsvDescriptorSize));
+	_isStaticShadowDirty = true;
 }
 
 void D3DApp::updateShadowTransform(void) noexcept
@@ -783,9 +1122,10 @@ void D3DApp::updateShadowTransform(void) noexcept
 	XMStoreFloat4x4(&_mainLightViewMatrix, lightView);
 	XMStoreFloat4x4(&_mainLightProjectionMatrix, lightProj);
 	XMStoreFloat4x4(&_shadowTransform, S);
+	_isStaticShadowDirty = true;
 }
 
-void D3DApp::updateShadowPassConstantBuffer(void) noexcept
+void D3DApp::updateShadowPassConstantBuffer(FrameSnapshot& snapshot) noexcept
 {
 	XMMATRIX view = XMLoadFloat4x4(&_mainLightViewMatrix);
 	XMMATRIX proj = XMLoadFloat4x4(&_mainLightProjectionMatrix);
@@ -814,46 +1154,144 @@ void D3DApp::updateShadowPassConstantBuffer(void) noexcept
 	_shadowPassConstants._renderTargetSize = XMFLOAT2(static_cast<float>(width), static_cast<float>(height));
 	_shadowPassConstants._invRenderTargetSize = XMFLOAT2(1.0f / width, 1.0f / height);
 
-	_frameResources[_frameIndex]->setPassCB(1, _shadowPassConstants);
+	snapshot._shadowPassConstants = _shadowPassConstants;
 }
 
-void D3DApp::updateObjectConstantBuffer()
+void D3DApp::cullShadowCasters(void) noexcept
 {
-	auto& currentFrameResource = _frameResources[_frameIndex];
+	XMMATRIX view = XMLoadFloat4x4(&_mainLightViewMatrix);
+	XMMATRIX proj = XMLoadFloat4x4(&_mainLightProjectionMatrix);
+	_shadowCuller.setFrustum(XMMatrixMultiply(view, proj));
+	_shadowCuller.clearBoxes();
 	for (const auto& e : _gameObjects)
 	{
-		if (e->popDirtyFrame())
+		e->addShadowCullingBox(_shadowCuller);
+	}
+
+	_shadowCuller.cull();
+
+	for (const auto& e : _gameObjects)
+	{
+		e->setShadowCulled(_shadowCuller);
+	}
+}
+
+void D3DApp::updateObjectConstantBuffer(FrameSnapshot& snapshot)
+{
+	snapshot._objectCBCapacity = _objectCBAllocator.getCapacity();
+	snapshot._objectConstants.reserve(_dirtyObjects.size());
+
+	++_constantBufferUpdateStatistics._frameCount;
+	_constantBufferUpdateStatistics._totalObjectCount += _gameObjects.size();
+
+	//  ٸ  ҽ ϴ ͸  ܼ .
+	uint32_t remainCount = 0;
+	for (auto gameObject : _dirtyObjects)
+	{
+		if (gameObject == nullptr)
 		{
-			ObjectConstants objectConstants;
+			continue;
+		}
+		ConstantBufferWrite<ObjectConstants> objectConstants;
+		objectConstants._index = gameObject->getObjectConstantBufferIndex();
+
+		XMMATRIX world = XMLoadFloat4x4(&gameObject->getWorldMatrix());
+		XMStoreFloat4x4(&objectConstants._constants._world, XMMatrixTranspose(world));
 
-			XMMATRIX world = XMLoadFloat4x4(&e->getWorldMatrix());
-			XMStoreFloat4x4(&objectConstants._world, XMMatrixTranspose(world));
+		XMMATRIX textureTransform = XMLoadFloat4x4(&gameObject->getTextrueTransformMatrix());
+		XMStoreFloat4x4(&objectConstants._constants._textureTransform, XMMatrixTranspose(textureTransform));
 
-			XMMATRIX textureTransform = XMLoadFloat4x4(&e->getTextrueTransformMatrix());
-			XMStoreFloat4x4(&objectConstants._textureTransform, XMMatrixTranspose(textureTransform));
+		snapshot._objectConstants.push_back(objectConstants);
+		++_constantBufferUpdateStatistics._updatedObjectCount;
 
-			currentFrameResource->setObjectCB(e->getObjectConstantBufferIndex(), objectConstants);
+		if (gameObject->popDirtyFrame())
+		{
+			gameObject->setDirtyListIndexXXX(remainCount);
+			_dirtyObjects[remainCount++] = gameObject;
+		}
+		else
+		{
+			gameObject->setDirtyListIndexXXX(GameObject::NOT_IN_DIRTY_LIST);
 		}
 	}
+	_dirtyObjects.resize(remainCount);
 }
 
-void D3DApp::updateSkinnedConstantBuffer(void)
+uint32_t D3DApp::addDirtyObject(GameObject* gameObject) noexcept
 {
-	auto& currentFrameResource = _frameResources[_frameIndex];
+	check(gameObject != nullptr);
+	check(gameObject->getDirtyListIndex() == GameObject::NOT_IN_DIRTY_LIST);
+	_dirtyObjects.push_back(gameObject);
+	return static_cast<uint32_t>(_dirtyObjects.size() - 1);
+}
+
+void D3DApp::removeDirtyObject(uint32_t dirtyListIndex) noexcept
+{
+	check(dirtyListIndex < _dirtyObjects.size());
+	check(_dirtyObjects[dirtyListIndex] != nullptr);
+	_dirtyObjects[dirtyListIndex] = nullptr;
+}
+
+void D3DApp::addDirtyMaterial(Material* material) noexcept
+{
+	check(material != nullptr);
+	_dirtyMaterials.push_back(material);
+}
+
+void D3DApp::logConstantBufferUpdateStatistics(void) noexcept
+{
+	const auto& statistics = _constantBufferUpdateStatistics;
+	if (statistics._frameCount == 0)
+	{
+		return;
+	}
+	const std::string text = "[ConstantBuffer] frame: " + std::to_string(statistics._frameCount) +
+		" object/frame: " + std::to_string(static_cast<double>(statistics._updatedObjectCount) / statistics._frameCount) +
+		"/" + std::to_string(static_cast<double>(statistics._totalObjectCount) / statistics._frameCount) +
+		" material/frame: " + std::to_string(static_cast<double>(statistics._updatedMaterialCount) / statistics._frameCount) +
+		"/" + std::to_string(static_cast<double>(statistics._totalMaterialCount) / statistics._frameCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_constantBufferUpdateStatistics = ConstantBufferUpdateStatistics();
+}
+
+void D3DApp::logLodStatistics(void) noexcept
+{
+	const auto& statistics = _lodStatistics;
+	if (statistics._frameCount == 0)
+	{
+		return;
+	}
+	std::string text = "[Lod] frame: " + std::to_string(statistics._frameCount) +
+		" triangle/frame: " + std::to_string(static_cast<double>(statistics._baseTriangleCount) / statistics._frameCount) +
+		" -> " + std::to_string(static_cast<double>(statistics._triangleCount) / statistics._frameCount) + " packet/lod:";
+	for (const auto& packetCount : statistics._lodPacketCounts)
+	{
+		text += " " + std::to_string(packetCount);
+	}
+	text += "\n";
+	OutputDebugStringA(text.c_str());
+	_lodStatistics = LodStatistics();
+}
+
+void D3DApp::updateSkinnedConstantBuffer(FrameSnapshot& snapshot)
+{
+	snapshot._skinnedCBCapacity = _skinnedCBAllocator.getCapacity();
+	snapshot._skinnedConstants.resize(_skinnedInstance.size());
+	size_t skinnedIndex = 0;
 
 	TickCount64 deltaTick = SMGFramework::Get().getTimer().getDeltaTickCount();
 	for (const auto& e : _skinnedInstance)
 	{
 		e->updateSkinnedAnimation(deltaTick);
-		SkinnedConstants skinnedConstants;
+		// ũⰡ Ŀ snapshot ٷ .
+		auto& skinnedConstants = snapshot._skinnedConstants[skinnedIndex++];
+		skinnedConstants._index = e->getIndex();
 		const auto& matrixes = e->getTransformMatrixes();
-		std::copy(std::begin(matrixes), std::end(matrixes), &skinnedConstants._boneTransforms[0]);
-
-		currentFrameResource->setSkinnedCB(e->getIndex(), skinnedConstants);
+		std::copy(std::begin(matrixes), std::end(matrixes), &skinnedConstants._constants._boneTransforms[0]);
 	}
 }
 
-void D3DApp::updatePassConstantBuffer()
+void D3DApp::updatePassConstantBuffer(FrameSnapshot& snapshot)
 {
 	const Camera* camera = SMGFramework::getCamera();
 	XMMATRIX view = XMLoadFloat4x4(&camera->getViewMatrix());
@@ -894,7 +1332,7 @@ void D3DApp::updatePassConstantBuffer()
 	_passConstants._fogStart = 20.f;
 	_passConstants._fogEnd = 5000.f;
 	
-	_frameResources[_frameIndex]->setPassCB(0, _passConstants);
+	snapshot._passConstants = _passConstants;
 }
 
 Material* D3DApp::loadXmlMaterial(const std::string& fileName, const std::string& materialName)
@@ -920,10 +1358,6 @@ Material* D3DApp::loadXmlMaterial(const std::string& fileName, const std::string
 		{
 			ThrowErrCode(ErrCode::KeyDuplicated, "material ߺ : " + name);
 		}
-		if (_materials.size() >= MATERIAL_MAX - 1)
-		{
-			ThrowErrCode(ErrCode::MemoryIsFull, "MaterialConstantBuffer " + std::to_string(MATERIAL_MAX) + " Ѿϴ.");
-		}
 		_materials.emplace(name, std::make_unique<Material>(static_cast<int>(_materials.size()), nodes[i]));
 	}
 
@@ -996,19 +1430,14 @@ GameObject* D3DApp::createGameObject(const MeshGeometry* meshGeometry, SkinnedMo
 
 	UINT objCBIndex = popObjectContantBufferIndex();
 
-	_gameObjects.emplace_back(std::make_unique<GameObject>(meshGeometry, objCBIndex, skinnedBufferIndex, skinnedInstance));
-	return _gameObjects.back().get();
+	return _gameObjects.create(meshGeometry, objCBIndex, skinnedBufferIndex, skinnedInstance);
 }
 
 SkinnedModelInstance* D3DApp::createSkinnedInstance(uint16_t& skinnedBufferIndex, const BoneInfo* boneInfo, const AnimationInfo* animationInfo) noexcept
 {
 	skinnedBufferIndex = popSkinnedContantBufferIndex();
 
-	unique_ptr<SkinnedModelInstance> newSkinnedInstance(std::make_unique<SkinnedModelInstance>(skinnedBufferIndex, boneInfo, animationInfo));
-	SkinnedModelInstance* skinnedInstancePtr = newSkinnedInstance.get();
-	_skinnedInstance.emplace_back(move(newSkinnedInstance));
-
-	return skinnedInstancePtr;
+	return _skinnedInstance.create(skinnedBufferIndex, boneInfo, animationInfo);
 }
 const MeshGeometry* D3DApp::getMeshGeometry(const std::string& meshName) const noexcept
 {
@@ -1042,16 +1471,57 @@ const Material* D3DApp::getMaterial(const std::string& fileName, const std::stri
 
 GameObject* D3DApp::createObjectFromXML(const std::string& fileName)
 {
+	LARGE_INTEGER startCounter;
+	QueryPerformanceCounter(&startCounter);
+
+	const ObjectTemplate* objectTemplate = loadObjectTemplate(fileName);
+
+	uint16_t skinnedConstantBufferIndex = SKINNED_UNDEFINED;
+	SkinnedModelInstance* skinnedInstance = nullptr;
+	if (objectTemplate->isSkinned())
+	{
+		skinnedInstance = createSkinnedInstance(skinnedConstantBufferIndex, objectTemplate->_boneInfo, objectTemplate->_animationInfo);
+	}
+
+	GameObject* gameObject = createGameObject(objectTemplate->_mesh, skinnedInstance, skinnedConstantBufferIndex);
+	
+	if (objectTemplate->_mesh != nullptr)
+	{
+		createRenderItems(gameObject, *objectTemplate);
+	}
+
+	LARGE_INTEGER endCounter;
+	QueryPerformanceCounter(&endCounter);
+	++_spawnStatistics._spawnCount;
+	_spawnStatistics._spawnCounter += endCounter.QuadPart - startCounter.QuadPart;
+	return gameObject;
+}
+
+void D3DApp::evictObjectTemplate(const std::string& fileName) noexcept
+{
+	_objectTemplates.erase(fileName);
+}
+
+const ObjectTemplate* D3DApp::loadObjectTemplate(const std::string& fileName)
+{
+	auto findIt = _objectTemplates.find(fileName);
+	if (findIt != _objectTemplates.end())
+	{
+		return findIt->second.get();
+	}
+
+	LARGE_INTEGER startCounter;
+	QueryPerformanceCounter(&startCounter);
+
 	const string filePath = "../Resources/XmlFiles/Object/" + fileName + ".xml";
 	XMLReader xmlObject;
 	xmlObject.loadXMLFile(filePath);
 
+	auto objectTemplate = std::make_unique<ObjectTemplate>();
 	const auto& childNodes = xmlObject.getRootNode().getChildNodesWithName();
 	bool isSkinned;
 	xmlObject.getRootNode().loadAttribute("IsSkinned", isSkinned);
 	auto childIter = childNodes.end();
-	uint16_t skinnedConstantBufferIndex = SKINNED_UNDEFINED;
-	SkinnedModelInstance* skinnedInstance = nullptr;
 
 	if (isSkinned)
 	{
@@ -1063,7 +1533,7 @@ GameObject* D3DApp::createObjectFromXML(const std::string& fileName)
 
 		string skeletonName;
 		childIter->second.loadAttribute("FileName", skeletonName);
-		const BoneInfo* boneInfo = loadXMLBoneInfo(skeletonName);
+		objectTemplate->_boneInfo = loadXMLBoneInfo(skeletonName);
 		
 		childIter = childNodes.find("Animation");
 		if (childIter == childNodes.end())
@@ -1072,9 +1542,7 @@ GameObject* D3DApp::createObjectFromXML(const std::string& fileName)
 		}
 		string animationInfoName;
 		childIter->second.loadAttribute("FileName", animationInfoName);
-		const AnimationInfo* animationInfo = loadXMLAnimationInfo(animationInfoName);
-
-		skinnedInstance = createSkinnedInstance(skinnedConstantBufferIndex, boneInfo, animationInfo);
+		objectTemplate->_animationInfo = loadXMLAnimationInfo(animationInfoName);
 	}
 
 	childIter = childNodes.find("Mesh");
@@ -1083,20 +1551,77 @@ GameObject* D3DApp::createObjectFromXML(const std::string& fileName)
 		ThrowErrCode(ErrCode::NodeNotFound, "Mesh 尡 ϴ.");
 	}
 	string meshFileName;
-	const MeshGeometry* mesh = nullptr;
 	childIter->second.loadAttribute("FileName", meshFileName);
 	if (!meshFileName.empty())
 	{
-		mesh = loadXMLMeshGeometry(meshFileName);
+		objectTemplate->_mesh = loadXMLMeshGeometry(meshFileName);
+		loadRenderItemTemplates(childIter->second, *objectTemplate);
 	}
-	
-	GameObject* gameObject = createGameObject(mesh, skinnedInstance, skinnedConstantBufferIndex);
-	
-	if (mesh != nullptr)
+
+	LARGE_INTEGER endCounter;
+	QueryPerformanceCounter(&endCounter);
+	++_spawnStatistics._templateLoadCount;
+	_spawnStatistics._templateLoadCounter += endCounter.QuadPart - startCounter.QuadPart;
+
+	auto it = _objectTemplates.emplace(fileName, std::move(objectTemplate));
+	return it.first->second.get();
+}
+
+void D3DApp::loadRenderItemTemplates(const XMLReaderNode& node, ObjectTemplate& objectTemplate)
+{
+	check(objectTemplate._mesh != nullptr);
+
+	const auto& subMeshList = objectTemplate._mesh->_subMeshList;
+	const auto& subMeshNodes = node.getChildNodes();
+
+	if (subMeshList.size() > std::numeric_limits<uint8_t>::max())
 	{
-		createRenderItems(gameObject, childIter->second);
+		ThrowErrCode(ErrCode::Overflow, "subMesh  255 ");
+	}
+	objectTemplate._renderItemTemplates.reserve(subMeshNodes.size());
+
+	for (int j = 0; j < subMeshNodes.size(); ++j)
+	{
+		string subMeshName;
+		subMeshNodes[j].loadAttribute("Name", subMeshName);
+		auto subMeshIt = find(subMeshList.begin(), subMeshList.end(), subMeshName);
+		if (subMeshIt == subMeshList.end())
+		{
+			ThrowErrCode(ErrCode::SubMeshNotFound, "SubMeshName : " + subMeshName + " ϴ.");
+		}
+		string materialFile, materialName;
+		subMeshNodes[j].loadAttribute("MaterialFile", materialFile);
+		subMeshNodes[j].loadAttribute("MaterialName", materialName);
+		const Material* material = loadXmlMaterial(materialFile, materialName);
+		if (objectTemplate.isSkinned() != (material->getRenderLayer() == RenderLayer::OpaqueSkinned))
+		{
+			ThrowErrCode(ErrCode::NotSkinnedMaterial, materialFile + "/" + materialName);
+		}
+
+		ObjectTemplate::RenderItemTemplate renderItemTemplate;
+		renderItemTemplate._material = material;
+		renderItemTemplate._subMeshIndex = static_cast<uint8_t>(subMeshIt - subMeshList.begin());
+		renderItemTemplate._renderLayer = material->getRenderLayer();
+		objectTemplate._renderItemTemplates.push_back(renderItemTemplate);
 	}
-	return gameObject;
+}
+
+void D3DApp::logSpawnStatistics(void) const noexcept
+{
+	if (_spawnStatistics._spawnCount == 0)
+	{
+		return;
+	}
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	const double counterToMicroSecond = 1000000.0 / frequency.QuadPart;
+
+	const std::string text = "[Spawn] count: " + std::to_string(_spawnStatistics._spawnCount) +
+		" avg: " + std::to_string(_spawnStatistics._spawnCounter * counterToMicroSecond / _spawnStatistics._spawnCount) + "us" +
+		" templateLoad: " + std::to_string(_spawnStatistics._templateLoadCount) +
+		" templateLoadTotal: " + std::to_string(_spawnStatistics._templateLoadCounter * counterToMicroSecond) + "us" +
+		" gameObjectPool: " + std::to_string(_gameObjects.size()) + "/" + std::to_string(_gameObjects.getCapacity()) + "\n";
+	OutputDebugStringA(text.c_str());
 }
 
 #if defined DEBUG | defined _DEBUG
@@ -1153,7 +1678,7 @@ void D3DApp::createGameObjectDev(Actor* actor)
 	auto object = createGameObject(mesh, nullptr, SKINNED_UNDEFINED);
  	parentObject->_devObjects.emplace_back(object);
 	
-	auto renderItem = make_unique<RenderItem>(
+	RenderItem* renderItem = _renderItems[static_cast<int>(RenderLayer::GameObjectDev)].create(
 		object,
 		loadXmlMaterial("devMat", "green"),
 		D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP,
@@ -1161,9 +1686,8 @@ void D3DApp::createGameObjectDev(Actor* actor)
 		RenderLayer::GameObjectDev);
 
 	std::vector<RenderItem*> renderItems;
-	renderItems.push_back(renderItem.get());
+	renderItems.push_back(renderItem);
 	object->setRenderItemsXXX(std::move(renderItems));
-	_renderItems[static_cast<int>(RenderLayer::GameObjectDev)].emplace_back(std::move(renderItem));
 }
 
 void D3DApp::createGameObjectDev(GameObject* gameObject)
@@ -1194,7 +1718,7 @@ void D3DApp::createGameObjectDev(GameObject* gameObject)
 	auto object = createGameObject(meshIt.first->second.get(), nullptr, SKINNED_UNDEFINED);
 	gameObject->_devObjects.emplace_back(object);
 
-	auto renderItem = make_unique<RenderItem>(
+	RenderItem* renderItem = _renderItems[static_cast<int>(RenderLayer::GameObjectDev)].create(
 		object,
 		loadXmlMaterial("devMat", "blueToRed"),
 		D3D11_PRIMITIVE_TOPOLOGY_LINELIST,
@@ -1202,27 +1726,42 @@ void D3DApp::createGameObjectDev(GameObject* gameObject)
 		RenderLayer::GameObjectDev);
 
 	std::vector<RenderItem*> renderItems;
-	renderItems.push_back(renderItem.get());
+	renderItems.push_back(renderItem);
 	object->setRenderItemsXXX(std::move(renderItems));
-	_renderItems[static_cast<int>(renderItem->_renderLayer)].emplace_back(std::move(renderItem));
 }
 #endif
 
 void D3DApp::releaseItemsForStageLoad(bool isReload) noexcept
 {
+	waitRenderThreadIdle();
 	flushCommandQueue();
 	Sleep(100);
 
+	logSpawnStatistics();
+	_spawnStatistics = ObjectSpawnStatistics();
+	_renderQueues[static_cast<int>(DrawPass::Main)].logStatistics("main");
+	_renderQueues[static_cast<int>(DrawPass::StaticShadow)].logStatistics("staticShadow");
+	_renderQueues[static_cast<int>(DrawPass::DynamicShadow)].logStatistics("dynamicShadow");
+	static_assert(static_cast<int>(DrawPass::Count) == 3, "Ÿ ߰ Ȯ");
+	logParallelRecordStatistics();
+	_frameSnapshotQueue.logStatistics();
+	_objectCBAllocator.logStatistics("objectCB");
+	_skinnedCBAllocator.logStatistics("skinnedCB");
+	_renderInstanceAllocator.logStatistics("renderInstance");
+	logFrameResourceStatistics();
+	logConstantBufferUpdateStatistics();
+	logLodStatistics();
+
 	for (int i = 0; i < static_cast<int>(RenderLayer::Count); ++i)
 	{
 		_renderItems[i].clear();
 	}
 	_gameObjects.clear();
+	_dirtyObjects.clear();
 	_skinnedInstance.clear();
-	_objectCBReturned = std::queue<UINT>();
-	_objectCBIndexCount = 0;
-	_skinnedCBReturned = std::queue<uint16_t>();
-	_skinnedCBIndexCount = 0;
+	_objectCBAllocator.clear();
+	_skinnedCBAllocator.clear();
+	_isStaticShadowDirty = true;
 
 	if (!isReload)
 	{
@@ -1230,69 +1769,78 @@ void D3DApp::releaseItemsForStageLoad(bool isReload) noexcept
 		_textureIndexMap.clear();
 		_textureLoadedCount = 0;
 		_materials.clear();
+		_dirtyMaterials.clear();
 		_boneInfoMap.clear();
 		_animationInfoMap.clear();
 		_geometries.clear();
+		_objectTemplates.clear();
 		_bitmapImages.clear();
 	}
 }
 
-void D3DApp::createRenderItems(GameObject* gameObject, const XMLReaderNode& node)
+void D3DApp::createRenderItems(GameObject* gameObject, const ObjectTemplate& objectTemplate)
 {
 	check(gameObject->getMeshGeometry() != nullptr);
-
-	const auto& subMeshList = gameObject->getMeshGeometry()->_subMeshList;
-	const auto& subMeshNodes = node.getChildNodes();
+	check(gameObject->getMeshGeometry() == objectTemplate._mesh);
 
 	std::vector<RenderItem*> renderItems;
-	if (subMeshList.size() > std::numeric_limits<uint8_t>::max())
-	{
-		ThrowErrCode(ErrCode::Overflow, "subMesh  255 ");
-	}
-	renderItems.reserve(subMeshNodes.size());
+	renderItems.reserve(objectTemplate._renderItemTemplates.size());
 
-	for (int j = 0; j < subMeshNodes.size(); ++j)
+	for (const auto& renderItemTemplate : objectTemplate._renderItemTemplates)
 	{
-		string subMeshName;
-		subMeshNodes[j].loadAttribute("Name", subMeshName);
-		auto subMeshIt = find(subMeshList.begin(), subMeshList.end(), subMeshName);
-		if (subMeshIt == subMeshList.end())
-		{
-			ThrowErrCode(ErrCode::SubMeshNotFound, "SubMeshName : " + subMeshName + " ϴ.");
-		}
-		string materialFile, materialName;
-		subMeshNodes[j].loadAttribute("MaterialFile", materialFile);
-		subMeshNodes[j].loadAttribute("MaterialName", materialName);
-		Material* material = loadXmlMaterial(materialFile, materialName);
-		if ((gameObject->isSkinnedAnimationObject()) != (material->getRenderLayer() == RenderLayer::OpaqueSkinned))
-		{
-			ThrowErrCode(ErrCode::NotSkinnedMaterial, materialFile + "/" + materialName);
-		}
-
-		RenderLayer renderLayer = material->getRenderLayer();
-		uint8_t subMeshIndex = subMeshIt - subMeshList.begin();
-		auto renderItem = make_unique<RenderItem>(
+		RenderItem* renderItem = _renderItems[static_cast<int>(renderItemTemplate._renderLayer)].create(
 			gameObject,
-			material,
+			renderItemTemplate._material,
 			D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
-			subMeshIndex,
-			renderLayer);
+			renderItemTemplate._subMeshIndex,
+			renderItemTemplate._renderLayer);
 
-		renderItems.push_back(renderItem.get());
-		_renderItems[static_cast<int>(renderLayer)].emplace_back(std::move(renderItem));
+		renderItems.push_back(renderItem);
 	}
 
 	gameObject->setRenderItemsXXX(std::move(renderItems));
 }
 
-void D3DApp::drawUI(void)
+void D3DApp::drawUI(const FrameSnapshot& snapshot)
 {
 	_deviceD3d11On12->AcquireWrappedResources(_backBufferWrapped[_currentBackBuffer].GetAddressOf(), 1);
 
 	_d2dContext->SetTarget(_backBufferBitmap[_currentBackBuffer].Get());
 	_d2dContext->BeginDraw();
 
-	SMGFramework::Get().getUIManager()->drawUI();
+	for (const auto& command : snapshot._uiDrawCommands)
+	{
+		switch (command._type)
+		{
+			case UIElementType::Image:
+			{
+				_d2dContext->DrawBitmap(command._bitmap.Get(), D2D1::RectF(command._position.x,
+					command._position.y,
+					command._position.x + command._size.x,
+					command._position.y + command._size.y));
+			}
+			break;
+			case UIElementType::Text:
+			{
+				_d2dContext->DrawTextLayout(D2D1::Point2F(command._position.x, command._position.y),
+					command._textLayout.Get(),
+					getTextBrush(command._brushType));
+			}
+			break;
+			case UIElementType::Iris:
+			{
+				_d2dContext->FillGeometry(command._geometry.Get(), getTextBrush(command._brushType));
+			}
+			break;
+			case UIElementType::Count:
+			default:
+			{
+				static_assert(static_cast<int>(UIElementType::Count) == 3, "Ÿ ߰ Ȯ");
+				check(false, "Դϴ");
+			}
+			break;
+		}
+	}
 
 	_d2dContext->EndDraw();
 	_d2dContext->SetTarget(nullptr);
@@ -1302,56 +1850,55 @@ void D3DApp::drawUI(void)
 	_d3d11Context->Flush();
 }
 
-void D3DApp::drawSceneToShadowMap(void)
+float D3DApp::calculateScreenSize(const DirectX::BoundingBox& localBox,
+									const DirectX::XMFLOAT4X4& world,
+									const DirectX::XMFLOAT3& eyePosition) noexcept
 {
-	_commandList->RSSetViewports(1, &_shadowMap->getViewPort());
-	_commandList->RSSetScissorRects(1, &_shadowMap->getScissorRect());
-
-	CD3DX12_RESOURCE_BARRIER depthWriteBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_shadowMap->getResource(),
-		D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_DEPTH_WRITE);
-	_commandList->ResourceBarrier(1, &depthWriteBarrier);
-	auto dsv = _shadowMap->getDsv();
-	_commandList->ClearDepthStencilView(dsv,
-		D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.f, 0, 0, nullptr);
-	
-	_commandList->OMSetRenderTargets(0, nullptr, false, &dsv);
-
-	UINT passCBByteSize = D3DUtil::CalcConstantBufferByteSize(sizeof(PassConstants));
-	auto shadowPassCBAddress = _frameResources[_frameIndex]->getPassCBVirtualAddress() + 1 * passCBByteSize;
-	_commandList->SetGraphicsRootConstantBufferView(3, shadowPassCBAddress);
-
-	_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Shadow].Get());
+	// ึ ũⰡ ٸ  ū   ø.
+	XMMATRIX worldMatrix = XMLoadFloat4x4(&world);
+	const float scale = std::max({ XMVectorGetX(XMVector3Length(worldMatrix.r[0])),
+		XMVectorGetX(XMVector3Length(worldMatrix.r[1])),
+		XMVectorGetX(XMVector3Length(worldMatrix.r[2])) });
+	const float radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&localBox.Extents))) * scale;
+	XMVECTOR center = XMVector3Transform(XMLoadFloat3(&localBox.Center), worldMatrix);
+	const float distance = XMVectorGetX(XMVector3Length(center - XMLoadFloat3(&eyePosition)));
+	if (distance <= radius)
+	{
+		return 1.f;
+	}
+	return radius / (distance * std::tan(FOV_ANGLE * 0.5f));
+}
 
-	drawRenderItems(RenderLayer::Opaque, false);
-	drawRenderItems(RenderLayer::AlphaTested, false);
+void D3DApp::addShadowCasters(DrawPass drawPass, FrameSnapshot& snapshot) noexcept
+{
+	check(drawPass == DrawPass::StaticShadow || drawPass == DrawPass::DynamicShadow);
 
-	_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::ShadowSkinned].Get());
-	drawRenderItems(RenderLayer::OpaqueSkinned, false);
+	const XMFLOAT3& lightPosition = _shadowPassConstants._cameraPos;
+	addRenderItems(RenderLayer::Opaque, PSOType::Shadow, drawPass, lightPosition, snapshot);
+	addRenderItems(RenderLayer::AlphaTested, PSOType::Shadow, drawPass, lightPosition, snapshot);
+	addRenderItems(RenderLayer::OpaqueSkinned, PSOType::ShadowSkinned, drawPass, lightPosition, snapshot);
 
 	static_assert(static_cast<int>(RenderLayer::Count) == 7, "׸ڰ ܾϴ ̾ ּ߰.");
-
-	CD3DX12_RESOURCE_BARRIER readBarrier = CD3DX12_RESOURCE_BARRIER::Transition(_shadowMap->getResource(),
-		D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_GENERIC_READ);
-	_commandList->ResourceBarrier(1, &readBarrier);
 }
 
-void D3DApp::drawEffects(void)
+void D3DApp::drawEffects(ID3D12GraphicsCommandList* commandList) const
 {
-	_commandList->SetPipelineState(_pipelineStateObjectMap[PSOType::Effect].Get());
+	check(_drawingSnapshot != nullptr);
+	commandList->SetPipelineState(_pipelineStateObjectMap.at(PSOType::Effect).Get());
 
-	auto meshGeometry = SMGFramework::getEffectManager()->getMeshGeometry();
+	auto meshGeometry = _drawingSnapshot->_effectMesh;
 	D3D12_VERTEX_BUFFER_VIEW vbv = meshGeometry->getVertexBufferView();
-	_commandList->IASetVertexBuffers(0, 1, &vbv);
+	commandList->IASetVertexBuffers(0, 1, &vbv);
 	D3D12_INDEX_BUFFER_VIEW ibv = meshGeometry->getIndexBufferView();
-	_commandList->IASetIndexBuffer(&ibv);
-	_commandList->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+	commandList->IASetIndexBuffer(&ibv);
+	commandList->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
 
 	auto instanceBufferAddress = _frameResources[_frameIndex]->getEffectBufferVirtualAddress();
-	_commandList->SetGraphicsRootShaderResourceView(6, instanceBufferAddress);
+	commandList->SetGraphicsRootShaderResourceView(6, instanceBufferAddress);
 	const auto& subMesh = meshGeometry->_subMeshList[0];
-	_commandList->DrawIndexedInstanced(
+	commandList->DrawIndexedInstanced(
 		subMesh._indexCount,
-		SMGFramework::getEffectManager()->getInstanceCount(),
+		static_cast<UINT>(_drawingSnapshot->_effectInstances.size()),
 		subMesh._baseIndexLoacation,
 		subMesh._baseVertexLoaction,
 		0);
@@ -1364,61 +1911,24 @@ std::string D3DApp::getMaterialKey(const std::string& fileName, const std::strin
 
 void D3DApp::removeRenderItem(const RenderLayer renderLayer, const RenderItem* renderItem) noexcept
 {
-	auto& renderItems = _renderItems[static_cast<int>(renderLayer)];
-	for (int i = 0; i < renderItems.size(); ++i)
-	{
-		if (renderItems[i].get() == renderItem)
-		{
-			renderItems[i] = std::move(renderItems.back());
-			renderItems.pop_back();
-			return;
-		}
-	}
-	check(false);
+	check(renderItem->_renderLayer == renderLayer);
+	_renderItems[static_cast<int>(renderLayer)].destroy(renderItem);
 }
 
 void D3DApp::removeSkinnedInstance(const SkinnedModelInstance* skinnedInstance) noexcept
 {
-	for (int i = 0; i < _skinnedInstance.size(); ++i)
-	{
-		if (_skinnedInstance[i].get() == skinnedInstance)
-		{
-			_skinnedInstance[i] = std::move(_skinnedInstance.back());
-			_skinnedInstance.pop_back();
-			return;
-		}
-	}
-	check(false);
+	_skinnedInstance.destroy(skinnedInstance);
 }
 
 void D3DApp::removeGameObject(const GameObject* gameObject) noexcept
 {
-	for (int i = 0; i < _gameObjects.size(); ++i)
-	{
-		if (_gameObjects[i].get() == gameObject)
-		{
-			_gameObjects[i] = std::move(_gameObjects.back());
-			_gameObjects.pop_back();
-			return;
-		}
-	}
-	check(false);
+	_gameObjects.destroy(gameObject);
 }
 
-bool XM_CALLCONV D3DApp::checkCulled(const DirectX::BoundingBox& box, FXMMATRIX world) const noexcept
+void D3DApp::getWorldFrustum(DirectX::BoundingFrustum& outFrustum) const noexcept
 {
-	XMVECTOR worldDet = XMMatrixDeterminant(world);
-	XMMATRIX invWorld = XMMatrixInverse(&worldDet, world);
-	XMMATRIX viewToLocal = XMMatrixMultiply(XMLoadFloat4x4(&SMGFramework::getCamera()->getInvViewMatrix()), invWorld);
-
-	BoundingFrustum localSpaceFrustum;
-	_viewFrustumLocal.Transform(localSpaceFrustum, viewToLocal);
-
-	if (localSpaceFrustum.Contains(box) != DirectX::DISJOINT)
-	{
-		return false;
-	}
-	return true;
+	XMMATRIX invView = XMLoadFloat4x4(&SMGFramework::getCamera()->getInvViewMatrix());
+	_viewFrustumLocal.Transform(outFrustum, invView);
 }
 
 void D3DApp::setLight(const std::vector<Light>& lights, const DirectX::XMFLOAT4& ambientLight) noexcept
@@ -1437,124 +1947,172 @@ void D3DApp::setBackgroundColor(const DirectX::XMFLOAT3& color) noexcept
 	_backgroundColor = color;
 }
 
-void D3DApp::updateMaterialConstantBuffer(void)
+void D3DApp::updateMaterialConstantBuffer(FrameSnapshot& snapshot)
 {
-	auto& currentFrameResource = _frameResources[_frameIndex];
-	for (auto it = _materials.begin(); it != _materials.end(); ++it)
+	snapshot._materialCBCapacity = static_cast<uint32_t>(_materials.size());
+	snapshot._materialConstants.reserve(_dirtyMaterials.size());
+	_constantBufferUpdateStatistics._totalMaterialCount += _materials.size();
+
+	size_t remainCount = 0;
+	for (auto mat : _dirtyMaterials)
 	{
-		Material* mat = it->second.get();
-		if (mat->_dirtyFrames > 0)
-		{
-			MaterialConstants matConstants;
-			matConstants._diffuseAlbedo = mat->getDiffuseAlbedo();
-			matConstants._fresnelR0 = mat->getFresnelR0();
-			matConstants._roughness = mat->getRoughness();
-			matConstants._diffuseMapIndex = mat->getDiffuseSRVHeapIndex();
+		ConstantBufferWrite<MaterialConstants> matConstants;
+		matConstants._index = mat->getMaterialCBIndex();
+		matConstants._constants._diffuseAlbedo = mat->getDiffuseAlbedo();
+		matConstants._constants._fresnelR0 = mat->getFresnelR0();
+		matConstants._constants._roughness = mat->getRoughness();
+		matConstants._constants._diffuseMapIndex = mat->getDiffuseSRVHeapIndex();
 
-			XMMATRIX matTransform = XMLoadFloat4x4(&mat->getMaterialTransform());
-			XMStoreFloat4x4(&matConstants._materialTransform, XMMatrixTranspose(matTransform));
+		XMMATRIX matTransform = XMLoadFloat4x4(&mat->getMaterialTransform());
+		XMStoreFloat4x4(&matConstants._constants._materialTransform, XMMatrixTranspose(matTransform));
 
-			currentFrameResource->setMaterialCB(mat->getMaterialCBIndex(), matConstants);
+		snapshot._materialConstants.push_back(matConstants);
+		++_constantBufferUpdateStatistics._updatedMaterialCount;
 
-			--mat->_dirtyFrames;
+		if (mat->popDirtyFrame())
+		{
+			_dirtyMaterials[remainCount++] = mat;
 		}
 	}
+	_dirtyMaterials.resize(remainCount);
 }
 
 UINT D3DApp::popObjectContantBufferIndex(void)
 {
-	if (_objectCBReturned.empty())
+	const uint32_t index = _objectCBAllocator.allocate();
+	if (index == PagedSlotAllocator::INVALID_SLOT)
 	{
-		if (_objectCBIndexCount >= OBJECT_MAX - 1)
-		{
-			ThrowErrCode(ErrCode::MemoryIsFull, "ObjectConstantBuffer " + std::to_string(OBJECT_MAX) + " Ѿϴ.");
-		}
-		return _objectCBIndexCount++;
-	}
-	else
-	{
-		UINT rv = _objectCBReturned.front();
-		_objectCBReturned.pop();
-
-		return rv;
+		ThrowErrCode(ErrCode::MemoryIsFull, "ObjectConstantBuffer ȣ մϴ.");
 	}
+	return index;
 }
 
 uint16_t D3DApp::popSkinnedContantBufferIndex(void)
 {
-	if (_skinnedCBReturned.empty())
+	const uint32_t index = _skinnedCBAllocator.allocate();
+	if (index == PagedSlotAllocator::INVALID_SLOT)
 	{
-		if (_skinnedCBIndexCount >= SKINNED_INSTANCE_MAX - 1)
-		{
-			ThrowErrCode(ErrCode::MemoryIsFull, "SkinnedConstantBuffer " + std::to_string(SKINNED_INSTANCE_MAX) + " Ѿϴ.");
-		}
-		return _skinnedCBIndexCount++;
-	}
-	else
-	{
-		uint16_t rv = _skinnedCBReturned.front();
-		_skinnedCBReturned.pop();
-
-		return rv;
+		ThrowErrCode(ErrCode::MemoryIsFull, "SkinnedConstantBuffer ȣ մϴ.");
 	}
+	return static_cast<uint16_t>(index);
 }
 
 void D3DApp::pushObjectContantBufferIndex(UINT index) noexcept
 {
-	_objectCBReturned.push(index);
+	_objectCBAllocator.release(index);
 }
 
 void D3DApp::pushSkinnedContantBufferIndex(uint16_t index) noexcept
 {
-	_skinnedCBReturned.push(index);
+	_skinnedCBAllocator.release(index);
 }
 
-void D3DApp::drawRenderItems(const RenderLayer renderLayer, bool checkCulled)
+void D3DApp::logFrameResourceStatistics(void) const noexcept
 {
-	int renderLayerIdx = static_cast<int>(renderLayer);
-	UINT objectCBByteSize = D3DUtil::CalcConstantBufferByteSize(sizeof(ObjectConstants));
-	UINT skinnedCBByteSize = D3DUtil::CalcConstantBufferByteSize(sizeof(SkinnedConstants));
-	UINT materialCBByteSize = D3DUtil::CalcConstantBufferByteSize(sizeof(MaterialConstants));
+	UINT growCount = 0;
+	for (const auto& frameResource : _frameResources)
+	{
+		growCount += frameResource->getGrowCount();
+	}
+	const std::string text = "[FrameResource] bufferGrow: " + std::to_string(growCount) + "\n";
+	OutputDebugStringA(text.c_str());
+}
 
-	D3D12_GPU_VIRTUAL_ADDRESS objectCBBaseAddress = _frameResources[_frameIndex]->getObjectCBVirtualAddress();
-	D3D12_GPU_VIRTUAL_ADDRESS skinnedCBBaseAddress = _frameResources[_frameIndex]->getSkinnedCBVirtualAddress();
-	D3D12_GPU_VIRTUAL_ADDRESS materialCBBaseAddress = _frameResources[_frameIndex]->getMaterialCBVirtualAddress();
-	
+bool D3DApp::isDrawSkipped(const GameObject* gameObject, DrawPass drawPass) const noexcept
+{
+	switch (drawPass)
+	{
+		case DrawPass::Main:
+		{
+			return gameObject->isCulled();
+		}
+		case DrawPass::StaticShadow:
+		{
+			return !gameObject->isShadowStatic() || gameObject->isShadowCulled();
+		}
+		case DrawPass::DynamicShadow:
+		{
+			return gameObject->isShadowStatic() || gameObject->isShadowCulled();
+		}
+		case DrawPass::Count:
+		default:
+		{
+			static_assert(static_cast<int>(DrawPass::Count) == 3, "Ÿ ߰ Ȯ");
+			check(false);
+			return false;
+		}
+	}
+}
+
+void D3DApp::addRenderItems(const RenderLayer renderLayer,
+							PSOType psoType,
+							DrawPass drawPass,
+							const DirectX::XMFLOAT3& eyePosition,
+							FrameSnapshot& snapshot) noexcept
+{
+	static_assert(static_cast<int>(RenderLayer::Count) <= 16, " Ű layer  Ȯּ.");
+	static_assert(static_cast<int>(PSOType::Count) <= 16, " Ű pso  Ȯּ.");
+	static_assert(MESH_LOD_COUNT_MAX <= 4, " Ű lod  Ȯּ.");
+	check(psoType != PSOType::Count);
+
+	int renderLayerIdx = static_cast<int>(renderLayer);
+	//   ͺ,     mesh, material Ƽ ׸.
+	const bool isBackToFront = (renderLayer == RenderLayer::Transparent);
+	XMVECTOR eye = XMLoadFloat3(&eyePosition);
 	for (int rIdx = 0; rIdx < _renderItems[renderLayerIdx].size(); ++rIdx)
 	{
-		auto renderItem = _renderItems[renderLayerIdx][rIdx].get();
+		auto renderItem = _renderItems[renderLayerIdx][rIdx];
 		check(renderItem != nullptr, "Դϴ.");
-		if (checkCulled && renderItem->_parentObject->isCulled())
+		const GameObject* gameObject = renderItem->_parentObject;
+		if (isDrawSkipped(gameObject, drawPass))
 		{
 			continue;
 		}
 
-		auto meshGeometry = renderItem->_parentObject->getMeshGeometry();
-		D3D12_VERTEX_BUFFER_VIEW vbv = meshGeometry->getVertexBufferView();
-		_commandList->IASetVertexBuffers(0, 1, &vbv);
-		D3D12_INDEX_BUFFER_VIEW ibv = meshGeometry->getIndexBufferView();
-		_commandList->IASetIndexBuffer(&ibv);
-		_commandList->IASetPrimitiveTopology(renderItem->_primitive);
-
-		D3D12_GPU_VIRTUAL_ADDRESS objectCBaddress = objectCBBaseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(renderItem->_parentObject->getObjectConstantBufferIndex()) * objectCBByteSize;
-		_commandList->SetGraphicsRootConstantBufferView(0, objectCBaddress);
+		const XMFLOAT4X4& world = gameObject->getWorldMatrix();
+		XMVECTOR position = XMVectorSet(world._41, world._42, world._43, 1.f);
+		const float depth = XMVectorGetX(XMVector3Length(position - eye)) / FAR_Z;
 
-		auto skinnedIndex = renderItem->_parentObject->getSkinnedConstantBufferIndex();
-		if (skinnedIndex != SKINNED_UNDEFINED)
+		const MeshGeometry* mesh = gameObject->getMeshGeometry();
+		//  ׸ڴ ĳؼ  Ƿ  ׸.
+		if (drawPass == DrawPass::Main)
 		{
-			D3D12_GPU_VIRTUAL_ADDRESS skinnedCBAdress = skinnedCBBaseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(skinnedIndex) * skinnedCBByteSize;
-			_commandList->SetGraphicsRootConstantBufferView(1, skinnedCBAdress);
+			const float screenSize = calculateScreenSize(mesh->getBoundingBox(), world, eyePosition);
+			renderItem->_lodLevel = mesh->selectLodLevel(screenSize, renderItem->_lodLevel);
 		}
-		D3D12_GPU_VIRTUAL_ADDRESS materialCBAddress = materialCBBaseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(renderItem->_material->getMaterialCBIndex()) * materialCBByteSize;
-		_commandList->SetGraphicsRootConstantBufferView(2, materialCBAddress);
-		
-		const auto& subMesh = meshGeometry->_subMeshList[renderItem->_subMeshIndex];
-		_commandList->DrawIndexedInstanced(
-			subMesh._indexCount,
-			1,
-			subMesh._baseIndexLoacation,
-			subMesh._baseVertexLoaction,
-			0);
+		else if (drawPass == DrawPass::DynamicShadow && gameObject->isCulled())
+		{
+			//  pass øǾ ̹  lod ŵ ʾǷ eyePosition()  ī޶  .
+			const float screenSize = calculateScreenSize(mesh->getBoundingBox(), world, SMGFramework::getCamera()->getPosition());
+			renderItem->_lodLevel = mesh->selectLodLevel(screenSize, renderItem->_lodLevel);
+		}
+		const uint8_t lodLevel = (drawPass == DrawPass::StaticShadow) ? 0 : renderItem->_lodLevel;
+
+		const SubMeshGeometry& subMesh = mesh->_subMeshList[renderItem->_subMeshIndex];
+		UINT lodIndexCount, lodBaseIndexLocation;
+		subMesh.getLodIndexRange(lodLevel, lodIndexCount, lodBaseIndexLocation);
+		_lodStatistics._baseTriangleCount += subMesh._indexCount / 3;
+		_lodStatistics._triangleCount += lodIndexCount / 3;
+		++_lodStatistics._lodPacketCounts[lodLevel];
+
+		DrawPacket packet;
+		packet._mesh = mesh;
+		packet._objectCBIndex = gameObject->getObjectConstantBufferIndex();
+		packet._materialCBIndex = renderItem->_material->getMaterialCBIndex();
+		packet._skinnedCBIndex = gameObject->getSkinnedConstantBufferIndex();
+		packet._psoType = static_cast<uint8_t>(psoType);
+		packet._primitive = static_cast<uint8_t>(renderItem->_primitive);
+		packet._subMeshIndex = renderItem->_subMeshIndex;
+		packet._lodLevel = lodLevel;
+		packet._sortKey = RenderQueue::makeSortKey(static_cast<uint8_t>(renderLayer),
+			packet._psoType,
+			packet._mesh,
+			packet._materialCBIndex,
+			packet._subMeshIndex,
+			packet._lodLevel,
+			depth,
+			isBackToFront);
+		snapshot._drawPackets[static_cast<int>(drawPass)].push_back(packet);
 	}
 }
 
@@ -1628,18 +2186,20 @@ void D3DApp::buildRootSignature(void)
 	CD3DX12_DESCRIPTOR_RANGE textureTable;
 	textureTable.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, TEXTURE_MAX, 1);
 
-	CD3DX12_ROOT_PARAMETER slotRootParameter[7];
+	CD3DX12_ROOT_PARAMETER slotRootParameter[9];
 
-	slotRootParameter[0].InitAsConstantBufferView(0); // objectConstant
+	slotRootParameter[0].InitAsShaderResourceView(2, 1); // objectDatas
 	slotRootParameter[1].InitAsConstantBufferView(1); // skinnedConstant
 	slotRootParameter[2].InitAsConstantBufferView(2); // materialDatas
 	slotRootParameter[3].InitAsConstantBufferView(3); // passConstant
 	slotRootParameter[4].InitAsDescriptorTable(1, &shadowMapTable, D3D12_SHADER_VISIBILITY_PIXEL); // shadowMap
 	slotRootParameter[5].InitAsDescriptorTable(1, &textureTable, D3D12_SHADER_VISIBILITY_PIXEL); // textures
 	slotRootParameter[6].InitAsShaderResourceView(1, 1); // instanceDatas
+	slotRootParameter[7].InitAsShaderResourceView(3, 1); // renderInstances
+	slotRootParameter[8].InitAsConstants(1, 4); // renderInstanceOffset
 
 	auto staticSampler = getStaticSampler();
-	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(7, slotRootParameter, staticSampler.size(), staticSampler.data(), D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(9, slotRootParameter, staticSampler.size(), staticSampler.data(), D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
 	WComPtr<ID3DBlob> serializedRootSig = nullptr;
 	WComPtr<ID3DBlob> errorBlob = nullptr;
 	
@@ -1942,6 +2502,7 @@ bool D3DApp::Initialize(void)
 
 	flushCommandQueue();
 
+	_renderThread = std::thread(&D3DApp::renderThreadLoop, this);
 	return true;
 }
 
@@ -2016,6 +2577,7 @@ RenderItem::RenderItem(const GameObject* parentObject,
 	, _primitive(primitive)
 	, _renderLayer(renderLayer)
 	, _subMeshIndex(subMeshIndex)
+	, _lodLevel(0)
 {
 }
 
@@ -2030,6 +2592,92 @@ void RenderItem::changeMaterial(const Material* material) noexcept
 	_material = material;
 }
 
+D3DRenderBackend::D3DRenderBackend(ID3D12GraphicsCommandList* commandList,
+								const unordered_map<PSOType, WComPtr<ID3D12PipelineState>>& pipelineStateObjectMap,
+								FrameResource* frameResource) noexcept
+	: _commandList(commandList)
+	, _pipelineStateObjectMap(pipelineStateObjectMap)
+	, _frameResource(frameResource)
+	, _skinnedCBBaseAddress(frameResource->getSkinnedCBVirtualAddress())
+	, _materialCBBaseAddress(frameResource->getMaterialCBVirtualAddress())
+	, _skinnedCBByteSize(D3DUtil::CalcConstantBufferByteSize(sizeof(SkinnedConstants)))
+	, _materialCBByteSize(D3DUtil::CalcConstantBufferByteSize(sizeof(MaterialConstants)))
+{
+	check(_commandList != nullptr);
+}
+
+void D3DRenderBackend::setPipelineState(uint8_t psoType) noexcept
+{
+	auto it = _pipelineStateObjectMap.find(static_cast<PSOType>(psoType));
+	if (it == _pipelineStateObjectMap.end())
+	{
+		check(false);
+		return;
+	}
+	_commandList->SetPipelineState(it->second.Get());
+}
+
+void D3DRenderBackend::setMesh(const MeshGeometry* mesh) noexcept
+{
+	check(mesh != nullptr);
+	D3D12_VERTEX_BUFFER_VIEW vbv = mesh->getVertexBufferView();
+	_commandList->IASetVertexBuffers(0, 1, &vbv);
+	D3D12_INDEX_BUFFER_VIEW ibv = mesh->getIndexBufferView();
+	_commandList->IASetIndexBuffer(&ibv);
+}
+
+void D3DRenderBackend::setPrimitiveTopology(uint8_t primitive) noexcept
+{
+	_commandList->IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(primitive));
+}
+
+void D3DRenderBackend::setSkinnedConstantBuffer(uint16_t skinnedCBIndex) noexcept
+{
+	check(skinnedCBIndex != SKINNED_UNDEFINED);
+	D3D12_GPU_VIRTUAL_ADDRESS skinnedCBAdress = _skinnedCBBaseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(skinnedCBIndex) * _skinnedCBByteSize;
+	_commandList->SetGraphicsRootConstantBufferView(1, skinnedCBAdress);
+}
+
+void D3DRenderBackend::setMaterialConstantBuffer(uint32_t materialCBIndex) noexcept
+{
+	D3D12_GPU_VIRTUAL_ADDRESS materialCBAddress = _materialCBBaseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(materialCBIndex) * _materialCBByteSize;
+	_commandList->SetGraphicsRootConstantBufferView(2, materialCBAddress);
+}
+
+void D3DRenderBackend::drawSubMeshInstanced(const MeshGeometry* mesh,
+											uint8_t subMeshIndex,
+											uint8_t lodLevel,
+											const uint32_t* objectCBIndices,
+											uint32_t instanceCount,
+											uint32_t instanceOffset) noexcept
+{
+	check(mesh != nullptr);
+	check(subMeshIndex < mesh->_subMeshList.size());
+	check(0 < instanceCount);
+	if (_frameResource->getRenderInstanceBufferCapacity() < instanceOffset + instanceCount)
+	{
+		check(false, "buildRecordTasks ۸ ̸ ÷ մϴ.");
+		return;
+	}
+	// ۾   ġ ʾƼ  忡 ÿ ᵵ ȴ.
+	for (uint32_t i = 0; i < instanceCount; ++i)
+	{
+		_frameResource->setRenderInstanceBuffer(instanceOffset + i, objectCBIndices[i]);
+	}
+	// SV_InstanceID StartInstanceLocation  Ƿ  ġ root constant ѱ.
+	_commandList->SetGraphicsRoot32BitConstant(8, instanceOffset, 0);
+
+	const auto& subMesh = mesh->_subMeshList[subMeshIndex];
+	UINT indexCount, baseIndexLocation;
+	subMesh.getLodIndexRange(lodLevel, indexCount, baseIndexLocation);
+	_commandList->DrawIndexedInstanced(
+		indexCount,
+		instanceCount,
+		baseIndexLocation,
+		subMesh._baseVertexLoaction,
+		0);
+}
+
 ID2D1Bitmap* D3DApp::loadBitmapImage(const std::string& resourceName)
 {
 	auto findIt = _bitmapImages.find(resourceName);
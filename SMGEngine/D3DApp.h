@@ -9,7 +9,12 @@
 #include "MeshGeometry.h"
 #include "FrameResource.h"
 #include "SkinnedData.h"
-#include <queue>
+#include "SlotPool.h"
+#include "FrustumCuller.h"
+#include "RenderQueue.h"
+#include "BufferAllocator.h"
+#include "RecordWorkerPool.h"
+#include "FrameSnapshot.h"
 
 using namespace std;
 using namespace DirectX;
@@ -69,11 +74,100 @@ struct RenderItem
 
 	RenderLayer _renderLayer;
 	uint8_t _subMeshIndex;
+	// ī޶  ȭ ũ  LOD.  pass   ׸ڵ   Ѵ.
+	//  pass ø ü  ׸ڸ ߰Ҷ .
+	uint8_t _lodLevel;
 	
 	const SubMeshGeometry& getSubMesh() const noexcept;
 	void changeMaterial(const Material* material) noexcept;
 };
 
+// RenderQueue packet command list Ѵ.   ҽ ؼ Ѵ.
+//  ۾    忡 ÿ   ִ.
+class D3DRenderBackend : public RenderBackend
+{
+public:
+	D3DRenderBackend(ID3D12GraphicsCommandList* commandList,
+					const unordered_map<PSOType, WComPtr<ID3D12PipelineState>>& pipelineStateObjectMap,
+					FrameResource* frameResource) noexcept;
+	virtual ~D3DRenderBackend() = default;
+	virtual void setPipelineState(uint8_t psoType) noexcept override;
+	virtual void setMesh(const MeshGeometry* mesh) noexcept override;
+	virtual void setPrimitiveTopology(uint8_t primitive) noexcept override;
+	virtual void setSkinnedConstantBuffer(uint16_t skinnedCBIndex) noexcept override;
+	virtual void setMaterialConstantBuffer(uint32_t materialCBIndex) noexcept override;
+	virtual void drawSubMeshInstanced(const MeshGeometry* mesh,
+									uint8_t subMeshIndex,
+									uint8_t lodLevel,
+									const uint32_t* objectCBIndices,
+									uint32_t instanceCount,
+									uint32_t instanceOffset) noexcept override;
+private:
+	ID3D12GraphicsCommandList* _commandList;
+	const unordered_map<PSOType, WComPtr<ID3D12PipelineState>>& _pipelineStateObjectMap;
+	FrameResource* _frameResource;
+	D3D12_GPU_VIRTUAL_ADDRESS _skinnedCBBaseAddress;
+	D3D12_GPU_VIRTUAL_ADDRESS _materialCBBaseAddress;
+	UINT _skinnedCBByteSize;
+	UINT _materialCBByteSize;
+};
+
+// object xml Ľ .  object Ҷ  ٽ  ʵ ĳѴ.
+struct ObjectTemplate
+{
+	struct RenderItemTemplate
+	{
+		const Material* _material;
+		uint8_t _subMeshIndex;
+		RenderLayer _renderLayer;
+	};
+
+	const MeshGeometry* _mesh = nullptr;
+	const BoneInfo* _boneInfo = nullptr;
+	const AnimationInfo* _animationInfo = nullptr;
+	std::vector<RenderItemTemplate> _renderItemTemplates;
+
+	bool isSkinned(void) const noexcept { return _boneInfo != nullptr; }
+};
+
+// object  ð 
+struct ObjectSpawnStatistics
+{
+	uint32_t _spawnCount = 0;
+	uint32_t _templateLoadCount = 0;
+	int64_t _spawnCounter = 0;
+	int64_t _templateLoadCounter = 0;
+};
+
+// constant buffer  Ȯο. dirty Ͽ ִ ͸ Ѵ.
+struct ConstantBufferUpdateStatistics
+{
+	uint32_t _frameCount = 0;
+	uint64_t _updatedObjectCount = 0;
+	uint64_t _totalObjectCount = 0;
+	uint64_t _updatedMaterialCount = 0;
+	uint64_t _totalMaterialCount = 0;
+};
+
+// LOD پ ﰢ  Ȯο.  pass packet .
+struct LodStatistics
+{
+	uint32_t _frameCount = 0;
+	//   ׷ LOD  ﰢ 
+	uint64_t _baseTriangleCount = 0;
+	uint64_t _triangleCount = 0;
+	std::array<uint64_t, MESH_LOD_COUNT_MAX> _lodPacketCounts = {};
+};
+
+// command list  ð 
+struct ParallelRecordStatistics
+{
+	uint32_t _frameCount = 0;
+	uint64_t _taskCount = 0;
+	int64_t _buildCounter = 0;
+	int64_t _recordCounter = 0;
+};
+
 class D3DApp
 {
 public:
@@ -89,13 +183,17 @@ public:
 	~D3DApp();
 
 	GameObject* createObjectFromXML(const std::string& fileName);
+	// ġũ. ĳõ object ø    xml ٽ а Ѵ. ̹  object ø  ʴ´.
+	void evictObjectTemplate(const std::string& fileName) noexcept;
 
 	uint16_t loadTexture(const string& textureName);
 
 	// Ʈ
 	void OnResize(void);
+	// ùķ̼   ȣѴ. ׸  snapshot ؼ  忡 ѱ.
 	void Update(void);
-	void Draw(void);
+	//  尡 ϴ ҽ ٲٰų   ȣѴ.
+	void waitRenderThreadIdle(void) noexcept;
 
 	// ui 
 	IDWriteFactory3* getWriteFactory(void) const noexcept { return _writeFactory.Get(); }
@@ -111,11 +209,18 @@ public:
 	void removeRenderItem(const RenderLayer renderLayer, const RenderItem* renderItem) noexcept;
 	void removeSkinnedInstance(const SkinnedModelInstance* skinnedInstance) noexcept;
 	void removeGameObject(const GameObject* gameObject) noexcept;
+	// dirty  ȣ ȯѴ.  updateҶ  Ƿ ȣ ٲ gameObject ٽ ˷ش.
+	uint32_t addDirtyObject(GameObject* gameObject) noexcept;
+	void removeDirtyObject(uint32_t dirtyListIndex) noexcept;
+	void addDirtyMaterial(Material* material) noexcept;
 	//const DirectX::XMFLOAT4X4& getInverseViewMatrix(void) const noexcept;
-	bool XM_CALLCONV checkCulled(const DirectX::BoundingBox& box, FXMMATRIX world) const noexcept;
+	// ī޶ world  frustum
+	void getWorldFrustum(DirectX::BoundingFrustum& outFrustum) const noexcept;
 	void setLight(const std::vector<Light>& lights, const DirectX::XMFLOAT4& ambientLight) noexcept;
+	// ׸ ĳø  Draw ٽ ׸.
+	void invalidateStaticShadow(void) noexcept { _isStaticShadowDirty = true; }
 	void setBackgroundColor(const DirectX::XMFLOAT3& color) noexcept;
-	void createRenderItems(GameObject* gameObject, const XMLReaderNode& node);
+	void createRenderItems(GameObject* gameObject, const ObjectTemplate& objectTemplate);
 
 	void releaseItemsForStageLoad(bool isReload) noexcept;
 	float getAspectRatio(void) const noexcept { return _aspectRatio; }
@@ -131,6 +236,8 @@ private:
 	void initDirect3D();
 	void initDirect2D(void);
 	void flushCommandQueue();
+	// ҽ ε  尡  fence ϹǷ  ø signalϴ  ѹ Ѵ.
+	UINT64 signalFence(void);
 	void set4XMsaaState(bool value);
 	void createCommandObjects(void);
 	void createSwapChain();
@@ -151,12 +258,20 @@ private:
 
 	void initShadowMap();
 	void updateShadowTransform(void) noexcept;
-	void updateShadowPassConstantBuffer(void) noexcept;
+	void updateShadowPassConstantBuffer(FrameSnapshot& snapshot) noexcept;
+	void cullShadowCasters(void) noexcept;
 private:
-	void updateObjectConstantBuffer(void);
-	void updateSkinnedConstantBuffer(void);
-	void updatePassConstantBuffer(void);
-	void updateMaterialConstantBuffer(void);
+	// ùķ̼ 忡 constant buffer   snapshot .
+	void updateObjectConstantBuffer(FrameSnapshot& snapshot);
+	void updateSkinnedConstantBuffer(FrameSnapshot& snapshot);
+	void updatePassConstantBuffer(FrameSnapshot& snapshot);
+	void updateMaterialConstantBuffer(FrameSnapshot& snapshot);
+private:
+	//  
+	void renderThreadLoop(void) noexcept;
+	// fence ٸ  snapshot    ҽ .
+	void updateFrameResource(const FrameSnapshot& snapshot);
+	void drawFrame(const FrameSnapshot& snapshot);
 private:
 	UINT popObjectContantBufferIndex(void);
 	uint16_t popSkinnedContantBufferIndex(void);
@@ -164,10 +279,10 @@ public:
 	void pushObjectContantBufferIndex(UINT index) noexcept;
 	void pushSkinnedContantBufferIndex(uint16_t index) noexcept;
 private:
-	UINT _objectCBIndexCount;
-	std::queue<UINT> _objectCBReturned;
-	uint16_t _skinnedCBIndexCount;
-	std::queue<uint16_t> _skinnedCBReturned;
+	void logFrameResourceStatistics(void) const noexcept;
+private:
+	PagedSlotAllocator _objectCBAllocator;
+	PagedSlotAllocator _skinnedCBAllocator;
 
 private:
 	GameObject* createGameObject(const MeshGeometry* meshGeometry, SkinnedModelInstance* skinnedInstance, uint16_t skinnedBufferIndex) noexcept;
@@ -177,10 +292,31 @@ public:
 	const MeshGeometry* getMeshGeometry(const std::string& meshName) const noexcept;
 	const Material* getMaterial(const std::string& fileName, const std::string& materialName) const noexcept;
 private:
-	void drawRenderItems(const RenderLayer renderLayer, bool checkCulled);
-	void drawUI(void);
-	void drawSceneToShadowMap(void);
-	void drawEffects(void);
+	// ̴   snapshot drawPass packet ߰Ѵ. eyePosition Ŀ  Ÿ 
+	void addRenderItems(const RenderLayer renderLayer,
+						PSOType psoType,
+						DrawPass drawPass,
+						const DirectX::XMFLOAT3& eyePosition,
+						FrameSnapshot& snapshot) noexcept;
+	// bounding sphere  ȭ ̿ ϴ 
+	static float calculateScreenSize(const DirectX::BoundingBox& localBox,
+									const DirectX::XMFLOAT4X4& world,
+									const DirectX::XMFLOAT3& eyePosition) noexcept;
+	void addShadowCasters(DrawPass drawPass, FrameSnapshot& snapshot) noexcept;
+	void addDrawPackets(FrameSnapshot& snapshot);
+	bool isDrawSkipped(const GameObject* gameObject, DrawPass drawPass) const noexcept;
+	// snapshot packet pass RenderQueue ä ϰ command list ϳ  ۾ .
+	void buildRecordTasks(const FrameSnapshot& snapshot);
+	// ۾ ϳ ڱ command list Ѵ. worker 忡 ȣȴ.
+	void recordTask(uint32_t taskIndex);
+	//  command list ° Ƿ ۾ pass ¸ ٽ Ѵ.
+	void setPassState(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const;
+	// pass ù ۾  ۾ ϴ barrier, clear, copy 
+	void recordPassBegin(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const;
+	void recordPassEnd(ID3D12GraphicsCommandList* commandList, DrawPass drawPass) const;
+	void drawUI(const FrameSnapshot& snapshot);
+	void drawEffects(ID3D12GraphicsCommandList* commandList) const;
+	void logParallelRecordStatistics(void) noexcept;
 	std::string getMaterialKey(const std::string& fileName, const std::string& materialName) const noexcept;
 
 	void buildShaderResourceViews();
@@ -189,6 +325,9 @@ private:
 	BoneInfo* loadXMLBoneInfo(const std::string& fileName);
 	MeshGeometry* loadXMLMeshGeometry(const std::string& fileName);
 	AnimationInfo* loadXMLAnimationInfo(const std::string& fileName);
+	const ObjectTemplate* loadObjectTemplate(const std::string& fileName);
+	void loadRenderItemTemplates(const XMLReaderNode& node, ObjectTemplate& objectTemplate);
+	void logSpawnStatistics(void) const noexcept;
 	
 private:
 	
@@ -234,13 +373,46 @@ private:
 
 	unordered_map<PSOType, WComPtr<ID3D12PipelineState>> _pipelineStateObjectMap;
 
-	std::vector<std::unique_ptr<RenderItem>> _renderItems[static_cast<int>(RenderLayer::Count)];
-	std::vector<std::unique_ptr<GameObject>> _gameObjects;
+	SlotPool<RenderItem> _renderItems[static_cast<int>(RenderLayer::Count)];
+	SlotPool<GameObject> _gameObjects;
+	std::array<RenderQueue, static_cast<int>(DrawPass::Count)> _renderQueues;
+	LinearAllocator _renderInstanceAllocator;
+	// pass 0 packet  instance  ġ
+	std::array<uint32_t, static_cast<int>(DrawPass::Count)> _renderInstanceOffsets;
+
+	// command list ϳ  ۾.   Ѵ.
+	struct RecordTask
+	{
+		DrawPass _drawPass;
+		RenderQueueRange _range;
+		bool _isPassBegin;
+		bool _isPassEnd;
+	};
+	static constexpr uint32_t RECORD_THREAD_MAX = 4;
+	static constexpr uint32_t RECORD_TASK_MAX = RECORD_THREAD_MAX * static_cast<uint32_t>(DrawPass::Count);
+	//  ϳ ּ packet . ʹ ߰  command list ¸ ϴ   ũ.
+	static constexpr uint32_t RECORD_PACKET_MIN = 64;
+	std::vector<RecordTask> _recordTasks;
+	std::vector<RenderQueueRange> _recordRanges;
+	// ۾      pass RenderQueue ģ.
+	std::vector<RenderQueueStatistics> _recordTaskStatistics;
+	std::array<WComPtr<ID3D12GraphicsCommandList>, RECORD_TASK_MAX> _recordCommandLists;
+	std::unique_ptr<RecordWorkerPool> _recordWorkerPool;
+	ParallelRecordStatistics _parallelRecordStatistics;
+
+	// ùķ̼ 尡 snapshot    尡  snapshot ׸.
+	FrameSnapshotQueue<FrameSnapshot> _frameSnapshotQueue;
+	// drawFrame ׸ ִ snapshot.  ۾ д´.
+	const FrameSnapshot* _drawingSnapshot;
+	std::thread _renderThread;
+	//  忡  ܴ  Update ٽ .
+	std::exception_ptr _renderThreadException;
+	std::mutex _fenceMutex;
 
 	std::vector<std::unique_ptr<Texture>> _textures;
 	std::unordered_map<std::string, uint16_t> _textureIndexMap;
 	int _textureLoadedCount;
-	static constexpr int TEXTURE_SRV_INDEX = 1;
+	static constexpr int TEXTURE_SRV_INDEX = 2;
 
 	DirectX::BoundingFrustum _viewFrustumLocal;
 
@@ -256,6 +428,10 @@ private:
 	DirectX::XMFLOAT4X4 _mainLightViewMatrix;
 	DirectX::XMFLOAT4X4 _mainLightProjectionMatrix;
 	DirectX::XMFLOAT4X4 _shadowTransform;
+	//  ʴ Ʈ ׸ ׸ .   _shadowMap   ̴ Ʈ ׸.
+	std::unique_ptr<ShadowMap> _staticShadowMap;
+	bool _isStaticShadowDirty;
+	FrustumCuller _shadowCuller;
 
 	DirectX::XMFLOAT3 _backgroundColor;
 
@@ -278,7 +454,17 @@ private:
 
 	unordered_map<string, unique_ptr<BoneInfo>> _boneInfoMap;
 	unordered_map<string, unique_ptr<AnimationInfo>> _animationInfoMap;
-	vector<unique_ptr<SkinnedModelInstance>> _skinnedInstance;
+	SlotPool<SkinnedModelInstance> _skinnedInstance;
+
+	unordered_map<string, unique_ptr<ObjectTemplate>> _objectTemplates;
+	ObjectSpawnStatistics _spawnStatistics;
+	//   ҽ    ͵.  gameObject nullptr ܵд.
+	std::vector<GameObject*> _dirtyObjects;
+	std::vector<Material*> _dirtyMaterials;
+	ConstantBufferUpdateStatistics _constantBufferUpdateStatistics;
+	void logConstantBufferUpdateStatistics(void) noexcept;
+	LodStatistics _lodStatistics;
+	void logLodStatistics(void) noexcept;
 
 #if defined DEBUG | defined _DEBUG
 public:
@@ -161,5 +161,56 @@ public:
 	{
 		return toString(value.x, n) + " " + toString(value.y, n) + " " + toString(value.z, n);
 	}
+
+	static std::string toHexString(const std::vector<uint16_t>& values)
+	{
+		static constexpr char HEX_CHARACTERS[] = "0123456789ABCDEF";
+		std::string s;
+		s.reserve(values.size() * 4);
+		for (const auto& value : values)
+		{
+			s.push_back(HEX_CHARACTERS[(value >> 12) & 0xF]);
+			s.push_back(HEX_CHARACTERS[(value >> 8) & 0xF]);
+			s.push_back(HEX_CHARACTERS[(value >> 4) & 0xF]);
+			s.push_back(HEX_CHARACTERS[value & 0xF]);
+		}
+		return s;
+	}
+
+	static void parseHexString(const std::string& input, std::vector<uint16_t>& values)
+	{
+		if (input.size() % 4 != 0)
+		{
+			ThrowErrCode(ErrCode::TokenizeError, "hex ڿ ̰ ߸Ǿϴ. " + std::to_string(input.size()));
+		}
+		values.resize(input.size() / 4);
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			uint16_t value = 0;
+			for (size_t j = i * 4; j < i * 4 + 4; ++j)
+			{
+				const char c = input[j];
+				uint16_t digit;
+				if ('0' <= c && c <= '9')
+				{
+					digit = c - '0';
+				}
+				else if ('A' <= c && c <= 'F')
+				{
+					digit = c - 'A' + 10;
+				}
+				else if ('a' <= c && c <= 'f')
+				{
+					digit = c - 'a' + 10;
+				}
+				else
+				{
+					ThrowErrCode(ErrCode::TokenizeError, "hex ڰ ƴմϴ. " + input);
+				}
+				value = (value << 4) | digit;
+			}
+			values[i] = value;
+		}
+	}
 };
 
@@ -21,23 +21,21 @@ Effect::Effect(const XMLReaderNode& node)
 	}
 }
 
-bool Effect::getEffectInstanceData(const EffectInstance& instance, EffectInstanceData& instanceData) const noexcept
+void Effect::addCullingBox(const EffectInstance& instance, FrustumCuller& culler) const noexcept
 {
-	TickCount64 currentTick = SMGFramework::Get().getTimer().getCurrentTickCount();
+	// billboard     밢 ̸  Ѵ.
+	float radius = std::sqrt(_size.x * _size.x + _size.y * _size.y) * instance.getSize();
+	culler.addBox(instance.getPosition(), XMFLOAT3(radius, radius, radius));
+}
 
-	float radius = std::sqrt(_size.x * _size.x + _size.y + _size.y) * instance.getSize();
-	XMMATRIX identityMat = XMLoadFloat4x4(&MathHelper::Identity4x4);
+void Effect::getEffectInstanceData(const EffectInstance& instance, EffectInstanceData& instanceData) const noexcept
+{
+	TickCount64 currentTick = SMGFramework::Get().getTimer().getCurrentTickCount();
 
 	instanceData._totalFrame = _totalFrame;
 	instanceData._textureIndex = _textureIndex;
 	TickCount64 effectTick = _totalFrame * _tickPerFrame;
 
-	BoundingBox box(instance.getPosition(), XMFLOAT3(radius, radius, radius));
-	if (SMGFramework::getD3DApp()->checkCulled(box, identityMat))
-	{
-		return false;
-	}
-
 	instanceData._position = instance.getPosition();
 
 	TickCount64 effectLocalTick = (currentTick - instance.getStartTick()) % effectTick;
@@ -46,7 +44,6 @@ bool Effect::getEffectInstanceData(const EffectInstance& instance, EffectInstanc
 	instanceData._size = XMFLOAT2(_size.x * instance.getSize(), _size.y * instance.getSize());
 
 	instanceData._alpha = 1;
-	return true;
 }
 
 TemporaryEffect::TemporaryEffect(const XMLReaderNode& node)
@@ -81,8 +78,7 @@ EffectInstance::EffectInstance(const DirectX::XMFLOAT3& position, float size) no
 }
 
 EffectManager::EffectManager()
-	: _instanceCount(0)
-	, _mesh(nullptr)
+	: _mesh(nullptr)
 {
 }
 
@@ -91,7 +87,6 @@ void EffectManager::releaseForStageLoad() noexcept
 	_temporaryEffects.clear();
 	_constantEffects.clear();
 
-	_instanceCount = 0;
 	_mesh = nullptr;
 }
 
@@ -200,21 +195,36 @@ void EffectManager::removeConstantEffectInstance(const std::string& effectName,
 	it->second->removeInstance(instancePtr);
 }
 
-void EffectManager::updateEffectInstanceData(FrameResource* frameResource) noexcept
+void EffectManager::updateEffectInstanceData(std::vector<EffectInstanceData>& outInstances) noexcept
 {
-	check(frameResource != nullptr);
+	BoundingFrustum worldFrustum;
+	SMGFramework::getD3DApp()->getWorldFrustum(worldFrustum);
+	_frustumCuller.setFrustum(worldFrustum);
+	_frustumCuller.clearBoxes();
+	for (const auto& c : _constantEffects)
+	{
+		c.second->addCullingBoxes(_frustumCuller);
+	}
+	for (const auto& t : _temporaryEffects)
+	{
+		t.second->addCullingBoxes(_frustumCuller);
+	}
 
-	_instanceCount = 0;
+	_frustumCuller.cull();
+	// ̴ νϽ  ڽ   ʴ´.
+	outInstances.reserve(outInstances.size() + _frustumCuller.getBoxCount());
 
+	uint32_t cullingIndex = 0;
 	for (const auto& c : _constantEffects)
 	{
-		c.second->updateEffectInstanceData(frameResource, _instanceCount);
+		c.second->updateEffectInstanceData(_frustumCuller, cullingIndex, outInstances);
 	}
 
 	for (const auto& t : _temporaryEffects)
 	{
-		t.second->updateEffectInstanceData(frameResource, _instanceCount);
+		t.second->updateEffectInstanceData(_frustumCuller, cullingIndex, outInstances);
 	}
+	check(cullingIndex == _frustumCuller.getBoxCount());
 }
 
 bool EffectManager::hasTemporaryEffect(const std::string& effectName) const noexcept
@@ -242,11 +252,6 @@ const MeshGeometry* EffectManager::getMeshGeometry(void) const noexcept
 	return _mesh;
 }
 
-uint32_t EffectManager::getInstanceCount(void) const noexcept
-{
-	return _instanceCount;
-}
-
 ConstantEffect::ConstantEffect(const XMLReaderNode& node)
 	: Effect(node)
 {
@@ -274,54 +279,64 @@ void ConstantEffect::removeInstance(ConstantEffectInstance* instancePtr) noexcep
 	check(false);
 }
 
-void ConstantEffect::updateEffectInstanceData(FrameResource* frameResource, uint32_t& instanceCount) const noexcept
+void ConstantEffect::addCullingBoxes(FrustumCuller& culler) const noexcept
+{
+	for (const auto& instance : _instances)
+	{
+		Effect::addCullingBox(*instance, culler);
+	}
+}
+
+void ConstantEffect::updateEffectInstanceData(const FrustumCuller& culler,
+											uint32_t& cullingIndex,
+											std::vector<EffectInstanceData>& outInstances) const noexcept
 {
-	check(frameResource != nullptr);
 	if (_instances.empty())
 	{
 		return;
 	}
 	for (const auto& instance : _instances)
 	{
-		float alpha = instance->getAlpha();
-		if (MathHelper::equal(alpha, 0))
+		if (!culler.isVisible(cullingIndex++))
 		{
 			continue;
 		}
-		EffectInstanceData instanceData;
-		if (!Effect::getEffectInstanceData(*instance, instanceData))
-		{
-			continue;
-		}
-		if (EFFECT_INSTANCE_MAX <= instanceCount)
+		float alpha = instance->getAlpha();
+		if (MathHelper::equal(alpha, 0))
 		{
-			check(false);
 			continue;
 		}
+		EffectInstanceData instanceData;
+		Effect::getEffectInstanceData(*instance, instanceData);
 		instanceData._alpha = alpha;
-		frameResource->setEffectBuffer(instanceCount++, instanceData);
+		outInstances.push_back(instanceData);
 	}
 }
 
-void TemporaryEffect::updateEffectInstanceData(FrameResource* frameResource, uint32_t& instanceCount) const noexcept
+void TemporaryEffect::addCullingBoxes(FrustumCuller& culler) const noexcept
+{
+	for (const auto& instance : _instances)
+	{
+		Effect::addCullingBox(instance, culler);
+	}
+}
+
+void TemporaryEffect::updateEffectInstanceData(const FrustumCuller& culler,
+											uint32_t& cullingIndex,
+											std::vector<EffectInstanceData>& outInstances) const noexcept
 {
-	check(frameResource != nullptr);
 	if (_instances.empty())
 	{
 		return;
 	}
 	for (const auto& instance : _instances)
 	{
-		EffectInstanceData instanceData;
-		if (!Effect::getEffectInstanceData(instance, instanceData))
+		if (!culler.isVisible(cullingIndex++))
 		{
 			continue;
 		}
-		if (EFFECT_INSTANCE_MAX <= instanceCount)
-		{
-			check(false);
-			continue;
-		}
+		EffectInstanceData instanceData;
+		Effect::getEffectInstanceData(instance, instanceData);
 		TickCount64 currentTick = SMGFramework::Get().getTimer().getCurrentTickCount();
 		TickCount64 effectTick = _totalFrame * _tickPerFrame;
 		TickCount64 effectLocalTick = (currentTick - instance.getStartTick()) % effectTick;
@@ -336,7 +351,7 @@ void TemporaryEffect::updateEffectInstanceData(FrameResource* frameResource, uin
 		
 		instanceData._alpha -= alphaDecreaseRate;
 
-		frameResource->setEffectBuffer(instanceCount++, instanceData);
+		outInstances.push_back(instanceData);
 	}
 }
 
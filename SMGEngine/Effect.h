@@ -2,9 +2,9 @@
 #include "TypeGeometry.h"
 #include "TypeCommon.h"
 #include <deque>
+#include "FrustumCuller.h"
 
 class XMLReaderNode;
-class FrameResource;
 class MeshGeometry;
 
 class EffectInstance
@@ -41,9 +41,13 @@ class Effect
 public:
 	Effect(const XMLReaderNode& node);
 	virtual ~Effect() = default;
-	virtual void updateEffectInstanceData(FrameResource* frameResource,
-										uint32_t& instanceCount) const noexcept = 0;
-	bool getEffectInstanceData(const EffectInstance& instance, EffectInstanceData& instanceData) const noexcept;
+	// νϽ ڽ ϳ ߰Ѵ. updateEffectInstanceData    д´.
+	virtual void addCullingBoxes(FrustumCuller& culler) const noexcept = 0;
+	virtual void updateEffectInstanceData(const FrustumCuller& culler,
+										uint32_t& cullingIndex,
+										std::vector<EffectInstanceData>& outInstances) const noexcept = 0;
+	void addCullingBox(const EffectInstance& instance, FrustumCuller& culler) const noexcept;
+	void getEffectInstanceData(const EffectInstance& instance, EffectInstanceData& instanceData) const noexcept;
 protected:
 	DirectX::XMFLOAT2 _size;
 	uint32_t _totalFrame;
@@ -58,8 +62,10 @@ public:
 	virtual ~ConstantEffect() = default;
 	ConstantEffectInstance* addInstance(EffectInstance&& instance) noexcept;
 	void removeInstance(ConstantEffectInstance* instancePtr) noexcept;
-	virtual void updateEffectInstanceData(FrameResource* frameResource,
-										uint32_t& instanceCount) const noexcept override;
+	virtual void addCullingBoxes(FrustumCuller& culler) const noexcept override;
+	virtual void updateEffectInstanceData(const FrustumCuller& culler,
+										uint32_t& cullingIndex,
+										std::vector<EffectInstanceData>& outInstances) const noexcept override;
 private:
 	std::vector<std::unique_ptr<ConstantEffectInstance>> _instances;
 
@@ -72,8 +78,10 @@ public:
 	virtual ~TemporaryEffect() = default;
 	void addInstance(EffectInstance&& instance) noexcept;
 	void update(void) noexcept;
-	virtual void updateEffectInstanceData(FrameResource* frameResource,
-										uint32_t& instanceCount) const noexcept override;
+	virtual void addCullingBoxes(FrustumCuller& culler) const noexcept override;
+	virtual void updateEffectInstanceData(const FrustumCuller& culler,
+										uint32_t& cullingIndex,
+										std::vector<EffectInstanceData>& outInstances) const noexcept override;
 
 private:
 	std::deque<EffectInstance> _instances;
@@ -95,15 +103,15 @@ public:
 	void addTemporaryEffectInstance(const std::string& effectName, EffectInstance&& instance) noexcept;
 	ConstantEffectInstance* addConstantEffectInstance(const std::string& effectName, EffectInstance&& instance) noexcept;
 	void removeConstantEffectInstance(const std::string& effectName, ConstantEffectInstance* instancePtr) noexcept;
-	void updateEffectInstanceData(FrameResource* frameResource) noexcept;
+	// ̴ νϽ outInstances ߰Ѵ.
+	void updateEffectInstanceData(std::vector<EffectInstanceData>& outInstances) noexcept;
 	bool hasTemporaryEffect(const std::string& effectName) const noexcept;
 	bool hasConstantEffect(const std::string& effectName) const noexcept;
 	const MeshGeometry* getMeshGeometry(void) const noexcept;
-	uint32_t getInstanceCount(void) const noexcept;
 private:
 	std::unordered_map<std::string, std::unique_ptr<TemporaryEffect>> _temporaryEffects;
 	std::unordered_map<std::string, std::unique_ptr<ConstantEffect>> _constantEffects;
 
-	uint32_t _instanceCount;
 	const MeshGeometry* _mesh;
+	FrustumCuller _frustumCuller;
 };
\ No newline at end of file
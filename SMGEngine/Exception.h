@@ -1,5 +1,7 @@
 #pragma once
+#if defined(_WIN32)
 #include <atlconv.h>
+#endif
 
 enum class ErrCode : uint32_t
 {
@@ -52,6 +54,8 @@ enum class ErrCode : uint32_t
 #define ErrCodeString(_val) std::to_string(static_cast<int>(_val))
 #define ErrCodeWString(_val) std::to_wstring(static_cast<int>(_val))
 
+#if defined(_WIN32)
+
 #ifndef ThrowIfFailed
 #define ThrowIfFailed(_expr, ...)											\
 {																			\
@@ -140,3 +144,50 @@ public:
 	std::wstring	_fileName;
 	int				_lineNumber;
 };
+#else
+// Windows (SMGTest) ޽ ڽ  ǥ  Ѵ.
+#include <cstdio>
+#include <cstdlib>
+
+inline void OutputDebugStringA(const char* text)
+{
+	std::fputs(text, stderr);
+}
+
+class DxException
+{
+public:
+	DxException(ErrCode errorCode, const std::string& text)
+		: _errorCode(errorCode)
+		, _text(text)
+	{
+	}
+	std::string to_string() const noexcept { return _text; }
+
+	ErrCode			_errorCode;
+	std::string		_text;
+};
+
+#ifndef ThrowErrCode
+#define ThrowErrCode(_err, ...)												\
+{																			\
+	std::string errorString = std::string(__FILE__) + ": line " + std::to_string(__LINE__) + " " + #_err + "\n";	\
+	errorString.append({__VA_ARGS__});										\
+	OutputDebugStringA(("Error! " + errorString + "\n").c_str());			\
+	throw DxException(_err, errorString);									\
+}
+#endif
+
+#ifndef check
+#define check(_val, ...)													\
+{																			\
+	if((_val) == false)														\
+	{																		\
+		std::string text = std::string(__FILE__) + ": line " + std::to_string(__LINE__) + "\n" + #_val + "\n";	\
+		text.append({__VA_ARGS__});											\
+		OutputDebugStringA(("Assert! " + text + "\n").c_str());				\
+		std::abort();														\
+	}																		\
+}
+#endif
+#endif
@@ -150,6 +150,24 @@ void XMLReader::loadXMLFile(const std::string& filePath)
 	_node = XMLReaderNode(element);
 }
 
+void XMLReader::loadXMLString(const std::string& xmlString)
+{
+	_document.CreateInstance(__uuidof(DOMDocument));
+	_document->put_async(VARIANT_FALSE);
+
+	_bstr_t bstrXml = xmlString.c_str();
+	VARIANT_BOOL isSuccessful;
+	HRESULT rv = _document->loadXML(bstrXml, &isSuccessful);
+	if (rv != S_OK || isSuccessful == VARIANT_FALSE)
+	{
+		ThrowErrCode(ErrCode::InvalidXmlData, "xml ڿ  ߽ϴ.");
+	}
+	IXMLDOMElementPtr element;
+
+	ThrowIfFailed(_document->get_documentElement(&element), "xml get_documentElement.");
+	_node = XMLReaderNode(element);
+}
+
 XMLReaderNode::XMLReaderNode(IXMLDOMElementPtr node) noexcept
 	: _element(node)
 {
@@ -303,6 +303,23 @@ public:
 
 	}
 
+	// Ӽ  outValue ״ ΰ false ȯѴ. ߿ ߰ Ӽ  Ϳ Բ  Ѵ.
+	template<typename T>
+	bool loadAttributeIfExist(const std::string& attrName, T& outValue) const
+	{
+		_bstr_t bstrAttrName = attrName.c_str();
+		_variant_t out;
+		const HRESULT hr = _element->getAttribute(bstrAttrName, &out);
+		if (hr == S_FALSE)
+		{
+			return false;
+		}
+		ThrowIfFailed(hr, attrName);
+
+		loadAttribute(attrName, outValue);
+		return true;
+	}
+
 	std::string getNodeName(void) const;
 
 	std::vector<XMLReaderNode> getChildNodes(void) const;
@@ -316,6 +333,8 @@ class XMLReader
 public:
 	XMLReader() = default;
 	void loadXMLFile(const std::string& filePath);
+	//   ڿ д´. ߿ ġũ ͸ 鶧 Ѵ.
+	void loadXMLString(const std::string& xmlString);
 	const XMLReaderNode& getRootNode(void) const noexcept { return _node; }
 private:
 	XMLReaderNode _node;
@@ -10,6 +10,7 @@
 #include "CharacterInfoManager.h"
 #include "StageInfo.h"
 #include "D3DApp.h"
+#include "NameTable.h"
 #include "GameObject.h"
 #include "Effect.h"
 #include "Camera.h"
@@ -24,29 +25,12 @@ FrameEvent::FrameEvent(const XMLReaderNode& node)
 	
 	std::string conditionStrings;
 	node.loadAttribute("Condition", conditionStrings);
-
-	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<ActionCondition> condition = ActionCondition::parseConditionString(c);
-
-		if (nullptr != condition) //  Ǹ ..
-		{
-			_conditions.push_back(std::move(condition));
-		}
-	}
+	_conditionProgram.compile(conditionStrings);
 }
 
 bool FrameEvent::checkConditions(Actor& actor) const noexcept
 {
-	for (const auto& condition : _conditions)
-	{
-		if (condition->isNotCondition() == condition->checkCondition(actor))
-		{
-			return false;
-		}
-	}
-	return true;
+	return _conditionProgram.evaluate(actor);
 }
 
 std::unique_ptr<FrameEvent> FrameEvent::loadXMLFrameEvent(const XMLReaderNode& node)
@@ -315,7 +299,9 @@ void FrameEvent_Effect::process(Actor& actor) const noexcept
 FrameEvent_SetVariable::FrameEvent_SetVariable(const XMLReaderNode& node)
 	: FrameEvent(node)
 {
-	node.loadAttribute("Name", _name);
+	std::string name;
+	node.loadAttribute("Name", name);
+	_name = NameTable::getNameId(name);
 	node.loadAttribute("Value", _value);
 }
 
@@ -449,7 +435,9 @@ void FrameEvent_AnimationSpeed::process(Actor& actor) const noexcept
 FrameEvent_AddStageVariable::FrameEvent_AddStageVariable(const XMLReaderNode& node)
 	: FrameEvent(node)
 {
-	node.loadAttribute("VariableName", _variableName);
+	std::string variableName;
+	node.loadAttribute("VariableName", variableName);
+	_variableName = NameTable::getNameId(variableName);
 	node.loadAttribute("Value", _value);
 }
 
@@ -496,7 +484,9 @@ void FrameEvent_SetEffectAlpha::process(Actor& actor) const noexcept
 FrameEvent_CallUIFunction::FrameEvent_CallUIFunction(const XMLReaderNode& node)
 	: FrameEvent(node)
 {
-	node.loadAttribute("UIGroupName", _uiGroupName);
+	std::string uiGroupName;
+	node.loadAttribute("UIGroupName", uiGroupName);
+	_uiGroupName = NameTable::getNameId(uiGroupName);
 
 	std::string functionString;
 	node.loadAttribute("Function", functionString);
@@ -512,7 +502,7 @@ void FrameEvent_CallUIFunction::process(Actor& actor) const noexcept
 	UIGroup* group = SMGFramework::getUIManager()->getGroup(_uiGroupName);
 	if (group == nullptr)
 	{
-		check(false, _uiGroupName);
+		check(false, NameTable::getName(_uiGroupName));
 		return;
 	}
 	UIFunction::execute(_uiFunctionType, group);
@@ -2,8 +2,8 @@
 #include "TypeCommon.h"
 #include "TypeAction.h"
 #include "TypeUI.h"
+#include "ActionCondition.h"
 class Actor;
-class ActionCondition;
 class XMLReaderNode;
 
 class FrameEvent
@@ -18,7 +18,7 @@ public:
 	static std::unique_ptr<FrameEvent> loadXMLFrameEvent(const XMLReaderNode& node);
 private:
 	TickCount64 _processTick;
-	std::vector<std::unique_ptr<ActionCondition>> _conditions;
+	ActionConditionProgram _conditionProgram;
 };
 
 class FrameEvent_Rotate : public FrameEvent
@@ -106,7 +106,7 @@ public:
 	virtual void process(Actor& actor) const noexcept override;
 	virtual FrameEventType getType() const noexcept override { return FrameEventType::SetVariable; }
 private:
-	std::string _name;
+	NameId _name;
 	int _value;
 };
 
@@ -205,7 +205,7 @@ public:
 	virtual void process(Actor& actor) const noexcept override;
 	virtual FrameEventType getType() const noexcept override { return FrameEventType::AddStageVariable; }
 private:
-	std::string _variableName;
+	NameId _variableName;
 	int _value;
 };
 
@@ -252,7 +252,7 @@ public:
 	virtual void process(Actor& actor) const noexcept override;
 	virtual FrameEventType getType() const noexcept override { return FrameEventType::CallUIFunction; }
 private:
-	std::string _uiGroupName;
+	NameId _uiGroupName;
 	UIFunctionType _uiFunctionType;
 };
 
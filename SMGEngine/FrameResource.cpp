@@ -1,18 +1,25 @@
 #include "stdafx.h"
 #include "FrameResource.h"
 
-FrameResource::FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount, UINT materialCount, UINT skinnedCount, UINT effectCount)
-	: _fence(0)
+FrameResource::FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount, UINT materialCount, UINT skinnedCount, UINT effectCount, UINT renderInstanceCount, UINT commandListCount)
+	: _device(device)
+	, _growCount(0)
+	, _fence(0)
 {
-	ThrowIfFailed(device->CreateCommandAllocator(
-		D3D12_COMMAND_LIST_TYPE_DIRECT,
-		IID_PPV_ARGS(_commandListAlloc.GetAddressOf())), "commandAllocator Ҵ ");
+	_commandListAllocs.resize(commandListCount);
+	for (auto& commandListAlloc : _commandListAllocs)
+	{
+		ThrowIfFailed(device->CreateCommandAllocator(
+			D3D12_COMMAND_LIST_TYPE_DIRECT,
+			IID_PPV_ARGS(commandListAlloc.GetAddressOf())), "commandAllocator Ҵ ");
+	}
 
 	_passConstantBuffer = std::make_unique<UploadBufferWrapper<PassConstants>>(device, passCount, true);
 	_objectConstantBuffer = std::make_unique<UploadBufferWrapper<ObjectConstants>>(device, objectCount, true);
 	_materialConstantBuffer = std::make_unique<UploadBufferWrapper<MaterialConstants>>(device, materialCount, true);
 	_skinnedConstantBuffer = std::make_unique<UploadBufferWrapper<SkinnedConstants>>(device, skinnedCount, true);
 	_effectInstanceBuffer = std::make_unique<UploadBufferWrapper<EffectInstanceData>>(device, effectCount, false);
+	_renderInstanceBuffer = std::make_unique<UploadBufferWrapper<uint32_t>>(device, renderInstanceCount, false);
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS FrameResource::getPassCBVirtualAddress() const noexcept
@@ -42,10 +49,15 @@ D3D12_GPU_VIRTUAL_ADDRESS FrameResource::getEffectBufferVirtualAddress() const n
 	return _effectInstanceBuffer->getResource()->GetGPUVirtualAddress();
 }
 
-ID3D12CommandAllocator* FrameResource::getCommandListAlloc() const noexcept
+D3D12_GPU_VIRTUAL_ADDRESS FrameResource::getRenderInstanceBufferVirtualAddress() const noexcept
 {
+	return _renderInstanceBuffer->getResource()->GetGPUVirtualAddress();
+}
 
-	return _commandListAlloc.Get();
+ID3D12CommandAllocator* FrameResource::getCommandListAlloc(UINT index) const noexcept
+{
+	check(index < _commandListAllocs.size());
+	return _commandListAllocs[index].Get();
 }
 
 void FrameResource::setPassCB(UINT index, const PassConstants& passContants)
@@ -73,6 +85,64 @@ void FrameResource::setEffectBuffer(UINT index, const EffectInstanceData& effect
 	_effectInstanceBuffer->copyData(index, effectInstance);
 }
 
+void FrameResource::setRenderInstanceBuffer(UINT index, uint32_t objectCBIndex)
+{
+	_renderInstanceBuffer->copyData(index, objectCBIndex);
+}
+
+template<typename T>
+bool FrameResource::reserveBuffer(std::unique_ptr<UploadBufferWrapper<T>>& buffer, UINT count, bool isConstantBuffer)
+{
+	check(buffer != nullptr);
+	const UINT elementCount = buffer->getElementCount();
+	if (count <= elementCount)
+	{
+		return false;
+	}
+	//  ٽ  ʵ ּ ι ø.
+	auto newBuffer = std::make_unique<UploadBufferWrapper<T>>(_device, std::max(count, elementCount * 2), isConstantBuffer);
+	newBuffer->copyAllData(*buffer);
+	_retiredBuffers.emplace_back(buffer->getResource());
+	buffer = std::move(newBuffer);
+	++_growCount;
+	return true;
+}
+
+bool FrameResource::reserveObjectCB(UINT count)
+{
+	return reserveBuffer(_objectConstantBuffer, count, true);
+}
+
+bool FrameResource::reserveMaterialCB(UINT count)
+{
+	return reserveBuffer(_materialConstantBuffer, count, true);
+}
+
+bool FrameResource::reserveSkinnedCB(UINT count)
+{
+	return reserveBuffer(_skinnedConstantBuffer, count, true);
+}
+
+bool FrameResource::reserveEffectBuffer(UINT count)
+{
+	return reserveBuffer(_effectInstanceBuffer, count, false);
+}
+
+bool FrameResource::reserveRenderInstanceBuffer(UINT count)
+{
+	return reserveBuffer(_renderInstanceBuffer, count, false);
+}
+
+UINT FrameResource::getRenderInstanceBufferCapacity(void) const noexcept
+{
+	return _renderInstanceBuffer->getElementCount();
+}
+
+void FrameResource::releaseRetiredBuffers(void) noexcept
+{
+	_retiredBuffers.clear();
+}
+
 void FrameResource::setFence(UINT fence) noexcept
 {
 	_fence = fence;
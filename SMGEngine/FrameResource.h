@@ -10,7 +10,9 @@ public:
 				UINT objectCount, 
 				UINT materialCount, 
 				UINT skinnedCount,
-				UINT effectCount);
+				UINT effectCount,
+				UINT renderInstanceCount,
+				UINT commandListCount);
 	FrameResource(const FrameResource& rhs) = delete;
 	FrameResource& operator=(const FrameResource& rhs) = delete;
 
@@ -19,23 +21,47 @@ public:
 	D3D12_GPU_VIRTUAL_ADDRESS getMaterialCBVirtualAddress() const noexcept;
 	D3D12_GPU_VIRTUAL_ADDRESS getSkinnedCBVirtualAddress() const noexcept;
 	D3D12_GPU_VIRTUAL_ADDRESS getEffectBufferVirtualAddress() const noexcept;
-	ID3D12CommandAllocator* getCommandListAlloc() const noexcept;
+	D3D12_GPU_VIRTUAL_ADDRESS getRenderInstanceBufferVirtualAddress() const noexcept;
+	// command list allocator  ־  忡 ÿ   ִ.
+	ID3D12CommandAllocator* getCommandListAlloc(UINT index) const noexcept;
 
 	void setPassCB(UINT index, const PassConstants& passContants);
 	void setObjectCB(UINT index, const ObjectConstants& objectContants);
 	void setMaterialCB(UINT index, const MaterialConstants& materialConstants);
 	void setSkinnedCB(UINT index, const SkinnedConstants& skinnedConstants);
 	void setEffectBuffer(UINT index, const EffectInstanceData& effectInstance);
+	void setRenderInstanceBuffer(UINT index, uint32_t objectCBIndex);
+
+	// ۰ count      ű. gpu ּҰ ٲ true ȯѴ.
+	//  ۴   ҽ command list   ִٰ releaseRetiredBuffers Ѵ.
+	bool reserveObjectCB(UINT count);
+	bool reserveMaterialCB(UINT count);
+	bool reserveSkinnedCB(UINT count);
+	bool reserveEffectBuffer(UINT count);
+	bool reserveRenderInstanceBuffer(UINT count);
+	UINT getRenderInstanceBufferCapacity(void) const noexcept;
+	// fence ٸ ڿ ȣѴ.
+	void releaseRetiredBuffers(void) noexcept;
+	UINT getGrowCount(void) const noexcept { return _growCount; }
 
 	void setFence(UINT fence) noexcept;
 	UINT getFence(void) const noexcept;
 private:
+	template<typename T>
+	bool reserveBuffer(std::unique_ptr<UploadBufferWrapper<T>>& buffer, UINT count, bool isConstantBuffer);
+private:
+	ID3D12Device* _device;
 	std::unique_ptr<UploadBufferWrapper<PassConstants>> _passConstantBuffer;
 	std::unique_ptr<UploadBufferWrapper<ObjectConstants>> _objectConstantBuffer;
 	std::unique_ptr<UploadBufferWrapper<MaterialConstants>> _materialConstantBuffer;
 	std::unique_ptr<UploadBufferWrapper<SkinnedConstants>> _skinnedConstantBuffer;
 	std::unique_ptr<UploadBufferWrapper<EffectInstanceData>> _effectInstanceBuffer;
-	WComPtr<ID3D12CommandAllocator> _commandListAlloc;
+	// instance  object constant buffer ȣ
+	std::unique_ptr<UploadBufferWrapper<uint32_t>> _renderInstanceBuffer;
+	std::vector<WComPtr<ID3D12CommandAllocator>> _commandListAllocs;
+	std::vector<WComPtr<ID3D12Resource>> _retiredBuffers;
+	//  Ȯο
+	UINT _growCount;
 
 	UINT64 _fence;
 };
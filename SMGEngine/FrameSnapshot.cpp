@@ -0,0 +1,22 @@
+#include "stdafx.h"
+#include "FrameSnapshot.h"
+
+void FrameSnapshot::clear(void) noexcept
+{
+	_objectConstants.clear();
+	_materialConstants.clear();
+	_skinnedConstants.clear();
+	_objectCBCapacity = 0;
+	_materialCBCapacity = 0;
+	_skinnedCBCapacity = 0;
+
+	_effectInstances.clear();
+	_effectMesh = nullptr;
+
+	for (auto& drawPackets : _drawPackets)
+	{
+		drawPackets.clear();
+	}
+	_isStaticShadowDirty = false;
+	_uiDrawCommands.clear();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "TypeGeometry.h"
+#include "TypeUI.h"
+#include "RenderQueue.h"
+#include "FrameSnapshotQueue.h"
+
+//  ҽ index ĭ  
+template<typename T>
+struct ConstantBufferWrite
+{
+	uint32_t _index;
+	T _constants;
+};
+
+// UI  ϳ ׸µ ʿ . ġ group ̵  ȭ ǥ̴.
+// ùķ̼ ڳ      ϰ ִ   ׸.
+struct UIDrawCommand
+{
+	UIElementType _type;
+	TextBrushType _brushType;
+	DirectX::XMFLOAT2 _position;
+	DirectX::XMFLOAT2 _size;
+	WComPtr<IDWriteTextLayout> _textLayout;
+	WComPtr<ID2D1Bitmap> _bitmap;
+	WComPtr<ID2D1Geometry> _geometry;
+};
+
+// ùķ̼    尡 ׸µ ʿ  ص .
+//  Ʈ Ű Ƿ  尡 д  ùķ̼   ص ȴ.
+// mesh  ٲܶ Ƿ ͷ  ִ´.
+struct FrameSnapshot
+{
+	void clear(void) noexcept;
+
+	PassConstants _passConstants;
+	PassConstants _shadowPassConstants;
+	// dirty Ͽ ִ ͸ ´.   ҽ ѹ    snapshot .
+	std::vector<ConstantBufferWrite<ObjectConstants>> _objectConstants;
+	std::vector<ConstantBufferWrite<MaterialConstants>> _materialConstants;
+	std::vector<ConstantBufferWrite<SkinnedConstants>> _skinnedConstants;
+	//  ҽ ۰   ּ ũ
+	uint32_t _objectCBCapacity = 0;
+	uint32_t _materialCBCapacity = 0;
+	uint32_t _skinnedCBCapacity = 0;
+
+	std::vector<EffectInstanceData> _effectInstances;
+	const MeshGeometry* _effectMesh = nullptr;
+
+	// ϱ  pass packet
+	std::array<std::vector<DrawPacket>, static_cast<int>(DrawPass::Count)> _drawPackets;
+	bool _isStaticShadowDirty = false;
+	DirectX::XMFLOAT3 _backgroundColor = DirectX::XMFLOAT3(0, 0, 0);
+
+	// ׸  ´.
+	std::vector<UIDrawCommand> _uiDrawCommands;
+};
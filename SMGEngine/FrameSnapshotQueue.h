@@ -0,0 +1,175 @@
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <string>
+
+//  Ȯο
+struct FrameSnapshotStatistics
+{
+	uint32_t _publishCount = 0;
+	// ùķ̼  带 ٸ Ƚ ð
+	uint32_t _publishWaitCount = 0;
+	int64_t _publishWaitMicroSecond = 0;
+	//  尡 ùķ̼ ٸ Ƚ ð
+	uint32_t _acquireWaitCount = 0;
+	int64_t _acquireWaitMicroSecond = 0;
+};
+
+// ùķ̼ 尡   尡 д snapshot 3.  , ׸⸦ ٸ , ׸   ϳ̴.
+// ٸ snapshot  publish ٸǷ ùķ̼  ִ 1 Ӹ ռ.
+// snapshot ٲ constant buffer Ƿ  ʰ publish   ׸.
+// snapshot   Ƿ D3D ġ    ִ.
+template<typename Snapshot>
+class FrameSnapshotQueue
+{
+public:
+	FrameSnapshotQueue(void) noexcept
+		: _writeIndex(0)
+		, _readyIndex(NO_SNAPSHOT)
+		, _readingIndex(NO_SNAPSHOT)
+		, _isStopped(false)
+	{
+	}
+	FrameSnapshotQueue(const FrameSnapshotQueue&) = delete;
+	FrameSnapshotQueue& operator=(const FrameSnapshotQueue&) = delete;
+
+	// ùķ̼ 忡 Ѵ. publishϱ   尡  ʴ´.
+	Snapshot& getWriteSnapshot(void) noexcept
+	{
+		return _snapshots[_writeIndex];
+	}
+
+	//  snapshot  忡 ѱ   snapshot ٲ۴. stopǾ false ȯѴ.
+	bool publish(void) noexcept
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_readyIndex != NO_SNAPSHOT && !_isStopped)
+		{
+			const auto waitStart = std::chrono::steady_clock::now();
+			_condition.wait(lock, [this]() { return _readyIndex == NO_SNAPSHOT || _isStopped; });
+			++_statistics._publishWaitCount;
+			_statistics._publishWaitMicroSecond += std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - waitStart).count();
+		}
+		if (_isStopped)
+		{
+			return false;
+		}
+
+		_readyIndex = _writeIndex;
+		++_statistics._publishCount;
+		// ׸⸦ ٸ ͵, ׸  ͵ ƴ snapshot ׻ ϳ ̻ ִ.
+		for (int i = 0; i < SNAPSHOT_COUNT; ++i)
+		{
+			if (i != _readyIndex && i != _readingIndex)
+			{
+				_writeIndex = i;
+				break;
+			}
+		}
+		check(_writeIndex != _readyIndex && _writeIndex != _readingIndex);
+
+		lock.unlock();
+		_condition.notify_all();
+		return true;
+	}
+
+	//  忡 Ѵ. publish   ٸ, stopǸ nullptr ȯѴ.
+	const Snapshot* acquire(void) noexcept
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		check(_readingIndex == NO_SNAPSHOT, "release ʾҽϴ.");
+		if (_readyIndex == NO_SNAPSHOT && !_isStopped)
+		{
+			const auto waitStart = std::chrono::steady_clock::now();
+			_condition.wait(lock, [this]() { return _readyIndex != NO_SNAPSHOT || _isStopped; });
+			++_statistics._acquireWaitCount;
+			_statistics._acquireWaitMicroSecond += std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - waitStart).count();
+		}
+		if (_isStopped)
+		{
+			return nullptr;
+		}
+
+		_readingIndex = _readyIndex;
+		_readyIndex = NO_SNAPSHOT;
+
+		lock.unlock();
+		_condition.notify_all();
+		return &_snapshots[_readingIndex];
+	}
+
+	// acquire snapshot  ׸  ȣѴ.
+	void release(void) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			check(_readingIndex != NO_SNAPSHOT);
+			_readingIndex = NO_SNAPSHOT;
+		}
+		_condition.notify_all();
+	}
+
+	// publish snapshot  尡  ׸ ٸ.  尡  ҽ   ȣѴ.
+	void waitIdle(void) noexcept
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_condition.wait(lock, [this]()
+			{
+				return (_readyIndex == NO_SNAPSHOT && _readingIndex == NO_SNAPSHOT) || _isStopped;
+			});
+	}
+
+	// ٸ ִ 带    publish, acquire ٷ Ѵ.
+	void stop(void) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_isStopped = true;
+		}
+		_condition.notify_all();
+	}
+
+	// ݱ  踦 ȯϰ .
+	FrameSnapshotStatistics popStatistics(void) noexcept
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		FrameSnapshotStatistics statistics = _statistics;
+		_statistics = FrameSnapshotStatistics();
+		return statistics;
+	}
+
+	void logStatistics(void) noexcept
+	{
+		const FrameSnapshotStatistics statistics = popStatistics();
+		if (statistics._publishCount == 0)
+		{
+			return;
+		}
+		const std::string text = "[FrameSnapshot] publish: " + std::to_string(statistics._publishCount) +
+			" simulationWait: " + std::to_string(statistics._publishWaitCount) +
+			"(" + std::to_string(statistics._publishWaitMicroSecond / statistics._publishCount) + "us/frame)" +
+			" renderWait: " + std::to_string(statistics._acquireWaitCount) +
+			"(" + std::to_string(statistics._acquireWaitMicroSecond / statistics._publishCount) + "us/frame)\n";
+		OutputDebugStringA(text.c_str());
+	}
+private:
+	static constexpr int SNAPSHOT_COUNT = 3;
+	static constexpr int NO_SNAPSHOT = -1;
+
+	std::array<Snapshot, SNAPSHOT_COUNT> _snapshots;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+
+	// Ʒ _mutex ȣѴ. _writeIndex ùķ̼ 常 ٲ۴.
+	int _writeIndex;
+	int _readyIndex;
+	int _readingIndex;
+	bool _isStopped;
+	FrameSnapshotStatistics _statistics;
+};
@@ -0,0 +1,152 @@
+#include "stdafx.h"
+#include "FrustumCuller.h"
+#include "Exception.h"
+
+FrustumCuller::FrustumCuller(void) noexcept
+	: _boxCount(0)
+{
+	_planes.fill(DirectX::XMFLOAT4(0, 0, 0, 0));
+}
+
+void FrustumCuller::setFrustum(const DirectX::BoundingFrustum& frustum) noexcept
+{
+	using namespace DirectX;
+	std::array<XMVECTOR, 6> planes;
+	frustum.GetPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+	for (size_t i = 0; i < planes.size(); ++i)
+	{
+		XMStoreFloat4(&_planes[i], planes[i]);
+	}
+}
+
+void XM_CALLCONV FrustumCuller::setFrustum(DirectX::FXMMATRIX viewProjection) noexcept
+{
+	using namespace DirectX;
+	//  ͸ ϹǷ clip ǥ   ġ     ̴.
+	//  -w <= x <= w, -w <= y <= w, 0 <= z <= w ̰  ٱ ϵ ȣ ´.
+	XMMATRIX m = XMMatrixTranspose(viewProjection);
+	const std::array<XMVECTOR, 6> planes = {
+		-(m.r[3] + m.r[0]),
+		-(m.r[3] - m.r[0]),
+		-(m.r[3] + m.r[1]),
+		-(m.r[3] - m.r[1]),
+		-m.r[2],
+		-(m.r[3] - m.r[2]),
+	};
+	for (size_t i = 0; i < planes.size(); ++i)
+	{
+		XMStoreFloat4(&_planes[i], XMPlaneNormalize(planes[i]));
+	}
+}
+
+void FrustumCuller::clearBoxes(void) noexcept
+{
+	_centerX.clear();
+	_centerY.clear();
+	_centerZ.clear();
+	_extentX.clear();
+	_extentY.clear();
+	_extentZ.clear();
+	_boxCount = 0;
+}
+
+uint32_t FrustumCuller::addBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) noexcept
+{
+	if (_boxCount % BATCH_SIZE == 0)
+	{
+		const size_t size = static_cast<size_t>(_boxCount) + BATCH_SIZE;
+		_centerX.resize(size, 0.f);
+		_centerY.resize(size, 0.f);
+		_centerZ.resize(size, 0.f);
+		_extentX.resize(size, 0.f);
+		_extentY.resize(size, 0.f);
+		_extentZ.resize(size, 0.f);
+	}
+	_centerX[_boxCount] = center.x;
+	_centerY[_boxCount] = center.y;
+	_centerZ[_boxCount] = center.z;
+	_extentX[_boxCount] = extents.x;
+	_extentY[_boxCount] = extents.y;
+	_extentZ[_boxCount] = extents.z;
+	return _boxCount++;
+}
+
+uint32_t XM_CALLCONV FrustumCuller::addBox(const DirectX::BoundingBox& localBox, DirectX::FXMMATRIX world) noexcept
+{
+	using namespace DirectX;
+	// ȸ ڽ δ AABB     밪   ؼ  ̴.
+	XMVECTOR localExtents = XMLoadFloat3(&localBox.Extents);
+	XMVECTOR extents = XMVectorAbs(world.r[0]) * XMVectorSplatX(localExtents) +
+		XMVectorAbs(world.r[1]) * XMVectorSplatY(localExtents) +
+		XMVectorAbs(world.r[2]) * XMVectorSplatZ(localExtents);
+
+	XMFLOAT3 centerF, extentsF;
+	XMStoreFloat3(&centerF, XMVector3Transform(XMLoadFloat3(&localBox.Center), world));
+	XMStoreFloat3(&extentsF, extents);
+	return addBox(centerF, extentsF);
+}
+
+void FrustumCuller::cull(void) noexcept
+{
+	using namespace DirectX;
+	check(_centerX.size() % BATCH_SIZE == 0);
+	check(_boxCount <= _centerX.size());
+
+	_visibleBits.assign((static_cast<size_t>(_boxCount) + 63) / 64, 0);
+
+	std::array<XMVECTOR, 6> normalX, normalY, normalZ, distance;
+	std::array<XMVECTOR, 6> absNormalX, absNormalY, absNormalZ;
+	for (size_t i = 0; i < _planes.size(); ++i)
+	{
+		normalX[i] = XMVectorReplicate(_planes[i].x);
+		normalY[i] = XMVectorReplicate(_planes[i].y);
+		normalZ[i] = XMVectorReplicate(_planes[i].z);
+		distance[i] = XMVectorReplicate(_planes[i].w);
+		absNormalX[i] = XMVectorAbs(normalX[i]);
+		absNormalY[i] = XMVectorAbs(normalY[i]);
+		absNormalZ[i] = XMVectorAbs(normalZ[i]);
+	}
+
+	for (uint32_t i = 0; i < _boxCount; i += BATCH_SIZE)
+	{
+		XMVECTOR centerX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_centerX[i]));
+		XMVECTOR centerY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_centerY[i]));
+		XMVECTOR centerZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_centerZ[i]));
+		XMVECTOR extentX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_extentX[i]));
+		XMVECTOR extentY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_extentY[i]));
+		XMVECTOR extentZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&_extentZ[i]));
+
+		// ߽  Ÿ    ڽ  ũ  ٱ ִ.
+		XMVECTOR outside = XMVectorFalseInt();
+		for (size_t p = 0; p < _planes.size(); ++p)
+		{
+			XMVECTOR centerDistance = XMVectorMultiplyAdd(centerZ, normalZ[p],
+				XMVectorMultiplyAdd(centerY, normalY[p],
+					XMVectorMultiplyAdd(centerX, normalX[p], distance[p])));
+			XMVECTOR radius = XMVectorMultiplyAdd(extentZ, absNormalZ[p],
+				XMVectorMultiplyAdd(extentY, absNormalY[p], extentX * absNormalX[p]));
+			outside = XMVectorOrInt(outside, XMVectorGreater(centerDistance, radius));
+		}
+
+		XMUINT4 outsideMask;
+		XMStoreUInt4(&outsideMask, outside);
+		const uint64_t visibleBits = (outsideMask.x == 0 ? 1ull : 0ull) |
+			(outsideMask.y == 0 ? 2ull : 0ull) |
+			(outsideMask.z == 0 ? 4ull : 0ull) |
+			(outsideMask.w == 0 ? 8ull : 0ull);
+		_visibleBits[i / 64] |= visibleBits << (i % 64);
+	}
+
+	// ä ڽ  .
+	if (_boxCount % 64 != 0)
+	{
+		_visibleBits.back() &= (1ull << (_boxCount % 64)) - 1;
+	}
+}
+
+bool FrustumCuller::isVisible(uint32_t index) const noexcept
+{
+	check(index < _boxCount);
+	check(index / 64 < _visibleBits.size());
+	return (_visibleBits[index / 64] >> (index % 64)) & 1;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+// world  AABB frustum  6 ѹ ˻Ѵ. ڽ ະ 迭(SoA) ϰ SIMD ѹ 4 ˻Ѵ.
+// D3D ġ  DirectXMath Ѵ.
+class FrustumCuller
+{
+public:
+	FrustumCuller(void) noexcept;
+	// world  frustum
+	void setFrustum(const DirectX::BoundingFrustum& frustum) noexcept;
+	// view * projection  clip  .     ִ.
+	void XM_CALLCONV setFrustum(DirectX::FXMMATRIX viewProjection) noexcept;
+	void clearBoxes(void) noexcept;
+	// ߰  ȣ ȯѴ.
+	uint32_t addBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) noexcept;
+	//  ڽ world ķ ű  δ AABB ߰Ѵ.
+	uint32_t XM_CALLCONV addBox(const DirectX::BoundingBox& localBox, DirectX::FXMMATRIX world) noexcept;
+	void cull(void) noexcept;
+	// cull Ŀ Ѵ. AABB ˻ϹǷ δ  ʴ ͵ δٰ   ִ.
+	bool isVisible(uint32_t index) const noexcept;
+	uint32_t getBoxCount(void) const noexcept { return _boxCount; }
+private:
+	static constexpr uint32_t BATCH_SIZE = 4;
+	//  frustum ٱ Ѵ.
+	std::array<DirectX::XMFLOAT4, 6> _planes;
+
+	// BATCH_SIZE  ÷  ĭ ũ 0 ڽ ä.
+	std::vector<float> _centerX;
+	std::vector<float> _centerY;
+	std::vector<float> _centerZ;
+	std::vector<float> _extentX;
+	std::vector<float> _extentY;
+	std::vector<float> _extentZ;
+	std::vector<uint64_t> _visibleBits;
+	uint32_t _boxCount;
+};
@@ -7,6 +7,7 @@
 #include "MeshGeometry.h"
 #include "Camera.h"
 #include "StageManager.h"
+#include "FrustumCuller.h"
 
 GameObject::GameObject(const MeshGeometry* meshGeometry,
 						uint16_t objConstantBufferIndex,
@@ -16,16 +17,26 @@ GameObject::GameObject(const MeshGeometry* meshGeometry,
 	, _worldMatrix(MathHelper::Identity4x4)
 	, _textureTransform(MathHelper::Identity4x4)
 	, _objConstantBufferIndex(objConstantBufferIndex)
-	, _dirtyFrames(FRAME_RESOURCE_COUNT)
+	, _dirtyFrames(0)
+	, _dirtyListIndex(NOT_IN_DIRTY_LIST)
 	, _skinnedConstantBufferIndex(skinnedConstantBufferIndex)
 	, _skinnedModelInstance(skinnedModelInstance)
 	, _isCulled(false)
+	, _cullingIndex(NO_CULLING_INDEX)
+	, _isShadowCulled(false)
+	, _shadowCullingIndex(NO_CULLING_INDEX)
+	, _isShadowStatic(false)
 {
 	check(_skinnedModelInstance != nullptr || _skinnedConstantBufferIndex == std::numeric_limits<uint16_t>::max());
+	setDirtyXXX();
 }
 
 GameObject::~GameObject()
 {
+	if (_dirtyListIndex != NOT_IN_DIRTY_LIST)
+	{
+		SMGFramework::getD3DApp()->removeDirtyObject(_dirtyListIndex);
+	}
 	if (SMGFramework::getStageManager()->isLoading())
 	{
 		return;
@@ -43,12 +54,20 @@ GameObject::~GameObject()
 	{
 		SMGFramework::getD3DApp()->removeSkinnedInstance(_skinnedModelInstance);
 	}
+	if (_isShadowStatic)
+	{
+		SMGFramework::getD3DApp()->invalidateStaticShadow();
+	}
 }
 
 void GameObject::setWorldMatrix(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction, const DirectX::XMFLOAT3& upVector, float size) noexcept
 {
 	MathHelper::getWorldMatrix(position, direction, upVector, size, _worldMatrix);
-	_dirtyFrames = FRAME_RESOURCE_COUNT;
+	setDirtyXXX();
+	if (_isShadowStatic)
+	{
+		SMGFramework::getD3DApp()->invalidateStaticShadow();
+	}
 #if defined DEBUG | defined _DEBUG
 	for (const auto& devObject : _devObjects)
 	{
@@ -89,26 +108,67 @@ void GameObject::setAnimation(const std::string& animationName, const TickCount6
 	_skinnedModelInstance->setAnimation(animationName, blendTick);
 }
 
-void GameObject::setCulled(void) noexcept
+void GameObject::addCullingBox(FrustumCuller& culler) noexcept
 {
 	if (_meshGeometry == nullptr)
 	{
+		_cullingIndex = NO_CULLING_INDEX;
 		return;
 	}
 	XMMATRIX worldMat = XMLoadFloat4x4(&_worldMatrix);
-	_isCulled = SMGFramework::getD3DApp()->checkCulled(_meshGeometry->getBoundingBox(), worldMat);
+	_cullingIndex = culler.addBox(_meshGeometry->getBoundingBox(), worldMat);
 }
 
-void GameObject::setCulledBackground() noexcept
+void GameObject::addCullingBoxBackground(FrustumCuller& culler) noexcept
 {
 	if (_meshGeometry == nullptr)
 	{
+		_cullingIndex = NO_CULLING_INDEX;
 		return;
 	}
 	XMMATRIX worldMat = XMLoadFloat4x4(&_worldMatrix);
 	XMVECTOR camPosition = XMLoadFloat3(&SMGFramework::getCamera()->getPosition());
 	XMMATRIX camPositionMatrix = XMMatrixTranslationFromVector(camPosition);
-	_isCulled = SMGFramework::getD3DApp()->checkCulled(_meshGeometry->getBoundingBox(), worldMat * camPositionMatrix);
+	_cullingIndex = culler.addBox(_meshGeometry->getBoundingBox(), worldMat * camPositionMatrix);
+}
+
+void GameObject::setCulled(const FrustumCuller& culler) noexcept
+{
+	if (_cullingIndex == NO_CULLING_INDEX)
+	{
+		return;
+	}
+	_isCulled = !culler.isVisible(_cullingIndex);
+}
+
+void GameObject::addShadowCullingBox(FrustumCuller& culler) noexcept
+{
+	if (_meshGeometry == nullptr)
+	{
+		_shadowCullingIndex = NO_CULLING_INDEX;
+		return;
+	}
+	XMMATRIX worldMat = XMLoadFloat4x4(&_worldMatrix);
+	_shadowCullingIndex = culler.addBox(_meshGeometry->getBoundingBox(), worldMat);
+}
+
+void GameObject::setShadowCulled(const FrustumCuller& culler) noexcept
+{
+	if (_shadowCullingIndex == NO_CULLING_INDEX)
+	{
+		return;
+	}
+	_isShadowCulled = !culler.isVisible(_shadowCullingIndex);
+}
+
+void GameObject::setShadowStatic(bool isShadowStatic) noexcept
+{
+	if (_isShadowStatic == isShadowStatic)
+	{
+		return;
+	}
+	_isShadowStatic = isShadowStatic;
+	SMGFramework::getD3DApp()->invalidateStaticShadow();
 }
 
 void GameObject::setAnimationSpeed(float speed) noexcept
@@ -146,12 +206,18 @@ void GameObject::setRenderItemsXXX(std::vector<RenderItem*>&& renderItems) noexc
 
 bool GameObject::popDirtyFrame(void) noexcept
 {
-	if (_dirtyFrames > 0)
+	check(_dirtyFrames > 0);
+	--_dirtyFrames;
+	return _dirtyFrames > 0;
+}
+
+void GameObject::setDirtyXXX(void) noexcept
+{
+	_dirtyFrames = FRAME_RESOURCE_COUNT;
+	if (_dirtyListIndex == NOT_IN_DIRTY_LIST)
 	{
-		--_dirtyFrames;
-		return true;
+		_dirtyListIndex = SMGFramework::getD3DApp()->addDirtyObject(this);
 	}
-	return false;
 }
 
 const MeshGeometry* GameObject::getMeshGeometry(void) const noexcept
@@ -5,6 +5,7 @@
 class SkinnedModelInstance;
 struct RenderItem;
 class MeshGeometry;
+class FrustumCuller;
 
 class GameObject
 {
@@ -21,7 +22,11 @@ public:
 						const DirectX::XMFLOAT3& upVector,
 						float size) noexcept;
 	DirectX::XMVECTOR XM_CALLCONV transformLocalToWorld(DirectX::FXMVECTOR vector) const noexcept;
+	//   ҽ  true. D3DApp dirty  Ҷ ȣѴ.
 	bool popDirtyFrame(void) noexcept;
+	static constexpr uint32_t NOT_IN_DIRTY_LIST = std::numeric_limits<uint32_t>::max();
+	uint32_t getDirtyListIndex(void) const noexcept { return _dirtyListIndex; }
+	void setDirtyListIndexXXX(uint32_t index) noexcept { _dirtyListIndex = index; }
 
 	inline uint16_t getObjectConstantBufferIndex(void) const noexcept { return _objConstantBufferIndex; }
 	inline uint16_t getSkinnedConstantBufferIndex(void) const noexcept { return _skinnedConstantBufferIndex; }
@@ -34,18 +39,32 @@ public:
 	inline bool isSkinnedAnimationObject(void) const noexcept { return _skinnedModelInstance != nullptr; }
 	bool isAnimationEnd() const noexcept;
 	void setAnimation(const std::string& animationName, const TickCount64& blendTick) noexcept;
-	void setCulled() noexcept;
-	void setCulledBackground() noexcept;
+	void addCullingBox(FrustumCuller& culler) noexcept;
+	// background ī޶ ٴϹǷ ī޶ ġŭ Űܼ ˻Ѵ.
+	void addCullingBoxBackground(FrustumCuller& culler) noexcept;
+	// culler.cull() Ŀ ȣѴ.
+	void setCulled(const FrustumCuller& culler) noexcept;
 	bool isCulled() const noexcept { return _isCulled; }
+	//   ׸   culling
+	void addShadowCullingBox(FrustumCuller& culler) noexcept;
+	void setShadowCulled(const FrustumCuller& culler) noexcept;
+	bool isShadowCulled() const noexcept { return _isShadowCulled; }
+	//  ʴ Ʈ ׸ ĳÿ ѹ ׸.
+	void setShadowStatic(bool isShadowStatic) noexcept;
+	bool isShadowStatic() const noexcept { return _isShadowStatic; }
 	void setAnimationSpeed(float speed) noexcept;
 	void changeMaterial(uint8_t renderItemIndex, 
 					const std::string& materialFileName,
 					const std::string& materialName) noexcept;
+private:
+	//   ҽ constant buffer ٽ  D3DApp dirty Ͽ ִ´.
+	void setDirtyXXX(void) noexcept;
 private:
 	DirectX::XMFLOAT4X4 _worldMatrix;
 	DirectX::XMFLOAT4X4 _textureTransform;
 	uint16_t _objConstantBufferIndex;
 	int _dirtyFrames;
+	uint32_t _dirtyListIndex;
 
 	uint16_t _skinnedConstantBufferIndex;
 	SkinnedModelInstance* _skinnedModelInstance;
@@ -53,6 +72,12 @@ private:
 
 	std::vector<RenderItem*> _renderItems;
 	bool _isCulled;
+	// ̹ ӿ culler ߰ ȣ. ޽  NO_CULLING_INDEX
+	static constexpr uint32_t NO_CULLING_INDEX = std::numeric_limits<uint32_t>::max();
+	uint32_t _cullingIndex;
+	bool _isShadowCulled;
+	uint32_t _shadowCullingIndex;
+	bool _isShadowStatic;
 
 #if defined DEBUG | defined _DEBUG
 public:
@@ -8,7 +8,7 @@
 Material::Material(int materialCBIndex, const XMLReaderNode& node)
 	: _materialCBIndex(materialCBIndex)
 	, _normalSRVHeapIndex(0)
-	, _dirtyFrames(FRAME_RESOURCE_COUNT)
+	, _dirtyFrames(0)
 	, _materialTransform(MathHelper::Identity4x4)
 {
 	node.loadAttribute("DiffuseAlbedo", _diffuseAlbedo);
@@ -56,4 +56,21 @@ Material::Material(int materialCBIndex, const XMLReaderNode& node)
 		ThrowErrCode(ErrCode::UndefinedType, renderLayerString);
 		static_assert(static_cast<int>(RenderLayer::Count) == 7, "Ÿ ߰ Ȯ");
 	}
+	setDirty();
+}
+
+void Material::setDirty(void) noexcept
+{
+	if (_dirtyFrames == 0)
+	{
+		SMGFramework::getD3DApp()->addDirtyMaterial(this);
+	}
+	_dirtyFrames = FRAME_RESOURCE_COUNT;
+}
+
+bool Material::popDirtyFrame(void) noexcept
+{
+	check(_dirtyFrames > 0);
+	--_dirtyFrames;
+	return _dirtyFrames > 0;
 }
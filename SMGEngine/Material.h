@@ -17,8 +17,12 @@ public:
 	inline float getRoughness(void) const noexcept { return _roughness; }
 	inline const DirectX::XMFLOAT4X4& getMaterialTransform(void) const noexcept { return _materialTransform; }
 	inline RenderLayer getRenderLayer(void) const noexcept { return _renderLayer; }
-	int _dirtyFrames;
+	//  ٲ ȣؼ   ҽ constant buffer ٽ  Ѵ.
+	void setDirty(void) noexcept;
+	//   ҽ  true. D3DApp dirty  Ҷ ȣѴ.
+	bool popDirtyFrame(void) noexcept;
 private:
+	int _dirtyFrames;
 	int _materialCBIndex;
 	uint16_t _textureIndex;
 	uint16_t _normalSRVHeapIndex;
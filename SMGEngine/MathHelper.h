@@ -562,6 +562,71 @@ namespace MathHelper
 		return intersectTime;
 	}
 
+	//  ﰢ     Ÿ .  ġ ﰢ , 𼭸,    ã´.
+	static float XM_CALLCONV getDistanceSqPointTriangle(DirectX::FXMVECTOR point,
+		DirectX::FXMVECTOR t0,
+		DirectX::FXMVECTOR t1,
+		DirectX::GXMVECTOR t2) noexcept
+	{
+		using namespace DirectX;
+		XMVECTOR edge01 = t1 - t0;
+		XMVECTOR edge02 = t2 - t0;
+		XMVECTOR toPoint0 = point - t0;
+		const float d1 = XMVectorGetX(XMVector3Dot(edge01, toPoint0));
+		const float d2 = XMVectorGetX(XMVector3Dot(edge02, toPoint0));
+		if (d1 <= 0.f && d2 <= 0.f)
+		{
+			return XMVectorGetX(XMVector3LengthSq(toPoint0));
+		}
+
+		XMVECTOR toPoint1 = point - t1;
+		const float d3 = XMVectorGetX(XMVector3Dot(edge01, toPoint1));
+		const float d4 = XMVectorGetX(XMVector3Dot(edge02, toPoint1));
+		if (d3 >= 0.f && d4 <= d3)
+		{
+			return XMVectorGetX(XMVector3LengthSq(toPoint1));
+		}
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+		{
+			const float v = d1 / (d1 - d3);
+			return XMVectorGetX(XMVector3LengthSq(point - (t0 + edge01 * v)));
+		}
+
+		XMVECTOR toPoint2 = point - t2;
+		const float d5 = XMVectorGetX(XMVector3Dot(edge01, toPoint2));
+		const float d6 = XMVectorGetX(XMVector3Dot(edge02, toPoint2));
+		if (d6 >= 0.f && d5 <= d6)
+		{
+			return XMVectorGetX(XMVector3LengthSq(toPoint2));
+		}
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+		{
+			const float w = d2 / (d2 - d6);
+			return XMVectorGetX(XMVector3LengthSq(point - (t0 + edge02 * w)));
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+		{
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return XMVectorGetX(XMVector3LengthSq(point - (t1 + (t2 - t1) * w)));
+		}
+
+		const float sum = va + vb + vc;
+		if (sum <= FLT_EPSILON)
+		{
+			// ̰  ﰢ
+			return XMVectorGetX(XMVector3LengthSq(toPoint0));
+		}
+		const float v = vb / sum;
+		const float w = vc / sum;
+		return XMVectorGetX(XMVector3LengthSq(point - (t0 + edge01 * v + edge02 * w)));
+	}
+
 	static float XM_CALLCONV getDeltaAngleToVector(DirectX::FXMVECTOR planeNormal, DirectX::FXMVECTOR originVectorNormal, DirectX::FXMVECTOR toVector) noexcept
 	{
 		using namespace DirectX;
@@ -649,7 +714,7 @@ namespace MathHelper
 			break;
 			case InterpolationType::Cosine:
 			{
-				return 0.5f - std::cosf(originalT * Pi) / 2.f;
+				return 0.5f - std::cos(originalT * Pi) / 2.f;
 			}
 			break;
 			case InterpolationType::Shake:
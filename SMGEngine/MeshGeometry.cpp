@@ -3,6 +3,7 @@
 #include "D3DUtil.h"
 #include "FileHelper.h"
 #include "GeometryGenerator.h"
+#include "MeshLod.h"
 
 void MeshGeometry::createMeshGeometryXXX(ID3D12Device* device,
 										ID3D12GraphicsCommandList* commandList,
@@ -106,6 +107,8 @@ MeshGeometry::MeshGeometry(const XMLReaderNode& rootNode, ID3D12Device* device,
 	_indexBufferByteSize = totalIndexCount * sizeof(GeoIndex);
 	indices.reserve(totalIndexCount);
 
+	// LOD index  index   ڿ ٿ 浹 ˻簡    ٲ ʰ Ѵ.
+	std::vector<GeoIndex> lodIndices;
 	UINT baseIndexLocation = 0;
 	UINT baseVertexLocation = 0;
 	const auto& childList = rootNode.getChildNodes();
@@ -149,6 +152,22 @@ MeshGeometry::MeshGeometry(const XMLReaderNode& rootNode, ID3D12Device* device,
 				{
 					loadXmlIndices(subMeshChildList[j], indices);
 				}
+				else if (subMeshNodeName == "LodIndices")
+				{
+					int level;
+					subMeshChildList[j].loadAttribute("Level", level);
+					SubMeshGeometry& lastSubMesh = _subMeshList.back();
+					if (level < 0 || static_cast<size_t>(level) != lastSubMesh._lodList.size() + 1 || MESH_LOD_COUNT_MAX <= level)
+					{
+						ThrowErrCode(ErrCode::InvalidXmlData, "lod level ̻մϴ. " + std::to_string(level));
+					}
+					SubMeshLod lod;
+					lod._baseIndexLoacation = static_cast<UINT>(lodIndices.size());
+					loadXmlIndices(subMeshChildList[j], lodIndices);
+					lod._indexCount = static_cast<UINT>(lodIndices.size()) - lod._baseIndexLoacation;
+					lastSubMesh._lodList.push_back(lod);
+					_lodCount = std::max(_lodCount, static_cast<uint8_t>(level + 1));
+				}
 				else
 				{
 					ThrowErrCode(ErrCode::NodeNameNotFound, "subMeshNodeName ̻մϴ." + subMeshNodeName);
@@ -161,6 +180,17 @@ MeshGeometry::MeshGeometry(const XMLReaderNode& rootNode, ID3D12Device* device,
 		}
 	}
 
+	const UINT lodBaseIndexLocation = static_cast<UINT>(indices.size());
+	for (auto& subMesh : _subMeshList)
+	{
+		for (auto& lod : subMesh._lodList)
+		{
+			lod._baseIndexLoacation += lodBaseIndexLocation;
+		}
+	}
+	indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+	_indexBufferByteSize = static_cast<UINT>(indices.size() * sizeof(GeoIndex));
+
 	if (isSkinned)
 	{
 		createMeshGeometryXXX(device, commandList, skinnedVertices.data(), indices.data());
@@ -207,6 +237,24 @@ const DirectX::BoundingBox& MeshGeometry::getBoundingBox(void) const noexcept
 	return _boundingBox;
 }
 
+uint8_t MeshGeometry::selectLodLevel(float screenSize, uint8_t currentLodLevel) const noexcept
+{
+	return MeshLod::selectLodLevel(screenSize, currentLodLevel, _lodCount);
+}
+
+void SubMeshGeometry::getLodIndexRange(uint8_t lodLevel, UINT& indexCount, UINT& baseIndexLocation) const noexcept
+{
+	if (lodLevel == 0 || _lodList.empty())
+	{
+		indexCount = _indexCount;
+		baseIndexLocation = _baseIndexLoacation;
+		return;
+	}
+	const SubMeshLod& lod = _lodList[std::min(static_cast<size_t>(lodLevel), _lodList.size()) - 1];
+	indexCount = lod._indexCount;
+	baseIndexLocation = lod._baseIndexLoacation;
+}
+
 void MeshGeometry::setVertexByteSizeOnlyXXXXX(UINT vertexBufferSize) noexcept
 {
 	_vertexBufferCPU = nullptr;
@@ -5,6 +5,13 @@
 
 class XMLReaderNode;
 
+// ȭ LOD  ܰ index .   submesh   .
+struct SubMeshLod
+{
+	UINT _indexCount = 0;
+	UINT _baseIndexLoacation = 0;
+};
+
 struct SubMeshGeometry
 {
 	bool operator==(const std::string rhs) const noexcept
@@ -15,6 +22,11 @@ struct SubMeshGeometry
 	UINT _indexCount = 0;
 	UINT _baseIndexLoacation = 0;
 	UINT _baseVertexLoaction = 0;
+	// 1ܰ LOD. 浹 ˻   Ѵ.
+	std::vector<SubMeshLod> _lodList;
+
+	//  submesh  ܰ   ܰ踦 Ѵ.
+	void getLodIndexRange(uint8_t lodLevel, UINT& indexCount, UINT& baseIndexLocation) const noexcept;
 };
 
 class MeshGeometry
@@ -40,6 +52,10 @@ public:
 	std::string getName(void) const noexcept { return _name; }
 	std::vector<SubMeshGeometry> _subMeshList;// todo private [1/14/2021 qwerw]
 	const DirectX::BoundingBox& getBoundingBox(void) const noexcept;
+	//   LOD ܰ . submesh     .
+	uint8_t getLodCount(void) const noexcept { return _lodCount; }
+	// screenSize bounding sphere  ȭ ̿ ϴ . MeshLod::selectLodLevel 
+	uint8_t selectLodLevel(float screenSize, uint8_t currentLodLevel) const noexcept;
 	
 private:
 	void createMeshGeometryXXX(ID3D12Device* device,
@@ -63,6 +79,7 @@ private:
 	WComPtr<ID3D12Resource> _indexBufferUploader;
 
 	DirectX::BoundingBox _boundingBox;
+	uint8_t _lodCount = 1;
 	void loadXmlSkinnedVertices(const  XMLReaderNode& node, std::vector<SkinnedVertex>& skinnedVertices) const;
 	void loadXmlVertices(const  XMLReaderNode& node, std::vector<Vertex>& vertices) const;
 	void loadXmlIndices(const  XMLReaderNode& node, std::vector<GeoIndex>& indices) const;
@@ -0,0 +1,30 @@
+#pragma once
+#include "TypeCommon.h"
+#include "Exception.h"
+#include <array>
+
+// ȭ ũ mesh LOD ܰ踦 . D3D    ֵ MeshGeometry д.
+class MeshLod
+{
+public:
+	// screenSize bounding sphere  ȭ ̿ ϴ . lodCount   ܰ .
+	// ذ ó ܰ谡   ٲ ʵ  ܰ踦  ذ  д.
+	static uint8_t selectLodLevel(float screenSize, uint8_t currentLodLevel, uint8_t lodCount) noexcept
+	{
+		check(0 < lodCount && lodCount <= MESH_LOD_COUNT_MAX, "Դϴ.");
+		uint8_t lodLevel = std::min(currentLodLevel, static_cast<uint8_t>(lodCount - 1));
+		while (lodLevel + 1 < lodCount && screenSize < LOD_SCREEN_SIZES[lodLevel + 1] * (1.f - LOD_HYSTERESIS))
+		{
+			++lodLevel;
+		}
+		while (0 < lodLevel && LOD_SCREEN_SIZES[lodLevel] * (1.f + LOD_HYSTERESIS) < screenSize)
+		{
+			--lodLevel;
+		}
+		return lodLevel;
+	}
+
+	// nܰ screenSize LOD_SCREEN_SIZES[n]  Ѵ.
+	static constexpr std::array<float, MESH_LOD_COUNT_MAX> LOD_SCREEN_SIZES = { 1.f, 0.25f, 0.1f, 0.04f };
+	static constexpr float LOD_HYSTERESIS = 0.15f;
+};
@@ -0,0 +1,44 @@
+#include "stdafx.h"
+#include "NameTable.h"
+#include "Exception.h"
+
+std::unordered_map<std::string, NameId> NameTable::_nameIds;
+std::vector<std::string> NameTable::_names;
+
+NameId NameTable::getNameId(const std::string& name)
+{
+	auto it = _nameIds.find(name);
+	if (it != _nameIds.end())
+	{
+		return it->second;
+	}
+	if (UNDEFINED_NAME_ID <= _names.size())
+	{
+		ThrowErrCode(ErrCode::Overflow, "NameId  Ѿϴ. " + name);
+	}
+
+	const NameId nameId = static_cast<NameId>(_names.size());
+	_names.push_back(name);
+	_nameIds.emplace(name, nameId);
+	return nameId;
+}
+
+NameId NameTable::findNameId(const std::string& name) noexcept
+{
+	auto it = _nameIds.find(name);
+	if (it == _nameIds.end())
+	{
+		return UNDEFINED_NAME_ID;
+	}
+	return it->second;
+}
+
+const std::string& NameTable::getName(NameId nameId) noexcept
+{
+	static const std::string undefinedName = "UNDEFINED";
+	if (_names.size() <= nameId)
+	{
+		return undefinedName;
+	}
+	return _names[nameId];
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "TypeCommon.h"
+#include "Exception.h"
+
+// ׼ , , ui ̸  εҶ NameId ٲ㼭  ƽ ڿ ؽ  ʵ Ѵ.
+//  ڿ ׻  id Ƿ ٸ ׼Ʈ /  id ã  ִ.
+class NameTable
+{
+public:
+	//   Ѵ. εҶ 
+	static NameId getNameId(const std::string& name);
+	// ϵ  ̸̸ UNDEFINED_NAME_ID
+	static NameId findNameId(const std::string& name) noexcept;
+	static const std::string& getName(NameId nameId) noexcept;
+private:
+	static std::unordered_map<std::string, NameId> _nameIds;
+	static std::vector<std::string> _names;
+};
+
+// NameId ε ٷ ã 迭. εҶ ä ߿ ε̸ Ѵ.
+template<typename T>
+class NameIdMap
+{
+public:
+	NameIdMap(const T& defaultValue) noexcept
+		: _defaultValue(defaultValue)
+	{
+	}
+	void set(NameId nameId, const T& value)
+	{
+		check(nameId != UNDEFINED_NAME_ID);
+		if (_values.size() <= nameId)
+		{
+			_values.resize(static_cast<size_t>(nameId) + 1, _defaultValue);
+		}
+		_values[nameId] = value;
+	}
+	const T& get(NameId nameId) const noexcept
+	{
+		if (_values.size() <= nameId)
+		{
+			return _defaultValue;
+		}
+		return _values[nameId];
+	}
+	void clear(void) noexcept
+	{
+		_values.clear();
+	}
+private:
+	std::vector<T> _values;
+	T _defaultValue;
+};
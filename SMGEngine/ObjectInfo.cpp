@@ -60,8 +60,28 @@ SpawnInfo::SpawnInfo(const DirectX::XMFLOAT3& position,
 
 TerrainObjectInfo::TerrainObjectInfo(const XMLReaderNode& node)
 	: ObjectInfo(node)
+	, _pathKey(-1)
+	, _rotateSpeed(0.f)
 {
 	node.loadAttribute("ObjectFile", _objectFileName);
 	node.loadAttribute("IsGround", _isGround);
 	node.loadAttribute("IsWall", _isWall);
+
+	std::string collisionTypeString = "Triangle";
+	node.loadAttributeIfExist("CollisionType", collisionTypeString);
+	if (collisionTypeString == "Triangle")
+	{
+		_collisionType = TerrainCollisionType::Triangle;
+	}
+	else if (collisionTypeString == "DistanceField")
+	{
+		_collisionType = TerrainCollisionType::DistanceField;
+	}
+	else
+	{
+		static_assert(static_cast<int>(TerrainCollisionType::Count) == 2, "Ÿ ߰ Ȯ");
+		ThrowErrCode(ErrCode::UndefinedType, collisionTypeString);
+	}
+	node.loadAttributeIfExist("PathKey", _pathKey);
+	node.loadAttributeIfExist("RotateSpeed", _rotateSpeed);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "TypeCommon.h"
+#include "TypeGeometry.h"
 class XMLReaderNode;
 
 class ObjectInfo
@@ -55,9 +56,17 @@ public:
 	const std::string getObjectFileName(void) const noexcept { return _objectFileName; }
 	bool isGround(void) const noexcept { return _isGround; }
 	bool isWall(void) const noexcept { return _isWall; }
+	TerrainCollisionType getCollisionType(void) const noexcept { return _collisionType; }
+	int getPathKey(void) const noexcept { return _pathKey; }
+	float getRotateSpeed(void) const noexcept { return _rotateSpeed; }
 private:
 	std::string _objectFileName;
 
 	bool _isGround;
 	bool _isWall;
+	TerrainCollisionType _collisionType;
+	// 0 이상이면 path를 따라 왕복해서 움직인다. 없으면 -1
+	int _pathKey;
+	// upVector를 축으로 tick당 회전하는 각도. 없으면 0
+	float _rotateSpeed;
 };
@@ -5,11 +5,13 @@
 #include "MathHelper.h"
 
 Path::Path(const XMLReaderNode& node)
+	: _isConstantSpeed(false)
 {
 	using namespace MathHelper;
 	node.loadAttribute("IsCurve", _isCurve);
 	node.loadAttribute("HasDirection", _hasDirection);
 	node.loadAttribute("MoveTick", _moveTick);
+	node.loadAttributeIfExist("ConstantSpeed", _isConstantSpeed);
 	const auto& childNodes = node.getChildNodes();
 	_points.reserve(childNodes.size());
 	for (const auto& childNode : childNodes)
@@ -20,8 +22,7 @@ Path::Path(const XMLReaderNode& node)
 	if (_isCurve)
 	{
 		using namespace DirectX;
-		int indexMax = _points.size() / 2;
-		for (int i = 0; i < indexMax; i += 2)
+		for (int i = 0; i + 2 < _points.size(); i += 2)
 		{
 			XMVECTOR A = XMLoadFloat3(&_points[i]._position);
 			XMVECTOR B = XMLoadFloat3(&_points[i + 2]._position);
@@ -81,28 +82,27 @@ Path::Path(const XMLReaderNode& node)
 			}
 		}
 	}
+
+	makeSegments();
+	if (_isConstantSpeed)
+	{
+		makeArcLengthTable();
+	}
 }
 
 void Path::getPathPositionAtTime(const TickCount64& currentMoveTick,
 								DirectX::XMFLOAT3& position,
 								InterpolationType interpolateType) const noexcept
 {
-	float t = MathHelper::getInterpolateValue(currentMoveTick, 0, _moveTick, interpolateType);
-	if (_isCurve)
-	{
-		getPathPositionAtTimeCurve(t, position);
-	}
-	else
-	{
-		getPathPositionAtTimeLine(t, position);
-	}
+	float t = getCurveT(MathHelper::getInterpolateValue(currentMoveTick, 0, _moveTick, interpolateType));
+	XMStoreFloat3(&position, getSegmentPosition(getSegment(t), t));
 }
 
 void Path::getPathRotationAtTime(const TickCount64& currentMoveTick,
 								DirectX::XMFLOAT4& quaternion,
 								InterpolationType interpolateType) const noexcept
 {
-	float t = MathHelper::getInterpolateValue(currentMoveTick, 0, _moveTick, interpolateType);
+	float t = getCurveT(MathHelper::getInterpolateValue(currentMoveTick, 0, _moveTick, interpolateType));
 
 	//OutputDebugStringA(("t : " + std::to_string(t) + '\n').c_str());
 	if (_isCurve)
@@ -115,6 +115,20 @@ void Path::getPathRotationAtTime(const TickCount64& currentMoveTick,
 	}
 }
 
+void Path::getPathPositionsAtTime(const TickCount64* currentMoveTicks,
+								size_t count,
+								DirectX::XMFLOAT3* outPositions,
+								InterpolationType interpolateType) const noexcept
+{
+	check(currentMoveTicks != nullptr || count == 0);
+	check(outPositions != nullptr || count == 0);
+	for (size_t i = 0; i < count; ++i)
+	{
+		float t = getCurveT(MathHelper::getInterpolateValue(currentMoveTicks[i], 0, _moveTick, interpolateType));
+		XMStoreFloat3(&outPositions[i], getSegmentPosition(getSegment(t), t));
+	}
+}
+
 const TickCount64& Path::getMoveTick(void) const noexcept
 {
 	return _moveTick;
@@ -125,51 +139,157 @@ const DirectX::XMFLOAT3& Path::getPathStartPosition(void) const noexcept
 	return _points.begin()->_position;
 }
 
-void Path::getPathPositionAtTimeCurve(float t, DirectX::XMFLOAT3& position) const noexcept
+void Path::makeSegments(void)
 {
 	using namespace DirectX;
-	check(0 <= t && t <= 1.f);
-
-	auto it = prev(upper_bound(_points.begin(), _points.end(), t, [](float t, const PathPoint& itor) {
-		return t < itor._time; }));
-	if (it == _points.end() || next(it) == _points.end())
+	const int step = _isCurve ? 2 : 1;
+	const size_t segmentCount = (_points.size() - 1) / step;
+	if (std::numeric_limits<uint16_t>::max() <= segmentCount * SEGMENT_LOOKUP_SIZE_PER_SEGMENT)
 	{
-		it = prev(prev(_points.end()));
+		ThrowErrCode(ErrCode::Overflow, "segment  : " + std::to_string(segmentCount));
 	}
 
-	int index = it - _points.begin();
-	index -= (index % 2);
+	_segments.reserve(segmentCount);
+	for (size_t i = 0; i + step < _points.size(); i += step)
+	{
+		XMVECTOR p0 = XMLoadFloat3(&_points[i]._position);
+		XMVECTOR pEnd = XMLoadFloat3(&_points[i + step]._position);
+		XMVECTOR b, c;
+		if (_isCurve)
+		{
+			XMVECTOR p1 = XMLoadFloat3(&_points[i + 1]._position);
+			b = 2.f * (p1 - p0);
+			c = p0 - (2.f * p1) + pEnd;
+		}
+		else
+		{
+			b = pEnd - p0;
+			c = XMVectorZero();
+		}
 
-	float startT = _points[index]._time;
-	float endT = _points[index + 2]._time;
-	check(startT <= t && t <= endT);
-	float localT = (t - startT) / (endT - startT);
-	
-	XMVECTOR p0 = XMLoadFloat3(&_points[index]._position);
-	XMVECTOR p1 = XMLoadFloat3(&_points[index + 1]._position);
-	XMVECTOR p2 = XMLoadFloat3(&_points[index + 2]._position);
-
-	float b0 = (1 - localT) * (1 - localT);
-	float b1 = 2 * (1 - localT) * localT;
-	float b2 = localT * localT;
-	XMVECTOR positionV = (p0 * b0) + (p1 * b1) + (p2 * b2);
-	XMStoreFloat3(&position, positionV);
+		PathSegment segment;
+		XMStoreFloat3(&segment._a, p0);
+		XMStoreFloat3(&segment._b, b);
+		XMStoreFloat3(&segment._c, c);
+		segment._startT = _points[i]._time;
+		segment._endT = _points[i + step]._time;
+		segment._invDuration = 1.f / (segment._endT - segment._startT);
+		segment._pointIndex = static_cast<uint16_t>(i);
+		_segments.push_back(segment);
+	}
+	check(_segments.size() == segmentCount);
+
+	_segmentLookup.resize(segmentCount * SEGMENT_LOOKUP_SIZE_PER_SEGMENT);
+	uint16_t segmentIndex = 0;
+	for (size_t i = 0; i < _segmentLookup.size(); ++i)
+	{
+		const float t = static_cast<float>(i) / _segmentLookup.size();
+		while (segmentIndex + 1 < _segments.size() && _segments[segmentIndex]._endT <= t)
+		{
+			++segmentIndex;
+		}
+		_segmentLookup[i] = segmentIndex;
+	}
 }
 
-void Path::getPathRotationAtTimeCurve(float t, DirectX::XMFLOAT4& quaternion) const noexcept
+void Path::makeArcLengthTable(void)
 {
 	using namespace DirectX;
+	check(!_segments.empty());
+
+	const size_t sampleCount = _segments.size() * ARC_LENGTH_SAMPLE_PER_SEGMENT;
+	std::vector<float> sampleT(sampleCount + 1);
+	std::vector<float> sampleLength(sampleCount + 1);
+	sampleT[0] = 0.f;
+	sampleLength[0] = 0.f;
+
+	XMVECTOR prevPosition = getSegmentPosition(_segments.front(), 0.f);
+	size_t sampleIndex = 1;
+	for (const auto& segment : _segments)
+	{
+		for (int i = 1; i <= ARC_LENGTH_SAMPLE_PER_SEGMENT; ++i)
+		{
+			const float t = segment._startT + (segment._endT - segment._startT) * i / ARC_LENGTH_SAMPLE_PER_SEGMENT;
+			XMVECTOR position = getSegmentPosition(segment, t);
+			sampleT[sampleIndex] = t;
+			sampleLength[sampleIndex] = sampleLength[sampleIndex - 1] + XMVectorGetX(XMVector3Length(position - prevPosition));
+			prevPosition = position;
+			++sampleIndex;
+		}
+	}
+	check(sampleIndex == sampleCount + 1);
+
+	const float totalLength = sampleLength.back();
+	if (MathHelper::equal(totalLength, 0.f))
+	{
+		ThrowErrCode(ErrCode::InvalidXmlData, "path ̰ 0Դϴ.");
+	}
+
+	_arcLengthTable.resize(sampleCount + 1);
+	size_t sample = 0;
+	for (size_t i = 0; i < _arcLengthTable.size(); ++i)
+	{
+		const float targetLength = totalLength * i / sampleCount;
+		while (sample + 2 < sampleLength.size() && sampleLength[sample + 1] < targetLength)
+		{
+			++sample;
+		}
+		const float sampleDelta = sampleLength[sample + 1] - sampleLength[sample];
+		const float ratio = (sampleDelta <= 0.f) ? 0.f :
+			std::clamp((targetLength - sampleLength[sample]) / sampleDelta, 0.f, 1.f);
+		_arcLengthTable[i] = sampleT[sample] + (sampleT[sample + 1] - sampleT[sample]) * ratio;
+	}
+	_arcLengthTable.front() = 0.f;
+	_arcLengthTable.back() = 1.f;
+}
+
+float Path::getCurveT(float t) const noexcept
+{
+	if (!_isConstantSpeed)
+	{
+		return t;
+	}
+	check(0 <= t && t <= 1.f);
+	check(2 <= _arcLengthTable.size());
+
+	const float scaled = t * (_arcLengthTable.size() - 1);
+	const size_t index = std::min(static_cast<size_t>(scaled), _arcLengthTable.size() - 2);
+	const float ratio = scaled - index;
+	return _arcLengthTable[index] + (_arcLengthTable[index + 1] - _arcLengthTable[index]) * ratio;
+}
+
+const PathSegment& Path::getSegment(float t) const noexcept
+{
 	check(0 <= t && t <= 1.f);
+	check(!_segmentLookup.empty());
 
-	auto it = prev(upper_bound(_points.begin(), _points.end(), t, [](float t, const PathPoint& itor) {
-		return t < itor._time; }));
-	if (it == _points.end() || next(it) == _points.end())
+	const size_t lookupIndex = std::min(static_cast<size_t>(t * _segmentLookup.size()), _segmentLookup.size() - 1);
+	size_t segmentIndex = _segmentLookup[lookupIndex];
+	// ȸ ̺  ĭ  谡  ִ 츸   Ѿ.
+	while (segmentIndex + 1 < _segments.size() && _segments[segmentIndex]._endT <= t)
 	{
-		it = prev(prev(_points.end()));
+		++segmentIndex;
 	}
+	return _segments[segmentIndex];
+}
+
+DirectX::XMVECTOR XM_CALLCONV Path::getSegmentPosition(const PathSegment& segment, float t) noexcept
+{
+	using namespace DirectX;
+	const float localT = std::clamp((t - segment._startT) * segment._invDuration, 0.f, 1.f);
+	XMVECTOR a = XMLoadFloat3(&segment._a);
+	XMVECTOR b = XMLoadFloat3(&segment._b);
+	XMVECTOR c = XMLoadFloat3(&segment._c);
+	return a + (b + c * localT) * localT;
+}
+
+void Path::getPathRotationAtTimeCurve(float t, DirectX::XMFLOAT4& quaternion) const noexcept
+{
+	using namespace DirectX;
+	check(0 <= t && t <= 1.f);
 
-	int index = it - _points.begin();
-	index -= (index % 2);
+	const PathSegment& segment = getSegment(t);
+	const int index = segment._pointIndex;
 
 	float startT = _points[index]._time;
 	float midT = _points[index + 1]._time;
@@ -204,11 +324,10 @@ void Path::getPathRotationAtTimeCurve(float t, DirectX::XMFLOAT4& quaternion) co
 	}
 	else
 	{
-		XMVECTOR p0 = XMLoadFloat3(&_points[index]._position);
-		XMVECTOR p1 = XMLoadFloat3(&_points[index + 1]._position);
-		XMVECTOR p2 = XMLoadFloat3(&_points[index + 2]._position);
-
-		XMVECTOR direction = XMVector3Normalize(((1 - localT) * (p1 - p0)) + (localT * (p2 - p1)));
+		// ġ ̺ b + 2cu
+		XMVECTOR b = XMLoadFloat3(&segment._b);
+		XMVECTOR c = XMLoadFloat3(&segment._c);
+		XMVECTOR direction = XMVector3Normalize(b + (2.f * localT) * c);
 
 		XMVECTOR u0, u1;
 		float d;
@@ -230,40 +349,14 @@ void Path::getPathRotationAtTimeCurve(float t, DirectX::XMFLOAT4& quaternion) co
 	}
 }
 
-void Path::getPathPositionAtTimeLine(float t, DirectX::XMFLOAT3& position) const noexcept
-{
-	using namespace DirectX;
-	check(0 <= t && t <= 1.f);
-
-	auto it0 = prev(upper_bound(_points.begin(), _points.end(), t, [](float t, const PathPoint& itor) {
-		return t < itor._time; }));
-	if (it0 == _points.end() || next(it0) == _points.end())
-	{
-		it0 = prev(prev(_points.end()));
-	}
-
-	auto it1 = next(it0);
-	float localT = (t - it0->_time) / (it1->_time - it0->_time);
-
-	XMVECTOR position0 = XMLoadFloat3(&it0->_position);
-	XMVECTOR position1 = XMLoadFloat3(&it1->_position);
-	XMStoreFloat3(&position, XMVectorLerp(position0, position1, localT));
-}
-
 void Path::getPathRotationAtTimeLine(float t, DirectX::XMFLOAT4& quaternion) const noexcept
 {
 	using namespace DirectX;
 	check(0 <= t && t <= 1.f);
 
-	auto it0 = prev(upper_bound(_points.begin(), _points.end(), t, [](float t, const PathPoint& itor) {
-		return t < itor._time; }));
-	if (it0 == _points.end() || next(it0) == _points.end())
-	{
-		it0 = prev(prev(_points.end()));
-	}
-
-	auto it1 = next(it0);
-	float localT = (t - it0->_time) / (it1->_time - it0->_time);
+	const PathSegment& segment = getSegment(t);
+	const auto it0 = _points.begin() + segment._pointIndex;
+	const auto it1 = next(it0);
 
 	XMVECTOR upVector = XMLoadFloat3(&it0->_upVector);
 	XMVECTOR direction;
@@ -10,6 +10,19 @@ struct PathPoint
 	DirectX::XMFLOAT3 _direction;
 	float _time;
 };
+// εҶ   t ->  ȸ ̺ ΰ Ҷ  ð  ã´.
+// position(u) = _a + _b * u + _c * u * u, u   [0, 1] .   _c 0̴.
+struct PathSegment
+{
+	DirectX::XMFLOAT3 _a;
+	DirectX::XMFLOAT3 _b;
+	DirectX::XMFLOAT3 _c;
+	float _startT;
+	float _endT;
+	float _invDuration;
+	uint16_t _pointIndex;
+};
+
 class Path
 {
 public:
@@ -18,15 +31,23 @@ public:
 		DirectX::XMFLOAT3& position, InterpolationType interpolateType) const noexcept;
 	void getPathRotationAtTime(const TickCount64& currentMoveTick,
 		DirectX::XMFLOAT4& quaternion, InterpolationType interpolateType) const noexcept;
+	//  path   ð ѹ Ѵ.
+	void getPathPositionsAtTime(const TickCount64* currentMoveTicks,
+		size_t count,
+		DirectX::XMFLOAT3* outPositions,
+		InterpolationType interpolateType) const noexcept;
 	const TickCount64& getMoveTick(void) const noexcept;
 	const DirectX::XMFLOAT3& getPathStartPosition(void) const noexcept;
 private:
-	void getPathPositionAtTimeCurve(float t,
-		DirectX::XMFLOAT3& position) const noexcept;
+	void makeSegments(void);
+	void makeArcLengthTable(void);
+	// _isConstantSpeed t  ̵Ÿ  t ٲ۴.
+	float getCurveT(float t) const noexcept;
+	const PathSegment& getSegment(float t) const noexcept;
+	static DirectX::XMVECTOR XM_CALLCONV getSegmentPosition(const PathSegment& segment, float t) noexcept;
+
 	void getPathRotationAtTimeCurve(float t,
 		DirectX::XMFLOAT4& quaternion) const noexcept;
-	void getPathPositionAtTimeLine(float t,
-		DirectX::XMFLOAT3& position) const noexcept;
 	void getPathRotationAtTimeLine(float t,
 		DirectX::XMFLOAT4& quaternion) const noexcept;
 private:
@@ -34,4 +55,15 @@ private:
 	TickCount64 _moveTick;
 	bool _isCurve;
 	bool _hasDirection;
+	// true PathPoint _time  ̵Ÿ    ӵ ȴ.
+	bool _isConstantSpeed;
+
+	std::vector<PathSegment> _segments;
+	// [i / size, (i + 1) / size)  t ϴ  ȣ
+	std::vector<uint16_t> _segmentLookup;
+	// i°  ̵Ÿ  i / (size - 1)  t
+	std::vector<float> _arcLengthTable;
+
+	static constexpr int SEGMENT_LOOKUP_SIZE_PER_SEGMENT = 4;
+	static constexpr int ARC_LENGTH_SAMPLE_PER_SEGMENT = 32;
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "stdafx.h"
+#include "RecordWorkerPool.h"
+#include "Exception.h"
+
+RecordWorkerPool::RecordWorkerPool(uint32_t threadCount)
+	: _task(nullptr)
+	, _taskCount(0)
+	, _finishedTaskCount(0)
+	, _activeWorkerCount(0)
+	, _generation(0)
+	, _isStopped(false)
+	, _nextTask(0)
+{
+	check(0 < threadCount);
+	_workers.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i)
+	{
+		_workers.emplace_back(&RecordWorkerPool::workerLoop, this);
+	}
+}
+
+RecordWorkerPool::~RecordWorkerPool(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopped = true;
+	}
+	_startCondition.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+void RecordWorkerPool::run(uint32_t taskCount, const std::function<void(uint32_t)>& task)
+{
+	if (taskCount == 0)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		check(_task == nullptr, "run  忡 ȣؾ մϴ.");
+		check(_activeWorkerCount == 0);
+		_task = &task;
+		_taskCount = taskCount;
+		_finishedTaskCount = 0;
+		_exception = nullptr;
+		_nextTask.store(0);
+		++_generation;
+	}
+	_startCondition.notify_all();
+
+	runTasksXXX(task, taskCount);
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		// ʰ  worker  run ۾ ȣ  ʵ  ö ٸ.
+		_finishCondition.wait(lock, [this]() { return _finishedTaskCount == _taskCount && _activeWorkerCount == 0; });
+		_task = nullptr;
+		_taskCount = 0;
+		exception = _exception;
+		_exception = nullptr;
+	}
+	if (exception != nullptr)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+void RecordWorkerPool::workerLoop(void) noexcept
+{
+	uint64_t generation = 0;
+	while (true)
+	{
+		const std::function<void(uint32_t)>* task = nullptr;
+		uint32_t taskCount = 0;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startCondition.wait(lock, [this, generation]() { return _isStopped || _generation != generation; });
+			if (_isStopped)
+			{
+				return;
+			}
+			generation = _generation;
+			if (_task == nullptr)
+			{
+				continue;
+			}
+			task = _task;
+			taskCount = _taskCount;
+			++_activeWorkerCount;
+		}
+
+		runTasksXXX(*task, taskCount);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			--_activeWorkerCount;
+		}
+		_finishCondition.notify_all();
+	}
+}
+
+void RecordWorkerPool::runTasksXXX(const std::function<void(uint32_t)>& task, uint32_t taskCount) noexcept
+{
+	uint32_t finishedCount = 0;
+	while (true)
+	{
+		const uint32_t index = _nextTask.fetch_add(1);
+		if (taskCount <= index)
+		{
+			break;
+		}
+		try
+		{
+			task(index);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_exception == nullptr)
+			{
+				_exception = std::current_exception();
+			}
+		}
+		++finishedCount;
+	}
+	if (finishedCount == 0)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_finishedTaskCount += finishedCount;
+	}
+	_finishCondition.notify_all();
+}
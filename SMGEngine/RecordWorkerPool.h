@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstdint>
+
+// Ӹ command list  ۾  óϴ  Ǯ. D3D ġ  ۾ ȣ ش.
+// ۾     Ƿ  ۾ ȣ  Ƽ ؾ Ѵ.
+class RecordWorkerPool
+{
+public:
+	// threadCount run ȣϴ 带  
+	explicit RecordWorkerPool(uint32_t threadCount);
+	~RecordWorkerPool(void);
+	RecordWorkerPool(const RecordWorkerPool&) = delete;
+	RecordWorkerPool& operator=(const RecordWorkerPool&) = delete;
+
+	// 0 ~ taskCount - 1 ۾   ٸ. ȣ 嵵 ۾ Ѵ.
+	// ۾  ܴ  ۾   ȣ 忡 ٽ .
+	void run(uint32_t taskCount, const std::function<void(uint32_t)>& task);
+	uint32_t getThreadCount(void) const noexcept { return static_cast<uint32_t>(_workers.size()) + 1; }
+private:
+	void workerLoop(void) noexcept;
+	void runTasksXXX(const std::function<void(uint32_t)>& task, uint32_t taskCount) noexcept;
+
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _startCondition;
+	std::condition_variable _finishCondition;
+
+	// Ʒ _mutex ȣѴ. _task run  nullptr̴.
+	const std::function<void(uint32_t)>* _task;
+	uint32_t _taskCount;
+	uint32_t _finishedTaskCount;
+	uint32_t _activeWorkerCount;
+	uint64_t _generation;
+	bool _isStopped;
+	std::exception_ptr _exception;
+
+	std::atomic<uint32_t> _nextTask;
+};
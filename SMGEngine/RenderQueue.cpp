@@ -0,0 +1,285 @@
+#include "stdafx.h"
+#include "RenderQueue.h"
+#include "Exception.h"
+#include <algorithm>
+
+uint64_t RenderQueue::makeSortKey(uint8_t layerOrder,
+								uint8_t psoType,
+								const MeshGeometry* mesh,
+								uint32_t materialCBIndex,
+								uint8_t subMeshIndex,
+								uint8_t lodLevel,
+								float depth,
+								bool isBackToFront) noexcept
+{
+	check(layerOrder < 16);
+	check(psoType < 16);
+	check(lodLevel < (1 << LOD_BITS));
+
+	// mesh   Ϻθ Ѵ. ٸ mesh  ĵ   ͷ ϹǷ  .
+	const uint64_t meshBits = (reinterpret_cast<uintptr_t>(mesh) >> 4) & 0xFFFF;
+	const uint64_t materialBits = materialCBIndex & 0xFFFF;
+	uint64_t depthBits = static_cast<uint64_t>(std::clamp(depth, 0.f, 1.f) * DEPTH_MAX);
+
+	const uint64_t subMeshBits = subMeshIndex;
+
+	uint64_t key = (static_cast<uint64_t>(layerOrder) << 60) | (static_cast<uint64_t>(psoType) << 56);
+	if (isBackToFront)
+	{
+		depthBits = DEPTH_MAX - depthBits;
+		key |= (depthBits << 40) | (meshBits << 24) | (materialBits << 8) | subMeshBits;
+	}
+	else
+	{
+		//  lod 𿩾 instancing   Ƿ  Ʒ ڸ lod .
+		const uint64_t lodBits = lodLevel;
+		key |= (meshBits << 40) | (materialBits << 24) | (subMeshBits << 16) | (lodBits << (16 - LOD_BITS)) | (depthBits >> LOD_BITS);
+	}
+	return key;
+}
+
+void RenderQueue::clear(void) noexcept
+{
+	_packets.clear();
+}
+
+void RenderQueue::addPacket(const DrawPacket& packet) noexcept
+{
+	_packets.push_back(packet);
+}
+
+void RenderQueue::addPackets(const std::vector<DrawPacket>& packets) noexcept
+{
+	_packets.insert(_packets.end(), packets.begin(), packets.end());
+}
+
+void RenderQueue::sort(void) noexcept
+{
+	if (_packets.size() <= 1)
+	{
+		return;
+	}
+	//  Ű ߰  ϴ LSD radix sort
+	_sortBuffer.resize(_packets.size());
+	for (int shift = 0; shift < 64; shift += RADIX_BITS)
+	{
+		std::array<uint32_t, RADIX_SIZE> offsets = {};
+		for (const auto& packet : _packets)
+		{
+			++offsets[(packet._sortKey >> shift) & (RADIX_SIZE - 1)];
+		}
+		//  Ű ̹ ڸ    ٲ ʴ´.
+		if (offsets[(_packets[0]._sortKey >> shift) & (RADIX_SIZE - 1)] == _packets.size())
+		{
+			continue;
+		}
+		uint32_t offset = 0;
+		for (auto& count : offsets)
+		{
+			const uint32_t bucketSize = count;
+			count = offset;
+			offset += bucketSize;
+		}
+		for (const auto& packet : _packets)
+		{
+			_sortBuffer[offsets[(packet._sortKey >> shift) & (RADIX_SIZE - 1)]++] = packet;
+		}
+		_packets.swap(_sortBuffer);
+	}
+}
+
+void RenderQueue::split(uint32_t chunkCount, std::vector<RenderQueueRange>& ranges) const noexcept
+{
+	check(0 < chunkCount);
+	ranges.clear();
+	const uint32_t packetCount = static_cast<uint32_t>(_packets.size());
+	uint32_t begin = 0;
+	for (uint32_t i = 1; i <= chunkCount && begin < packetCount; ++i)
+	{
+		uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(packetCount) * i / chunkCount);
+		while (begin < end && end < packetCount && isSameInstanceGroup(_packets[end - 1], _packets[end]))
+		{
+			++end;
+		}
+		if (begin < end)
+		{
+			ranges.push_back({ begin, end });
+			begin = end;
+		}
+	}
+	if (ranges.empty())
+	{
+		ranges.push_back({ 0, 0 });
+	}
+}
+
+void RenderQueue::submit(RenderBackend& backend,
+						const RenderQueueRange& range,
+						uint32_t instanceOffset,
+						RenderQueueStatistics& statistics) const noexcept
+{
+	check(range._begin <= range._end && range._end <= _packets.size());
+	if (range._begin == 0)
+	{
+		++statistics._submitCount;
+	}
+	statistics._packetCount += range._end - range._begin;
+
+	//  draw ٸ ¸ Ѵ.  ù draw command list ̹Ƿ  Ѵ.
+	const DrawPacket* prev = nullptr;
+	auto isChanged = [&statistics](bool isSame)
+	{
+		if (isSame)
+		{
+			++statistics._skippedStateChangeCount;
+			return false;
+		}
+		++statistics._stateChangeCount;
+		return true;
+	};
+	std::vector<uint32_t> instanceObjectCBIndices;
+	for (uint32_t begin = range._begin; begin < range._end;)
+	{
+		const DrawPacket& packet = _packets[begin];
+		instanceObjectCBIndices.clear();
+		uint32_t end = begin;
+		for (; end < range._end && isSameInstanceGroup(packet, _packets[end]); ++end)
+		{
+			instanceObjectCBIndices.push_back(_packets[end]._objectCBIndex);
+		}
+
+		if (isChanged(prev != nullptr && prev->_psoType == packet._psoType))
+		{
+			backend.setPipelineState(packet._psoType);
+		}
+		if (isChanged(prev != nullptr && prev->_mesh == packet._mesh))
+		{
+			backend.setMesh(packet._mesh);
+		}
+		if (isChanged(prev != nullptr && prev->_primitive == packet._primitive))
+		{
+			backend.setPrimitiveTopology(packet._primitive);
+		}
+		if (packet._skinnedCBIndex != std::numeric_limits<uint16_t>::max() &&
+			isChanged(prev != nullptr && prev->_skinnedCBIndex == packet._skinnedCBIndex))
+		{
+			backend.setSkinnedConstantBuffer(packet._skinnedCBIndex);
+		}
+		if (isChanged(prev != nullptr && prev->_materialCBIndex == packet._materialCBIndex))
+		{
+			backend.setMaterialConstantBuffer(packet._materialCBIndex);
+		}
+		backend.drawSubMeshInstanced(packet._mesh,
+			packet._subMeshIndex,
+			packet._lodLevel,
+			instanceObjectCBIndices.data(),
+			static_cast<uint32_t>(instanceObjectCBIndices.size()),
+			instanceOffset + begin);
+		++statistics._drawCallCount;
+
+		prev = &packet;
+		begin = end;
+	}
+}
+
+bool RenderQueue::isSameInstanceGroup(const DrawPacket& lhs, const DrawPacket& rhs) noexcept
+{
+	// skinned bone ȷƮ ƾ   ִ. ȷƮ instance  Ƿ skinned packet  ʴ´.
+	return lhs._psoType == rhs._psoType &&
+		lhs._mesh == rhs._mesh &&
+		lhs._subMeshIndex == rhs._subMeshIndex &&
+		lhs._lodLevel == rhs._lodLevel &&
+		lhs._primitive == rhs._primitive &&
+		lhs._materialCBIndex == rhs._materialCBIndex &&
+		lhs._skinnedCBIndex == rhs._skinnedCBIndex;
+}
+
+RecordingRenderBackend::RecordingRenderBackend(void) noexcept
+{
+	clear();
+}
+
+void RecordingRenderBackend::setPipelineState(uint8_t psoType) noexcept
+{
+	_state._psoType = psoType;
+	++_stateChangeCount;
+}
+
+void RecordingRenderBackend::setMesh(const MeshGeometry* mesh) noexcept
+{
+	_state._stateMesh = mesh;
+	++_stateChangeCount;
+}
+
+void RecordingRenderBackend::setPrimitiveTopology(uint8_t primitive) noexcept
+{
+	_state._primitive = primitive;
+	++_stateChangeCount;
+}
+
+void RecordingRenderBackend::setSkinnedConstantBuffer(uint16_t skinnedCBIndex) noexcept
+{
+	_state._skinnedCBIndex = skinnedCBIndex;
+	++_stateChangeCount;
+}
+
+void RecordingRenderBackend::setMaterialConstantBuffer(uint32_t materialCBIndex) noexcept
+{
+	_state._materialCBIndex = materialCBIndex;
+	++_stateChangeCount;
+}
+
+void RecordingRenderBackend::drawSubMeshInstanced(const MeshGeometry* mesh,
+												uint8_t subMeshIndex,
+												uint8_t lodLevel,
+												const uint32_t* objectCBIndices,
+												uint32_t instanceCount,
+												uint32_t instanceOffset) noexcept
+{
+	DrawCall drawCall = _state;
+	drawCall._mesh = mesh;
+	drawCall._subMeshIndex = subMeshIndex;
+	drawCall._lodLevel = lodLevel;
+	drawCall._instanceOffset = instanceOffset;
+	drawCall._objectCBIndices.assign(objectCBIndices, objectCBIndices + instanceCount);
+	_drawCalls.push_back(std::move(drawCall));
+}
+
+void RecordingRenderBackend::clear(void) noexcept
+{
+	_state._psoType = std::numeric_limits<uint8_t>::max();
+	_state._stateMesh = nullptr;
+	_state._primitive = std::numeric_limits<uint8_t>::max();
+	_state._skinnedCBIndex = std::numeric_limits<uint16_t>::max();
+	_state._materialCBIndex = std::numeric_limits<uint32_t>::max();
+	_state._mesh = nullptr;
+	_state._subMeshIndex = 0;
+	_state._lodLevel = 0;
+	_state._instanceOffset = 0;
+	_drawCalls.clear();
+	_stateChangeCount = 0;
+}
+
+void RenderQueue::addStatistics(const RenderQueueStatistics& statistics) noexcept
+{
+	_statistics._submitCount += statistics._submitCount;
+	_statistics._packetCount += statistics._packetCount;
+	_statistics._stateChangeCount += statistics._stateChangeCount;
+	_statistics._skippedStateChangeCount += statistics._skippedStateChangeCount;
+	_statistics._drawCallCount += statistics._drawCallCount;
+}
+
+void RenderQueue::logStatistics(const std::string& name) noexcept
+{
+	if (_statistics._submitCount == 0)
+	{
+		return;
+	}
+	const uint64_t totalStateCount = _statistics._stateChangeCount + _statistics._skippedStateChangeCount;
+	const std::string text = "[RenderQueue] " + name + " submit: " + std::to_string(_statistics._submitCount) +
+		" packet/submit: " + std::to_string(static_cast<double>(_statistics._packetCount) / _statistics._submitCount) +
+		" stateChange: " + std::to_string(_statistics._stateChangeCount) + "/" + std::to_string(totalStateCount) +
+		" drawCall: " + std::to_string(_statistics._drawCallCount) + "/" + std::to_string(_statistics._packetCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_statistics = RenderQueueStatistics();
+}
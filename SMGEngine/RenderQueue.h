@@ -0,0 +1,156 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class MeshGeometry;
+
+//   ϳ ׸µ ʿ . _sortKey  ׸.
+struct DrawPacket
+{
+	uint64_t _sortKey;
+	const MeshGeometry* _mesh;
+	// instance world   object constant buffer ȣ
+	uint32_t _objectCBIndex;
+	uint32_t _materialCBIndex;
+	uint16_t _skinnedCBIndex;
+	uint8_t _psoType;
+	uint8_t _primitive;
+	uint8_t _subMeshIndex;
+	uint8_t _lodLevel;
+};
+
+// RenderQueue  packet  API ȣ ٲ۴.   D3DApp Ÿ  ٲ ̴.
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() = default;
+	virtual void setPipelineState(uint8_t psoType) noexcept = 0;
+	// vertex buffer index buffer
+	virtual void setMesh(const MeshGeometry* mesh) noexcept = 0;
+	virtual void setPrimitiveTopology(uint8_t primitive) noexcept = 0;
+	virtual void setSkinnedConstantBuffer(uint16_t skinnedCBIndex) noexcept = 0;
+	virtual void setMaterialConstantBuffer(uint32_t materialCBIndex) noexcept = 0;
+	// instance i objectCBIndices[i] object world ķ ׸.
+	// instanceOffset instance ۿ  draw   ġ, ٸ draw ġ ʴ´.
+	virtual void drawSubMeshInstanced(const MeshGeometry* mesh,
+									uint8_t subMeshIndex,
+									uint8_t lodLevel,
+									const uint32_t* objectCBIndices,
+									uint32_t instanceCount,
+									uint32_t instanceOffset) noexcept = 0;
+};
+
+// API ȣ ʰ ȣ 븸 Ѵ. D3D ġ  ,  , instancing  ȮҶ Ѵ.
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+	// draw ȣ ϳ ׶ Ǿ ִ .   ´ Ÿ ִ밪̴.
+	struct DrawCall
+	{
+		uint8_t _psoType;
+		const MeshGeometry* _stateMesh;
+		uint8_t _primitive;
+		uint16_t _skinnedCBIndex;
+		uint32_t _materialCBIndex;
+
+		const MeshGeometry* _mesh;
+		uint8_t _subMeshIndex;
+		uint8_t _lodLevel;
+		uint32_t _instanceOffset;
+		std::vector<uint32_t> _objectCBIndices;
+	};
+	RecordingRenderBackend(void) noexcept;
+	virtual ~RecordingRenderBackend() = default;
+	virtual void setPipelineState(uint8_t psoType) noexcept override;
+	virtual void setMesh(const MeshGeometry* mesh) noexcept override;
+	virtual void setPrimitiveTopology(uint8_t primitive) noexcept override;
+	virtual void setSkinnedConstantBuffer(uint16_t skinnedCBIndex) noexcept override;
+	virtual void setMaterialConstantBuffer(uint32_t materialCBIndex) noexcept override;
+	virtual void drawSubMeshInstanced(const MeshGeometry* mesh,
+									uint8_t subMeshIndex,
+									uint8_t lodLevel,
+									const uint32_t* objectCBIndices,
+									uint32_t instanceCount,
+									uint32_t instanceOffset) noexcept override;
+	//  command listó  µ .
+	void clear(void) noexcept;
+	const std::vector<DrawCall>& getDrawCalls(void) const noexcept { return _drawCalls; }
+	// draw    ȣ 
+	uint64_t getStateChangeCount(void) const noexcept { return _stateChangeCount; }
+private:
+	DrawCall _state;
+	std::vector<DrawCall> _drawCalls;
+	uint64_t _stateChangeCount;
+};
+
+// ĵ packet [_begin, _end) 
+struct RenderQueueRange
+{
+	uint32_t _begin;
+	uint32_t _end;
+};
+
+//  Ȯο
+struct RenderQueueStatistics
+{
+	uint32_t _submitCount = 0;
+	uint64_t _packetCount = 0;
+	// backend     packet Ƽ   
+	uint64_t _stateChangeCount = 0;
+	uint64_t _skippedStateChangeCount = 0;
+	// instancing   draw ȣ .   _packetCount .
+	uint64_t _drawCallCount = 0;
+};
+
+// ̴   packet Ƽ  Ű radix sort  ٲ ¸ backend Ѵ.
+//   ӵ packet pso, mesh, submesh, lod, material, skinned ȷƮ   draw ѹ ´.
+// skinned ȷƮ instance  Ƿ skinned packet  ʰ packet drawѴ.
+//  packet    ٸ command list ÿ   ִ.
+class RenderQueue
+{
+public:
+	RenderQueue(void) noexcept = default;
+	// layer, pso, mesh, material, submesh, lod,   Ѵ. isBackToFront mesh, material    ׸ lod  ʴ´.
+	// depth [0, 1]  ȭ ī޶ Ÿ
+	static uint64_t makeSortKey(uint8_t layerOrder,
+								uint8_t psoType,
+								const MeshGeometry* mesh,
+								uint32_t materialCBIndex,
+								uint8_t subMeshIndex,
+								uint8_t lodLevel,
+								float depth,
+								bool isBackToFront) noexcept;
+
+	void clear(void) noexcept;
+	void addPacket(const DrawPacket& packet) noexcept;
+	void addPackets(const std::vector<DrawPacket>& packets) noexcept;
+	void sort(void) noexcept;
+	// ִ chunkCount  . instancing ̴ packet  ʴ´.
+	// packet  pass յ    ֵ   ϳ .
+	void split(uint32_t chunkCount, std::vector<RenderQueueRange>& ranges) const noexcept;
+	//  ٸ backend statistics ϸ  忡 ÿ ȣ  ִ.
+	// instance ۴ packet ĭ instanceOffset packet  Ѵ.
+	void submit(RenderBackend& backend,
+				const RenderQueueRange& range,
+				uint32_t instanceOffset,
+				RenderQueueStatistics& statistics) const noexcept;
+	void addStatistics(const RenderQueueStatistics& statistics) noexcept;
+	bool empty(void) const noexcept { return _packets.empty(); }
+	const std::vector<DrawPacket>& getPackets(void) const noexcept { return _packets; }
+
+	const RenderQueueStatistics& getStatistics(void) const noexcept { return _statistics; }
+	void logStatistics(const std::string& name) noexcept;
+private:
+	static constexpr int RADIX_BITS = 8;
+	static constexpr uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+	static constexpr uint32_t DEPTH_MAX = (1 << 16) - 1;
+	static constexpr int LOD_BITS = 2;
+
+	static bool isSameInstanceGroup(const DrawPacket& lhs, const DrawPacket& rhs) noexcept;
+
+	std::vector<DrawPacket> _packets;
+	// radix sort ӽ 
+	std::vector<DrawPacket> _sortBuffer;
+	RenderQueueStatistics _statistics;
+};
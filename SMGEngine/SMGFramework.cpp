@@ -293,8 +293,8 @@ int SMGFramework::Run(void)
 					_uiManager->update();
 					_camera->update();
 					_effectManager->update();
+					// ׸  UI  忡 ѱ ٷ   Ѵ.
 					_d3dApp->Update();
-					_d3dApp->Draw();
 				}
 
 				Sleep(1);
@@ -424,6 +424,10 @@ LRESULT SMGFramework::MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 			{
 				//set4XMsaaState(!_4xMsaaState);
 			}
+			else if (wParam == VK_F5)
+			{
+				getStageManager()->requestBenchmark();
+			}
 			return 0;
 	}
 	return DefWindowProc(hwnd, msg, wParam, lParam);
@@ -2,17 +2,366 @@
 #include "SkinnedData.h"
 #include "FileHelper.h"
 #include "MathHelper.h"
+#include "D3DUtil.h"
+#include <algorithm>
 
 using namespace DirectX;
 
-BoneAnimation::BoneAnimation(std::vector<KeyFrame>&& keyFrames) noexcept
-	: _keyFrames(keyFrames)
+AnimationTrack::AnimationTrack() noexcept
+	: _type(AnimationTrackType::Count)
+	, _rangeMin(0.f, 0.f, 0.f)
+	, _rangeExtent(0.f, 0.f, 0.f)
 {
 }
 
+AnimationTrack::AnimationTrack(AnimationTrackType type, const std::vector<KeyFrame>& keyFrames, float tolerance)
+	: _type(type)
+	, _rangeMin(0.f, 0.f, 0.f)
+	, _rangeExtent(0.f, 0.f, 0.f)
+{
+	check(type != AnimationTrackType::Count);
+	if (keyFrames.empty())
+	{
+		return;
+	}
+	if (std::numeric_limits<uint16_t>::max() < keyFrames.back()._frame)
+	{
+		ThrowErrCode(ErrCode::Overflow, "animation frame uint16  Ѿϴ. " + std::to_string(keyFrames.back()._frame));
+	}
+
+	std::vector<size_t> keyIndices;
+	keyIndices.reserve(keyFrames.size());
+	keyIndices.push_back(0);
+
+	const XMVECTOR firstValue = getKeyValue(type, keyFrames.front());
+	bool isConstant = true;
+	for (size_t i = 1; i < keyFrames.size(); ++i)
+	{
+		if (!isInTolerance(type, firstValue, getKeyValue(type, keyFrames[i]), tolerance))
+		{
+			isConstant = false;
+			break;
+		}
+	}
+
+	if (!isConstant)
+	{
+		//   Ű to   Ű  ȿ   ÷.
+		size_t from = 0;
+		for (size_t to = 2; to < keyFrames.size(); ++to)
+		{
+			if (!canRemoveKeys(type, keyFrames, from, to, tolerance))
+			{
+				from = to - 1;
+				keyIndices.push_back(from);
+			}
+		}
+		keyIndices.push_back(keyFrames.size() - 1);
+	}
+
+	quantize(keyFrames, keyIndices);
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::sample(const TickCount64& currentTick) const noexcept
+{
+	if (_frames.empty())
+	{
+		return getDefaultValue(_type);
+	}
+	if (_frames.size() == 1 || currentTick <= _frames.front() * FRAME_TO_TICKCOUNT)
+	{
+		return decode(0);
+	}
+	if (_frames.back() * FRAME_TO_TICKCOUNT <= currentTick)
+	{
+		return decode(_frames.size() - 1);
+	}
+
+	auto it1 = std::upper_bound(_frames.begin(), _frames.end(), currentTick, [](const TickCount64& tick, const uint16_t frame) {
+		return tick < frame * FRAME_TO_TICKCOUNT; });
+	const size_t index1 = it1 - _frames.begin();
+	const size_t index0 = index1 - 1;
+
+	const TickCount64 tick0 = _frames[index0] * FRAME_TO_TICKCOUNT;
+	const TickCount64 tick1 = _frames[index1] * FRAME_TO_TICKCOUNT;
+	const float lerpPercent = (currentTick - tick0) / static_cast<float>(tick1 - tick0);
+
+	return interpolateValue(_type, decode(index0), decode(index1), lerpPercent);
+}
+
+void AnimationTrack::loadXML(const XMLReaderNode& node, AnimationTrackType type, const uint32_t clipEndFrame)
+{
+	_type = type;
+	if (node.getNodeName() != getTrackName(type))
+	{
+		ThrowErrCode(ErrCode::InvalidAnimationData, "track  ߸Ǿϴ. " + node.getNodeName());
+	}
+
+	std::string hexString;
+	node.loadAttribute("Frames", hexString);
+	D3DUtil::parseHexString(hexString, _frames);
+	node.loadAttribute("Values", hexString);
+	D3DUtil::parseHexString(hexString, _values);
+
+	if (_values.size() != _frames.size() * VALUE_PER_KEY)
+	{
+		ThrowErrCode(ErrCode::InvalidAnimationData, "frame  value   ʽϴ.");
+	}
+	for (size_t i = 0; i < _frames.size(); ++i)
+	{
+		if (i != 0 && _frames[i - 1] >= _frames[i])
+		{
+			ThrowErrCode(ErrCode::InvalidAnimationData, "ð մϴ.");
+		}
+		if (_frames[i] > clipEndFrame)
+		{
+			ThrowErrCode(ErrCode::InvalidAnimationData, "ð  Դϴ. frame: " + std::to_string(_frames[i]));
+		}
+	}
+
+	if (type != AnimationTrackType::Rotation)
+	{
+		node.loadAttribute("RangeMin", _rangeMin);
+		node.loadAttribute("RangeExtent", _rangeExtent);
+	}
+}
+
+std::string AnimationTrack::getTrackName(AnimationTrackType type) noexcept
+{
+	switch (type)
+	{
+		case AnimationTrackType::Translation:
+			return "Translation";
+		case AnimationTrackType::Scaling:
+			return "Scaling";
+		case AnimationTrackType::Rotation:
+			return "Rotation";
+		case AnimationTrackType::Count:
+		default:
+			check(false, "Ÿ ߰ Ȯ");
+			static_assert(static_cast<int>(AnimationTrackType::Count) == 3, "Ÿ ߰ Ȯ");
+			return "";
+	}
+}
+
+size_t AnimationTrack::getMemorySize(void) const noexcept
+{
+	return sizeof(AnimationTrack) + (_frames.size() + _values.size()) * sizeof(uint16_t);
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::getKeyValue(AnimationTrackType type, const KeyFrame& keyFrame) noexcept
+{
+	switch (type)
+	{
+		case AnimationTrackType::Translation:
+			return XMLoadFloat3(&keyFrame._translation);
+		case AnimationTrackType::Scaling:
+			return XMLoadFloat3(&keyFrame._scaling);
+		case AnimationTrackType::Rotation:
+			return XMLoadFloat4(&keyFrame._rotationQuat);
+		case AnimationTrackType::Count:
+		default:
+			check(false, "Ÿ ߰ Ȯ");
+			static_assert(static_cast<int>(AnimationTrackType::Count) == 3, "Ÿ ߰ Ȯ");
+			return XMVectorZero();
+	}
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::getDefaultValue(AnimationTrackType type) noexcept
+{
+	switch (type)
+	{
+		case AnimationTrackType::Translation:
+			return XMVectorZero();
+		case AnimationTrackType::Scaling:
+			return XMVectorSplatOne();
+		case AnimationTrackType::Rotation:
+			return XMQuaternionIdentity();
+		case AnimationTrackType::Count:
+		default:
+			check(false, "Ÿ ߰ Ȯ");
+			static_assert(static_cast<int>(AnimationTrackType::Count) == 3, "Ÿ ߰ Ȯ");
+			return XMVectorZero();
+	}
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::interpolateValue(AnimationTrackType type,
+																DirectX::FXMVECTOR lhs,
+																DirectX::FXMVECTOR rhs,
+																float lerpPercent) noexcept
+{
+	if (type == AnimationTrackType::Rotation)
+	{
+		return XMQuaternionSlerp(lhs, rhs, lerpPercent);
+	}
+	return XMVectorLerp(lhs, rhs, lerpPercent);
+}
+
+bool XM_CALLCONV AnimationTrack::isInTolerance(AnimationTrackType type,
+												DirectX::FXMVECTOR lhs,
+												DirectX::FXMVECTOR rhs,
+												float tolerance) noexcept
+{
+	if (type == AnimationTrackType::Rotation)
+	{
+		// q -q  ȸ̹Ƿ 밪 Ѵ.
+		const float dot = std::abs(XMVectorGetX(XMQuaternionDot(XMQuaternionNormalize(lhs), XMQuaternionNormalize(rhs))));
+		return std::cos(tolerance * 0.5f) <= dot;
+	}
+	return XMVector3NearEqual(lhs, rhs, XMVectorReplicate(tolerance));
+}
+
+bool AnimationTrack::canRemoveKeys(AnimationTrackType type,
+									const std::vector<KeyFrame>& keyFrames,
+									size_t from,
+									size_t to,
+									float tolerance) noexcept
+{
+	check(from < to && to < keyFrames.size());
+	const XMVECTOR fromValue = getKeyValue(type, keyFrames[from]);
+	const XMVECTOR toValue = getKeyValue(type, keyFrames[to]);
+	const float frameLength = static_cast<float>(keyFrames[to]._frame - keyFrames[from]._frame);
+
+	for (size_t i = from + 1; i < to; ++i)
+	{
+		const float lerpPercent = (keyFrames[i]._frame - keyFrames[from]._frame) / frameLength;
+		const XMVECTOR interpolated = interpolateValue(type, fromValue, toValue, lerpPercent);
+		if (!isInTolerance(type, interpolated, getKeyValue(type, keyFrames[i]), tolerance))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void XM_CALLCONV AnimationTrack::encodeQuaternion(DirectX::FXMVECTOR quaternion, uint16_t* outValues) noexcept
+{
+	XMFLOAT4 normalized;
+	XMStoreFloat4(&normalized, XMQuaternionNormalize(quaternion));
+	const float components[4] = { normalized.x, normalized.y, normalized.z, normalized.w };
+
+	int largestIndex = 0;
+	for (int i = 1; i < 4; ++i)
+	{
+		if (std::abs(components[largestIndex]) < std::abs(components[i]))
+		{
+			largestIndex = i;
+		}
+	}
+	//  ū   ǵ ȣ ߸      ִ.
+	const float sign = components[largestIndex] < 0.f ? -1.f : 1.f;
+
+	// [largestIndex 2bit][component 15bit x 3]
+	uint64_t packed = largestIndex;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (i == largestIndex)
+		{
+			continue;
+		}
+		const float normalizedComponent = (components[i] * sign * DirectX::XM_SQRT2 + 1.f) * 0.5f;
+		const uint64_t quantized = static_cast<uint64_t>(std::clamp(std::round(normalizedComponent * 0x7FFF), 0.f, static_cast<float>(0x7FFF)));
+		packed = (packed << 15) | quantized;
+	}
+
+	outValues[0] = static_cast<uint16_t>((packed >> 32) & 0xFFFF);
+	outValues[1] = static_cast<uint16_t>((packed >> 16) & 0xFFFF);
+	outValues[2] = static_cast<uint16_t>(packed & 0xFFFF);
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::decodeQuaternion(const uint16_t* values) noexcept
+{
+	uint64_t packed = (static_cast<uint64_t>(values[0]) << 32) | (static_cast<uint64_t>(values[1]) << 16) | values[2];
+	const int largestIndex = static_cast<int>((packed >> 45) & 0x3);
+
+	float components[4];
+	float lengthSq = 0.f;
+	for (int i = 3; i >= 0; --i)
+	{
+		if (i == largestIndex)
+		{
+			continue;
+		}
+		const float normalizedComponent = (packed & 0x7FFF) / static_cast<float>(0x7FFF);
+		packed >>= 15;
+		components[i] = (normalizedComponent * 2.f - 1.f) * (1.f / DirectX::XM_SQRT2);
+		lengthSq += components[i] * components[i];
+	}
+	components[largestIndex] = std::sqrt(std::max(0.f, 1.f - lengthSq));
+
+	return XMVectorSet(components[0], components[1], components[2], components[3]);
+}
+
+void AnimationTrack::quantize(const std::vector<KeyFrame>& keyFrames, const std::vector<size_t>& keyIndices) noexcept
+{
+	_frames.reserve(keyIndices.size());
+	_values.resize(keyIndices.size() * VALUE_PER_KEY);
+	for (const auto& index : keyIndices)
+	{
+		_frames.push_back(static_cast<uint16_t>(keyFrames[index]._frame));
+	}
+
+	if (_type == AnimationTrackType::Rotation)
+	{
+		for (size_t i = 0; i < keyIndices.size(); ++i)
+		{
+			encodeQuaternion(getKeyValue(_type, keyFrames[keyIndices[i]]), &_values[i * VALUE_PER_KEY]);
+		}
+		return;
+	}
+
+	XMVECTOR rangeMin = getKeyValue(_type, keyFrames[keyIndices.front()]);
+	XMVECTOR rangeMax = rangeMin;
+	for (const auto& index : keyIndices)
+	{
+		const XMVECTOR value = getKeyValue(_type, keyFrames[index]);
+		rangeMin = XMVectorMin(rangeMin, value);
+		rangeMax = XMVectorMax(rangeMax, value);
+	}
+	XMStoreFloat3(&_rangeMin, rangeMin);
+	XMStoreFloat3(&_rangeExtent, XMVectorSubtract(rangeMax, rangeMin));
+
+	const float extents[VALUE_PER_KEY] = { _rangeExtent.x, _rangeExtent.y, _rangeExtent.z };
+	for (size_t i = 0; i < keyIndices.size(); ++i)
+	{
+		XMFLOAT3 offset;
+		XMStoreFloat3(&offset, XMVectorSubtract(getKeyValue(_type, keyFrames[keyIndices[i]]), rangeMin));
+		const float offsets[VALUE_PER_KEY] = { offset.x, offset.y, offset.z };
+		for (int c = 0; c < VALUE_PER_KEY; ++c)
+		{
+			const float normalized = (extents[c] > 0.f) ? (offsets[c] / extents[c]) : 0.f;
+			_values[i * VALUE_PER_KEY + c] = static_cast<uint16_t>(std::clamp(std::round(normalized * 0xFFFF), 0.f, static_cast<float>(0xFFFF)));
+		}
+	}
+}
+
+DirectX::XMVECTOR XM_CALLCONV AnimationTrack::decode(size_t keyIndex) const noexcept
+{
+	check(keyIndex < _frames.size());
+	const uint16_t* values = &_values[keyIndex * VALUE_PER_KEY];
+	if (_type == AnimationTrackType::Rotation)
+	{
+		return decodeQuaternion(values);
+	}
+
+	const XMVECTOR quantized = XMVectorSet(values[0], values[1], values[2], 0.f);
+	const XMVECTOR scale = XMVectorScale(XMLoadFloat3(&_rangeExtent), 1.f / 0xFFFF);
+	return XMVectorMultiplyAdd(quantized, scale, XMLoadFloat3(&_rangeMin));
+}
+
+BoneAnimation::BoneAnimation(const std::vector<KeyFrame>& keyFrames)
+{
+	_tracks[static_cast<int>(AnimationTrackType::Translation)] =
+		AnimationTrack(AnimationTrackType::Translation, keyFrames, ANIMATION_TRANSLATION_TOLERANCE);
+	_tracks[static_cast<int>(AnimationTrackType::Scaling)] =
+		AnimationTrack(AnimationTrackType::Scaling, keyFrames, ANIMATION_SCALING_TOLERANCE);
+	_tracks[static_cast<int>(AnimationTrackType::Rotation)] =
+		AnimationTrack(AnimationTrackType::Rotation, keyFrames, ANIMATION_ROTATION_TOLERANCE);
+	static_assert(static_cast<int>(AnimationTrackType::Count) == 3, "Ÿ ߰ Ȯ");
+}
+
 DirectX::XMMATRIX BoneAnimation::interpolate(const TickCount64& currentTick) const noexcept
 {
-	check(!_keyFrames.empty(), "keyFrame ϴ.");
 	const XMVECTOR zero = XMVectorSet(0.f, 0.f, 0.f, 1.f);
 
 	XMVECTOR S, P, Q;
@@ -25,7 +374,6 @@ DirectX::XMMATRIX BoneAnimation::interpolateWithBlend(const TickCount64& current
 													const TickCount64& blendTick,
 													const BoneAnimationBlendInstance& blendInstance) const noexcept
 {
-	check(!_keyFrames.empty(), "keyFrame ϴ.");
 	check(currentTick < blendTick);
 	float blendLerpPecent = 1 - (currentTick / static_cast<float>(blendTick));
 
@@ -48,68 +396,70 @@ DirectX::XMMATRIX BoneAnimation::interpolateWithBlend(const TickCount64& current
 void BoneAnimation::interpolateXXX(const TickCount64& currentTick, DirectX::XMVECTOR& S, DirectX::XMVECTOR& P, DirectX::XMVECTOR& Q) const noexcept
 {
 	check(currentTick < std::numeric_limits<uint32_t>::max());
-	if (currentTick <= _keyFrames.front()._tick)
-	{
-		S = XMLoadFloat3(&_keyFrames.back()._scaling);
-		P = XMLoadFloat3(&_keyFrames.back()._translation);
-		Q = XMLoadFloat4(&_keyFrames.back()._rotationQuat);
-	}
-	else if (currentTick >= _keyFrames.back()._tick)
-	{
-		S = XMLoadFloat3(&_keyFrames.back()._scaling);
-		P = XMLoadFloat3(&_keyFrames.back()._translation);
-		Q = XMLoadFloat4(&_keyFrames.back()._rotationQuat);
-	}
-	else
-	{
-		auto it1 = lower_bound(_keyFrames.begin(), _keyFrames.end(), static_cast<uint32_t>(currentTick), [](const KeyFrame& itor, const uint32_t& t) {
-			return itor._tick < t; });
-		auto it0 = prev(it1);
-
-		float lerpPercent = (currentTick - it0->_tick) / static_cast<float>(it1->_tick - it0->_tick);
-
-		XMVECTOR s0 = XMLoadFloat3(&it0->_scaling);
-		XMVECTOR s1 = XMLoadFloat3(&it1->_scaling);
-
-		XMVECTOR p0 = XMLoadFloat3(&it0->_translation);
-		XMVECTOR p1 = XMLoadFloat3(&it1->_translation);
-
-		XMVECTOR q0 = XMLoadFloat4(&it0->_rotationQuat);
-		XMVECTOR q1 = XMLoadFloat4(&it1->_rotationQuat);
 
-		S = XMVectorLerp(s0, s1, lerpPercent);
-		P = XMVectorLerp(p0, p1, lerpPercent);
-		Q = XMQuaternionSlerp(q0, q1, lerpPercent);
-	}
+	S = getTrack(AnimationTrackType::Scaling).sample(currentTick);
+	P = getTrack(AnimationTrackType::Translation).sample(currentTick);
+	Q = getTrack(AnimationTrackType::Rotation).sample(currentTick);
 }
 
 void BoneAnimation::loadXML(const XMLReaderNode& node, const uint32_t start, const uint32_t end)
 {
 	const auto& childNodes = node.getChildNodes();
 
-	_keyFrames.resize(childNodes.size());
+	if (!childNodes.empty() && childNodes.front().getNodeName() != "KeyFrame")
+	{
+		// Ϳ  
+		if (childNodes.size() != _tracks.size())
+		{
+			ThrowErrCode(ErrCode::InvalidAnimationData, "track   ʽϴ. " + std::to_string(childNodes.size()));
+		}
+		for (int i = 0; i < childNodes.size(); ++i)
+		{
+			_tracks[i].loadXML(childNodes[i], static_cast<AnimationTrackType>(i), end - start);
+		}
+		return;
+	}
+
+	//     εϸ鼭 Ѵ.
+	std::vector<KeyFrame> keyFrames(childNodes.size());
 	for (int i = 0; i < childNodes.size(); ++i)
 	{
 		uint32_t frame = 0;
 		childNodes[i].loadAttribute("Frame", frame);
-		_keyFrames[i]._tick = (frame - start) * FRAME_TO_TICKCOUNT;
-		if (i != 0 && _keyFrames[i - 1]._tick >= _keyFrames[i]._tick)
-		{
-			ThrowErrCode(ErrCode::InvalidAnimationData, "ð մϴ.");
-		}
 		if (frame > end || frame < start)
 		{
 			ThrowErrCode(ErrCode::InvalidAnimationData, "ð  Դϴ. frame: " + std::to_string(frame));
 		}
-		childNodes[i].loadAttribute("Translation", _keyFrames[i]._translation);
-		childNodes[i].loadAttribute("Scaling", _keyFrames[i]._scaling);
-		childNodes[i].loadAttribute("RotationQuat", _keyFrames[i]._rotationQuat);
+		keyFrames[i]._frame = frame - start;
+		if (i != 0 && keyFrames[i - 1]._frame >= keyFrames[i]._frame)
+		{
+			ThrowErrCode(ErrCode::InvalidAnimationData, "ð մϴ.");
+		}
+		childNodes[i].loadAttribute("Translation", keyFrames[i]._translation);
+		childNodes[i].loadAttribute("Scaling", keyFrames[i]._scaling);
+		childNodes[i].loadAttribute("RotationQuat", keyFrames[i]._rotationQuat);
 	}
+	*this = BoneAnimation(keyFrames);
 }
 
-const std::vector<KeyFrame>& BoneAnimation::getKeyFrameReferenceXXX(void) const noexcept
+size_t BoneAnimation::getKeyCount(void) const noexcept
 {
-	return _keyFrames;
+	size_t keyCount = 0;
+	for (const auto& track : _tracks)
+	{
+		keyCount += track.getKeyCount();
+	}
+	return keyCount;
+}
+
+size_t BoneAnimation::getMemorySize(void) const noexcept
+{
+	size_t memorySize = 0;
+	for (const auto& track : _tracks)
+	{
+		memorySize += track.getMemorySize();
+	}
+	return memorySize;
 }
 
 void BoneInfo::getFinalTransforms(const std::vector<DirectX::XMMATRIX>& toParentTransforms,
@@ -227,6 +577,16 @@ const std::vector<BoneAnimation>& AnimationClip::getBoneAnimationXXX(void) const
 	return _boneAnimations;
 }
 
+size_t AnimationClip::getMemorySize(void) const noexcept
+{
+	size_t memorySize = sizeof(AnimationClip);
+	for (const auto& boneAnimation : _boneAnimations)
+	{
+		memorySize += boneAnimation.getMemorySize();
+	}
+	return memorySize;
+}
+
 void AnimationClip::getBlendValue(const TickCount64& currentTick, std::vector<BoneAnimationBlendInstance>& blendInstances) const noexcept
 {
 	blendInstances.clear();
@@ -240,7 +600,7 @@ void AnimationClip::getBlendValue(const TickCount64& currentTick, std::vector<Bo
 }
 
 KeyFrame::KeyFrame() noexcept
-	: _tick(0)
+	: _frame(0)
 	, _translation(0.f, 0.f, 0.f)
 	, _scaling(0.f, 0.f, 0.f)
 	, _rotationQuat(0.f, 0.f, 0.f, 0.f)
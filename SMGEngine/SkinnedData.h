@@ -3,11 +3,17 @@
 #include "TypeCommon.h"
 
 class XMLReaderNode;
+
+// Ű   . Ϳ   xml ε   Ѵ.
+static constexpr float ANIMATION_TRANSLATION_TOLERANCE = 0.01f;
+static constexpr float ANIMATION_SCALING_TOLERANCE = 0.001f;
+static constexpr float ANIMATION_ROTATION_TOLERANCE = 0.001f; // radian
+
 struct KeyFrame
 {
 	KeyFrame() noexcept;
 
-	uint32_t _tick;
+	uint32_t _frame;
 	DirectX::XMFLOAT3 _translation;
 	DirectX::XMFLOAT3 _scaling;
 	DirectX::XMFLOAT4 _rotationQuat;
@@ -21,6 +27,70 @@ struct BoneAnimationBlendInstance
 	DirectX::XMFLOAT4 _rotationQuat;
 };
 
+enum class AnimationTrackType : uint8_t
+{
+	Translation,
+	Scaling,
+	Rotation,
+
+	Count,
+};
+
+// bone ϳ ä(translation, scaling, rotation) Ű .
+//   ä Ű ϳ ,    ȿ Ǵ Ű Ѵ.
+// translation, scaling ä   16bit, rotation smallest-three 48bit ȭؼ ִ´.
+class AnimationTrack
+{
+public:
+	AnimationTrack() noexcept;
+	AnimationTrack(AnimationTrackType type, const std::vector<KeyFrame>& keyFrames, float tolerance);
+
+	DirectX::XMVECTOR XM_CALLCONV sample(const TickCount64& currentTick) const noexcept;
+	void loadXML(const XMLReaderNode& node, AnimationTrackType type, const uint32_t clipEndFrame);
+
+	static std::string getTrackName(AnimationTrackType type) noexcept;
+	AnimationTrackType getType(void) const noexcept { return _type; }
+	size_t getKeyCount(void) const noexcept { return _frames.size(); }
+	size_t getMemorySize(void) const noexcept;
+
+	// fbxLoader xml   
+	const std::vector<uint16_t>& getFramesXXX(void) const noexcept { return _frames; }
+	const std::vector<uint16_t>& getValuesXXX(void) const noexcept { return _values; }
+	const DirectX::XMFLOAT3& getRangeMinXXX(void) const noexcept { return _rangeMin; }
+	const DirectX::XMFLOAT3& getRangeExtentXXX(void) const noexcept { return _rangeExtent; }
+private:
+	static constexpr int VALUE_PER_KEY = 3;
+
+	static DirectX::XMVECTOR XM_CALLCONV getKeyValue(AnimationTrackType type, const KeyFrame& keyFrame) noexcept;
+	static DirectX::XMVECTOR XM_CALLCONV getDefaultValue(AnimationTrackType type) noexcept;
+	static DirectX::XMVECTOR XM_CALLCONV interpolateValue(AnimationTrackType type,
+														DirectX::FXMVECTOR lhs,
+														DirectX::FXMVECTOR rhs,
+														float lerpPercent) noexcept;
+	static bool XM_CALLCONV isInTolerance(AnimationTrackType type,
+										DirectX::FXMVECTOR lhs,
+										DirectX::FXMVECTOR rhs,
+										float tolerance) noexcept;
+	static bool canRemoveKeys(AnimationTrackType type,
+							const std::vector<KeyFrame>& keyFrames,
+							size_t from,
+							size_t to,
+							float tolerance) noexcept;
+
+	static void XM_CALLCONV encodeQuaternion(DirectX::FXMVECTOR quaternion, uint16_t* outValues) noexcept;
+	static DirectX::XMVECTOR XM_CALLCONV decodeQuaternion(const uint16_t* values) noexcept;
+
+	void quantize(const std::vector<KeyFrame>& keyFrames, const std::vector<size_t>& keyIndices) noexcept;
+	DirectX::XMVECTOR XM_CALLCONV decode(size_t keyIndex) const noexcept;
+
+	AnimationTrackType _type;
+	std::vector<uint16_t> _frames;
+	// Ű VALUE_PER_KEY
+	std::vector<uint16_t> _values;
+	DirectX::XMFLOAT3 _rangeMin;
+	DirectX::XMFLOAT3 _rangeExtent;
+};
+
 class BoneAnimation
 {
 public:
@@ -31,7 +101,8 @@ public:
 	BoneAnimation(const BoneAnimation&) = delete;
 	BoneAnimation& operator=(const BoneAnimation&) = delete;
 
-	BoneAnimation(std::vector<KeyFrame>&& keyFrames) noexcept;
+	// keyFrame _frame clip  ̾ Ѵ.
+	BoneAnimation(const std::vector<KeyFrame>& keyFrames);
 
 	DirectX::XMMATRIX interpolate(const TickCount64& currentTick) const noexcept;
 	DirectX::XMMATRIX interpolateWithBlend(const TickCount64& currentTick,
@@ -42,11 +113,11 @@ public:
 
 	void loadXML(const XMLReaderNode& rootNode, const uint32_t start, const uint32_t end);
 
-	// fbxLoader  ߴµ ٸ  ã ڴ. [1/26/2021 qwerw]
-	const std::vector<KeyFrame>& getKeyFrameReferenceXXX(void) const noexcept;
-	
+	const AnimationTrack& getTrack(AnimationTrackType type) const noexcept { return _tracks[static_cast<int>(type)]; }
+	size_t getKeyCount(void) const noexcept;
+	size_t getMemorySize(void) const noexcept;
 private:
-	std::vector<KeyFrame> _keyFrames;
+	std::array<AnimationTrack, static_cast<int>(AnimationTrackType::Count)> _tracks;
 };
 
 class AnimationClip
@@ -74,6 +145,7 @@ public:
 	// fbxLoader  ߴµ ٸ  ã ڴ. [1/26/2021 qwerw]
 	const std::vector<BoneAnimation>& getBoneAnimationXXX(void) const noexcept;
 	void getBlendValue(const TickCount64& currentTick, std::vector<BoneAnimationBlendInstance>& blendInstances) const noexcept;
+	size_t getMemorySize(void) const noexcept;
 private:
 	std::vector<BoneAnimation> _boneAnimations;
 	uint32_t _clipEndFrame;
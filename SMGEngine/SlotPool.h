@@ -0,0 +1,164 @@
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+#include <cstddef>
+
+// pool ۿ ü   Ѵ. ü  generation ޶ get nullptr ȯѴ.
+// slot   ݴ ǹǷ ͷ  ٸ ü Ű ȴ.
+struct SlotHandle
+{
+	static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	uint32_t _index = INVALID_INDEX;
+	uint32_t _generation = 0;
+
+	bool isValid(void) const noexcept { return _index != INVALID_INDEX; }
+	bool operator==(const SlotHandle& rhs) const noexcept { return _index == rhs._index && _generation == rhs._generation; }
+	bool operator!=(const SlotHandle& rhs) const noexcept { return !(*this == rhs); }
+};
+
+// /  ü pool.
+// ü chunk  Ҵ slot ǹǷ ּҰ ٲ ʰ,  slot free list Ѵ.
+// ִ ü dense 迭  ־ ȸ  ְ,  swap & pop O(1)̴.
+//  dense 迭  ٲǷ  ϸ ȵȴ.
+template<typename T>
+class SlotPool
+{
+public:
+	SlotPool(void) noexcept = default;
+	SlotPool(const SlotPool&) = delete;
+	SlotPool& operator=(const SlotPool&) = delete;
+	~SlotPool(void)
+	{
+		clear();
+	}
+
+	template<typename... Args>
+	T* create(Args&&... args)
+	{
+		uint32_t index;
+		if (_freeIndices.empty())
+		{
+			index = static_cast<uint32_t>(_slotCount);
+			if (_slotCount % CHUNK_SIZE == 0)
+			{
+				_chunks.emplace_back(std::make_unique<Slot[]>(CHUNK_SIZE));
+			}
+			++_slotCount;
+		}
+		else
+		{
+			index = _freeIndices.back();
+			_freeIndices.pop_back();
+		}
+
+		Slot& slot = getSlot(index);
+		check(!slot._isAlive);
+		try
+		{
+			new (slot._storage) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_freeIndices.push_back(index);
+			throw;
+		}
+		slot._isAlive = true;
+		slot._index = index;
+		slot._denseIndex = static_cast<uint32_t>(_dense.size());
+		T* object = slot.get();
+		_dense.push_back(object);
+		return object;
+	}
+
+	void destroy(const T* object) noexcept
+	{
+		check(object != nullptr);
+		Slot* slot = toSlot(object);
+		check(slot->_isAlive, "̹  üԴϴ.");
+		check(_dense[slot->_denseIndex] == object, "pool  ü ƴմϴ.");
+
+		const uint32_t denseIndex = slot->_denseIndex;
+		if (denseIndex != _dense.size() - 1)
+		{
+			_dense[denseIndex] = _dense.back();
+			toSlot(_dense[denseIndex])->_denseIndex = denseIndex;
+		}
+		_dense.pop_back();
+
+		// Ҹ ȿ  pool ٸ ü  ǵ ¸  Ѵ.
+		slot->_isAlive = false;
+		++slot->_generation;
+		_freeIndices.push_back(slot->_index);
+		slot->get()->~T();
+	}
+
+	SlotHandle getHandle(const T* object) const noexcept
+	{
+		check(object != nullptr);
+		const Slot* slot = toSlot(object);
+		check(slot->_isAlive);
+		return SlotHandle{ slot->_index, slot->_generation };
+	}
+
+	//  ü handle̸  slot ٸ ü  ־ nullptr ȯѴ.
+	T* get(const SlotHandle& handle) const noexcept
+	{
+		if (!handle.isValid() || _slotCount <= handle._index)
+		{
+			return nullptr;
+		}
+		Slot& slot = getSlot(handle._index);
+		if (!slot._isAlive || slot._generation != handle._generation)
+		{
+			return nullptr;
+		}
+		return slot.get();
+	}
+
+	// Ҵ chunk ϰ ü .   Ѵ.
+	void clear(void) noexcept
+	{
+		while (!_dense.empty())
+		{
+			destroy(_dense.back());
+		}
+	}
+
+	size_t size(void) const noexcept { return _dense.size(); }
+	bool empty(void) const noexcept { return _dense.empty(); }
+	size_t getCapacity(void) const noexcept { return _chunks.size() * CHUNK_SIZE; }
+
+	T* operator[](size_t denseIndex) const noexcept { return _dense[denseIndex]; }
+	typename std::vector<T*>::const_iterator begin(void) const noexcept { return _dense.begin(); }
+	typename std::vector<T*>::const_iterator end(void) const noexcept { return _dense.end(); }
+private:
+	static constexpr size_t CHUNK_SIZE = 64;
+
+	struct Slot
+	{
+		// toSlot ü ּҸ slot ּҷ ٲٹǷ ù°  Ѵ.
+		alignas(T) unsigned char _storage[sizeof(T)];
+		uint32_t _index = 0;
+		uint32_t _generation = 0;
+		uint32_t _denseIndex = 0;
+		bool _isAlive = false;
+
+		T* get(void) noexcept { return reinterpret_cast<T*>(_storage); }
+	};
+
+	Slot& getSlot(uint32_t index) const noexcept
+	{
+		return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	}
+	static Slot* toSlot(const T* object) noexcept
+	{
+		static_assert(offsetof(Slot, _storage) == 0, "storage ù°  մϴ.");
+		return reinterpret_cast<Slot*>(const_cast<T*>(object));
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> _chunks;
+	size_t _slotCount = 0;
+	std::vector<uint32_t> _freeIndices;
+	std::vector<T*> _dense;
+};
@@ -0,0 +1,176 @@
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+
+// (߽, ) ǥǴ  δ AABB Ʈ.  εҶ ѹ  ߿ ȸ Ѵ.
+// gravity point, auto camera pointó ġ ϳ   ȿ ִ ã Ѵ.
+template<typename T>
+class SphereAABBTree
+{
+public:
+	SphereAABBTree(void) noexcept = default;
+
+	void addSphere(const DirectX::XMFLOAT3& center, float radius, const T* data)
+	{
+		check(_nodes.empty(), "build Ŀ ߰  ϴ.");
+		_spheres.push_back({ center, radius, data });
+	}
+
+	void build(void)
+	{
+		_nodes.clear();
+		if (_spheres.empty())
+		{
+			return;
+		}
+		if (std::numeric_limits<uint16_t>::max() <= _spheres.size())
+		{
+			ThrowErrCode(ErrCode::Overflow, "sphere  : " + std::to_string(_spheres.size()));
+		}
+		_nodes.reserve(_spheres.size() * 2 / LEAF_SIZE + 1);
+		buildXXX(0, static_cast<int>(_spheres.size()));
+	}
+
+	void clear(void) noexcept
+	{
+		_spheres.clear();
+		_nodes.clear();
+	}
+
+	// position  + margin ̳ ִ   outData ߰Ѵ.
+	void query(const DirectX::XMFLOAT3& position, float margin, std::vector<const T*>& outData) const noexcept
+	{
+		if (_nodes.empty())
+		{
+			return;
+		}
+		queryXXX(0, position, margin, outData);
+	}
+private:
+	static constexpr int LEAF_SIZE = 4;
+
+	struct Sphere
+	{
+		DirectX::XMFLOAT3 _center;
+		float _radius;
+		const T* _data;
+	};
+
+	// leaf [_begin, _begin + _count)   .   _count 0
+	struct Node
+	{
+		DirectX::XMFLOAT3 _min;
+		DirectX::XMFLOAT3 _max;
+		std::array<uint16_t, 2> _children;
+		uint16_t _begin;
+		uint16_t _count;
+	};
+
+	uint16_t buildXXX(int begin, int end)
+	{
+		using namespace DirectX;
+		check(begin < end);
+		check(end <= _spheres.size());
+
+		// ڽĺ  ־ Ʈ 0 ǵ Ѵ.
+		const uint16_t nodeIndex = static_cast<uint16_t>(_nodes.size());
+		_nodes.emplace_back();
+
+		XMVECTOR min = XMVectorReplicate(std::numeric_limits<float>::max());
+		XMVECTOR max = -min;
+		XMVECTOR centerMin = min;
+		XMVECTOR centerMax = max;
+		for (int i = begin; i < end; ++i)
+		{
+			XMVECTOR center = XMLoadFloat3(&_spheres[i]._center);
+			XMVECTOR radius = XMVectorReplicate(_spheres[i]._radius);
+			min = XMVectorMin(min, center - radius);
+			max = XMVectorMax(max, center + radius);
+			centerMin = XMVectorMin(centerMin, center);
+			centerMax = XMVectorMax(centerMax, center);
+		}
+
+		Node node;
+		XMStoreFloat3(&node._min, min);
+		XMStoreFloat3(&node._max, max);
+		if (end - begin <= LEAF_SIZE)
+		{
+			node._children = { std::numeric_limits<uint16_t>::max(), std::numeric_limits<uint16_t>::max() };
+			node._begin = static_cast<uint16_t>(begin);
+			node._count = static_cast<uint16_t>(end - begin);
+		}
+		else
+		{
+			// ߽  а   ߾Ӱ .
+			XMFLOAT3 centerRange;
+			XMStoreFloat3(&centerRange, centerMax - centerMin);
+			int axis = 0;
+			if (centerRange.y > centerRange.x && centerRange.y > centerRange.z)
+			{
+				axis = 1;
+			}
+			else if (centerRange.z > centerRange.x)
+			{
+				axis = 2;
+			}
+			auto getAxisValue = [axis](const Sphere& sphere)
+			{
+				return (axis == 0) ? sphere._center.x :
+					(axis == 1) ? sphere._center.y : sphere._center.z;
+			};
+
+			const int mid = (begin + end) / 2;
+			std::nth_element(_spheres.begin() + begin,
+				_spheres.begin() + mid,
+				_spheres.begin() + end,
+				[&getAxisValue](const Sphere& lhs, const Sphere& rhs)
+				{
+					return getAxisValue(lhs) < getAxisValue(rhs);
+				});
+
+			node._begin = 0;
+			node._count = 0;
+			node._children[0] = buildXXX(begin, mid);
+			node._children[1] = buildXXX(mid, end);
+		}
+		_nodes[nodeIndex] = node;
+		return nodeIndex;
+	}
+
+	void queryXXX(int nodeIndex, const DirectX::XMFLOAT3& position, float margin, std::vector<const T*>& outData) const noexcept
+	{
+		check(0 <= nodeIndex && nodeIndex < _nodes.size());
+
+		const Node& node = _nodes[nodeIndex];
+		if (position.x < node._min.x - margin || node._max.x + margin < position.x ||
+			position.y < node._min.y - margin || node._max.y + margin < position.y ||
+			position.z < node._min.z - margin || node._max.z + margin < position.z)
+		{
+			return;
+		}
+
+		if (node._count != 0)
+		{
+			for (int i = node._begin; i < node._begin + node._count; ++i)
+			{
+				const Sphere& sphere = _spheres[i];
+				const float dx = sphere._center.x - position.x;
+				const float dy = sphere._center.y - position.y;
+				const float dz = sphere._center.z - position.z;
+				const float range = sphere._radius + margin;
+				if (dx * dx + dy * dy + dz * dz <= range * range)
+				{
+					outData.push_back(sphere._data);
+				}
+			}
+			return;
+		}
+
+		queryXXX(node._children[0], position, margin, outData);
+		queryXXX(node._children[1], position, margin, outData);
+	}
+private:
+	// build Ŀ Ʈ leaf  ĵǾ ִ.
+	std::vector<Sphere> _spheres;
+	std::vector<Node> _nodes;
+};
@@ -0,0 +1,294 @@
+#include "stdafx.h"
+#include "StageBenchmark.h"
+#include "StageManager.h"
+#include "SMGFramework.h"
+#include "D3DApp.h"
+#include "Actor.h"
+#include "CharacterInfoManager.h"
+#include "ObjectInfo.h"
+#include "ActionChart.h"
+#include "FrameEvent.h"
+#include "FileHelper.h"
+#include "Terrain.h"
+#include "MathHelper.h"
+#include "Exception.h"
+#include <chrono>
+#include <algorithm>
+
+void StageBenchmark::run(StageManager& stageManager)
+{
+	if (stageManager.getPlayerActor() == nullptr)
+	{
+		OutputDebugStringA("[Benchmark] ÷̾   ʽϴ.\n");
+		return;
+	}
+
+	std::vector<Actor*> actors;
+	spawnStorm(stageManager, actors);
+	evaluateConditions(actors);
+	processFrameEvents(actors);
+	killActors(stageManager, actors);
+	deformTerrains(stageManager);
+}
+
+void StageBenchmark::spawnStorm(StageManager& stageManager, std::vector<Actor*>& outActors)
+{
+	using Clock = std::chrono::steady_clock;
+	const Actor* playerActor = stageManager.getPlayerActor();
+	SpawnInfo spawnInfo(playerActor->getPosition(),
+		playerActor->getDirection(),
+		playerActor->getUpVector(),
+		StageManager::STAR_SHOOT_SIZE,
+		StageManager::STAR_SHOOT_CHARACTER_KEY,
+		StageManager::STAR_SHOOT_ACTION_INDEX);
+
+	const CharacterInfo* characterInfo = SMGFramework::getCharacterInfoManager()->getInfo(StageManager::STAR_SHOOT_CHARACTER_KEY);
+	check(characterInfo != nullptr);
+	const std::string& objectFileName = characterInfo->getObjectFileName();
+
+	outActors.reserve(ACTOR_COUNT);
+	D3DApp* d3dApp = SMGFramework::getD3DApp();
+	d3dApp->prepareCommandQueue();
+	//      ־ ĳð  θ 絵 Ź ø . mesh material  ĳõǾ ִ.
+	int64_t uncachedMicroSecond = 0;
+	for (int i = 0; i < UNCACHED_SPAWN_COUNT; ++i)
+	{
+		d3dApp->evictObjectTemplate(objectFileName);
+		const auto start = Clock::now();
+		outActors.push_back(stageManager.spawnActor(spawnInfo));
+		uncachedMicroSecond += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+	}
+	const auto cachedStart = Clock::now();
+	for (int i = UNCACHED_SPAWN_COUNT; i < ACTOR_COUNT; ++i)
+	{
+		outActors.push_back(stageManager.spawnActor(spawnInfo));
+	}
+	const int64_t cachedMicroSecond = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - cachedStart).count();
+	d3dApp->executeCommandQueue();
+
+	const std::string text = "[Benchmark] spawnStorm: " + std::to_string(ACTOR_COUNT) +
+		" uncached: " + std::to_string(static_cast<double>(uncachedMicroSecond) / UNCACHED_SPAWN_COUNT) + "us" +
+		" cached: " + std::to_string(static_cast<double>(cachedMicroSecond) / (ACTOR_COUNT - UNCACHED_SPAWN_COUNT)) + "us\n";
+	OutputDebugStringA(text.c_str());
+}
+
+void StageBenchmark::evaluateConditions(const std::vector<Actor*>& actors)
+{
+	XMLReader xmlReader;
+	xmlReader.loadXMLString(makeConditionChartXML());
+	const ActionChart actionChart(xmlReader.getRootNode());
+
+	int64_t microSeconds[2] = { 0, 0 };
+	for (int useSkipMask = 0; useSkipMask < 2; ++useSkipMask)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int s = 0; s < CONDITION_STATE_COUNT; ++s)
+		{
+			const ActionState* actionState = actionChart.getActionState(NameTable::getNameId("BENCHMARK_" + std::to_string(s)));
+			check(actionState != nullptr);
+			for (const auto& actor : actors)
+			{
+				actor->setSkippedBranchMask(0);
+			}
+			for (int f = 0; f < CONDITION_FRAME_COUNT; ++f)
+			{
+				for (const auto& actor : actors)
+				{
+					if (useSkipMask == 0)
+					{
+						actor->setSkippedBranchMask(0);
+					}
+					NameId nextState;
+					if (actionState->checkBranch(*actor, nextState))
+					{
+						check(false, "ġũ branch  ؾ մϴ.");
+					}
+				}
+			}
+		}
+		microSeconds[useSkipMask] = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+
+	const std::string text = "[Benchmark] condition: " + std::to_string(CONDITION_STATE_COUNT) + "x" +
+		std::to_string(CONDITION_BRANCH_COUNT) + "x" + std::to_string(actors.size()) +
+		" frame: " + std::to_string(CONDITION_FRAME_COUNT) +
+		" full: " + std::to_string(microSeconds[0]) + "us" +
+		" skipMask: " + std::to_string(microSeconds[1]) + "us\n";
+	OutputDebugStringA(text.c_str());
+}
+
+std::string StageBenchmark::makeConditionChartXML(void)
+{
+	// ӵ  ƴ϶ CheckSpeed_-2000_-1000 ׻ ϹǷ  branch ¸ ٲ ʴ´.
+	//  Է ǿ ϴ branch Ź ؾ ϴ branch ´.
+	static const char* branchConditions[] =
+	{
+		"ActionIndex_-1 CheckPlayerDistance_0_100 CheckSpeed_-2000_-1000",
+		"CharacterType_Player Random_50 CheckSpeed_-2000_-1000",
+		"HasPath OnGround CheckSpeed_-2000_-1000",
+		"CheckSpeed_-2000_-1000 Tick_0_1000000",
+		"!OnGround CheckPlayerDistance_0_100000 CheckSpeed_-2000_-1000",
+	};
+	constexpr int conditionCount = sizeof(branchConditions) / sizeof(branchConditions[0]);
+
+	std::string xml = "<ActionChart><ActionStates><IDLE Animation=\"\" BlendTick=\"0\"/>";
+	for (int s = 0; s < CONDITION_STATE_COUNT; ++s)
+	{
+		xml += "<BENCHMARK_" + std::to_string(s) + " Animation=\"\" BlendTick=\"0\">";
+		for (int b = 0; b < CONDITION_BRANCH_COUNT; ++b)
+		{
+			xml += "<Branch State=\"IDLE\" Condition=\"";
+			xml += branchConditions[(s + b) % conditionCount];
+			xml += "\"/>";
+		}
+		xml += "</BENCHMARK_" + std::to_string(s) + ">";
+	}
+	xml += "</ActionStates><CollisionHandlers/><Variables/><ChildEffects/></ActionChart>";
+	return xml;
+}
+
+void StageBenchmark::processFrameEvents(const std::vector<Actor*>& actors)
+{
+	XMLReader xmlReader;
+	xmlReader.loadXMLString(makeFrameEventChartXML());
+	const ActionChart actionChart(xmlReader.getRootNode());
+	const ActionState* actionState = actionChart.getActionState(NameTable::getNameId("BENCHMARK_FRAME_EVENT"));
+	check(actionState != nullptr);
+
+	const TickCount64 frameTick = static_cast<TickCount64>(FRAME_EVENT_COUNT) * FRAME_EVENT_TICK_INTERVAL / FRAME_EVENT_FRAME_COUNT;
+	const auto cursorStart = std::chrono::steady_clock::now();
+	for (const auto& actor : actors)
+	{
+		actor->setFrameEventCursor(actionState->getFrameEventStartCursor());
+	}
+	for (int f = 1; f <= FRAME_EVENT_FRAME_COUNT; ++f)
+	{
+		for (const auto& actor : actors)
+		{
+			actionState->processFrameEvents(*actor, f * frameTick);
+		}
+	}
+	const auto scanStart = std::chrono::steady_clock::now();
+	uint64_t checkCount = 0;
+	for (int f = 1; f <= FRAME_EVENT_FRAME_COUNT; ++f)
+	{
+		const TickCount64 prevTick = (f - 1) * frameTick;
+		const TickCount64 progressedTick = f * frameTick;
+		for (const auto& actor : actors)
+		{
+			for (const auto& frameEvent : actionState->_frameEvents)
+			{
+				if (prevTick < frameEvent->getProcessTick() && frameEvent->getProcessTick() <= progressedTick)
+				{
+					++checkCount;
+					if (frameEvent->checkConditions(*actor))
+					{
+						frameEvent->process(*actor);
+					}
+				}
+			}
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const int64_t cursorMicroSecond = std::chrono::duration_cast<std::chrono::microseconds>(scanStart - cursorStart).count();
+	const int64_t scanMicroSecond = std::chrono::duration_cast<std::chrono::microseconds>(end - scanStart).count();
+	const std::string text = "[Benchmark] frameEvent: " + std::to_string(FRAME_EVENT_COUNT) + "x" + std::to_string(actors.size()) +
+		" frame: " + std::to_string(FRAME_EVENT_FRAME_COUNT) +
+		" cursor: " + std::to_string(cursorMicroSecond) + "us" +
+		" scan: " + std::to_string(scanMicroSecond) + "us" +
+		" conditionCheck: " + std::to_string(checkCount) + "\n";
+	OutputDebugStringA(text.c_str());
+}
+
+std::string StageBenchmark::makeFrameEventChartXML(void)
+{
+	//  ׻ ϹǷ óǴ ̺Ʈ   򰡱 .
+	std::string xml = "<ActionChart><ActionStates><IDLE Animation=\"\" BlendTick=\"0\"/>"
+		"<BENCHMARK_FRAME_EVENT Animation=\"\" BlendTick=\"0\">";
+	for (int i = 1; i <= FRAME_EVENT_COUNT; ++i)
+	{
+		xml += "<FrameEvent Type=\"Die\" Tick=\"" + std::to_string(i * FRAME_EVENT_TICK_INTERVAL) +
+			"\" Condition=\"CheckSpeed_-2000_-1000\"/>";
+	}
+	xml += "</BENCHMARK_FRAME_EVENT></ActionStates><CollisionHandlers/><Variables/><ChildEffects/></ActionChart>";
+	return xml;
+}
+
+void StageBenchmark::killActors(StageManager& stageManager, const std::vector<Actor*>& actors)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (const auto& actor : actors)
+	{
+		stageManager.killActor(actor);
+	}
+	stageManager.killActors();
+	const int64_t microSecond = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	const std::string text = "[Benchmark] kill: " + std::to_string(actors.size()) +
+		" avg: " + std::to_string(static_cast<double>(microSecond) / std::max<size_t>(actors.size(), 1)) + "us\n";
+	OutputDebugStringA(text.c_str());
+}
+
+void StageBenchmark::deformTerrains(StageManager& stageManager)
+{
+	using Clock = std::chrono::steady_clock;
+	for (auto& terrain : stageManager._terrains)
+	{
+		if (!terrain.isGround() || !terrain.isDeformable())
+		{
+			continue;
+		}
+		std::vector<XMFLOAT3> meshPositions;
+		terrain.getMeshPositions(meshPositions);
+		const XMFLOAT3 meshMin = terrain.getLocalMin();
+		const XMFLOAT3 meshMax = terrain.getLocalMax();
+		const float sizeX = std::max(meshMax.x - meshMin.x, FLT_EPSILON);
+		const float sizeZ = std::max(meshMax.z - meshMin.z, FLT_EPSILON);
+		const float amplitude = std::max({ meshMax.x - meshMin.x, meshMax.y - meshMin.y, meshMax.z - meshMin.z }) * DEFORM_AMPLITUDE_RATE;
+
+		//     y δ.
+		std::vector<XMFLOAT3> positions(meshPositions.size());
+		int64_t refitMicroSecond = 0;
+		int rebuildCount = 0;
+		float maxTreeCostRatio = 0.f;
+		for (int f = 0; f < DEFORM_FRAME_COUNT; ++f)
+		{
+			const float phase = MathHelper::Pi * 2.f * f / DEFORM_FRAME_COUNT;
+			for (size_t i = 0; i < meshPositions.size(); ++i)
+			{
+				const float u = (meshPositions[i].x - meshMin.x) / sizeX;
+				const float v = (meshPositions[i].z - meshMin.z) / sizeZ;
+				positions[i] = meshPositions[i];
+				positions[i].y += amplitude * std::sin(MathHelper::Pi * 4.f * (u + v) + phase);
+			}
+			const auto start = Clock::now();
+			terrain.setDeformedPositions(positions);
+			refitMicroSecond += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+			maxTreeCostRatio = std::max(maxTreeCostRatio, terrain.getTreeCostRatio());
+			if (terrain.updateTreeRebuild())
+			{
+				++rebuildCount;
+			}
+		}
+
+		//  ġ Ʈ ü  ð. refit    ̷  ̴.
+		TerrainTreeBuildResult buildResult;
+		const auto buildStart = Clock::now();
+		const size_t triangleCount = terrain.buildTree(positions, buildResult);
+		const int64_t buildMicroSecond = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - buildStart).count();
+
+		terrain.waitTreeRebuild();
+		terrain.setDeformedPositions(std::vector<XMFLOAT3>());
+		terrain.waitTreeRebuild();
+
+		const std::string text = "[Benchmark] terrainRefit: triangles: " + std::to_string(triangleCount) +
+			" refit avg: " + std::to_string(static_cast<double>(refitMicroSecond) / DEFORM_FRAME_COUNT) + "us" +
+			" build: " + std::to_string(buildMicroSecond) + "us" +
+			" backgroundRebuild: " + std::to_string(rebuildCount) +
+			" maxCostRatio: " + std::to_string(maxTreeCostRatio) + "\n";
+		OutputDebugStringA(text.c_str());
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "TypeCommon.h"
+
+class StageManager;
+class Actor;
+
+// ߿ ġũ.   actor ѹ   ϰ   ¿ .
+//  actor ùķ̼ ʰ    .
+class StageBenchmark
+{
+public:
+	static void run(StageManager& stageManager);
+private:
+	//   ACTOR_COUNT ٷ Ѵ.  UNCACHED_SPAWN_COUNT Ź ø ĳø  ؼ
+	// ĳð    ð Ѵ.
+	static void spawnStorm(StageManager& stageManager, std::vector<Actor*>& outActors);
+	static void killActors(StageManager& stageManager, const std::vector<Actor*>& actors);
+	//  CONDITION_STATE_COUNT, ¸ branch CONDITION_BRANCH_COUNT Ʈ 
+	//  actor branch 򰡸 CONDITION_FRAME_COUNT ݺѴ.   Ź  ü 򰡿 Ѵ.
+	static void evaluateConditions(const std::vector<Actor*>& actors);
+	static std::string makeConditionChartXML(void);
+	// frame event FRAME_EVENT_COUNT ¿  actor frame event ó FRAME_EVENT_FRAME_COUNT  Ѵ.
+	// Actor Ŀ óϴ Ͱ   ü  Ⱦ tick  Ȯϴ  Ѵ.
+	static void processFrameEvents(const std::vector<Actor*>& actors);
+	static std::string makeFrameEventChartXML(void);
+	// ٴ terrain    DEFORM_FRAME_COUNT  ̸鼭 refit ð ,
+	// Ʈ ü ٽ  ð Ѵ.    .
+	static void deformTerrains(StageManager& stageManager);
+
+	static constexpr int ACTOR_COUNT = 1000;
+	static constexpr int UNCACHED_SPAWN_COUNT = 20;
+	static constexpr int CONDITION_STATE_COUNT = 50;
+	static constexpr int CONDITION_BRANCH_COUNT = 10;
+	static constexpr int CONDITION_FRAME_COUNT = 10;
+	static constexpr int FRAME_EVENT_COUNT = 200;
+	static constexpr int FRAME_EVENT_TICK_INTERVAL = 10;
+	static constexpr int FRAME_EVENT_FRAME_COUNT = 125;
+	static constexpr int DEFORM_FRAME_COUNT = 60;
+	//  ũ⿡    
+	static constexpr float DEFORM_AMPLITUDE_RATE = 0.05f;
+};
@@ -7,6 +7,8 @@
 #include "Path.h"
 #include "ObjectInfo.h"
 
+using namespace DirectX;
+
 StageInfo::StageInfo(void) noexcept
 	: _sectorUnitNumber(0, 0, 0)
 	, _sectorSize(0, 0, 0)
@@ -113,24 +115,20 @@ const std::vector<SpawnInfo>& StageInfo::getSpawnInfos(void) const noexcept
 	return _spawnInfo;
 }
 
-std::vector<const CameraPoint*> StageInfo::getNearCameraPoints(const DirectX::XMFLOAT3& position) const noexcept
+const CameraPoint* StageInfo::getNearestCameraPoint(const DirectX::XMFLOAT3& position, CameraPointCache& cache) const noexcept
 {
-	std::vector<const CameraPoint*> rv;
-	for (const auto& camera : _autoCameraPoints)
+	using namespace MathHelper;
+	if (cache._isValid && lengthSq(sub(cache._center, position)) < cache._safeRadius * cache._safeRadius)
 	{
-		if (camera->checkInRange(position))
-		{
-			rv.push_back(camera.get());
-		}
+		return cache._nearestPoint;
 	}
-	return rv;
-}
 
-const CameraPoint* StageInfo::getNearestCameraPoint(const DirectX::XMFLOAT3& position) const noexcept
-{
+	cache._candidates.clear();
+	_autoCameraPointTree.query(position, AUTO_CAMERA_POINT_QUERY_MARGIN, cache._candidates);
+
 	float minDistanceSq = std::numeric_limits<float>::max();
 	const CameraPoint* cameraPoint = nullptr;
-	for (const auto& camera : _autoCameraPoints)
+	for (const auto& camera : cache._candidates)
 	{
 		if (!camera->checkInRange(position))
 		{
@@ -139,10 +137,29 @@ const CameraPoint* StageInfo::getNearestCameraPoint(const DirectX::XMFLOAT3& pos
 		float distanceSq = camera->getDistanceSq(position);
 		if (distanceSq < minDistanceSq)
 		{
-			cameraPoint = camera.get();
+			cameraPoint = camera;
 			minDistanceSq = distanceSq;
 		}
 	}
+
+	//  ݰ ȿ    踦  ʰ,    ٸ  Ÿ  ٲ ʴ´.
+	// ĺ    margin ̻  ִ.
+	float safeRadius = AUTO_CAMERA_POINT_QUERY_MARGIN;
+	const float minDistance = (cameraPoint != nullptr) ? sqrtf(minDistanceSq) : 0.f;
+	for (const auto& camera : cache._candidates)
+	{
+		const float distance = sqrtf(camera->getDistanceSq(position));
+		safeRadius = std::min(safeRadius, fabsf(distance - camera->getRadius()));
+		if (cameraPoint != nullptr && camera != cameraPoint && camera->checkInRange(position))
+		{
+			safeRadius = std::min(safeRadius, (distance - minDistance) * 0.5f);
+		}
+	}
+
+	cache._center = position;
+	cache._safeRadius = safeRadius;
+	cache._nearestPoint = cameraPoint;
+	cache._isValid = true;
 	return cameraPoint;
 }
 
@@ -171,23 +188,38 @@ const DirectX::XMINT3& StageInfo::getSectorSize(void) const noexcept
 	return _sectorSize;
 }
 
-const GravityPoint* StageInfo::getGravityPointAt(const DirectX::XMFLOAT3& position) const noexcept
+const GravityPoint* StageInfo::getGravityPointAt(const DirectX::XMFLOAT3& position, GravityPointCandidates& candidates) const noexcept
+{
+	using namespace MathHelper;
+	constexpr float margin = GRAVITY_POINT_CANDIDATE_MARGIN;
+	if (!candidates._isValid || margin * margin < lengthSq(sub(candidates._center, position)))
+	{
+		candidates._points.clear();
+		_gravityPointTree.query(position, margin, candidates._points);
+		candidates._center = position;
+		candidates._isValid = true;
+	}
+	return getNearestGravityPoint(candidates._points, position);
+}
+
+const GravityPoint* StageInfo::getNearestGravityPoint(const std::vector<const GravityPoint*>& gravityPoints, const DirectX::XMFLOAT3& position) noexcept
 {
 	using namespace MathHelper;
 	const GravityPoint* nearestPoint = nullptr;
 	float nearestDistanceSq = std::numeric_limits<float>::max();
-	for (const auto& gravityPoint : _gravityPoints)
+	for (const auto& gravityPoint : gravityPoints)
 	{
-		float distanceSq = lengthSq(sub(gravityPoint.second->_position, position));
+		float distanceSq = lengthSq(sub(gravityPoint->_position, position));
 		if (distanceSq < nearestDistanceSq &&
-			distanceSq <= gravityPoint.second->_radius * gravityPoint.second->_radius)
+			distanceSq <= gravityPoint->_radius * gravityPoint->_radius)
 		{
 			nearestDistanceSq = distanceSq;
-			nearestPoint = gravityPoint.second.get();
+			nearestPoint = gravityPoint;
 		}
 	}
 	return nearestPoint;
 }
+
 const GravityPoint* StageInfo::getGravityPoint(int key) const noexcept
 {
 	auto it = _gravityPoints.find(key);
@@ -309,8 +341,10 @@ void StageInfo::loadXmlGravityPointInfo(const XMLReaderNode& node)
 			gravityPoint->_direction = { 0, 0, 0 };
 		}
 
+		_gravityPointTree.addSphere(gravityPoint->_position, gravityPoint->_radius, gravityPoint.get());
 		_gravityPoints.emplace(key, std::move(gravityPoint));
 	}
+	_gravityPointTree.build();
 }
 
 void StageInfo::loadXmlLightInfo(const XMLReaderNode& node)
@@ -406,7 +440,11 @@ void StageInfo::loadXmlAutoCameraInfo(const XMLReaderNode& node)
 	for (const auto& childNode : childNodes)
 	{
 		_autoCameraPoints.emplace_back(CameraPoint::loadXMLCameraPoint(childNode, true));
+		_autoCameraPointTree.addSphere(_autoCameraPoints.back()->getPointPosition(),
+			_autoCameraPoints.back()->getRadius(),
+			_autoCameraPoints.back().get());
 	}
+	_autoCameraPointTree.build();
 }
 
 void StageInfo::loadXmlPaths(const XMLReaderNode& node)
@@ -441,4 +479,20 @@ GravityPoint::GravityPoint() noexcept
 	, _minRadius(0.f)
 {
 
+}
+
+GravityPointCandidates::GravityPointCandidates() noexcept
+	: _center(0.f, 0.f, 0.f)
+	, _isValid(false)
+{
+
+}
+
+CameraPointCache::CameraPointCache() noexcept
+	: _center(0.f, 0.f, 0.f)
+	, _safeRadius(0.f)
+	, _isValid(false)
+	, _nearestPoint(nullptr)
+{
+
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "TypeCommon.h"
 #include "TypeGeometry.h"
 #include "TypeStage.h"
+#include "SphereAABBTree.h"
 
 class XMLReaderNode;
 class CameraPoint;
@@ -27,6 +28,28 @@ struct GravityPoint
 	DirectX::XMFLOAT3 _direction;
 };
 
+// actor  ִ gravity point ĺ .
+// _center  + GRAVITY_POINT_CANDIDATE_MARGIN ȿ ִ ̶, _center margin ̳ ̴  ĺ ˻ϸ ȴ.
+struct GravityPointCandidates
+{
+	GravityPointCandidates() noexcept;
+	DirectX::XMFLOAT3 _center;
+	bool _isValid;
+	std::vector<const GravityPoint*> _points;
+};
+
+// ī޶  ִ auto camera point ȸ .
+// _center _safeRadius ̳ ̴          ٲ Ƿ ٽ ã ʴ´.
+struct CameraPointCache
+{
+	CameraPointCache() noexcept;
+	DirectX::XMFLOAT3 _center;
+	float _safeRadius;
+	bool _isValid;
+	const CameraPoint* _nearestPoint;
+	std::vector<const CameraPoint*> _candidates;
+};
+
 class StageInfo
 {
 public:
@@ -47,14 +70,15 @@ public:
 	void loadXmlPaths(const XMLReaderNode& node);
 	void loadXMLUIInfo(const XMLReaderNode& node);
 
-	std::vector<const CameraPoint*> getNearCameraPoints(const DirectX::XMFLOAT3& position) const noexcept;
-	const CameraPoint* getNearestCameraPoint(const DirectX::XMFLOAT3& position) const noexcept;
+	// cache  ݰ  Ʈ ٽ ã´.
+	const CameraPoint* getNearestCameraPoint(const DirectX::XMFLOAT3& position, CameraPointCache& cache) const noexcept;
 	const CameraPoint* getTriggeredCameraPoint(int key) const noexcept;
 	const std::vector<SpawnInfo>& getSpawnInfos(void) const noexcept;
 	const std::vector<TerrainObjectInfo>& getTerrainObjectInfos(void) const noexcept;
 	const DirectX::XMINT3& getSectorUnitNumber(void) const noexcept;
 	const DirectX::XMINT3& getSectorSize(void) const noexcept;
-	const GravityPoint* getGravityPointAt(const DirectX::XMFLOAT3& position) const noexcept;
+	// ĺ  ų position ĺ   Ʈ ĺ ٽ ã´.
+	const GravityPoint* getGravityPointAt(const DirectX::XMFLOAT3& position, GravityPointCandidates& candidates) const noexcept;
 	const GravityPoint* getGravityPoint(int key) const noexcept;
 	const std::vector<Light>& getLights(void) const noexcept;
 	const DirectX::XMFLOAT4& getAmbientLight(void) const noexcept;
@@ -88,5 +112,9 @@ private:
 	DirectX::XMINT3 _sectorSize;
 
 	std::string _name;
-	
+
+	SphereAABBTree<GravityPoint> _gravityPointTree;
+	SphereAABBTree<CameraPoint> _autoCameraPointTree;
+private:
+	static const GravityPoint* getNearestGravityPoint(const std::vector<const GravityPoint*>& gravityPoints, const DirectX::XMFLOAT3& position) noexcept;
 };
\ No newline at end of file
@@ -16,18 +16,26 @@
 #include "BackgroundObject.h"
 #include "ObjectInfo.h"
 #include "StageScript.h"
+#include "StagePhaseCondition.h"
 #include "Effect.h"
 #include "UIManager.h"
 #include "Camera.h"
+#include "GameObject.h"
+#include "StageBenchmark.h"
+#include "Path.h"
 
 StageManager::StageManager()
 	: _sectorSize(100, 100, 100)
 	, _sectorUnitNumber(9, 9, 9)
 	, _actorsBySector(9 * 9 * 9)
+	, _stageScriptVariableIndices(-1)
+	, _stageScriptVariableVersion(0)
 	, _currentPhase(nullptr)
-	, _playerActor(nullptr)
+	, _updateFrameCount(0)
+	, _nextActivityPhase(0)
+	, _actorActivityCounts{}
 	, _isLoading(false)
-	, _raycastActor(nullptr)
+	, _isBenchmarkRequested(false)
 	, _raycastPosition(0, 0, 0)
 {
 }
@@ -58,30 +66,97 @@ void StageManager::loadStage(void)
 
 void StageManager::update()
 {
+	if (_isBenchmarkRequested)
+	{
+		_isBenchmarkRequested = false;
+		StageBenchmark::run(*this);
+	}
 	TickCount64 deltaTick = SMGFramework::Get().getTimer().getDeltaTickCount();
 
+	updateTerrains(deltaTick);
 	updateMouseRaycast();
 
+	++_updateFrameCount;
+	_actorActivityCounts.fill(0);
+	_updatingActors.clear();
+	_pathMoveActors.clear();
 	for (const auto& actor : _actors)
 	{
-		actor->updateActor(deltaTick);
+		const ActorActivityLevel activityLevel = getActorActivityLevel(actor);
+		++_actorActivityCounts[static_cast<int>(activityLevel)];
 
+		TickCount64 actorDeltaTick;
+		if (!actor->consumeActivityTick(activityLevel, _updateFrameCount, deltaTick, actorDeltaTick))
+		{
+			continue;
+		}
+		actor->updateActor(actorDeltaTick);
+		_updatingActors.emplace_back(actor, actorDeltaTick);
+		if (actor->isPathMove())
+		{
+			_pathMoveActors.push_back(actor);
+		}
+	}
+	updatePathPositions();
+
+	for (const auto& [actor, actorDeltaTick] : _updatingActors)
+	{
 		bool isChanged = false;
-		isChanged |= rotateActor(actor.get(), deltaTick);
-		isChanged |= moveActor(actor.get(), deltaTick);
-		isChanged |= applyGravity(actor.get(), deltaTick);
+		isChanged |= rotateActor(actor, actorDeltaTick);
+		gatherTerrainTriangles(actor, actorDeltaTick);
+		isChanged |= moveActor(actor, actorDeltaTick);
+		isChanged |= applyGravity(actor, actorDeltaTick);
 
 		if (isChanged)
 		{
 			actor->updateObjectWorldMatrix();
 		}
 	}
+	_terrainTriangleCache.reset();
+	++_actorActivityStatistics._frameCount;
+	for (size_t i = 0; i < _actorActivityCounts.size(); ++i)
+	{
+		_actorActivityStatistics._actorCounts[i] += _actorActivityCounts[i];
+	}
 	processActorCollision();
 	killActors();
 	updateStageScript();
 	spawnRequested();
 }
 
+void StageManager::updatePathPositions(void) noexcept
+{
+	std::sort(_pathMoveActors.begin(), _pathMoveActors.end(),
+		[](const Actor* lhs, const Actor* rhs)
+		{
+			return lhs->getPath() < rhs->getPath();
+		});
+
+	for (size_t begin = 0; begin < _pathMoveActors.size();)
+	{
+		const Path* path = _pathMoveActors[begin]->getPath();
+		size_t end = begin + 1;
+		while (end < _pathMoveActors.size() && _pathMoveActors[end]->getPath() == path)
+		{
+			++end;
+		}
+
+		const size_t count = end - begin;
+		_pathTimes.resize(count);
+		_pathPositions.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			_pathTimes[i] = _pathMoveActors[begin + i]->getPathTime();
+		}
+		path->getPathPositionsAtTime(_pathTimes.data(), count, _pathPositions.data(), InterpolationType::Linear);
+		for (size_t i = 0; i < count; ++i)
+		{
+			_pathMoveActors[begin + i]->setPathPosition(_pathPositions[i]);
+		}
+		begin = end;
+	}
+}
+
 void StageManager::releaseObjects()
 {
 	_isLoading = true;
@@ -209,33 +284,34 @@ const StageInfo* StageManager::getStageInfo(void) const noexcept
 	return _stageInfo.get();
 }
 
-void StageManager::spawnActor(const SpawnInfo& spawnInfo)
+Actor* StageManager::spawnActor(const SpawnInfo& spawnInfo)
 {
-	std::unique_ptr<Actor> actor = std::make_unique<Actor>(spawnInfo);;
+	Actor* actor = _actors.create(spawnInfo);
+	actor->setActivityPhase(_nextActivityPhase++);
 	auto characterInfo = SMGFramework::getCharacterInfoManager()->getInfo(spawnInfo.getCharacterKey());
 	check(characterInfo != nullptr);
 	if (characterInfo->getCharacterType() == CharacterType::Player)
 	{
-		check(_playerActor == nullptr, "÷̾ Ͱ ü˴ϴ.");
-		_playerActor = static_cast<Actor*>(actor.get());
+		check(getPlayerActor() == nullptr, "÷̾ Ͱ ü˴ϴ.");
+		_playerActor = _actors.getHandle(actor);
 	}
 
 	int sectorIndex = sectorCoordToIndex(actor->getSectorCoord());
 	check(sectorIndex < _actorsBySector.size());
-	auto it = _actorsBySector[sectorIndex].emplace(actor.get());
+	auto it = _actorsBySector[sectorIndex].emplace(actor);
 
 #if defined DEBUG | defined _DEBUG
-	SMGFramework::getD3DApp()->createGameObjectDev(actor.get());
+	SMGFramework::getD3DApp()->createGameObjectDev(actor);
 #endif
-	_actors.emplace_back(std::move(actor));
+	return actor;
 }
 
 const Actor* StageManager::getPlayerActor(void) const noexcept
 {
-	return _playerActor;
+	return _actors.get(_playerActor);
 }
 
-const GravityPoint* StageManager::getGravityPointAt(const DirectX::XMFLOAT3& position) const noexcept
+const GravityPoint* StageManager::getGravityPointAt(const DirectX::XMFLOAT3& position, GravityPointCandidates& candidates) const noexcept
 {
 	if (_stageInfo == nullptr)
 	{
@@ -243,20 +319,23 @@ const GravityPoint* StageManager::getGravityPointAt(const DirectX::XMFLOAT3& pos
 		return nullptr;
 	}
 
-	return _stageInfo->getGravityPointAt(position);
+	return _stageInfo->getGravityPointAt(position, candidates);
 }
 
 float StageManager::checkWall(Actor* actor, const DirectX::XMFLOAT3& moveVector) const noexcept
 {
 	float minCollisionTime = 1.f;
-	for (const auto& terrain : _terrains)
+	const TerrainTriangleCache* triangleCache = (_terrainTriangleCache._actor == _actors.getHandle(actor)) ? &_terrainTriangleCache : nullptr;
+	for (size_t i = 0; i < _terrains.size(); ++i)
 	{
+		const auto& terrain = _terrains[i];
 		if (terrain.isWall() == false)
 		{
 			continue;
 		}
 		float collisionTime;
-		if (terrain.checkCollision(*actor, moveVector, collisionTime) && collisionTime < minCollisionTime)
+		TerrainContact contact;
+		if (terrain.checkCollision(*actor, moveVector, triangleCache, i, nullptr, collisionTime, contact) && collisionTime < minCollisionTime)
 		{
 			minCollisionTime = collisionTime;
 		}
@@ -266,21 +345,104 @@ float StageManager::checkWall(Actor* actor, const DirectX::XMFLOAT3& moveVector)
 float StageManager::checkGround(Actor* actor, const DirectX::XMFLOAT3& moveVector) const noexcept
 {
 	float minCollisionTime = 1.f;
-	for (const auto& terrain : _terrains)
+	const TerrainTriangleCache* triangleCache = (_terrainTriangleCache._actor == _actors.getHandle(actor)) ? &_terrainTriangleCache : nullptr;
+	//   ﰢ ˻Ѵ.   쿡   ؼ  üũ ٽ Ѵ.
+	const TerrainContact previousContact = actor->getGroundContact();
+	const TerrainContact* lastContact = (previousContact._terrain != nullptr) ? &previousContact : nullptr;
+	TerrainContact groundContact = previousContact;
+	for (size_t i = 0; i < _terrains.size(); ++i)
 	{
+		const auto& terrain = _terrains[i];
 		if (terrain.isGround() == false)
 		{
 			continue;
 		}
 		float collisionTime;
-		if (terrain.checkCollision(*actor, moveVector, collisionTime) && collisionTime < minCollisionTime)
+		TerrainContact contact;
+		if (terrain.checkCollision(*actor, moveVector, triangleCache, i, lastContact, collisionTime, contact) && collisionTime < minCollisionTime)
 		{
 			minCollisionTime = collisionTime;
+			groundContact = contact;
 		}
 	}
+	actor->setGroundContact(groundContact);
 	return minCollisionTime;
 }
 
+void StageManager::updateTerrains(const TickCount64& deltaTick) noexcept
+{
+	bool isMoved = false;
+	for (auto& terrain : _terrains)
+	{
+		terrain.updateTreeRebuild();
+		isMoved |= terrain.updateTransform(deltaTick);
+	}
+	if (!isMoved)
+	{
+		return;
+	}
+
+	for (const auto& actor : _actors)
+	{
+		const Terrain* groundTerrain = actor->getGroundContact()._terrain;
+		if (!actor->isOnGround() || groundTerrain == nullptr || !groundTerrain->isMoving())
+		{
+			continue;
+		}
+		XMMATRIX deltaMatrix = XMLoadFloat4x4(&groundTerrain->getDeltaMatrix());
+		XMVECTOR position = XMLoadFloat3(&actor->getPosition());
+		XMFLOAT3 moveVector;
+		XMStoreFloat3(&moveVector, XMVector3Transform(position, deltaMatrix) - position);
+		moveActorXXX(actor, moveVector);
+
+		XMVECTOR upVector = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&actor->getUpVector()), deltaMatrix));
+		XMVECTOR direction = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&actor->getDirection()), deltaMatrix));
+		XMFLOAT4 rotationQuat;
+		XMStoreFloat4(&rotationQuat, MathHelper::getQuaternion(upVector, direction));
+		actor->rotateQuat(rotationQuat);
+		actor->updateObjectWorldMatrix();
+	}
+}
+
+void StageManager::gatherTerrainTriangles(const Actor* actor, const TickCount64& deltaTick) noexcept
+{
+	_terrainTriangleCache.reset();
+	if (!actor->isCollisionOn())
+	{
+		return;
+	}
+
+	const XMFLOAT3 moveVector = actor->getMoveVector(deltaTick);
+	const float verticalSpeed = std::abs(actor->getVerticalSpeed());
+	int sweepCount = 0;
+	if (!MathHelper::equal(moveVector, XMFLOAT3(0, 0, 0)))
+	{
+		sweepCount += actor->isPlaneMove() ? 1 : 2;
+	}
+	if (!MathHelper::equal(verticalSpeed, 0.f))
+	{
+		++sweepCount;
+	}
+	// Ʈ ȸ ѹ̸ Ƶδ 븸  .
+	if (sweepCount < 2)
+	{
+		return;
+	}
+
+	// ̵, ߷ ̵   Ÿ actor ũ 浹 üũ ڷ ̴ Ÿ( ) Ѵ.
+	const float boxExtent = sqrtf(actor->getSizeX() * actor->getSizeX() +
+		actor->getSizeY() * actor->getSizeY() +
+		actor->getSizeZ() * actor->getSizeZ());
+	const float radius = MathHelper::length(moveVector) + verticalSpeed +
+		std::max(actor->getRadius(), boxExtent) + actor->getRadius() * 0.5f + TERRAIN_TRIANGLE_CACHE_MARGIN;
+
+	for (const auto& terrain : _terrains)
+	{
+		terrain.gatherTriangles(actor->getPosition(), radius, _terrainTriangleCache);
+	}
+	_terrainTriangleCache._actor = _actors.getHandle(actor);
+}
+
 bool StageManager::moveActor(Actor* actor, const TickCount64& deltaTick) noexcept
 {
 	const XMFLOAT3 zeroVector(0, 0, 0);
@@ -335,16 +497,8 @@ void StageManager::killActors(void) noexcept
 		int sectorIndex = sectorCoordToIndex(actor->getSectorCoord());
 		size_t erased = _actorsBySector[sectorIndex].erase(actor);
 		check(erased == 1);
-		
-		for (int i = 0; i < _actors.size(); ++i)
-		{
-			if (_actors[i].get() == actor)
-			{
-				_actors[i] = std::move(_actors.back());
-				_actors.pop_back();
-				break;
-			}
-		}
+
+		_actors.destroy(actor);
 	}
 	_deadActors.clear();
 }
@@ -412,7 +566,7 @@ void StageManager::raycast(DirectX::XMVECTOR start, DirectX::XMVECTOR dir, float
 					bool colliding = actor->checkCollisionWithLine(start, velocity, t);
 					if (colliding && (t * maxLength) < collisionTime)
 					{
-						_raycastActor = actor;
+						_raycastActor = _actors.getHandle(actor);
 						collisionTime = t * maxLength;
 					}
 				}
@@ -454,7 +608,15 @@ void StageManager::loadStageScript(void)
 	_stageScript = std::make_unique<StageScript>(xmlStageScript.getRootNode());
 
 	_currentPhase = _stageScript->getStartPhase();
-	_stageScriptVariables = _stageScript->getVariables();
+	const auto& variables = _stageScript->getVariables();
+	_stageScriptVariables.reserve(variables.size());
+	for (const auto& variable : variables)
+	{
+		_stageScriptVariableIndices.set(NameTable::getNameId(variable.first), static_cast<int>(_stageScriptVariables.size()));
+		_stageScriptVariables.push_back(variable.second);
+	}
+	++_stageScriptVariableVersion;
+	_currentPhase->enterPhase();
 
 }
 
@@ -644,7 +806,7 @@ void StageManager::processActorCollisionXXX(int sectorCoord0, int sectorCoord1)
 void StageManager::updateMouseRaycast()
 {
 	using namespace DirectX;
-	_raycastActor = nullptr;
+	_raycastActor = SlotHandle();
 	if (!SMGFramework::Get().isPointerActive())
 	{
 		return;
@@ -698,45 +860,71 @@ void StageManager::updateStageScript(void) noexcept
 	if (changePhase)
 	{
 		_currentPhase = _stageScript->getPhase(nextPhaseName);
+		_currentPhase->enterPhase();
 	}
 }
 
 void StageManager::setCulled(void) noexcept
 {
+	BoundingFrustum worldFrustum;
+	SMGFramework::getD3DApp()->getWorldFrustum(worldFrustum);
+	_frustumCuller.setFrustum(worldFrustum);
+	_frustumCuller.clearBoxes();
 	for (auto& backgroundObject : _backgroundObjects)
 	{
-		backgroundObject.setCulled();
+		backgroundObject.addCullingBox(_frustumCuller);
 	}
 	for (auto& t : _terrains)
 	{
-		t.setCulled();
+		t.addCullingBox(_frustumCuller);
 	}
 	for (auto& actor : _actors)
 	{
-		actor->setCulled();
+		actor->addCullingBox(_frustumCuller);
+	}
+
+	_frustumCuller.cull();
+
+	for (auto& backgroundObject : _backgroundObjects)
+	{
+		backgroundObject.setCulled(_frustumCuller);
+	}
+	for (auto& t : _terrains)
+	{
+		t.setCulled(_frustumCuller);
+	}
+	for (auto& actor : _actors)
+	{
+		actor->setCulled(_frustumCuller);
 	}
 }
 
-void StageManager::addStageScriptVariable(const std::string& name, int value) noexcept
+void StageManager::addStageScriptVariable(NameId nameId, int value) noexcept
 {
-	auto it = _stageScriptVariables.find(name);
-	if (it == _stageScriptVariables.end())
+	const int index = _stageScriptVariableIndices.get(nameId);
+	if (index == -1)
 	{
-		check(false, name);
+		check(false, NameTable::getName(nameId));
 		return;
 	}
-	it->second += value;
+	if (value != 0)
+	{
+		_stageScriptVariables[index] += value;
+		++_stageScriptVariableVersion;
+		check(_currentPhase != nullptr);
+		_currentPhase->onVariableChanged(nameId);
+	}
 }
 
-int StageManager::getStageScriptVariable(const std::string& name) const noexcept
+int StageManager::getStageScriptVariable(NameId nameId) const noexcept
 {
-	auto it = _stageScriptVariables.find(name);
-	if (it == _stageScriptVariables.end())
+	const int index = _stageScriptVariableIndices.get(nameId);
+	if (index == -1)
 	{
-		check(false, name);
+		check(false, NameTable::getName(nameId));
 		return 0;
 	}
-	return it->second;
+	return _stageScriptVariables[index];
 }
 
 void StageManager::createMap(void)
@@ -771,17 +959,24 @@ void StageManager::createMap(void)
 
 void StageManager::unloadStage(bool isReload)
 {
+	//  Ʈ ҽ  尡  ׸   ִ.
+	SMGFramework::getD3DApp()->waitRenderThreadIdle();
+	ActionConditionProgram::logStatistics();
+	StagePhaseConditionProgram::logStatistics();
+	Terrain::logStatistics();
+	logActorActivityStatistics();
 	_terrains.clear();
 	_backgroundObjects.clear();
 	_requestedSpawnInfos.clear();
 	_requestedSpawnKeys.clear();
 	_stageScriptVariables.clear();
+	_stageScriptVariableIndices.clear();
 	_stageScript = nullptr;
 	_currentPhase = nullptr;
 	_actorsBySector.clear();
 	_deadActors.clear();
 	_actors.clear();
-	_playerActor = nullptr;
+	_playerActor = SlotHandle();
 
 	_stageInfo = nullptr;
 	_actionchartMap.clear();
@@ -791,3 +986,48 @@ void StageManager::unloadStage(bool isReload)
 	SMGFramework::getEffectManager()->releaseForStageLoad();
 	SMGFramework::getD3DApp()->releaseItemsForStageLoad(isReload);
 }
+
+
+ActorActivityLevel StageManager::getActorActivityLevel(const Actor* actor) const noexcept
+{
+	const Actor* playerActor = getPlayerActor();
+	if (playerActor == nullptr || actor == playerActor)
+	{
+		return ActorActivityLevel::Full;
+	}
+
+	//  ְ ̴ actor  ־ ׻ ùķ̼Ѵ.
+	const float distanceSq = MathHelper::lengthSq(MathHelper::sub(actor->getPosition(), playerActor->getPosition()));
+	ActorActivityLevel level = ActorActivityLevel::Minimal;
+	if (distanceSq < ACTIVITY_REDUCED_DISTANCE * ACTIVITY_REDUCED_DISTANCE)
+	{
+		level = actor->getGameObject()->isCulled() ? ActorActivityLevel::Reduced : ActorActivityLevel::Full;
+	}
+	else if (distanceSq < ACTIVITY_MINIMAL_DISTANCE * ACTIVITY_MINIMAL_DISTANCE)
+	{
+		level = ActorActivityLevel::Reduced;
+	}
+
+	if (level != ActorActivityLevel::Full && actor->isSleepable())
+	{
+		return ActorActivityLevel::Sleep;
+	}
+	return level;
+}
+
+void StageManager::logActorActivityStatistics(void) noexcept
+{
+	if (_actorActivityStatistics._frameCount == 0)
+	{
+		return;
+	}
+	static_assert(static_cast<int>(ActorActivityLevel::Count) == 4, "Ÿ ߰ Ȯ");
+	const auto& counts = _actorActivityStatistics._actorCounts;
+	const std::string text = "[ActorActivity] frame: " + std::to_string(_actorActivityStatistics._frameCount) +
+		" full: " + std::to_string(counts[static_cast<int>(ActorActivityLevel::Full)]) +
+		" reduced: " + std::to_string(counts[static_cast<int>(ActorActivityLevel::Reduced)]) +
+		" minimal: " + std::to_string(counts[static_cast<int>(ActorActivityLevel::Minimal)]) +
+		" sleep: " + std::to_string(counts[static_cast<int>(ActorActivityLevel::Sleep)]) + "\n";
+	OutputDebugStringA(text.c_str());
+	_actorActivityStatistics = ActorActivityStatistics();
+}
\ No newline at end of file
@@ -3,20 +3,32 @@
 #include "TypeCommon.h"
 #include <unordered_set>
 #include "TypeGeometry.h"
+#include "SlotPool.h"
+#include "NameTable.h"
+#include "TypeStage.h"
+#include "Terrain.h"
+#include "FrustumCuller.h"
 
 class StageInfo;
 enum class ErrCode : uint32_t;
 class Actor;
 class ActionChart;
 struct GravityPoint;
-class Terrain;
+struct GravityPointCandidates;
 class SpawnInfo;
 class BackgroundObject;
 class StageScript;
 class StagePhase;
 
+struct ActorActivityStatistics
+{
+	uint64_t _frameCount = 0;
+	std::array<uint64_t, static_cast<int>(ActorActivityLevel::Count)> _actorCounts = {};
+};
+
 class StageManager
 {
+	friend class StageBenchmark;
 public:
 	StageManager();
 	~StageManager();
@@ -40,7 +52,7 @@ public:
 private:
 	void spawnStageInfoActors();
 	void spawnRequested();
-	void spawnActor(const SpawnInfo& spawnInfo);
+	Actor* spawnActor(const SpawnInfo& spawnInfo);
 	void loadStageInfo();
 	void loadStageScript(void);
 	void createMap(void);
@@ -55,9 +67,15 @@ public:
 	bool applyGravity(Actor* actor, const TickCount64& deltaTick) noexcept;
 	float checkWall(Actor* actor, const DirectX::XMFLOAT3& moveVector) const noexcept;
 	float checkGround(Actor* actor, const DirectX::XMFLOAT3& moveVector) const noexcept;
+	// ̹ ӿ 浹 üũ ι ̻  actor terrain ﰢ ĺ ѹ Ƶд.
+	void gatherTerrainTriangles(const Actor* actor, const TickCount64& deltaTick) noexcept;
+	// ̴ terrain world  ϰ,    ִ actor  ű.
+	void updateTerrains(const TickCount64& deltaTick) noexcept;
+	// ̹ ӿ path ̵ϴ actor ġ path Ƽ ѹ Ѵ.
+	void updatePathPositions(void) noexcept;
 
 	const Actor* getPlayerActor(void) const noexcept;
-	const GravityPoint* getGravityPointAt(const DirectX::XMFLOAT3& position) const noexcept;
+	const GravityPoint* getGravityPointAt(const DirectX::XMFLOAT3& position, GravityPointCandidates& candidates) const noexcept;
 
 	DirectX::XMINT3 getSectorCoord(const DirectX::XMFLOAT3& position, bool checkRange = true) const noexcept;
 	void killActor(Actor* actor) noexcept;
@@ -65,20 +83,34 @@ public:
 	void setCulled(void) noexcept;
 
 	// stage script
-	void addStageScriptVariable(const std::string& name, int value) noexcept;
-	int getStageScriptVariable(const std::string& name) const noexcept;
+	void addStageScriptVariable(NameId nameId, int value) noexcept;
+	int getStageScriptVariable(NameId nameId) const noexcept;
+	//   ٲ𶧸 ö󰣴.    
+	uint32_t getStageScriptVariableVersion(void) const noexcept { return _stageScriptVariableVersion; }
 	void updateStageScript(void) noexcept;
 
-	const Actor* getPointerPickedActor(void) const noexcept { return _raycastActor; }
+	// ̹ ӿ ش 󵵷 ó actor 
+	uint32_t getActorActivityCount(ActorActivityLevel level) const noexcept { return _actorActivityCounts[static_cast<int>(level)]; }
+
+	// ߿.  update StageBenchmark Ѵ.
+	void requestBenchmark(void) noexcept { _isBenchmarkRequested = true; }
+
+	const Actor* getPointerPickedActor(void) const noexcept { return _actors.get(_raycastActor); }
 	const DirectX::XMFLOAT3& getPointerPickedPosition(void) const noexcept { return _raycastPosition; }
 private:
 	void killActors(void) noexcept;
 	int sectorCoordToIndex(const DirectX::XMINT3& sectorCoord) const noexcept;
 	void raycast(DirectX::XMVECTOR start, DirectX::XMVECTOR dir, float maxLength);
+	ActorActivityLevel getActorActivityLevel(const Actor* actor) const noexcept;
+	void logActorActivityStatistics(void) noexcept;
 
 private:
 	std::vector<Terrain> _terrains;
+	// Ʈ  actor ϳ ﰢ ĺ. ٸ actor  ʴ´.
+	TerrainTriangleCache _terrainTriangleCache;
 	std::vector<BackgroundObject> _backgroundObjects;
+	// background, terrain, actor  ڽ ߰Ѵ.
+	FrustumCuller _frustumCuller;
 	DirectX::XMINT3 _sectorSize;
 	DirectX::XMINT3 _sectorUnitNumber;
 	std::vector<std::unordered_set<Actor*>> _actorsBySector;
@@ -86,23 +118,37 @@ private:
 	std::vector<SpawnInfo> _requestedSpawnInfos;
 	std::vector<int> _requestedSpawnKeys;
 
-	std::unordered_map<std::string, int> _stageScriptVariables;
+	std::vector<int> _stageScriptVariables;
+	NameIdMap<int> _stageScriptVariableIndices;
+	uint32_t _stageScriptVariableVersion;
 	StagePhase* _currentPhase;
 	std::unique_ptr<StageScript> _stageScript;
 
-	std::vector<std::unique_ptr<Actor>> _actors;
-	Actor* _playerActor;
+	SlotPool<Actor> _actors;
+	// actor slot ǹǷ  ִ actor handle  ְ _actors.get ã´.
+	SlotHandle _playerActor;
+	// ̹ ӿ ùķ̼ϴ actor  tick.   ٽ ä.
+	std::vector<std::pair<Actor*, TickCount64>> _updatingActors;
+	std::vector<Actor*> _pathMoveActors;
+	std::vector<TickCount64> _pathTimes;
+	std::vector<DirectX::XMFLOAT3> _pathPositions;
+	uint32_t _updateFrameCount;
+	uint8_t _nextActivityPhase;
+	std::array<uint32_t, static_cast<int>(ActorActivityLevel::Count)> _actorActivityCounts;
+	ActorActivityStatistics _actorActivityStatistics;
 	std::unique_ptr<StageInfo> _stageInfo;
 	
 	std::string _nextStageName;
 	std::string _currentStageName;
 	bool _isLoading;
+	bool _isBenchmarkRequested;
 	std::unordered_map<std::string, std::unique_ptr<ActionChart>> _actionchartMap;
 
 	// mouse raycast
-	Actor* _raycastActor;
+	SlotHandle _raycastActor;
 	DirectX::XMFLOAT3 _raycastPosition;
 
+	static constexpr float TERRAIN_TRIANGLE_CACHE_MARGIN = 1.f;
 	static constexpr CharacterKey STAR_SHOOT_CHARACTER_KEY = 8;
 	static constexpr int STAR_SHOOT_ACTION_INDEX = 2;
 	static constexpr float STAR_SHOOT_SIZE = 0.3f;
@@ -5,73 +5,112 @@
 #include "D3DUtil.h"
 #include "SMGFramework.h"
 #include "UserData.h"
+#include "NameTable.h"
 
-StagePhaseCondition::StagePhaseCondition()
-	: _not(false)
+StagePhaseConditionStatistics StagePhaseConditionProgram::_statistics;
+
+StagePhaseCondition::StagePhaseCondition() noexcept
+	: _type(StagePhaseConditionType::Count)
+	, _not(false)
+	, _variable{ UNDEFINED_NAME_ID, OperatorType::Count, 0 }
 {
 
 }
 
-std::unique_ptr<StagePhaseCondition> StagePhaseCondition::parseConditionString(const std::string& input)
+void StagePhaseCondition::parseConditionString(const std::string& input, StagePhaseCondition& outCondition)
 {
-	bool notCondition;
 	std::string conditionString;
 	if (input.at(0) == '!')
 	{
 		conditionString = input.substr(1);
-		notCondition = true;
+		outCondition._not = true;
 	}
 	else
 	{
 		conditionString = input;
-		notCondition = false;
+		outCondition._not = false;
 	}
-	std::unique_ptr<StagePhaseCondition> condition = nullptr;
 
 	size_t cursor = std::min(conditionString.find('_'), conditionString.length());
 	std::string conditionTypeString = conditionString.substr(0, cursor);
 	std::string conditionArgs = (cursor < conditionString.length()) ? conditionString.substr(cursor + 1) : "";
 
-	//  switch case.. [9/3/2021 qwerwy]
 	if (conditionTypeString == "Variable")
 	{
-		condition = std::make_unique<StagePhaseCondition_Variable>(conditionArgs);
+		outCondition._type = StagePhaseConditionType::Variable;
+		outCondition.parseVariable(conditionArgs);
 	}
 	else if (conditionTypeString == "UserData")
 	{
-		condition = std::make_unique<StagePhaseCondition_UserData>(conditionArgs);
+		outCondition._type = StagePhaseConditionType::UserData;
+		outCondition.parseUserData(conditionArgs);
 	}
 	else
 	{
 		static_assert(static_cast<int>(StagePhaseConditionType::Count) == 2, "Ÿ ߰Ǹ ۾Ǿ մϴ.");
 		ThrowErrCode(ErrCode::UndefinedType, "conditionString : " + conditionString);
 	}
+}
 
-	if (notCondition)
+bool StagePhaseCondition::checkCondition(void) const noexcept
+{
+	switch (_type)
 	{
-		condition->setNotCondition();
+		case StagePhaseConditionType::Variable:
+		{
+			check(SMGFramework::getStageManager() != nullptr);
+			int variable = SMGFramework::getStageManager()->getStageScriptVariable(_variable._name);
+
+			return D3DUtil::compare(_variable._operator, variable, _variable._value);
+		}
+		case StagePhaseConditionType::UserData:
+		{
+			return checkUserData();
+		}
+		default:
+		{
+			static_assert(static_cast<int>(StagePhaseConditionType::Count) == 2, "Ÿ ߰ Ȯ");
+			check(false, "Ÿ ߰ Ȯ");
+			return false;
+		}
 	}
-	return condition;
 }
 
-StagePhaseCondition_Variable::StagePhaseCondition_Variable(const std::string& args)
+void StagePhaseCondition::getDependency(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept
 {
-	bool rv = D3DUtil::parseComparison(args, _name, _operator, _value);
-	if (!rv)
+	switch (_type)
 	{
-		ThrowErrCode(ErrCode::InvalidXmlData, "StagePhaseCondition_Variable" + args);
+		case StagePhaseConditionType::Variable:
+		{
+			outVariableNames.push_back(_variable._name);
+		}
+		break;
+		case StagePhaseConditionType::UserData:
+		{
+			outUsesUserData = true;
+		}
+		break;
+		default:
+		{
+			static_assert(static_cast<int>(StagePhaseConditionType::Count) == 2, "Ÿ ߰ Ȯ");
+			check(false, "Ÿ ߰ Ȯ");
+		}
+		break;
 	}
 }
 
-bool StagePhaseCondition_Variable::checkCondition(void) const noexcept
+void StagePhaseCondition::parseVariable(const std::string& args)
 {
-	check(SMGFramework::getStageManager() != nullptr);
-	int variable = SMGFramework::getStageManager()->getStageScriptVariable(_name);
-
-	return D3DUtil::compare(_operator, variable, _value);
+	std::string name;
+	bool rv = D3DUtil::parseComparison(args, name, _variable._operator, _variable._value);
+	if (!rv)
+	{
+		ThrowErrCode(ErrCode::InvalidXmlData, "StagePhaseCondition_Variable" + args);
+	}
+	_variable._name = NameTable::getNameId(name);
 }
 
-StagePhaseCondition_UserData::StagePhaseCondition_UserData(const std::string& args)
+void StagePhaseCondition::parseUserData(const std::string& args)
 {
 	// save file ۾ϸ鼭   [9/3/2021 qwerw]
 	const auto& tokenized = D3DUtil::tokenizeString(args, '_');
@@ -79,21 +118,87 @@ StagePhaseCondition_UserData::StagePhaseCondition_UserData(const std::string& ar
 	{
 		ThrowErrCode(ErrCode::InvalidXmlData, "StagePhaseCondition_UserData" + args);
 	}
-	_name = tokenized[0];
-	_value = std::stoi(tokenized[1]);
+	if (tokenized[0] == "Life")
+	{
+		_userData._userDataType = UserDataType::Life;
+	}
+	else
+	{
+		static_assert(static_cast<int>(UserDataType::Count) == 1, "Ÿ ߰ Ȯ");
+		ThrowErrCode(ErrCode::InvalidXmlData, "StagePhaseCondition_UserData" + args);
+	}
+	_userData._value = std::stoi(tokenized[1]);
 }
 
-bool StagePhaseCondition_UserData::checkCondition(void) const noexcept
+bool StagePhaseCondition::checkUserData(void) const noexcept
 {
 	// save file ۾ϸ鼭   [9/3/2021 qwerw]
-	if (_name == "Life")
+	switch (_userData._userDataType)
 	{
-		if (SMGFramework::Get().getUserData()->getLife() == _value)
+		case UserDataType::Life:
 		{
-			return true;
+			return SMGFramework::Get().getUserData()->getLife() == _userData._value;
 		}
-		return false;
+		default:
+		{
+			static_assert(static_cast<int>(UserDataType::Count) == 1, "Ÿ ߰ Ȯ");
+			check(false, "̱");
+			return false;
+		}
+	}
+}
+
+StagePhaseConditionProgram::StagePhaseConditionProgram(void) noexcept
+{
+
+}
+
+void StagePhaseConditionProgram::compile(const std::string& conditionStrings)
+{
+	check(_conditions.empty());
+	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
+	_conditions.resize(conditionTokenized.size());
+	for (size_t i = 0; i < conditionTokenized.size(); ++i)
+	{
+		StagePhaseCondition::parseConditionString(conditionTokenized[i], _conditions[i]);
+	}
+	if (std::numeric_limits<uint8_t>::max() < _conditions.size())
+	{
+		ThrowErrCode(ErrCode::InvalidXmlData, " ʹ ϴ. " + conditionStrings);
+	}
+}
+
+bool StagePhaseConditionProgram::evaluate(void) const noexcept
+{
+#if defined DEBUG | defined _DEBUG
+	++_statistics._programCheckCount;
+#endif
+	for (const auto& condition : _conditions)
+	{
+		if (condition.isNotCondition() == condition.checkCondition())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void StagePhaseConditionProgram::getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept
+{
+	for (const auto& condition : _conditions)
+	{
+		condition.getDependency(outVariableNames, outUsesUserData);
+	}
+}
+
+void StagePhaseConditionProgram::logStatistics(void) noexcept
+{
+	if (_statistics._programCheckCount == 0 && _statistics._evaluationSkipCount == 0)
+	{
+		return;
 	}
-	check(false, "̱");
-	return false;
+	const std::string text = "[StagePhaseCondition] programCheck: " + std::to_string(_statistics._programCheckCount) +
+		" evaluationSkip: " + std::to_string(_statistics._evaluationSkipCount) + "\n";
+	OutputDebugStringA(text.c_str());
+	_statistics = StagePhaseConditionStatistics();
 }
@@ -3,41 +3,76 @@
 
 class XMLReaderNode;
 
+//   ϳ. ActionCondition  ŸԺ ڸ union  switch Ѵ.
 class StagePhaseCondition
 {
 public:
-	StagePhaseCondition();
-	virtual ~StagePhaseCondition() = default;
-	virtual StagePhaseConditionType getType(void) const noexcept = 0;
-	virtual bool checkCondition(void) const noexcept = 0;
+	StagePhaseCondition() noexcept;
+	static void parseConditionString(const std::string& input, StagePhaseCondition& outCondition);
+	StagePhaseConditionType getType(void) const noexcept { return _type; }
 	bool isNotCondition(void) const noexcept { return _not; }
-	void setNotCondition(void) noexcept { _not = true; }
-	static std::unique_ptr<StagePhaseCondition> parseConditionString(const std::string& input);
+	bool checkCondition(void) const noexcept;
+	//   ִ   UserData  θ ߰Ѵ.
+	void getDependency(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept;
 private:
+	void parseVariable(const std::string& args);
+	void parseUserData(const std::string& args);
+	bool checkUserData(void) const noexcept;
+private:
+	struct Variable
+	{
+		NameId _name;
+		OperatorType _operator;
+		int _value;
+	};
+	// save file ۾ϸ鼭   [9/3/2021 qwerw]
+	enum class UserDataType : uint8_t
+	{
+		Life,
+
+		Count,
+	};
+	struct UserData
+	{
+		UserDataType _userDataType;
+		int _value;
+	};
+
+	StagePhaseConditionType _type;
 	bool _not;
+	union
+	{
+		Variable _variable;
+		UserData _userData;
+	};
 };
 
-class StagePhaseCondition_Variable : public StagePhaseCondition
+//  忡 .
+struct StagePhaseConditionStatistics
 {
-public:
-	StagePhaseCondition_Variable(const std::string& args);
-	virtual ~StagePhaseCondition_Variable() = default;
-	virtual StagePhaseConditionType getType(void) const noexcept override { return StagePhaseConditionType::Variable; }
-	virtual bool checkCondition(void) const noexcept override;
-private:
-	std::string _name;
-	OperatorType _operator;
-	int _value;
+	uint64_t _programCheckCount = 0;
+	// Է ٲ ʾƼ   Ƚ
+	uint64_t _evaluationSkipCount = 0;
 };
 
-class StagePhaseCondition_UserData : public StagePhaseCondition
+// εҶ  ڿ Ľص .   ̸ ̴.
+class StagePhaseConditionProgram
 {
 public:
-	StagePhaseCondition_UserData(const std::string& args);
-	virtual ~StagePhaseCondition_UserData() = default;
-	virtual StagePhaseConditionType getType(void) const noexcept override { return StagePhaseConditionType::Variable; }
-	virtual bool checkCondition(void) const noexcept override;
+	StagePhaseConditionProgram(void) noexcept;
+	void compile(const std::string& conditionStrings);
+	bool evaluate(void) const noexcept;
+	void getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept;
+
+	static void countSkippedEvaluation(void) noexcept
+	{
+#if defined DEBUG | defined _DEBUG
+		++_statistics._evaluationSkipCount;
+#endif
+	}
+	static void logStatistics(void) noexcept;
 private:
-	std::string _name;
-	int _value;
-};
\ No newline at end of file
+	std::vector<StagePhaseCondition> _conditions;
+
+	static StagePhaseConditionStatistics _statistics;
+};
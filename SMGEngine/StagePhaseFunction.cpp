@@ -12,13 +12,7 @@ StagePhaseFunction::StagePhaseFunction(const XMLReaderNode& node)
 	std::string conditionStrings;
 	node.loadAttribute("Condition", conditionStrings);
 
-	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<StagePhaseCondition> condition = StagePhaseCondition::parseConditionString(c);
-		check(condition != nullptr);
-		_conditions.push_back(std::move(condition));
-	}
+	_conditionProgram.compile(conditionStrings);
 
 	node.loadAttribute("ProcessCount", _processCountInit);
 	_processCount = _processCountInit;
@@ -31,19 +25,12 @@ void StagePhaseFunction::process(void) noexcept
 
 bool StagePhaseFunction::checkConditions(void) const noexcept
 {
-	if (_processCount == 0)
-	{
-		return false;
-	}
+	return _conditionProgram.evaluate();
+}
 
-	for (const auto& condition : _conditions)
-	{
-		if (condition->isNotCondition() == condition->checkCondition())
-		{
-			return false;
-		}
-	}
-	return true;
+void StagePhaseFunction::getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept
+{
+	_conditionProgram.getDependencies(outVariableNames, outUsesUserData);
 }
 
 std::unique_ptr<StagePhaseFunction> StagePhaseFunction::loadXMLFunction(const XMLReaderNode& node)
@@ -1,7 +1,7 @@
 #pragma once
 #include "TypeStage.h"
+#include "StagePhaseCondition.h"
 
-class StagePhaseCondition;
 class XMLReaderNode;
 
 class StagePhaseFunction
@@ -12,9 +12,12 @@ public:
 	virtual void process(void) noexcept;
 	virtual StagePhaseFunctionType getType() const noexcept = 0;
 	bool checkConditions(void) const noexcept;
+	// ProcessCountŭ  true
+	bool isProcessEnd(void) const noexcept { return _processCount == 0; }
+	void getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept;
 	static std::unique_ptr<StagePhaseFunction> loadXMLFunction(const XMLReaderNode& node);
 private:
-	std::vector<std::unique_ptr<StagePhaseCondition>> _conditions;
+	StagePhaseConditionProgram _conditionProgram;
 	int _processCount;
 	int _processCountInit;
 };
@@ -3,8 +3,12 @@
 #include "FileHelper.h"
 #include "StagePhaseFunction.h"
 #include "StagePhaseCondition.h"
+#include "SMGFramework.h"
+#include "StageManager.h"
+#include "UserData.h"
 
 StagePhase::StagePhase(const XMLReaderNode& node)
+	: _userDataVersion(0)
 {
 	const auto& childNodes = node.getChildNodes();
 	for (const auto& childNode : childNodes)
@@ -23,6 +27,42 @@ StagePhase::StagePhase(const XMLReaderNode& node)
 			ThrowErrCode(ErrCode::InvalidXmlData, nodeName);
 		}
 	}
+
+	const size_t itemCount = _branches.size() + _functions.size();
+	if (std::numeric_limits<uint16_t>::max() < itemCount)
+	{
+		ThrowErrCode(ErrCode::Overflow, "branch, function ʹ ϴ. " + std::to_string(itemCount));
+	}
+	_dirtyItems.assign(itemCount, 1);
+	_functionConditionResults.assign(_functions.size(), 0);
+
+	std::vector<NameId> variableNames;
+	for (size_t i = 0; i < itemCount; ++i)
+	{
+		variableNames.clear();
+		bool usesUserData = false;
+		if (i < _branches.size())
+		{
+			_branches[i].getDependencies(variableNames, usesUserData);
+		}
+		else
+		{
+			_functions[i - _branches.size()]->getDependencies(variableNames, usesUserData);
+		}
+
+		std::sort(variableNames.begin(), variableNames.end());
+		variableNames.erase(std::unique(variableNames.begin(), variableNames.end()), variableNames.end());
+		for (const auto& variableName : variableNames)
+		{
+			_variableSubscriptions.push_back({ variableName, static_cast<uint16_t>(i) });
+		}
+		if (usesUserData)
+		{
+			_userDataSubscriptions.push_back(static_cast<uint16_t>(i));
+		}
+	}
+	std::stable_sort(_variableSubscriptions.begin(), _variableSubscriptions.end(),
+		[](const Subscription& lhs, const Subscription& rhs) { return lhs._name < rhs._name; });
 }
 
 StagePhase::~StagePhase()
@@ -30,13 +70,51 @@ StagePhase::~StagePhase()
 
 }
 
-bool StagePhase::getNextPhaseName(std::string& nextPhaseName) const noexcept
+void StagePhase::enterPhase(void) noexcept
 {
-	for (const auto& branch : _branches)
+	std::fill(_dirtyItems.begin(), _dirtyItems.end(), 1);
+	_userDataVersion = SMGFramework::getUserData()->getVersion();
+}
+
+void StagePhase::onVariableChanged(NameId name) noexcept
+{
+	auto it = std::lower_bound(_variableSubscriptions.begin(), _variableSubscriptions.end(), name,
+		[](const Subscription& subscription, NameId name) { return subscription._name < name; });
+	for (; it != _variableSubscriptions.end() && it->_name == name; ++it)
+	{
+		_dirtyItems[it->_itemIndex] = 1;
+	}
+}
+
+void StagePhase::checkUserDataVersion(void) noexcept
+{
+	const uint32_t version = SMGFramework::getUserData()->getVersion();
+	if (_userDataVersion == version)
+	{
+		return;
+	}
+	_userDataVersion = version;
+	for (const auto& itemIndex : _userDataSubscriptions)
 	{
-		if (branch.checkBranchCondition())
+		_dirtyItems[itemIndex] = 1;
+	}
+}
+
+bool StagePhase::getNextPhaseName(std::string& nextPhaseName) noexcept
+{
+	checkUserDataVersion();
+	// ٽ  ʴ branch  ̾ Էµ ״̹Ƿ  ̴.
+	for (size_t i = 0; i < _branches.size(); ++i)
+	{
+		if (_dirtyItems[i] == 0)
+		{
+			StagePhaseConditionProgram::countSkippedEvaluation();
+			continue;
+		}
+		_dirtyItems[i] = 0;
+		if (_branches[i].checkBranchCondition())
 		{
-			nextPhaseName = branch.getStagePhase();
+			nextPhaseName = _branches[i].getStagePhase();
 			return true;
 		}
 	}
@@ -45,11 +123,30 @@ bool StagePhase::getNextPhaseName(std::string& nextPhaseName) const noexcept
 
 void StagePhase::processFunctions(void) noexcept
 {
-	for (const auto& function : _functions)
+	checkUserDataVersion();
+	for (size_t i = 0; i < _functions.size(); ++i)
 	{
-		if (function->checkConditions())
+		auto& function = _functions[i];
+		if (function->isProcessEnd())
+		{
+			continue;
+		}
+		const size_t itemIndex = _branches.size() + i;
+		if (_dirtyItems[itemIndex] != 0)
+		{
+			_dirtyItems[itemIndex] = 0;
+			_functionConditionResults[i] = function->checkConditions();
+		}
+		else
+		{
+			StagePhaseConditionProgram::countSkippedEvaluation();
+		}
+
+		if (_functionConditionResults[i] != 0)
 		{
 			function->process();
+			//   ٲ UserData ڿ ִ function ٷ ݿѴ.
+			checkUserDataVersion();
 		}
 	}
 }
@@ -128,25 +225,15 @@ StagePhaseBranch::StagePhaseBranch(const XMLReaderNode& node)
 	node.loadAttribute("Phase", _stagePhase);
 	std::string conditionStrings;
 	node.loadAttribute("Condition", conditionStrings);
-
-	std::vector<std::string> conditionTokenized = D3DUtil::tokenizeString(conditionStrings, ' ');
-	_conditions.reserve(conditionTokenized.size());
-	for (const auto& c : conditionTokenized)
-	{
-		std::unique_ptr<StagePhaseCondition> condition = StagePhaseCondition::parseConditionString(c);
-		check(condition != nullptr);
-		_conditions.push_back(std::move(condition));
-	}
+	_conditionProgram.compile(conditionStrings);
 }
 
 bool StagePhaseBranch::checkBranchCondition(void) const noexcept
 {
-	for (const auto& condition : _conditions)
-	{
-		if (condition->isNotCondition() == condition->checkCondition())
-		{
-			return false;
-		}
-	}
-	return true;
+	return _conditionProgram.evaluate();
+}
+
+void StagePhaseBranch::getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept
+{
+	_conditionProgram.getDependencies(outVariableNames, outUsesUserData);
 }
@@ -1,8 +1,8 @@
 #pragma once
+#include "StagePhaseCondition.h"
 
 class XMLReaderNode;
 class StagePhaseFunction;
-class StagePhaseCondition;
 
 class StagePhaseBranch
 {
@@ -10,20 +10,42 @@ public:
 	StagePhaseBranch(const XMLReaderNode& node);
 	const std::string& getStagePhase() const noexcept { return _stagePhase; }
 	bool checkBranchCondition(void) const noexcept;
+	void getDependencies(std::vector<NameId>& outVariableNames, bool& outUsesUserData) const noexcept;
 private:
 	std::string _stagePhase;
-	std::vector<std::unique_ptr<StagePhaseCondition>> _conditions;
+	StagePhaseConditionProgram _conditionProgram;
 };
+// branch function  д  , UserData ϰ   ٲ  ٽ Ѵ.
 class StagePhase
 {
 public:
 	StagePhase(const XMLReaderNode& node);
 	~StagePhase();
-	bool getNextPhaseName(std::string& nextPhaseName) const noexcept;
+	//  phase ٲ ȣѴ.   ٽ ϵ Ѵ.
+	void enterPhase(void) noexcept;
+	//   ٲ StageManager ȣѴ.
+	void onVariableChanged(NameId name) noexcept;
+	bool getNextPhaseName(std::string& nextPhaseName) noexcept;
+	//   function  ٲ𶧱   Ѵ.
 	void processFunctions(void) noexcept;
 private:
+	void checkUserDataVersion(void) noexcept;
+private:
+	struct Subscription
+	{
+		NameId _name;
+		uint16_t _itemIndex;
+	};
 	std::vector<StagePhaseBranch> _branches;
 	std::vector<std::unique_ptr<StagePhaseFunction>> _functions;
+	// branch, function  ȣ δ. ٽ ؾ ϸ 1
+	std::vector<uint8_t> _dirtyItems;
+	// function    
+	std::vector<uint8_t> _functionConditionResults;
+	// _name  ĵǾ ִ.
+	std::vector<Subscription> _variableSubscriptions;
+	std::vector<uint16_t> _userDataSubscriptions;
+	uint32_t _userDataVersion;
 };
 
 class StageScript
@@ -10,7 +10,11 @@
 #include "CharacterInfoManager.h"
 #include "ObjectInfo.h"
 #include "StageManager.h"
+#include "Path.h"
+#include <tuple>
+#include <chrono>
 
+TerrainCollisionStatistics Terrain::_statistics;
 
 bool Terrain::isGround(void) const noexcept
 {
@@ -25,19 +29,38 @@ bool Terrain::isWall(void) const noexcept
 Terrain::Terrain(const TerrainObjectInfo& terrainInfo)
 	: _vertexBuffer(nullptr)
 	, _indexBuffer(nullptr)
+	, _vertexCount(0)
+	, _treeCost(0.f)
+	, _builtTreeCost(0.f)
 	, _max(0, 0, 0)
 	, _min(0, 0, 0)
+	, _path(nullptr)
+	, _pathTime(0)
+	, _rotateSpeed(terrainInfo.getRotateSpeed())
+	, _rotateAngle(0.f)
+	, _position(terrainInfo.getPosition())
+	, _direction(terrainInfo.getDirection())
+	, _upVector(terrainInfo.getUpVector())
 {
 	_isGround = terrainInfo.isGround();
 	_isWall = terrainInfo.isWall();
+	_collisionType = terrainInfo.getCollisionType();
 
 	_gameObject = SMGFramework::getD3DApp()->createObjectFromXML(terrainInfo.getObjectFileName());
 
-	_gameObject->setWorldMatrix(terrainInfo.getPosition(),
-		terrainInfo.getDirection(),
-		terrainInfo.getUpVector(),
-		terrainInfo.getSize());
 	_size = terrainInfo.getSize();
+	if (0 <= terrainInfo.getPathKey())
+	{
+		_path = SMGFramework::getStageManager()->getStageInfo()->getPath(terrainInfo.getPathKey());
+		if (_path == nullptr)
+		{
+			ThrowErrCode(ErrCode::PathNotFound, "terrain path : " + std::to_string(terrainInfo.getPathKey()));
+		}
+		_position = _path->getPathStartPosition();
+	}
+	_gameObject->setShadowStatic(!isMoving());
+	setWorldMatrix(_position, _direction);
+	XMStoreFloat4x4(&_deltaMatrix, XMMatrixIdentity());
 #if defined DEBUG | defined _DEBUG
 	//SMGFramework::getD3DApp()->createGameObjectDev(_gameObject);
 #endif
@@ -45,17 +68,75 @@ Terrain::Terrain(const TerrainObjectInfo& terrainInfo)
 	if (_isGround || _isWall)
 	{
 		makeAABBTree();
+		if (_collisionType == TerrainCollisionType::DistanceField)
+		{
+			makeDistanceField();
+		}
 	}
 }
 
 Terrain::~Terrain()
 {
+	// ׶ ۾ ޽ø а   ִ.
+	if (isTreeRebuilding())
+	{
+		_treeRebuildFuture.wait();
+	}
 	if (!SMGFramework::getStageManager()->isLoading())
 	{
 		SMGFramework::getD3DApp()->removeGameObject(_gameObject);
 	}
 }
 
+void Terrain::setWorldMatrix(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction) noexcept
+{
+	_gameObject->setWorldMatrix(position, direction, _upVector, _size);
+	XMMATRIX inverseMatrix = XMMatrixInverse(nullptr, XMLoadFloat4x4(&_gameObject->getWorldMatrix()));
+	XMStoreFloat4x4(&_inverseWorldMatrix, inverseMatrix);
+}
+
+bool Terrain::isMoving(void) const noexcept
+{
+	return _path != nullptr || !MathHelper::equal(_rotateSpeed, 0.f);
+}
+
+bool Terrain::updateTransform(const TickCount64& deltaTick) noexcept
+{
+	if (!isMoving() || deltaTick == 0)
+	{
+		return false;
+	}
+
+	XMFLOAT3 position = _position;
+	if (_path != nullptr)
+	{
+		//  ó ٷ ư   ִ actor ̵ϹǷ պѴ.
+		const TickCount64 moveTick = _path->getMoveTick();
+		if (moveTick == 0)
+		{
+			_pathTime = 0;
+		}
+		else
+		{
+			_pathTime = (_pathTime + deltaTick) % (moveTick * 2);
+		}
+		const TickCount64 pathTime = (_pathTime <= moveTick) ? _pathTime : moveTick * 2 - _pathTime;
+		_path->getPathPositionAtTime(pathTime, position, InterpolationType::Linear);
+	}
+	XMFLOAT3 direction = _direction;
+	if (!MathHelper::equal(_rotateSpeed, 0.f))
+	{
+		_rotateAngle = MathHelper::AddRadian(_rotateAngle, _rotateSpeed * deltaTick);
+		XMMATRIX rotateMatrix = XMMatrixRotationAxis(XMLoadFloat3(&_upVector), _rotateAngle);
+		XMStoreFloat3(&direction, XMVector3TransformNormal(XMLoadFloat3(&_direction), rotateMatrix));
+	}
+
+	XMMATRIX previousInverse = XMLoadFloat4x4(&_inverseWorldMatrix);
+	setWorldMatrix(position, direction);
+	XMStoreFloat4x4(&_deltaMatrix, previousInverse * XMLoadFloat4x4(&_gameObject->getWorldMatrix()));
+	return true;
+}
+
 void Terrain::makeAABBTree(void)
 {
 	check(_gameObject != nullptr);
@@ -84,41 +165,138 @@ void Terrain::makeAABBTree(void)
 		}
 	}
 
-	size_t vertexCount;
-	_vertexBuffer = mesh->getVertexBufferXXX(vertexCount);
+	_vertexBuffer = mesh->getVertexBufferXXX(_vertexCount);
 	_indexBuffer = mesh->getIndexBufferXXX();
 
-	const auto& subMesh = mesh->_subMeshList[terrainLeafList[0]._subMeshIndex];
-	_min = getVertexFromLeafNode(terrainLeafList[0], 0)._position;
-	_max = _min;
-	for (int i = 0; i < terrainLeafList.size(); ++i)
+	TerrainTreeBuildResult result;
+	buildTreeXXX(_deformedPositions, terrainLeafList, result);
+	applyTreeBuildResult(result);
+}
+
+void Terrain::buildTreeXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+	std::vector<TerrainAABBNode::DataType::Leaf>& terrainLeafList,
+	TerrainTreeBuildResult& outResult) const
+{
+	check(!terrainLeafList.empty());
+
+	XMFLOAT3 min = getPositionXXX(positions, terrainLeafList[0], 0);
+	XMFLOAT3 max = min;
+	for (const auto& leaf : terrainLeafList)
 	{
 		for (int j = 0; j < 3; ++j)
 		{
-			const Vertex& vertex = getVertexFromLeafNode(terrainLeafList[i], j);
+			const XMFLOAT3& position = getPositionXXX(positions, leaf, j);
+
+			min.x = std::min(min.x, position.x);
+			min.y = std::min(min.y, position.y);
+			min.z = std::min(min.z, position.z);
+
+			max.x = std::max(max.x, position.x);
+			max.y = std::max(max.y, position.y);
+			max.z = std::max(max.z, position.z);
+		}
+	}
+	outResult._min = min;
+	outResult._max = max;
+
+	outResult._aabbNodes.clear();
+	outResult._aabbNodes.reserve(terrainLeafList.size() * 2 - 1);
+	makeAABBTreeXXX(positions, terrainLeafList, 0, terrainLeafList.size(), XMLoadFloat3(&min), XMLoadFloat3(&max), outResult._aabbNodes);
+
+	makeTriangleNeighbors(outResult._aabbNodes, outResult._triangleNeighborOffsets, outResult._triangleNeighbors);
+
+	std::vector<std::array<XMFLOAT3, 2>> nodeBounds;
+	outResult._treeCost = computeNodeBoundsXXX(positions, outResult._aabbNodes, nodeBounds);
+}
 
-			_min.x = std::min(_min.x, vertex._position.x);
-			_min.y = std::min(_min.y, vertex._position.y);
-			_min.z = std::min(_min.z, vertex._position.z);
+void Terrain::applyTreeBuildResult(TerrainTreeBuildResult& result) noexcept
+{
+	_aabbNodes.swap(result._aabbNodes);
+	_triangleNeighborOffsets.swap(result._triangleNeighborOffsets);
+	_triangleNeighbors.swap(result._triangleNeighbors);
+	_min = result._min;
+	_max = result._max;
+	_treeCost = result._treeCost;
+	_builtTreeCost = result._treeCost;
+}
 
-			_max.x = std::max(_max.x, vertex._position.x);
-			_max.y = std::max(_max.y, vertex._position.y);
-			_max.z = std::max(_max.z, vertex._position.z);
+void Terrain::makeTriangleNeighbors(const std::vector<TerrainAABBNode>& aabbNodes,
+	std::vector<uint32_t>& outNeighborOffsets,
+	std::vector<uint16_t>& outNeighbors) const
+{
+	// ص   Ƿ ޽  ġ ã´.
+	const std::vector<XMFLOAT3> meshPositions;
+	// ޽ø     Ƿ ε ƴ϶ ġ  θ ǴѴ.
+	std::map<std::tuple<float, float, float>, std::vector<uint16_t>> trianglesByPosition;
+	for (size_t i = 0; i < aabbNodes.size(); ++i)
+	{
+		const uint16_t nodeIndex = static_cast<uint16_t>(i);
+		if (!isLeafNodeXXX(aabbNodes[i]))
+		{
+			continue;
+		}
+		for (int j = 0; j < 3; ++j)
+		{
+			const XMFLOAT3& position = getPositionXXX(meshPositions, aabbNodes[i]._data._leaf, j);
+			trianglesByPosition[std::make_tuple(position.x, position.y, position.z)].push_back(nodeIndex);
+		}
+	}
+
+	outNeighborOffsets.assign(aabbNodes.size() + 1, 0);
+	outNeighbors.clear();
+	std::vector<uint16_t> neighbors;
+	for (size_t i = 0; i < aabbNodes.size(); ++i)
+	{
+		outNeighborOffsets[i] = static_cast<uint32_t>(outNeighbors.size());
+		const uint16_t nodeIndex = static_cast<uint16_t>(i);
+		if (!isLeafNodeXXX(aabbNodes[i]))
+		{
+			continue;
+		}
+		neighbors.clear();
+		for (int j = 0; j < 3; ++j)
+		{
+			const XMFLOAT3& position = getPositionXXX(meshPositions, aabbNodes[i]._data._leaf, j);
+			const auto& sharing = trianglesByPosition[std::make_tuple(position.x, position.y, position.z)];
+			neighbors.insert(neighbors.end(), sharing.begin(), sharing.end());
+		}
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+		for (const auto& neighbor : neighbors)
+		{
+			if (neighbor != nodeIndex)
+			{
+				outNeighbors.push_back(neighbor);
+			}
 		}
 	}
+	outNeighborOffsets.back() = static_cast<uint32_t>(outNeighbors.size());
+}
 
-	XMVECTOR min = XMLoadFloat3(&_min);
-	XMVECTOR max = XMLoadFloat3(&_max);
-	// reserve ũ üũؾ [6/24/2021 qwerw]
-	_aabbNodes.reserve(vertexCount);
-	makeAABBTreeXXX(terrainLeafList, 0, terrainLeafList.size(), min, max);
+void Terrain::makeDistanceField(void)
+{
+	std::vector<XMFLOAT3> triangles;
+	for (size_t i = 0; i < _aabbNodes.size(); ++i)
+	{
+		if (!isLeafNode(static_cast<uint16_t>(i)))
+		{
+			continue;
+		}
+		for (int j = 0; j < 3; ++j)
+		{
+			triangles.push_back(getPositionFromLeafNode(_aabbNodes[i]._data._leaf, j));
+		}
+	}
+	_distanceField.build(_min, _max, triangles);
 }
 
-uint16_t XM_CALLCONV Terrain::makeAABBTreeXXX(std::vector<TerrainAABBNode::DataType::Leaf>& terrainLeafList,
+uint16_t XM_CALLCONV Terrain::makeAABBTreeXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+	std::vector<TerrainAABBNode::DataType::Leaf>& terrainLeafList,
 	int begin,
 	int end,
 	FXMVECTOR min,
-	FXMVECTOR max)
+	FXMVECTOR max,
+	std::vector<TerrainAABBNode>& outNodes) const
 {
 	check(begin < end);
 	check(_vertexBuffer != nullptr);
@@ -135,7 +313,7 @@ uint16_t XM_CALLCONV Terrain::makeAABBTreeXXX(std::vector<TerrainAABBNode::DataT
 	}
 	else
 	{
-		node._data._node = getAABBRange(terrainLeafList, begin, end, min, max);
+		node._data._node = getAABBRange(positions, terrainLeafList, begin, end, min, max);
 
 		XMVECTOR minXyz = DirectX::XMVectorSet(node._data._node._minX,
 			node._data._node._minY,
@@ -177,28 +355,45 @@ uint16_t XM_CALLCONV Terrain::makeAABBTreeXXX(std::vector<TerrainAABBNode::DataT
 			}
 		}
 
-		sortIndexList(terrainLeafList, begin, end, divideType);
+		sortIndexList(positions, terrainLeafList, begin, end, divideType);
 		int mid = (begin + end) / 2;
 
-		node._children[0] = makeAABBTreeXXX(terrainLeafList, begin, mid, nextMin, nextMax);
-		node._children[1] = makeAABBTreeXXX(terrainLeafList, mid, end, nextMin, nextMax);
+		node._children[0] = makeAABBTreeXXX(positions, terrainLeafList, begin, mid, nextMin, nextMax, outNodes);
+		node._children[1] = makeAABBTreeXXX(positions, terrainLeafList, mid, end, nextMin, nextMax, outNodes);
 	}
-	_aabbNodes.push_back(node);
+	outNodes.push_back(node);
 
-	if (_aabbNodes.size() - 1 >= std::numeric_limits<uint16_t>::max())
+	if (outNodes.size() - 1 >= std::numeric_limits<uint16_t>::max())
 	{
 		ThrowErrCode(ErrCode::Overflow, " ٲ");
 	}
-	return (_aabbNodes.size() - 1);
+	return (outNodes.size() - 1);
 }
 
-const Vertex& Terrain::getVertexFromLeafNode(const TerrainAABBNode::DataType::Leaf& leafNode, const int offset) const noexcept
+const DirectX::XMFLOAT3& Terrain::getPositionXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+	const TerrainAABBNode::DataType::Leaf& leafNode,
+	const int offset) const noexcept
 {
 	const auto& subMesh = _gameObject->getMeshGeometry()->_subMeshList[leafNode._subMeshIndex];
-	return _vertexBuffer[subMesh._baseVertexLoaction + _indexBuffer[subMesh._baseIndexLoacation + leafNode._index + offset]];
+	const size_t vertexIndex = subMesh._baseVertexLoaction + _indexBuffer[subMesh._baseIndexLoacation + leafNode._index + offset];
+	if (positions.empty())
+	{
+		return _vertexBuffer[vertexIndex]._position;
+	}
+	check(vertexIndex < positions.size());
+	return positions[vertexIndex];
+}
+
+const DirectX::XMFLOAT3& Terrain::getPositionFromLeafNode(const TerrainAABBNode::DataType::Leaf& leafNode, const int offset) const noexcept
+{
+	return getPositionXXX(_deformedPositions, leafNode, offset);
 }
 
-void Terrain::sortIndexList(std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList, int begin, int end, DivideType divideType) const noexcept
+void Terrain::sortIndexList(const std::vector<DirectX::XMFLOAT3>& positions,
+	std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
+	int begin,
+	int end,
+	DivideType divideType) const noexcept
 {
 	check(begin <= end);
 	check(_vertexBuffer != nullptr);
@@ -217,14 +412,14 @@ void Terrain::sortIndexList(std::vector<TerrainAABBNode::DataType::Leaf>& terrai
 	// merge sort ٲٴ° غ . [6/25/2021 qwerw]
 	std::swap(terrainIndexList[begin], terrainIndexList[(begin + end) / 2]);
 
-	float pivotValue = sortCompareValue(terrainIndexList[begin], divideType);
+	float pivotValue = sortCompareValue(positions, terrainIndexList[begin], divideType);
 	while (true)
 	{
-		while (i < end && sortCompareValue(terrainIndexList[i], divideType) <= pivotValue)
+		while (i < end && sortCompareValue(positions, terrainIndexList[i], divideType) <= pivotValue)
 		{
 			i++;
 		}
-		while (j > begin && sortCompareValue(terrainIndexList[j], divideType) >= pivotValue)
+		while (j > begin && sortCompareValue(positions, terrainIndexList[j], divideType) >= pivotValue)
 		{
 			j--;
 		}
@@ -239,11 +434,13 @@ void Terrain::sortIndexList(std::vector<TerrainAABBNode::DataType::Leaf>& terrai
 			break;
 		}
 	}
-	sortIndexList(terrainIndexList, begin, j, divideType);
-	sortIndexList(terrainIndexList, j + 1, end, divideType);
+	sortIndexList(positions, terrainIndexList, begin, j, divideType);
+	sortIndexList(positions, terrainIndexList, j + 1, end, divideType);
 }
 
-float Terrain::sortCompareValue(const TerrainAABBNode::DataType::Leaf& index, DivideType type) const noexcept
+float Terrain::sortCompareValue(const std::vector<DirectX::XMFLOAT3>& positions,
+	const TerrainAABBNode::DataType::Leaf& index,
+	DivideType type) const noexcept
 {
 	check(_vertexBuffer != nullptr);
 	check(_indexBuffer != nullptr);
@@ -251,19 +448,19 @@ float Terrain::sortCompareValue(const TerrainAABBNode::DataType::Leaf& index, Di
 	switch (type)
 	{
 		case DivideType::X:
-			return getVertexFromLeafNode(index, 0)._position.x +
-				getVertexFromLeafNode(index, 1)._position.x +
-				getVertexFromLeafNode(index, 2)._position.x;
+			return getPositionXXX(positions, index, 0).x +
+				getPositionXXX(positions, index, 1).x +
+				getPositionXXX(positions, index, 2).x;
 			break;
 		case DivideType::Y:
-			return getVertexFromLeafNode(index, 0)._position.y +
-				getVertexFromLeafNode(index, 1)._position.y +
-				getVertexFromLeafNode(index, 2)._position.y;
+			return getPositionXXX(positions, index, 0).y +
+				getPositionXXX(positions, index, 1).y +
+				getPositionXXX(positions, index, 2).y;
 			break;
 		case DivideType::Z:
-			return getVertexFromLeafNode(index, 0)._position.z +
-				getVertexFromLeafNode(index, 1)._position.z +
-				getVertexFromLeafNode(index, 2)._position.z;
+			return getPositionXXX(positions, index, 0).z +
+				getPositionXXX(positions, index, 1).z +
+				getPositionXXX(positions, index, 2).z;
 			break;
 		default:
 			check(false);
@@ -272,7 +469,8 @@ float Terrain::sortCompareValue(const TerrainAABBNode::DataType::Leaf& index, Di
 	return 0.f;
 }
 
-TerrainAABBNode::DataType::Node XM_CALLCONV Terrain::getAABBRange(std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
+TerrainAABBNode::DataType::Node XM_CALLCONV Terrain::getAABBRange(const std::vector<DirectX::XMFLOAT3>& positions,
+	std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
 	int begin,
 	int end,
 	FXMVECTOR min,
@@ -284,81 +482,476 @@ TerrainAABBNode::DataType::Node XM_CALLCONV Terrain::getAABBRange(std::vector<Te
 	check(0 <= begin && begin < terrainIndexList.size());
 	check(0 < end && end <= terrainIndexList.size());
 
-	TerrainAABBNode::DataType::Node aabbRange;
-	aabbRange._minX = std::numeric_limits<uint8_t>::max();
-	aabbRange._minY = std::numeric_limits<uint8_t>::max();
-	aabbRange._minZ = std::numeric_limits<uint8_t>::max();
-	aabbRange._maxX = 0;
-	aabbRange._maxY = 0;
-	aabbRange._maxZ = 0;
-
+	XMVECTOR boundsMin = XMLoadFloat3(&getPositionXXX(positions, terrainIndexList[begin], 0));
+	XMVECTOR boundsMax = boundsMin;
 	for (int i = begin; i < end; ++i)
 	{
 		for (int j = 0; j < 3; ++j)
 		{
-			const Vertex& vertex = getVertexFromLeafNode(terrainIndexList[i], j);
-			XMVECTOR position = XMLoadFloat3(&vertex._position);
-			position = (position - min) * std::numeric_limits<uint8_t>::max() / (max - min);
+			XMVECTOR position = XMLoadFloat3(&getPositionXXX(positions, terrainIndexList[i], j));
+			boundsMin = XMVectorMin(boundsMin, position);
+			boundsMax = XMVectorMax(boundsMax, position);
+		}
+	}
 
-			XMFLOAT3 positionF;
-			XMStoreFloat3(&positionF, position);
+	XMFLOAT3 boundsMinF, boundsMaxF, rangeMinF, rangeMaxF;
+	XMStoreFloat3(&boundsMinF, boundsMin);
+	XMStoreFloat3(&boundsMaxF, boundsMax);
+	XMStoreFloat3(&rangeMinF, min);
+	XMStoreFloat3(&rangeMaxF, max);
+	return quantizeRangeXXX(boundsMinF, boundsMaxF, rangeMinF, rangeMaxF);
+}
 
-			aabbRange._minX = std::min(aabbRange._minX, static_cast<uint8_t>(positionF.x));
-			aabbRange._minY = std::min(aabbRange._minY, static_cast<uint8_t>(positionF.y));
-			aabbRange._minZ = std::min(aabbRange._minZ, static_cast<uint8_t>(positionF.z));
+TerrainAABBNode::DataType::Node Terrain::quantizeRangeXXX(const DirectX::XMFLOAT3& boundsMin,
+	const DirectX::XMFLOAT3& boundsMax,
+	const DirectX::XMFLOAT3& rangeMin,
+	const DirectX::XMFLOAT3& rangeMax) noexcept
+{
+	constexpr float maxValue = static_cast<float>(std::numeric_limits<uint8_t>::max());
+	const float* boundsMinXyz = &boundsMin.x;
+	const float* boundsMaxXyz = &boundsMax.x;
+	const float* rangeMinXyz = &rangeMin.x;
+	const float* rangeMaxXyz = &rangeMax.x;
+
+	std::array<uint8_t, 3> quantizedMin;
+	std::array<uint8_t, 3> quantizedMax;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float minRate = 0.f;
+		float maxRate = 0.f;
+		const float rangeSize = rangeMaxXyz[axis] - rangeMinXyz[axis];
+		if (0.f < rangeSize)
+		{
+			minRate = (boundsMinXyz[axis] - rangeMinXyz[axis]) * maxValue / rangeSize;
+			maxRate = (boundsMaxXyz[axis] - rangeMinXyz[axis]) * maxValue / rangeSize;
+		}
+		quantizedMin[axis] = static_cast<uint8_t>(std::clamp(std::floor(minRate), 0.f, maxValue));
+		quantizedMax[axis] = static_cast<uint8_t>(std::clamp(std::ceil(maxRate), 0.f, maxValue));
 
-			aabbRange._maxX = std::max(aabbRange._maxX, static_cast<uint8_t>(ceil(positionF.x)));
-			aabbRange._maxY = std::max(aabbRange._maxY, static_cast<uint8_t>(ceil(positionF.y)));
-			aabbRange._maxZ = std::max(aabbRange._maxZ, static_cast<uint8_t>(ceil(positionF.z)));
+		//  忡    ǥ  
+		if (quantizedMin[axis] == quantizedMax[axis])
+		{
+			if (quantizedMax[axis] == std::numeric_limits<uint8_t>::max())
+			{
+				--quantizedMin[axis];
+			}
+			else
+			{
+				++quantizedMax[axis];
+			}
 		}
+		check(quantizedMin[axis] < quantizedMax[axis]);
 	}
-	//  忡    x, y, z ǥ  
-	if (aabbRange._minX == aabbRange._maxX)
+
+	TerrainAABBNode::DataType::Node aabbRange;
+	aabbRange._minX = quantizedMin[0];
+	aabbRange._minY = quantizedMin[1];
+	aabbRange._minZ = quantizedMin[2];
+	aabbRange._maxX = quantizedMax[0];
+	aabbRange._maxY = quantizedMax[1];
+	aabbRange._maxZ = quantizedMax[2];
+	return aabbRange;
+}
+
+float Terrain::computeNodeBoundsXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+	const std::vector<TerrainAABBNode>& aabbNodes,
+	std::vector<std::array<DirectX::XMFLOAT3, 2>>& outNodeBounds) const noexcept
+{
+	check(!aabbNodes.empty());
+	outNodeBounds.resize(aabbNodes.size());
+
+	//  ڽ  θ  Ǿ Ƿ տ ϸ ڽ   .
+	float internalArea = 0.f;
+	for (size_t i = 0; i < aabbNodes.size(); ++i)
 	{
-		if (aabbRange._maxX == std::numeric_limits<uint8_t>::max())
+		const auto& node = aabbNodes[i];
+		XMVECTOR boundsMin;
+		XMVECTOR boundsMax;
+		if (isLeafNodeXXX(node))
 		{
-			++aabbRange._minX;
+			XMVECTOR t0 = XMLoadFloat3(&getPositionXXX(positions, node._data._leaf, 0));
+			XMVECTOR t1 = XMLoadFloat3(&getPositionXXX(positions, node._data._leaf, 1));
+			XMVECTOR t2 = XMLoadFloat3(&getPositionXXX(positions, node._data._leaf, 2));
+			boundsMin = XMVectorMin(XMVectorMin(t0, t1), t2);
+			boundsMax = XMVectorMax(XMVectorMax(t0, t1), t2);
 		}
 		else
 		{
-			++aabbRange._maxX;
+			check(node._children[0] < i && node._children[1] < i);
+			const auto& bounds0 = outNodeBounds[node._children[0]];
+			const auto& bounds1 = outNodeBounds[node._children[1]];
+			boundsMin = XMVectorMin(XMLoadFloat3(&bounds0[0]), XMLoadFloat3(&bounds1[0]));
+			boundsMax = XMVectorMax(XMLoadFloat3(&bounds0[1]), XMLoadFloat3(&bounds1[1]));
+			internalArea += getSurfaceAreaXXX(boundsMin, boundsMax);
 		}
+		XMStoreFloat3(&outNodeBounds[i][0], boundsMin);
+		XMStoreFloat3(&outNodeBounds[i][1], boundsMax);
 	}
-	if (aabbRange._minY == aabbRange._maxY)
+
+	const auto& rootBounds = outNodeBounds.back();
+	const float rootArea = getSurfaceAreaXXX(XMLoadFloat3(&rootBounds[0]), XMLoadFloat3(&rootBounds[1]));
+	if (rootArea <= 0.f)
 	{
-		if (aabbRange._maxY == std::numeric_limits<uint8_t>::max())
+		return 0.f;
+	}
+	return internalArea / rootArea;
+}
+
+float XM_CALLCONV Terrain::getSurfaceAreaXXX(DirectX::FXMVECTOR min, DirectX::FXMVECTOR max) noexcept
+{
+	XMFLOAT3 size;
+	XMStoreFloat3(&size, max - min);
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+void Terrain::refitAABBTree(void) noexcept
+{
+	check(!_aabbNodes.empty());
+	_treeCost = computeNodeBoundsXXX(_deformedPositions, _aabbNodes, _refitNodeBounds);
+
+	const size_t rootIndex = _aabbNodes.size() - 1;
+	_min = _refitNodeBounds[rootIndex][0];
+	_max = _refitNodeBounds[rootIndex][1];
+
+	//   θ   ̹Ƿ Ʈ 鼭 ٽ Ѵ.
+	_refitNodeRanges.resize(_aabbNodes.size());
+	_refitNodeRanges[rootIndex] = { _min, _max };
+	for (size_t i = _aabbNodes.size(); 0 < i; --i)
+	{
+		const size_t nodeIndex = i - 1;
+		auto& node = _aabbNodes[nodeIndex];
+		if (isLeafNodeXXX(node))
 		{
-			++aabbRange._minY;
+			continue;
 		}
-		else
+		const auto& bounds = _refitNodeBounds[nodeIndex];
+		const auto& range = _refitNodeRanges[nodeIndex];
+		node._data._node = quantizeRangeXXX(bounds[0], bounds[1], range[0], range[1]);
+
+		XMVECTOR rangeMin = XMLoadFloat3(&range[0]);
+		XMVECTOR rangeMax = XMLoadFloat3(&range[1]);
+		XMVECTOR minXyz = XMVectorSet(node._data._node._minX, node._data._node._minY, node._data._node._minZ, 0);
+		XMVECTOR maxXyz = XMVectorSet(node._data._node._maxX, node._data._node._maxY, node._data._node._maxZ, 0);
+		std::array<XMFLOAT3, 2> childRange;
+		XMStoreFloat3(&childRange[0], rangeMin + (rangeMax - rangeMin) * minXyz / static_cast<float>(std::numeric_limits<uint8_t>::max()));
+		XMStoreFloat3(&childRange[1], rangeMin + (rangeMax - rangeMin) * maxXyz / static_cast<float>(std::numeric_limits<uint8_t>::max()));
+#if defined DEBUG | defined _DEBUG
+		//  ٻ    δ ȮѴ.  ŭ Ѵ.
+		XMVECTOR epsilon = (rangeMax - rangeMin) * 0.0001f + XMVectorReplicate(FLT_EPSILON);
+		check(XMVector3LessOrEqual(XMLoadFloat3(&childRange[0]), XMLoadFloat3(&bounds[0]) + epsilon) &&
+			XMVector3GreaterOrEqual(XMLoadFloat3(&childRange[1]) + epsilon, XMLoadFloat3(&bounds[1])),
+			"refit   ﰢ  ʽϴ.");
+#endif
+		_refitNodeRanges[node._children[0]] = childRange;
+		_refitNodeRanges[node._children[1]] = childRange;
+	}
+}
+
+void Terrain::setDeformedPositions(const std::vector<DirectX::XMFLOAT3>& positions)
+{
+	check(!_aabbNodes.empty(), "浹 Ʈ  terrainԴϴ.");
+	check(_collisionType != TerrainCollisionType::DistanceField, "Ÿ ϴ terrain   ϴ.");
+	check(positions.empty() || positions.size() == _vertexCount, "  ޽ÿ ٸϴ.");
+
+	_deformedPositions = positions;
+	refitAABBTree();
+
+	if (isTreeRebuilding() || _treeCost <= _builtTreeCost * TREE_REBUILD_COST_RATIO)
+	{
+		return;
+	}
+	std::vector<TerrainAABBNode::DataType::Leaf> terrainLeafList;
+	getLeafListXXX(terrainLeafList);
+	//  ȿ ġ ٲ  Ƿ  ġ ؼ ѱ.
+	// terrain StageManager reserve vector ־   Ű ʴ´.
+	_treeRebuildFuture = std::async(std::launch::async,
+		[this, positions = _deformedPositions, terrainLeafList = std::move(terrainLeafList)]() mutable
 		{
-			++aabbRange._maxY;
+			TerrainTreeBuildResult result;
+			buildTreeXXX(positions, terrainLeafList, result);
+			return result;
+		}).share();
+}
+
+bool Terrain::updateTreeRebuild(void)
+{
+	if (!isTreeRebuilding() ||
+		_treeRebuildFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return false;
+	}
+	TerrainTreeBuildResult result = _treeRebuildFuture.get();
+	_treeRebuildFuture = std::shared_future<TerrainTreeBuildResult>();
+	applyTreeBuildResult(result);
+	//   ٲ ġ .
+	refitAABBTree();
+	return true;
+}
+
+bool Terrain::isDeformable(void) const noexcept
+{
+	return !_aabbNodes.empty() && _collisionType == TerrainCollisionType::Triangle;
+}
+
+void Terrain::waitTreeRebuild(void)
+{
+	if (!isTreeRebuilding())
+	{
+		return;
+	}
+	_treeRebuildFuture.wait();
+	const bool isReplaced = updateTreeRebuild();
+	check(isReplaced);
+}
+
+float Terrain::getTreeCostRatio(void) const noexcept
+{
+	return _treeCost / std::max(_builtTreeCost, FLT_EPSILON);
+}
+
+void Terrain::getMeshPositions(std::vector<DirectX::XMFLOAT3>& outPositions) const
+{
+	outPositions.resize(_vertexCount);
+	for (size_t i = 0; i < _vertexCount; ++i)
+	{
+		outPositions[i] = _vertexBuffer[i]._position;
+	}
+}
+
+size_t Terrain::buildTree(const std::vector<DirectX::XMFLOAT3>& positions, TerrainTreeBuildResult& outResult) const
+{
+	check(positions.empty() || positions.size() == _vertexCount, "  ޽ÿ ٸϴ.");
+	std::vector<TerrainAABBNode::DataType::Leaf> terrainLeafList;
+	getLeafListXXX(terrainLeafList);
+	const size_t triangleCount = terrainLeafList.size();
+	buildTreeXXX(positions, terrainLeafList, outResult);
+	return triangleCount;
+}
+
+void Terrain::getLeafListXXX(std::vector<TerrainAABBNode::DataType::Leaf>& outLeafList) const
+{
+	outLeafList.clear();
+	outLeafList.reserve(_aabbNodes.size() / 2 + 1);
+	for (const auto& node : _aabbNodes)
+	{
+		if (isLeafNodeXXX(node))
+		{
+			outLeafList.push_back(node._data._leaf);
 		}
 	}
-	if (aabbRange._minZ == aabbRange._maxZ)
+}
+
+
+float XM_CALLCONV Terrain::checkCollisionTriangleXXX(DirectX::FXMVECTOR t0,
+													DirectX::FXMVECTOR t1,
+													DirectX::FXMVECTOR t2,
+													const TerrainCollisionInfoXXX& collisionInfo) noexcept
+{
+	switch (collisionInfo._shape)
 	{
-		if (aabbRange._maxZ == std::numeric_limits<uint8_t>::max())
+		case CollisionShape::Sphere:
 		{
-			++aabbRange._minZ;
+			return MathHelper::triangleIntersectSphere(t0, t1, t2,
+												collisionInfo._position, 
+												collisionInfo._velocity, 
+												collisionInfo._radius);
 		}
-		else
+		break;
+		case CollisionShape::Box:
+		{
+			return MathHelper::triangleIntersectBox(t0, t1, t2,
+												collisionInfo._position,
+												collisionInfo._boxX,
+												collisionInfo._boxY,
+												collisionInfo._boxZ,
+												collisionInfo._velocity);
+		}
+		break;
+		case CollisionShape::Line:
+		{
+			return MathHelper::triangleIntersectLine(t0, t1, t2, 
+													collisionInfo._position,
+													collisionInfo._velocity);
+		}
+		break;
+		case CollisionShape::Polygon:
+		case CollisionShape::Count:
+		default:
 		{
-			++aabbRange._maxZ;
+			check(false);
+			static_assert(static_cast<int>(CollisionShape::Count) == 4);
+			return MathHelper::NO_INTERSECTION;
 		}
+		break;
 	}
+}
 
-	check(aabbRange._minX < aabbRange._maxX);
-	check(aabbRange._minY < aabbRange._maxY);
-	check(aabbRange._minZ < aabbRange._maxZ);
+float Terrain::checkCollisionCachedXXX(const TerrainTriangleCache& cache,
+										const TerrainTriangleCache::Range& range,
+										const TerrainCollisionInfoXXX& collisionInfo,
+										uint16_t& outHitNodeIndex) const noexcept
+{
+	check(range._terrain == this);
+	check(range._end <= cache._vertices.size());
+	check(cache._vertices.size() == cache._nodeIndices.size() * 3);
 
-	return aabbRange;
+	float minCollisionTime = MathHelper::NO_INTERSECTION;
+	for (uint32_t i = range._begin; i < range._end; i += 3)
+	{
+		XMVECTOR t0 = XMLoadFloat3(&cache._vertices[i]);
+		XMVECTOR t1 = XMLoadFloat3(&cache._vertices[i + 1]);
+		XMVECTOR t2 = XMLoadFloat3(&cache._vertices[i + 2]);
+		const float collisionTime = checkCollisionTriangleXXX(t0, t1, t2, collisionInfo);
+		if (collisionTime < minCollisionTime)
+		{
+			minCollisionTime = collisionTime;
+			outHitNodeIndex = cache._nodeIndices[i / 3];
+		}
+	}
+	return minCollisionTime;
+}
+
+bool Terrain::isLeafNode(uint16_t nodeIndex) const noexcept
+{
+	check(nodeIndex < _aabbNodes.size());
+	return isLeafNodeXXX(_aabbNodes[nodeIndex]);
+}
+
+bool Terrain::isLeafNodeXXX(const TerrainAABBNode& node) noexcept
+{
+	return node._children[0] == std::numeric_limits<uint16_t>::max() &&
+		node._children[1] == std::numeric_limits<uint16_t>::max();
+}
+
+float Terrain::checkCollisionLeafXXX(uint16_t nodeIndex, const TerrainCollisionInfoXXX& collisionInfo) const noexcept
+{
+	check(isLeafNode(nodeIndex));
+	const auto& leaf = _aabbNodes[nodeIndex]._data._leaf;
+	XMVECTOR t0 = XMLoadFloat3(&getPositionFromLeafNode(leaf, 0));
+	XMVECTOR t1 = XMLoadFloat3(&getPositionFromLeafNode(leaf, 1));
+	XMVECTOR t2 = XMLoadFloat3(&getPositionFromLeafNode(leaf, 2));
+	return checkCollisionTriangleXXX(t0, t1, t2, collisionInfo);
+}
+
+float Terrain::checkCollisionNeighborXXX(uint16_t nodeIndex,
+										const TerrainCollisionInfoXXX& collisionInfo,
+										uint16_t& outHitNodeIndex) const noexcept
+{
+	check(nodeIndex + 1 < _triangleNeighborOffsets.size());
+
+	float minCollisionTime = checkCollisionLeafXXX(nodeIndex, collisionInfo);
+	outHitNodeIndex = nodeIndex;
+	for (uint32_t i = _triangleNeighborOffsets[nodeIndex]; i < _triangleNeighborOffsets[nodeIndex + 1]; ++i)
+	{
+		const float collisionTime = checkCollisionLeafXXX(_triangleNeighbors[i], collisionInfo);
+		if (collisionTime < minCollisionTime)
+		{
+			minCollisionTime = collisionTime;
+			outHitNodeIndex = _triangleNeighbors[i];
+		}
+	}
+	return minCollisionTime;
+}
+
+float XM_CALLCONV Terrain::checkCollisionDistanceFieldXXX(DirectX::FXMVECTOR min,
+														DirectX::FXMVECTOR max,
+														const TerrainCollisionInfoXXX& collisionInfo,
+														uint16_t& outHitNodeIndex) const noexcept
+{
+	check(_distanceField.isBuilt());
+	check(collisionInfo._shape == CollisionShape::Sphere);
+	++_statistics._distanceFieldCastCount;
+
+	// Ÿ     ŭ  ﰢ  ʰ ̵  ִ.
+	const float speed = XMVectorGetX(XMVector3Length(collisionInfo._velocity));
+	const float contactDistance = collisionInfo._radius + _distanceField.getMaxError() + _distanceField.getCellSize() * 0.5f;
+	float startTime = 0.f;
+	for (int i = 0; i < DISTANCE_FIELD_MAX_STEP_COUNT; ++i)
+	{
+		XMFLOAT3 position;
+		XMStoreFloat3(&position, collisionInfo._position + collisionInfo._velocity * startTime);
+		const float distance = _distanceField.getDistance(position);
+		if (distance <= contactDistance || speed <= FLT_EPSILON)
+		{
+			break;
+		}
+		++_statistics._distanceFieldStepCount;
+		startTime += (distance - collisionInfo._radius - _distanceField.getMaxError()) / speed;
+		if (1.f < startTime)
+		{
+			++_statistics._distanceFieldMissCount;
+			return MathHelper::NO_INTERSECTION;
+		}
+	}
+
+	// startTime   ﰢ Ƿ  ̵  ٿ Ʈ ˻Ѵ.
+	// ﰢ ˻  ̵ ü  ϹǷ  ð Ʈ Ҷ .
+	TerrainCollisionInfoXXX shortenedInfo = collisionInfo;
+	XMVECTOR start = collisionInfo._position + collisionInfo._velocity * startTime;
+	XMVECTOR end = collisionInfo._position + collisionInfo._velocity;
+	shortenedInfo._min = XMVectorMin(start, end) - collisionInfo._extent;
+	shortenedInfo._max = XMVectorMax(start, end) + collisionInfo._extent;
+	return checkCollisionXXX(_aabbNodes.size() - 1, min, max, shortenedInfo, outHitNodeIndex);
 }
 
+void XM_CALLCONV Terrain::gatherTrianglesXXX(int nodeIndex,
+											DirectX::FXMVECTOR min,
+											DirectX::FXMVECTOR max,
+											DirectX::FXMVECTOR queryMin,
+											DirectX::GXMVECTOR queryMax,
+											TerrainTriangleCache& outCache) const noexcept
+{
+	check(nodeIndex < _aabbNodes.size());
+	check(0 <= nodeIndex);
+
+	const auto& node = _aabbNodes[nodeIndex];
+	if (node._children[0] == std::numeric_limits<uint16_t>::max() &&
+		node._children[1] == std::numeric_limits<uint16_t>::max())
+	{
+		const auto& v0 = getPositionFromLeafNode(node._data._leaf, 0);
+		const auto& v1 = getPositionFromLeafNode(node._data._leaf, 1);
+		const auto& v2 = getPositionFromLeafNode(node._data._leaf, 2);
+
+		XMVECTOR t0 = XMLoadFloat3(&v0);
+		XMVECTOR t1 = XMLoadFloat3(&v1);
+		XMVECTOR t2 = XMLoadFloat3(&v2);
+		XMVECTOR triangleMin = XMVectorMin(XMVectorMin(t0, t1), t2);
+		XMVECTOR triangleMax = XMVectorMax(XMVectorMax(t0, t1), t2);
+		if (XMVector3GreaterOrEqual(queryMax, triangleMin) &&
+			XMVector3GreaterOrEqual(triangleMax, queryMin))
+		{
+			outCache._vertices.push_back(v0);
+			outCache._vertices.push_back(v1);
+			outCache._vertices.push_back(v2);
+			outCache._nodeIndices.push_back(static_cast<uint16_t>(nodeIndex));
+		}
+		return;
+	}
+
+	XMVECTOR nodeMinRate = XMVectorSet(static_cast<float>(node._data._node._minX) / std::numeric_limits<uint8_t>::max(),
+								static_cast<float>(node._data._node._minY) / std::numeric_limits<uint8_t>::max(),
+								static_cast<float>(node._data._node._minZ) / std::numeric_limits<uint8_t>::max(), 0);
+
+	XMVECTOR nodeMaxRate = XMVectorSet(static_cast<float>(node._data._node._maxX) / std::numeric_limits<uint8_t>::max(),
+								static_cast<float>(node._data._node._maxY) / std::numeric_limits<uint8_t>::max(),
+								static_cast<float>(node._data._node._maxZ) / std::numeric_limits<uint8_t>::max(), 0);
+
+	XMVECTOR nodeMin = min + (max - min) * nodeMinRate;
+	XMVECTOR nodeMax = min + (max - min) * nodeMaxRate;
+
+	if (XMVector3Greater(queryMax, nodeMin) &&
+		XMVector3Greater(nodeMax, queryMin))
+	{
+		gatherTrianglesXXX(node._children[0], nodeMin, nodeMax, queryMin, queryMax, outCache);
+		gatherTrianglesXXX(node._children[1], nodeMin, nodeMax, queryMin, queryMax, outCache);
+	}
+}
 
 float XM_CALLCONV Terrain::checkCollisionXXX(int nodeIndex,
 											DirectX::FXMVECTOR min, 
 											DirectX::FXMVECTOR max,
-											const TerrainCollisionInfoXXX& collisionInfo) const noexcept
+											const TerrainCollisionInfoXXX& collisionInfo,
+											uint16_t& outHitNodeIndex) const noexcept
 {
 	check(nodeIndex < _aabbNodes.size());
 	check(0 <= nodeIndex);
@@ -367,51 +960,16 @@ float XM_CALLCONV Terrain::checkCollisionXXX(int nodeIndex,
 	if (node._children[0] == std::numeric_limits<uint16_t>::max() &&
 		node._children[1] == std::numeric_limits<uint16_t>::max())
 	{
-		const auto& v0 = getVertexFromLeafNode(node._data._leaf, 0);
-		const auto& v1 = getVertexFromLeafNode(node._data._leaf, 1);
-		const auto& v2 = getVertexFromLeafNode(node._data._leaf, 2);
+		const auto& v0 = getPositionFromLeafNode(node._data._leaf, 0);
+		const auto& v1 = getPositionFromLeafNode(node._data._leaf, 1);
+		const auto& v2 = getPositionFromLeafNode(node._data._leaf, 2);
 
-		const auto& t0 = XMLoadFloat3(&v0._position);
-		const auto& t1 = XMLoadFloat3(&v1._position);
-		const auto& t2 = XMLoadFloat3(&v2._position);
+		const auto& t0 = XMLoadFloat3(&v0);
+		const auto& t1 = XMLoadFloat3(&v1);
+		const auto& t2 = XMLoadFloat3(&v2);
 
-		switch (collisionInfo._shape)
-		{
-			case CollisionShape::Sphere:
-			{
-				return MathHelper::triangleIntersectSphere(t0, t1, t2,
-													collisionInfo._position, 
-													collisionInfo._velocity, 
-													collisionInfo._radius);
-			}
-			break;
-			case CollisionShape::Box:
-			{
-				return MathHelper::triangleIntersectBox(t0, t1, t2,
-													collisionInfo._position,
-													collisionInfo._boxX,
-													collisionInfo._boxY,
-													collisionInfo._boxZ,
-													collisionInfo._velocity);
-			}
-			break;
-			case CollisionShape::Line:
-			{
-				return MathHelper::triangleIntersectLine(t0, t1, t2, 
-														collisionInfo._position,
-														collisionInfo._velocity);
-			}
-			break;
-			case CollisionShape::Polygon:
-			case CollisionShape::Count:
-			default:
-			{
-				check(false);
-				static_assert(static_cast<int>(CollisionShape::Count) == 4);
-				return MathHelper::NO_INTERSECTION;
-			}
-			break;
-		}
+		outHitNodeIndex = static_cast<uint16_t>(nodeIndex);
+		return checkCollisionTriangleXXX(t0, t1, t2, collisionInfo);
 	}
 	else
 	{
@@ -430,8 +988,16 @@ float XM_CALLCONV Terrain::checkCollisionXXX(int nodeIndex,
 		if (XMVector3Greater(collisionInfo._max, nodeMin) &&
 			XMVector3Greater(nodeMax, collisionInfo._min))
 		{
-			return std::min(checkCollisionXXX(node._children[0], nodeMin, nodeMax, collisionInfo),
-							checkCollisionXXX(node._children[1], nodeMin, nodeMax, collisionInfo));
+			uint16_t hitNodeIndex0, hitNodeIndex1;
+			const float collisionTime0 = checkCollisionXXX(node._children[0], nodeMin, nodeMax, collisionInfo, hitNodeIndex0);
+			const float collisionTime1 = checkCollisionXXX(node._children[1], nodeMin, nodeMax, collisionInfo, hitNodeIndex1);
+			if (collisionTime1 < collisionTime0)
+			{
+				outHitNodeIndex = hitNodeIndex1;
+				return collisionTime1;
+			}
+			outHitNodeIndex = hitNodeIndex0;
+			return collisionTime0;
 		}
 		else
 		{
@@ -453,13 +1019,13 @@ float XM_CALLCONV Terrain::checkCollisionLineXXX(int nodeIndex,
 	if (node._children[0] == std::numeric_limits<uint16_t>::max() &&
 		node._children[1] == std::numeric_limits<uint16_t>::max())
 	{
-		const auto& v0 = getVertexFromLeafNode(node._data._leaf, 0);
-		const auto& v1 = getVertexFromLeafNode(node._data._leaf, 1);
-		const auto& v2 = getVertexFromLeafNode(node._data._leaf, 2);
+		const auto& v0 = getPositionFromLeafNode(node._data._leaf, 0);
+		const auto& v1 = getPositionFromLeafNode(node._data._leaf, 1);
+		const auto& v2 = getPositionFromLeafNode(node._data._leaf, 2);
 
-		const auto& t0 = XMLoadFloat3(&v0._position);
-		const auto& t1 = XMLoadFloat3(&v1._position);
-		const auto& t2 = XMLoadFloat3(&v2._position);
+		const auto& t0 = XMLoadFloat3(&v0);
+		const auto& t1 = XMLoadFloat3(&v1);
+		const auto& t2 = XMLoadFloat3(&v2);
 
 		return MathHelper::triangleIntersectLine(t0, t1, t2,
 			XMLoadFloat3(&start),
@@ -595,15 +1161,25 @@ float XM_CALLCONV Terrain::checkCollisionLineXXX(int nodeIndex,
 
 
 
-void Terrain::setCulled(void) noexcept
+void Terrain::addCullingBox(FrustumCuller& culler) noexcept
 {
-	_gameObject->setCulled();
+	_gameObject->addCullingBox(culler);
 }
 
-bool Terrain::checkCollision(const Actor& actor, const DirectX::XMFLOAT3& velocity, float& collisionTime) const noexcept
+void Terrain::setCulled(const FrustumCuller& culler) noexcept
 {
-	XMMATRIX inverseMatrix = XMLoadFloat4x4(&_gameObject->getWorldMatrix());
-	inverseMatrix = XMMatrixInverse(nullptr, inverseMatrix);
+	_gameObject->setCulled(culler);
+}
+
+bool Terrain::checkCollision(const Actor& actor,
+							const DirectX::XMFLOAT3& velocity,
+							const TerrainTriangleCache* triangleCache,
+							size_t terrainIndex,
+							const TerrainContact* lastContact,
+							float& collisionTime,
+							TerrainContact& outContact) const noexcept
+{
+	XMMATRIX inverseMatrix = XMLoadFloat4x4(&_inverseWorldMatrix);
 
 	TerrainCollisionInfoXXX collisionInfo;
 	// sliding  ʾұ ,  쿡 ڷ ؼ ̸ ŭ ڷ  浹 üũ  . [7/12/2021 qwerw]
@@ -629,6 +1205,7 @@ bool Terrain::checkCollision(const Actor& actor, const DirectX::XMFLOAT3& veloci
 			XMVECTOR radiusVector = XMVectorSet(collisionInfo._radius, collisionInfo._radius, collisionInfo._radius, 0.f);
 			collisionInfo._min -= radiusVector;
 			collisionInfo._max += radiusVector;
+			collisionInfo._extent = radiusVector;
 		}
 		break;
 		case CollisionShape::Box:
@@ -653,6 +1230,7 @@ bool Terrain::checkCollision(const Actor& actor, const DirectX::XMFLOAT3& veloci
 
 			collisionInfo._min -= absVector;
 			collisionInfo._max += absVector;
+			collisionInfo._extent = absVector;
 		}
 		break;
 		case CollisionShape::Count:
@@ -665,12 +1243,88 @@ bool Terrain::checkCollision(const Actor& actor, const DirectX::XMFLOAT3& veloci
 
 	XMVECTOR minV = XMLoadFloat3(&_min);
 	XMVECTOR maxV = XMLoadFloat3(&_max);
-	
-	float collisionTimeRaw = checkCollisionXXX(_aabbNodes.size() - 1, minV, maxV, collisionInfo);
+
+	const TerrainTriangleCache::Range* cachedRange = nullptr;
+	if (triangleCache != nullptr)
+	{
+		check(terrainIndex < triangleCache->_ranges.size());
+		const auto& range = triangleCache->_ranges[terrainIndex];
+		check(range._terrain == this);
+		if (XMVector3GreaterOrEqual(collisionInfo._min, XMLoadFloat3(&range._min)) &&
+			XMVector3GreaterOrEqual(XMLoadFloat3(&range._max), collisionInfo._max))
+		{
+			cachedRange = &range;
+		}
+	}
+
+	float collisionTimeRaw;
+	uint16_t hitNodeIndex = 0;
+	bool isFullQuery = false;
+	const bool useDistanceField = _collisionType == TerrainCollisionType::DistanceField &&
+		collisionInfo._shape == CollisionShape::Sphere;
+	if (useDistanceField)
+	{
+		collisionTimeRaw = checkCollisionDistanceFieldXXX(minV, maxV, collisionInfo, hitNodeIndex);
+	}
+	else if (cachedRange != nullptr)
+	{
+		collisionTimeRaw = checkCollisionCachedXXX(*triangleCache, *cachedRange, collisionInfo, hitNodeIndex);
+	}
+	else if (lastContact != nullptr && lastContact->_terrain == this &&
+		lastContact->_nodeIndex < _aabbNodes.size() && isLeafNode(lastContact->_nodeIndex))
+	{
+		// Ʈ    ȣ ٸ ﰢ ų  , ã ð   浹 ð ̴.
+		collisionTimeRaw = checkCollisionNeighborXXX(lastContact->_nodeIndex, collisionInfo, hitNodeIndex);
+		if (collisionTimeRaw <= 1.f)
+		{
+			// ã ð   ﰢ  ð ̵  ȿ Ƿ  ٿ Ʈ ȮѴ.
+			++_statistics._contactHitCount;
+			TerrainCollisionInfoXXX shortenedInfo = collisionInfo;
+			XMVECTOR end = collisionInfo._position + collisionInfo._velocity * collisionTimeRaw;
+			shortenedInfo._min = XMVectorMin(collisionInfo._position, end) - collisionInfo._extent;
+			shortenedInfo._max = XMVectorMax(collisionInfo._position, end) + collisionInfo._extent;
+
+			uint16_t treeHitNodeIndex;
+			const float treeCollisionTime = checkCollisionXXX(_aabbNodes.size() - 1, minV, maxV, shortenedInfo, treeHitNodeIndex);
+			if (treeCollisionTime < collisionTimeRaw)
+			{
+				collisionTimeRaw = treeCollisionTime;
+				hitNodeIndex = treeHitNodeIndex;
+			}
+		}
+		else
+		{
+			++_statistics._contactMissCount;
+			collisionTimeRaw = checkCollisionXXX(_aabbNodes.size() - 1, minV, maxV, collisionInfo, hitNodeIndex);
+			isFullQuery = true;
+		}
+	}
+	else
+	{
+		++_statistics._fullQueryCount;
+		collisionTimeRaw = checkCollisionXXX(_aabbNodes.size() - 1, minV, maxV, collisionInfo, hitNodeIndex);
+		isFullQuery = true;
+	}
+#if defined DEBUG | defined _DEBUG
+	// ü Ʈ ȸ    ϰ ǹǷ Ȯ ʴ´.
+	if (!isFullQuery)
+	{
+		uint16_t debugHitNodeIndex;
+		const float collisionTimeTree = checkCollisionXXX(_aabbNodes.size() - 1, minV, maxV, collisionInfo, debugHitNodeIndex);
+		if (useDistanceField && collisionTimeRaw <= 1.f && collisionTimeTree <= 1.f)
+		{
+			_statistics._distanceFieldMaxError = std::max(_statistics._distanceFieldMaxError, std::abs(collisionTimeRaw - collisionTimeTree));
+		}
+		check((1.f < collisionTimeRaw && 1.f < collisionTimeTree) || MathHelper::equal(collisionTimeRaw, collisionTimeTree),
+			"Ʈ ȸ  ٸϴ.");
+	}
+#endif
 	if (1.f < collisionTimeRaw)
 	{
 		return false;
 	}
+	outContact._terrain = this;
+	outContact._nodeIndex = hitNodeIndex;
 	collisionTime = (collisionTimeRaw * (adjustingDistance + speed) - adjustingDistance) / speed;
 
 	check(collisionTime < 1.05);
@@ -678,10 +1332,33 @@ bool Terrain::checkCollision(const Actor& actor, const DirectX::XMFLOAT3& veloci
 	return true;
 }
 
+void Terrain::gatherTriangles(const DirectX::XMFLOAT3& center, float radius, TerrainTriangleCache& cache) const noexcept
+{
+	TerrainTriangleCache::Range range;
+	range._terrain = this;
+	range._begin = static_cast<uint32_t>(cache._vertices.size());
+	range._min = { 0, 0, 0 };
+	range._max = { 0, 0, 0 };
+	if (!_aabbNodes.empty())
+	{
+		XMMATRIX inverseMatrix = XMLoadFloat4x4(&_inverseWorldMatrix);
+
+		XMVECTOR localCenter = XMVector3Transform(XMLoadFloat3(&center), inverseMatrix);
+		XMVECTOR localRadius = XMVectorReplicate(radius / _size);
+		XMVECTOR queryMin = localCenter - localRadius;
+		XMVECTOR queryMax = localCenter + localRadius;
+		XMStoreFloat3(&range._min, queryMin);
+		XMStoreFloat3(&range._max, queryMax);
+
+		gatherTrianglesXXX(_aabbNodes.size() - 1, XMLoadFloat3(&_min), XMLoadFloat3(&_max), queryMin, queryMax, cache);
+	}
+	range._end = static_cast<uint32_t>(cache._vertices.size());
+	cache._ranges.push_back(range);
+}
+
 bool Terrain::checkCollisionLine(DirectX::FXMVECTOR start, DirectX::FXMVECTOR velocity, float& collisionTime) const noexcept
 {
-	XMMATRIX inverseMatrix = XMLoadFloat4x4(&_gameObject->getWorldMatrix());
-	inverseMatrix = XMMatrixInverse(nullptr, inverseMatrix);
+	XMMATRIX inverseMatrix = XMLoadFloat4x4(&_inverseWorldMatrix);
 
 	DirectX::XMFLOAT3 startF, velocityF;
 	TerrainCollisionInfoXXX collisionInfo;
@@ -695,3 +1372,32 @@ bool Terrain::checkCollisionLine(DirectX::FXMVECTOR start, DirectX::FXMVECTOR ve
 	collisionTime = checkCollisionLineXXX(_aabbNodes.size() - 1, minV, maxV, startF, velocityF);
 	return collisionTime < 1.f;
 }
+
+void Terrain::logStatistics(void) noexcept
+{
+	if (_statistics._contactHitCount != 0 || _statistics._contactMissCount != 0 || _statistics._fullQueryCount != 0)
+	{
+		const std::string text = "[TerrainContact] hit: " + std::to_string(_statistics._contactHitCount) +
+			" miss: " + std::to_string(_statistics._contactMissCount) +
+			" fullQuery: " + std::to_string(_statistics._fullQueryCount) + "\n";
+		OutputDebugStringA(text.c_str());
+	}
+	if (_statistics._distanceFieldCastCount != 0)
+	{
+		const std::string text = "[TerrainDistanceField] cast: " + std::to_string(_statistics._distanceFieldCastCount) +
+			" step: " + std::to_string(_statistics._distanceFieldStepCount) +
+			" missWithoutTriangle: " + std::to_string(_statistics._distanceFieldMissCount) +
+			" maxTimeError: " + std::to_string(_statistics._distanceFieldMaxError) + "\n";
+		OutputDebugStringA(text.c_str());
+	}
+	_statistics = TerrainCollisionStatistics();
+}
+
+
+void TerrainTriangleCache::reset(void) noexcept
+{
+	_actor = SlotHandle();
+	_vertices.clear();
+	_nodeIndices.clear();
+	_ranges.clear();
+}
\ No newline at end of file
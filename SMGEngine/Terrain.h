@@ -1,12 +1,18 @@
 #pragma once
 #include "TypeGeometry.h"
 #include "TypeAction.h"
+#include "TerrainDistanceField.h"
+#include "SlotPool.h"
+#include <future>
 
+class Terrain;
 class TerrainObjectInfo;
 class ObjectInfo;
 class MeshGeometry;
 class GameObject;
 class Actor;
+class Path;
+class FrustumCuller;
 
 struct TerrainAABBNode
 {
@@ -46,9 +52,69 @@ struct TerrainCollisionInfoXXX
 	DirectX::XMVECTOR _boxZ;
 	DirectX::XMVECTOR _min;
 	DirectX::XMVECTOR _max;
+	// ̵    _min, _max ø ũ
+	DirectX::XMVECTOR _extent;
 	float _radius;
 };
 
+// actor   ٴ ﰢ.  ӿ  ﰢ ̿ ˻Ѵ.
+struct TerrainContact
+{
+	const Terrain* _terrain = nullptr;
+	// _terrain leaf  ȣ
+	uint16_t _nodeIndex = 0;
+};
+
+struct TerrainCollisionStatistics
+{
+	uint64_t _contactHitCount = 0;
+	uint64_t _contactMissCount = 0;
+	uint64_t _fullQueryCount = 0;
+	uint64_t _distanceFieldCastCount = 0;
+	uint64_t _distanceFieldStepCount = 0;
+	// Ÿ常 浹 ʴ´ٰ Ǵؼ ﰢ ˻  Ƚ
+	uint64_t _distanceFieldMissCount = 0;
+	//  忡 Ʈ ȸ   浹 ð  ִ밪
+	float _distanceFieldMaxError = 0.f;
+};
+
+// actor ϳ    , ٴ, ߷ 浹 üũ ϴ terrain ﰢ ĺ.
+// terrain AABB Ʈ ѹ ȸؼ Ƶΰ,  üũ Ƶ ﰢ ˻Ѵ.
+struct TerrainTriangleCache
+{
+	struct Range
+	{
+		const Terrain* _terrain;
+		uint32_t _begin;
+		uint32_t _end;
+		// ĺ  terrain  . 浹 üũ   ȿ  ĳø Ѵ.
+		DirectX::XMFLOAT3 _min;
+		DirectX::XMFLOAT3 _max;
+	};
+	void reset(void) noexcept;
+
+	//  actor.  actor slot ٸ actor  handle ޶ ĳø  ʴ´.
+	SlotHandle _actor;
+	// ﰢ  3, terrain  ǥ
+	std::vector<DirectX::XMFLOAT3> _vertices;
+	// ﰢ ϳ, ﰢ leaf  ȣ
+	std::vector<uint16_t> _nodeIndices;
+	// StageManager terrain  .
+	std::vector<Range> _ranges;
+};
+
+// Ʈ   . ϴ terrain ׶忡   üѴ.
+struct TerrainTreeBuildResult
+{
+	std::vector<TerrainAABBNode> _aabbNodes;
+	std::vector<uint32_t> _triangleNeighborOffsets;
+	std::vector<uint16_t> _triangleNeighbors;
+	DirectX::XMFLOAT3 _min;
+	DirectX::XMFLOAT3 _max;
+	//   ǥ  Ʈ ǥ  . Ŭ ȸҶ ˻ϴ 尡 .
+	float _treeCost = 0.f;
+};
+
 class Terrain
 {
 public:
@@ -56,18 +122,86 @@ public:
 	bool isWall(void) const noexcept;
 	Terrain(const TerrainObjectInfo& terrainInfo);
 	~Terrain();
-	bool checkCollision(const Actor& actor, const DirectX::XMFLOAT3& velocity, float& collisionTime) const noexcept;
+	// triangleCache ְ üũ  ĳ  ̸ Ʈ  ĳ ﰢ ˻Ѵ.
+	// lastContact  terrain̸  ﰢ ̿  ã ð  ٿ Ʈ ˻Ѵ.
+	// Ÿ ϴ terrain̸  Ÿ ǥ ó ̵    Ʈ ˻Ѵ.
+	// 浹ϸ outContact 浹 ﰢ ִ´.
+	bool checkCollision(const Actor& actor,
+						const DirectX::XMFLOAT3& velocity,
+						const TerrainTriangleCache* triangleCache,
+						size_t terrainIndex,
+						const TerrainContact* lastContact,
+						float& collisionTime,
+						TerrainContact& outContact) const noexcept;
+	// center radius  ȿ   ִ ﰢ cache .
+	void gatherTriangles(const DirectX::XMFLOAT3& center, float radius, TerrainTriangleCache& cache) const noexcept;
 	bool checkCollisionLine(DirectX::FXMVECTOR start, DirectX::FXMVECTOR velocity, float& collisionTime) const noexcept;
 	float XM_CALLCONV checkCollisionXXX(int nodeIndex, 
 										DirectX::FXMVECTOR min,
 										DirectX::FXMVECTOR max, 
-										const TerrainCollisionInfoXXX& collisionInfo) const noexcept;
+										const TerrainCollisionInfoXXX& collisionInfo,
+										uint16_t& outHitNodeIndex) const noexcept;
 	float XM_CALLCONV checkCollisionLineXXX(int nodeIndex,
 											DirectX::FXMVECTOR min,
 											DirectX::FXMVECTOR max,
 											const DirectX::XMFLOAT3& start,
 											const DirectX::XMFLOAT3& velocity) const noexcept;
-	void setCulled(void) noexcept;
+	void addCullingBox(FrustumCuller& culler) noexcept;
+	void setCulled(const FrustumCuller& culler) noexcept;
+	// path ȸ ӵ  world  Ѵ. Ʈ  ǥ ٽ  ʴ´.
+	//  true ȯϰ getDeltaMatrix ̹ ̵ Ÿ.
+	bool updateTransform(const TickCount64& deltaTick) noexcept;
+	bool isMoving(void) const noexcept;
+	//  world ǥ ̹ world ǥ ű . ٴڿ  ִ actor  ű涧 Ѵ.
+	const DirectX::XMFLOAT4X4& getDeltaMatrix(void) const noexcept { return _deltaMatrix; }
+	// 浹  ġ ٲ۴. positions ޽  ȣ   ǥ̰,  ޽  ġ ư.
+	// 浹 Ʈ ٲٰ GPU  ۴ ״ζ ׷  ٲ ʴ´. ̴  ٲٷ ޽ø  ؾ Ѵ.
+	// Ʈ  ״ ΰ   Ʒ ٽ Ѵ(refit). Ʈ   TREE_REBUILD_COST_RATIO踦 
+	// ׶忡 Ʈ   updateTreeRebuild üѴ. Ÿ ϴ terrain   .
+	void setDeformedPositions(const std::vector<DirectX::XMFLOAT3>& positions);
+	// setDeformedPositions   ִ terrain̸ true
+	bool isDeformable(void) const noexcept;
+	// ׶忡  Ʈ غ üϰ true ȯѴ.   ȣѴ.
+	bool updateTreeRebuild(void);
+	bool isTreeRebuilding(void) const noexcept { return _treeRebuildFuture.valid(); }
+	// ׶忡  Ʈ   ٷȴٰ üѴ.
+	void waitTreeRebuild(void);
+	// refit Ʈ  Ʈ    
+	float getTreeCostRatio(void) const noexcept;
+	// ޽   ġ,  ǥ
+	void getMeshPositions(std::vector<DirectX::XMFLOAT3>& outPositions) const;
+	// 浹 Ʈ Ʈ ,  ǥ
+	const DirectX::XMFLOAT3& getLocalMin(void) const noexcept { return _min; }
+	const DirectX::XMFLOAT3& getLocalMax(void) const noexcept { return _max; }
+	//  Ʈ ﰢ positions ġ Ʈ  .  ٲ ʴ´. ﰢ  ȯѴ.
+	size_t buildTree(const std::vector<DirectX::XMFLOAT3>& positions, TerrainTreeBuildResult& outResult) const;
+	static void logStatistics(void) noexcept;
+private:
+	static float XM_CALLCONV checkCollisionTriangleXXX(DirectX::FXMVECTOR t0,
+														DirectX::FXMVECTOR t1,
+														DirectX::FXMVECTOR t2,
+														const TerrainCollisionInfoXXX& collisionInfo) noexcept;
+	float checkCollisionCachedXXX(const TerrainTriangleCache& cache,
+								const TerrainTriangleCache::Range& range,
+								const TerrainCollisionInfoXXX& collisionInfo,
+								uint16_t& outHitNodeIndex) const noexcept;
+	// leaf  ϳ ̿ ﰢ ˻Ѵ.
+	float checkCollisionNeighborXXX(uint16_t nodeIndex,
+									const TerrainCollisionInfoXXX& collisionInfo,
+									uint16_t& outHitNodeIndex) const noexcept;
+	float checkCollisionLeafXXX(uint16_t nodeIndex, const TerrainCollisionInfoXXX& collisionInfo) const noexcept;
+	float XM_CALLCONV checkCollisionDistanceFieldXXX(DirectX::FXMVECTOR min,
+													DirectX::FXMVECTOR max,
+													const TerrainCollisionInfoXXX& collisionInfo,
+													uint16_t& outHitNodeIndex) const noexcept;
+	bool isLeafNode(uint16_t nodeIndex) const noexcept;
+	static bool isLeafNodeXXX(const TerrainAABBNode& node) noexcept;
+	void XM_CALLCONV gatherTrianglesXXX(int nodeIndex,
+										DirectX::FXMVECTOR min,
+										DirectX::FXMVECTOR max,
+										DirectX::FXMVECTOR queryMin,
+										DirectX::GXMVECTOR queryMax,
+										TerrainTriangleCache& outCache) const noexcept;
 private:
 	enum class DivideType
 	{
@@ -75,10 +209,44 @@ private:
 		Y,
 		Z,
 	};
+	// Ÿ忡 ̸ŭ ̵ص ǥ ó  ϸ   Ʈ ˻Ѵ.
+	static constexpr int DISTANCE_FIELD_MAX_STEP_COUNT = 16;
+	// refit Ʈ      Ʈ  .
+	static constexpr float TREE_REBUILD_COST_RATIO = 1.5f;
 	GameObject* _gameObject;
 	std::vector<TerrainAABBNode> _aabbNodes;
+	//  ϴ ﰢ .  ȣ i ̿ _triangleNeighbors [_triangleNeighborOffsets[i], _triangleNeighborOffsets[i + 1])
+	std::vector<uint32_t> _triangleNeighborOffsets;
+	std::vector<uint16_t> _triangleNeighbors;
+
+	TerrainCollisionType _collisionType;
+	TerrainDistanceField _distanceField;
+
+	// 浹 üũ   ʵ world  ٲ𶧸 Ѵ.
+	DirectX::XMFLOAT4X4 _inverseWorldMatrix;
+	DirectX::XMFLOAT4X4 _deltaMatrix;
+	const Path* _path;
+	TickCount64 _pathTime;
+	float _rotateSpeed;
+	float _rotateAngle;
+	// ȸϱ   
+	DirectX::XMFLOAT3 _position;
+	DirectX::XMFLOAT3 _direction;
+	DirectX::XMFLOAT3 _upVector;
+
+	static TerrainCollisionStatistics _statistics;
 	const Vertex* _vertexBuffer;
 	const GeoIndex* _indexBuffer;
+	size_t _vertexCount;
+	//   ġ.  _vertexBuffer ġ Ѵ.
+	std::vector<DirectX::XMFLOAT3> _deformedPositions;
+	float _treeCost;
+	float _builtTreeCost;
+	// refit ϴ 庰 [min, max]. Ź Ҵ ʵ  ִ´.
+	std::vector<std::array<DirectX::XMFLOAT3, 2>> _refitNodeBounds;
+	std::vector<std::array<DirectX::XMFLOAT3, 2>> _refitNodeRanges;
+	// vector<Terrain>   ֵ   shared_future Ѵ.
+	std::shared_future<TerrainTreeBuildResult> _treeRebuildFuture;
 
 	DirectX::XMFLOAT3 _min;
 	DirectX::XMFLOAT3 _max;
@@ -87,22 +255,55 @@ private:
 	float _size;
 private:
 	void makeAABBTree(void);
-	uint16_t XM_CALLCONV makeAABBTreeXXX(std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
+	// Ʈ  Լ  ٲ ʰ ޽ø о ׶忡 ȣ  ִ.
+	// positions  ޽  ġ Ѵ.
+	void buildTreeXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+		std::vector<TerrainAABBNode::DataType::Leaf>& terrainLeafList,
+		TerrainTreeBuildResult& outResult) const;
+	void applyTreeBuildResult(TerrainTreeBuildResult& result) noexcept;
+	void getLeafListXXX(std::vector<TerrainAABBNode::DataType::Leaf>& outLeafList) const;
+	void makeTriangleNeighbors(const std::vector<TerrainAABBNode>& aabbNodes,
+		std::vector<uint32_t>& outNeighborOffsets,
+		std::vector<uint16_t>& outNeighbors) const;
+	void makeDistanceField(void);
+	void setWorldMatrix(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction) noexcept;
+	uint16_t XM_CALLCONV makeAABBTreeXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+		std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
 		int begin,
 		int end,
 		DirectX::FXMVECTOR min,
-		DirectX::FXMVECTOR max);
-	const Vertex& getVertexFromLeafNode(const TerrainAABBNode::DataType::Leaf& leafNode, const int offset) const noexcept;
-	void sortIndexList(std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
+		DirectX::FXMVECTOR max,
+		std::vector<TerrainAABBNode>& outNodes) const;
+	const DirectX::XMFLOAT3& getPositionFromLeafNode(const TerrainAABBNode::DataType::Leaf& leafNode, const int offset) const noexcept;
+	const DirectX::XMFLOAT3& getPositionXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+		const TerrainAABBNode::DataType::Leaf& leafNode,
+		const int offset) const noexcept;
+	void sortIndexList(const std::vector<DirectX::XMFLOAT3>& positions,
+		std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
 		int begin,
 		int end,
 		DivideType divideType) const noexcept;
 
-	inline float sortCompareValue(const TerrainAABBNode::DataType::Leaf& index, DivideType type) const noexcept;
+	inline float sortCompareValue(const std::vector<DirectX::XMFLOAT3>& positions,
+		const TerrainAABBNode::DataType::Leaf& index,
+		DivideType type) const noexcept;
 
-	TerrainAABBNode::DataType::Node XM_CALLCONV getAABBRange(std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
+	TerrainAABBNode::DataType::Node XM_CALLCONV getAABBRange(const std::vector<DirectX::XMFLOAT3>& positions,
+		std::vector<TerrainAABBNode::DataType::Leaf>& terrainIndexList,
 		int begin,
 		int end,
 		DirectX::FXMVECTOR min,
 		DirectX::FXMVECTOR max) const noexcept;
+	// bounds range   ٲ۴. ε min  max ø.
+	static TerrainAABBNode::DataType::Node quantizeRangeXXX(const DirectX::XMFLOAT3& boundsMin,
+		const DirectX::XMFLOAT3& boundsMax,
+		const DirectX::XMFLOAT3& rangeMin,
+		const DirectX::XMFLOAT3& rangeMax) noexcept;
+	// 帶 δ  ڽĺ ϰ Ʈ  ȯѴ.
+	float computeNodeBoundsXXX(const std::vector<DirectX::XMFLOAT3>& positions,
+		const std::vector<TerrainAABBNode>& aabbNodes,
+		std::vector<std::array<DirectX::XMFLOAT3, 2>>& outNodeBounds) const noexcept;
+	static float XM_CALLCONV getSurfaceAreaXXX(DirectX::FXMVECTOR min, DirectX::FXMVECTOR max) noexcept;
+	// Ʈ  ΰ _deformedPositions °   _min, _max ٽ Ѵ.
+	void refitAABBTree(void) noexcept;
 };
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "stdafx.h"
+#include "TerrainDistanceField.h"
+#include "Exception.h"
+#include "MathHelper.h"
+
+TerrainDistanceField::TerrainDistanceField(void) noexcept
+	: _origin(0, 0, 0)
+	, _cellSize(0.f)
+	, _bandWidth(0.f)
+	, _brickCounts{ 0, 0, 0 }
+{
+
+}
+
+void TerrainDistanceField::build(const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max, const std::vector<DirectX::XMFLOAT3>& triangles)
+{
+	using namespace DirectX;
+	check(triangles.size() % 3 == 0);
+	_brickOffsets.clear();
+	_samples.clear();
+
+	const float longestAxis = std::max({ max.x - min.x, max.y - min.y, max.z - min.z });
+	if (triangles.empty() || longestAxis <= FLT_EPSILON)
+	{
+		ThrowErrCode(ErrCode::InvalidVertexInfo, "Ÿ  ﰢ ϴ.");
+	}
+	_cellSize = longestAxis / CELL_COUNT;
+	_bandWidth = _cellSize * BAND_CELL_COUNT;
+	_origin = MathHelper::sub(min, XMFLOAT3(_bandWidth, _bandWidth, _bandWidth));
+
+	const XMFLOAT3 extent = MathHelper::sub(max, min);
+	const float brickSize = _cellSize * BRICK_CELL_COUNT;
+	_brickCounts[0] = static_cast<int>(std::ceil((extent.x + _bandWidth * 2) / brickSize));
+	_brickCounts[1] = static_cast<int>(std::ceil((extent.y + _bandWidth * 2) / brickSize));
+	_brickCounts[2] = static_cast<int>(std::ceil((extent.z + _bandWidth * 2) / brickSize));
+	_brickOffsets.assign(static_cast<size_t>(_brickCounts[0]) * _brickCounts[1] * _brickCounts[2], EMPTY_BRICK);
+
+	// ﰢ bandŭ ø  ġ brick ﰢ  ´.
+	// brick   band ̳ ִ ﰢ   brick .
+	std::vector<std::vector<uint32_t>> brickTriangles(_brickOffsets.size());
+	XMVECTOR origin = XMLoadFloat3(&_origin);
+	XMVECTOR band = XMVectorReplicate(_bandWidth);
+	XMVECTOR brickCountMax = XMVectorSet(static_cast<float>(_brickCounts[0] - 1),
+										static_cast<float>(_brickCounts[1] - 1),
+										static_cast<float>(_brickCounts[2] - 1), 0.f);
+	for (uint32_t i = 0; i < triangles.size(); i += 3)
+	{
+		XMVECTOR t0 = XMLoadFloat3(&triangles[i]);
+		XMVECTOR t1 = XMLoadFloat3(&triangles[i + 1]);
+		XMVECTOR t2 = XMLoadFloat3(&triangles[i + 2]);
+		XMVECTOR triangleMin = XMVectorMin(XMVectorMin(t0, t1), t2) - band;
+		XMVECTOR triangleMax = XMVectorMax(XMVectorMax(t0, t1), t2) + band;
+
+		XMFLOAT3 brickMin, brickMax;
+		XMStoreFloat3(&brickMin, XMVectorClamp(XMVectorFloor((triangleMin - origin) / brickSize), XMVectorZero(), brickCountMax));
+		XMStoreFloat3(&brickMax, XMVectorClamp(XMVectorFloor((triangleMax - origin) / brickSize), XMVectorZero(), brickCountMax));
+		for (int z = static_cast<int>(brickMin.z); z <= static_cast<int>(brickMax.z); ++z)
+		{
+			for (int y = static_cast<int>(brickMin.y); y <= static_cast<int>(brickMax.y); ++y)
+			{
+				for (int x = static_cast<int>(brickMin.x); x <= static_cast<int>(brickMax.x); ++x)
+				{
+					brickTriangles[getBrickIndex(x, y, z)].push_back(i);
+				}
+			}
+		}
+	}
+
+	constexpr int BRICK_SAMPLE_TOTAL = BRICK_SAMPLE_COUNT * BRICK_SAMPLE_COUNT * BRICK_SAMPLE_COUNT;
+	const size_t brickCount = std::count_if(brickTriangles.begin(), brickTriangles.end(),
+		[](const std::vector<uint32_t>& triangleList) { return !triangleList.empty(); });
+	if (std::numeric_limits<uint32_t>::max() / BRICK_SAMPLE_TOTAL <= brickCount)
+	{
+		ThrowErrCode(ErrCode::Overflow, "brick  : " + std::to_string(brickCount));
+	}
+	_samples.reserve(brickCount * BRICK_SAMPLE_TOTAL);
+
+	const float bandSq = _bandWidth * _bandWidth;
+	for (int brickZ = 0; brickZ < _brickCounts[2]; ++brickZ)
+	{
+		for (int brickY = 0; brickY < _brickCounts[1]; ++brickY)
+		{
+			for (int brickX = 0; brickX < _brickCounts[0]; ++brickX)
+			{
+				const size_t brickIndex = getBrickIndex(brickX, brickY, brickZ);
+				const auto& triangleList = brickTriangles[brickIndex];
+				if (triangleList.empty())
+				{
+					continue;
+				}
+				_brickOffsets[brickIndex] = static_cast<uint32_t>(_samples.size());
+				for (int z = 0; z < BRICK_SAMPLE_COUNT; ++z)
+				{
+					for (int y = 0; y < BRICK_SAMPLE_COUNT; ++y)
+					{
+						for (int x = 0; x < BRICK_SAMPLE_COUNT; ++x)
+						{
+							XMVECTOR samplePosition = origin + XMVectorSet(static_cast<float>(brickX * BRICK_CELL_COUNT + x),
+																			static_cast<float>(brickY * BRICK_CELL_COUNT + y),
+																			static_cast<float>(brickZ * BRICK_CELL_COUNT + z), 0.f) * _cellSize;
+							float distanceSq = bandSq;
+							for (const auto& triangleIndex : triangleList)
+							{
+								distanceSq = std::min(distanceSq, MathHelper::getDistanceSqPointTriangle(samplePosition,
+																				XMLoadFloat3(&triangles[triangleIndex]),
+																				XMLoadFloat3(&triangles[triangleIndex + 1]),
+																				XMLoadFloat3(&triangles[triangleIndex + 2])));
+							}
+							_samples.push_back(std::sqrt(distanceSq));
+						}
+					}
+				}
+			}
+		}
+	}
+	check(_samples.size() == brickCount * BRICK_SAMPLE_TOTAL);
+
+#if defined DEBUG | defined _DEBUG
+	logBuildError(triangles, brickTriangles);
+#endif
+}
+
+float TerrainDistanceField::getDistance(const DirectX::XMFLOAT3& position) const noexcept
+{
+	check(isBuilt());
+	const float gridX = (position.x - _origin.x) / _cellSize;
+	const float gridY = (position.y - _origin.y) / _cellSize;
+	const float gridZ = (position.z - _origin.z) / _cellSize;
+	const float cellCountX = static_cast<float>(_brickCounts[0] * BRICK_CELL_COUNT);
+	const float cellCountY = static_cast<float>(_brickCounts[1] * BRICK_CELL_COUNT);
+	const float cellCountZ = static_cast<float>(_brickCounts[2] * BRICK_CELL_COUNT);
+	if (gridX < 0.f || cellCountX <= gridX ||
+		gridY < 0.f || cellCountY <= gridY ||
+		gridZ < 0.f || cellCountZ <= gridZ)
+	{
+		// ڴ terrain  bandŭ ø ̹Ƿ   ڱ Ÿ band  ͺ ִ.
+		const float outsideX = std::max({ 0.f, -gridX, gridX - cellCountX });
+		const float outsideY = std::max({ 0.f, -gridY, gridY - cellCountY });
+		const float outsideZ = std::max({ 0.f, -gridZ, gridZ - cellCountZ });
+		return _bandWidth + std::sqrt(outsideX * outsideX + outsideY * outsideY + outsideZ * outsideZ) * _cellSize;
+	}
+
+	const int brickX = static_cast<int>(gridX) / BRICK_CELL_COUNT;
+	const int brickY = static_cast<int>(gridY) / BRICK_CELL_COUNT;
+	const int brickZ = static_cast<int>(gridZ) / BRICK_CELL_COUNT;
+	const uint32_t brickOffset = _brickOffsets[getBrickIndex(brickX, brickY, brickZ)];
+	if (brickOffset == EMPTY_BRICK)
+	{
+		return _bandWidth;
+	}
+
+	const float localX = gridX - brickX * BRICK_CELL_COUNT;
+	const float localY = gridY - brickY * BRICK_CELL_COUNT;
+	const float localZ = gridZ - brickZ * BRICK_CELL_COUNT;
+	const int x = std::min(static_cast<int>(localX), BRICK_CELL_COUNT - 1);
+	const int y = std::min(static_cast<int>(localY), BRICK_CELL_COUNT - 1);
+	const int z = std::min(static_cast<int>(localZ), BRICK_CELL_COUNT - 1);
+	const float tx = localX - x;
+	const float ty = localY - y;
+	const float tz = localZ - z;
+
+	auto lerp = [](float lhs, float rhs, float t) { return lhs + (rhs - lhs) * t; };
+	const float d00 = lerp(getSample(brickOffset, x, y, z), getSample(brickOffset, x + 1, y, z), tx);
+	const float d10 = lerp(getSample(brickOffset, x, y + 1, z), getSample(brickOffset, x + 1, y + 1, z), tx);
+	const float d01 = lerp(getSample(brickOffset, x, y, z + 1), getSample(brickOffset, x + 1, y, z + 1), tx);
+	const float d11 = lerp(getSample(brickOffset, x, y + 1, z + 1), getSample(brickOffset, x + 1, y + 1, z + 1), tx);
+	return lerp(lerp(d00, d10, ty), lerp(d01, d11, ty), tz);
+}
+
+size_t TerrainDistanceField::getBrickIndex(int x, int y, int z) const noexcept
+{
+	check(0 <= x && x < _brickCounts[0]);
+	check(0 <= y && y < _brickCounts[1]);
+	check(0 <= z && z < _brickCounts[2]);
+	return (static_cast<size_t>(z) * _brickCounts[1] + y) * _brickCounts[0] + x;
+}
+
+float TerrainDistanceField::getSample(uint32_t brickOffset, int x, int y, int z) const noexcept
+{
+	check(0 <= x && x < BRICK_SAMPLE_COUNT);
+	check(0 <= y && y < BRICK_SAMPLE_COUNT);
+	check(0 <= z && z < BRICK_SAMPLE_COUNT);
+	return _samples[brickOffset + (z * BRICK_SAMPLE_COUNT + y) * BRICK_SAMPLE_COUNT + x];
+}
+
+#if defined DEBUG | defined _DEBUG
+void TerrainDistanceField::logBuildError(const std::vector<DirectX::XMFLOAT3>& triangles,
+										const std::vector<std::vector<uint32_t>>& brickTriangles) const noexcept
+{
+	using namespace DirectX;
+	//  ̿    Ÿ 󸶳 ٸ ĭ ߽ Ѵ.
+	float maxError = 0.f;
+	for (int brickZ = 0; brickZ < _brickCounts[2]; ++brickZ)
+	{
+		for (int brickY = 0; brickY < _brickCounts[1]; ++brickY)
+		{
+			for (int brickX = 0; brickX < _brickCounts[0]; ++brickX)
+			{
+				const auto& triangleList = brickTriangles[getBrickIndex(brickX, brickY, brickZ)];
+				if (triangleList.empty())
+				{
+					continue;
+				}
+				for (int z = 0; z < BRICK_CELL_COUNT; ++z)
+				{
+					for (int y = 0; y < BRICK_CELL_COUNT; ++y)
+					{
+						for (int x = 0; x < BRICK_CELL_COUNT; ++x)
+						{
+							XMFLOAT3 position;
+							position.x = _origin.x + (brickX * BRICK_CELL_COUNT + x + 0.5f) * _cellSize;
+							position.y = _origin.y + (brickY * BRICK_CELL_COUNT + y + 0.5f) * _cellSize;
+							position.z = _origin.z + (brickZ * BRICK_CELL_COUNT + z + 0.5f) * _cellSize;
+							XMVECTOR positionV = XMLoadFloat3(&position);
+
+							float distanceSq = _bandWidth * _bandWidth;
+							for (const auto& triangleIndex : triangleList)
+							{
+								distanceSq = std::min(distanceSq, MathHelper::getDistanceSqPointTriangle(positionV,
+																				XMLoadFloat3(&triangles[triangleIndex]),
+																				XMLoadFloat3(&triangles[triangleIndex + 1]),
+																				XMLoadFloat3(&triangles[triangleIndex + 2])));
+							}
+							maxError = std::max(maxError, std::abs(getDistance(position) - std::sqrt(distanceSq)));
+						}
+					}
+				}
+			}
+		}
+	}
+	check(maxError <= getMaxError(), "  Ѱ躸 Ůϴ.");
+
+	const std::string text = "[TerrainDistanceField] brick: " + std::to_string(_samples.size() / (BRICK_SAMPLE_COUNT * BRICK_SAMPLE_COUNT * BRICK_SAMPLE_COUNT)) +
+		"/" + std::to_string(_brickOffsets.size()) +
+		" memory: " + std::to_string((_samples.size() * sizeof(float) + _brickOffsets.size() * sizeof(uint32_t)) / 1024) + "KB" +
+		" maxError: " + std::to_string(maxError) +
+		" errorBound: " + std::to_string(getMaxError()) + "\n";
+	OutputDebugStringA(text.c_str());
+}
+#endif
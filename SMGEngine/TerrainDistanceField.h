@@ -0,0 +1,44 @@
+#pragma once
+#include "stdafx.h"
+
+// terrain ǥ ó ϴ Ÿ. terrain    ڷ  ǥ鿡 band Ÿ ȿ ġ brick .
+//  ̵ üũ ǥ Ÿ θ ϹǷ ȣ  ʴ´.
+class TerrainDistanceField
+{
+public:
+	TerrainDistanceField(void) noexcept;
+	// triangles ﰢ  3, min max   δ 
+	void build(const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max, const std::vector<DirectX::XMFLOAT3>& triangles);
+	bool isBuilt(void) const noexcept { return !_brickOffsets.empty(); }
+	// position   ǥ Ÿ.  Ÿ ̴ getMaxError() ̴̳.
+	// getBandWidth()    Ÿ   ȯѴ.
+	float getDistance(const DirectX::XMFLOAT3& position) const noexcept;
+	float getCellSize(void) const noexcept { return _cellSize; }
+	float getBandWidth(void) const noexcept { return _bandWidth; }
+	// ĭ  ϹǷ ĭ 밢 ̸ŭ Ʋ  ִ.
+	float getMaxError(void) const noexcept { return _cellSize * 1.7320508f; }
+private:
+	//    ĭ 
+	static constexpr int CELL_COUNT = 64;
+	static constexpr int BRICK_CELL_COUNT = 8;
+	static constexpr int BRICK_SAMPLE_COUNT = BRICK_CELL_COUNT + 1;
+	static constexpr int BAND_CELL_COUNT = 4;
+	static constexpr uint32_t EMPTY_BRICK = std::numeric_limits<uint32_t>::max();
+
+	size_t getBrickIndex(int x, int y, int z) const noexcept;
+	float getSample(uint32_t brickOffset, int x, int y, int z) const noexcept;
+#if defined DEBUG | defined _DEBUG
+	void logBuildError(const std::vector<DirectX::XMFLOAT3>& triangles,
+						const std::vector<std::vector<uint32_t>>& brickTriangles) const noexcept;
+#endif
+private:
+	//  (0, 0, 0) ġ. terrain  bandŭ ø  Ѵ.
+	DirectX::XMFLOAT3 _origin;
+	float _cellSize;
+	float _bandWidth;
+	std::array<int, 3> _brickCounts;
+	// brick ڸ _samples  ġ. ǥ ó ƴϸ EMPTY_BRICK
+	std::vector<uint32_t> _brickOffsets;
+	// brick BRICK_SAMPLE_COUNT^3, x   ٲ. ̿ brick   ߺؼ .
+	std::vector<float> _samples;
+};
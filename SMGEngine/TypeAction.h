@@ -5,6 +5,7 @@ enum class ActionConditionType
 {
 	Tick,
 	Key,
+	Stick,
 	End,
 	IsStop,
 	OnGround,
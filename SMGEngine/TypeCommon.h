@@ -6,6 +6,15 @@ using TickCount64 = int64_t;
 static constexpr TickCount64 FRAME_TO_TICKCOUNT = 20;
 static constexpr double TICKCOUNT_TO_FRAME = 1.f / FRAME_TO_TICKCOUNT;
 
+// εҶ ڿ ̸  ٲ id. NameTable 
+using NameId = uint16_t;
+static constexpr NameId UNDEFINED_NAME_ID = std::numeric_limits<NameId>::max();
+
+// index buffer  ĭ. ȯ⵵ D3D  Ѵ.
+using GeoIndex = uint16_t;
+//   mesh LOD ܰ  ִ밪. ܰ踶 index  ְ     .
+constexpr int MESH_LOD_COUNT_MAX = 4;
+
 enum class ButtonInputType : uint8_t
 {
 	AB,
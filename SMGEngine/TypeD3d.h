@@ -19,10 +19,13 @@ constexpr const char* NUM_DIR_LIGHTS_LPCSTR = "3";
 constexpr const char* NUM_POINT_LIGHTS_LPCSTR = "0";
 constexpr const char* NUM_SPOT_LIGHTS_LPCSTR = "0";
 
-constexpr UINT OBJECT_MAX = 200;
-constexpr UINT MATERIAL_MAX = 200;
-constexpr UINT SKINNED_INSTANCE_MAX = 50;
-constexpr UINT EFFECT_INSTANCE_MAX = 400;
+//  ҽ  ʱ ũ. ϸ FrameResource ۸ ø.
+constexpr UINT OBJECT_PAGE_SIZE = 200;
+constexpr UINT MATERIAL_PAGE_SIZE = 200;
+constexpr UINT SKINNED_INSTANCE_PAGE_SIZE = 50;
+constexpr UINT EFFECT_INSTANCE_PAGE_SIZE = 400;
+//  ӿ ׸  pass instance 
+constexpr UINT RENDER_INSTANCE_PAGE_SIZE = 2000;
 constexpr UINT TEXTURE_MAX = 200;
 constexpr const char* TEXTURE_MAX_LPCSTR = "200";
 
@@ -92,6 +95,22 @@ constexpr RenderLayer HasShadowLayers[] =
 	RenderLayer::AlphaTested,
 };
 static_assert(static_cast<int>(RenderLayer::Count) == 7, "׸ڰ ܾ ϴ ̾ ּ߰.");
+// addRenderItems ׸    
+enum class DrawPass : uint8_t
+{
+	Main,			// ī޶ culling
+	StaticShadow,	//  ʴ Ʈ, ׸ culling
+	DynamicShadow,	// ̴ Ʈ, ׸ culling
+	Count,
+};
+// command list ϴ . ׸   ׷  pass   ִ.
+constexpr DrawPass RecordPassOrder[] =
+{
+	DrawPass::StaticShadow,
+	DrawPass::DynamicShadow,
+	DrawPass::Main,
+};
+static_assert(sizeof(RecordPassOrder) == static_cast<int>(DrawPass::Count), "DrawPass ߰  ּ.");
 constexpr uint16_t SKINNED_UNDEFINED = std::numeric_limits<uint16_t>::max();
 
 static constexpr float FOV_ANGLE = 0.25f * DirectX::XM_PI;
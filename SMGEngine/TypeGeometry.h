@@ -1,10 +1,22 @@
 #pragma once
 #include "stdafx.h"
 #include "TypeD3d.h"
+#include "TypeCommon.h"
 
 // MAX_LIGHT_COUNT    LightingUtil.hlsl   ؾ.
 constexpr int MAX_LIGHT_COUNT = 16;
 
+// terrain 浹 üũ 
+enum class TerrainCollisionType : uint8_t
+{
+	// AABB Ʈ ﰢ ãƼ ˻
+	Triangle,
+	//  浹 Ÿ ǥ ó ̵    ﰢ ˻. ༺ó   Ѵ.
+	DistanceField,
+
+	Count,
+};
+
 struct Light
 {
 	Light() noexcept;
@@ -100,8 +112,6 @@ struct SkinnedConstants
 	DirectX::XMFLOAT4X4 _boneTransforms[BONE_INDEX_MAX];
 };
 
-using GeoIndex = uint16_t;
-
 struct Texture
 {
 	std::string _name;
@@ -2,6 +2,28 @@
 #include "TypeCommon.h"
 class XMLReaderNode;
 
+// actor gravity point ĺ ٽ ã    ִ Ÿ
+static constexpr float GRAVITY_POINT_CANDIDATE_MARGIN = 200.f;
+// auto camera point ٽ ã ĺ  . ѹ ã  ִ  ݰ̱⵵ ϴ.
+static constexpr float AUTO_CAMERA_POINT_QUERY_MARGIN = 500.f;
+
+// ÷̾ Ÿ, ø ο  actor ùķ̼ 
+enum class ActorActivityLevel : uint8_t
+{
+	Full,
+	Reduced,
+	Minimal,
+	// ְ Է ٲ  ° ٲ ʴ actor. tick .
+	Sleep,
+
+	Count,
+};
+static constexpr float ACTIVITY_REDUCED_DISTANCE = 3000.f;
+static constexpr float ACTIVITY_MINIMAL_DISTANCE = 6000.f;
+//  Ӹ ѹ ùķ̼ ϴ. ǳʶ  tick Ƽ ѱ.
+static constexpr uint32_t ACTIVITY_REDUCED_INTERVAL = 2;
+static constexpr uint32_t ACTIVITY_MINIMAL_INTERVAL = 4;
+
 enum class CameraPointType
 {
 	Fixed,
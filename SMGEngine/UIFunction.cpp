@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "MathHelper.h"
 #include "UserData.h"
+#include "NameTable.h"
 
 std::array<std::function<void(UIGroup*)>, static_cast<int>(UIFunctionType::Count)> UIFunction::_functions =
 std::array<std::function<void(UIGroup*)>, static_cast<int>(UIFunctionType::Count)>();
@@ -43,10 +44,13 @@ void UIFunction::execute(UIFunctionType functionType, UIGroup* uiGroup)
 
 void UIFunction::setHpUI(UIGroup* uiGroup)
 {
+	static const NameId hpPanelImageNameId = NameTable::getNameId("HPPanelImage");
+	static const NameId hpTextNameId = NameTable::getNameId("HPText");
+	static const NameId playerHPNameId = NameTable::getNameId("PlayerHP");
 	check(uiGroup != nullptr);
 
 	shakeUI(uiGroup);
-	UIElement* elementImage = uiGroup->findElement("HPPanelImage", UIElementType::Image);
+	UIElement* elementImage = uiGroup->findElement(hpPanelImageNameId, UIElementType::Image);
 	if (elementImage == nullptr)
 	{
 		check(false, "HPPanelImage .");
@@ -55,7 +59,7 @@ void UIFunction::setHpUI(UIGroup* uiGroup)
 
 	UIElementImage* elementImageCasted = static_cast<UIElementImage*>(elementImage);
 
-	UIElement* elementText = uiGroup->findElement("HPText", UIElementType::Text);
+	UIElement* elementText = uiGroup->findElement(hpTextNameId, UIElementType::Text);
 	if (elementText == nullptr)
 	{
 		check(false, "HPText .");
@@ -63,7 +67,7 @@ void UIFunction::setHpUI(UIGroup* uiGroup)
 	}
 
 	UIElementText* elementTextCasted = static_cast<UIElementText*>(elementText);
-	int hp = SMGFramework::getStageManager()->getStageScriptVariable("PlayerHP");
+	int hp = SMGFramework::getStageManager()->getStageScriptVariable(playerHPNameId);
 	hp = std::clamp(hp, 0, 6);
 	elementImageCasted->setImage("ui/hpBackground_" + std::to_string(hp));
 	elementTextCasted->setText(std::to_wstring(hp));
@@ -71,10 +75,12 @@ void UIFunction::setHpUI(UIGroup* uiGroup)
 
 void UIFunction::setStarBitUI(UIGroup* uiGroup)
 {
+	static const NameId starBitTextNameId = NameTable::getNameId("StarBitText");
+	static const NameId playerStarBitNameId = NameTable::getNameId("PlayerStarBit");
 	check(uiGroup != nullptr);
 	shakeUI(uiGroup);
 
-	UIElement* elementText = uiGroup->findElement("StarBitText", UIElementType::Text);
+	UIElement* elementText = uiGroup->findElement(starBitTextNameId, UIElementType::Text);
 	if (elementText == nullptr)
 	{
 		check(false, "StarBitText .");
@@ -82,16 +88,18 @@ void UIFunction::setStarBitUI(UIGroup* uiGroup)
 	}
 
 	UIElementText* elementTextCasted = static_cast<UIElementText*>(elementText);
-	int starBit = SMGFramework::getStageManager()->getStageScriptVariable("PlayerStarBit");
+	int starBit = SMGFramework::getStageManager()->getStageScriptVariable(playerStarBitNameId);
 	elementTextCasted->setText(std::to_wstring(starBit));
 }
 
 void UIFunction::setCoinUI(UIGroup* uiGroup)
 {
+	static const NameId coinTextNameId = NameTable::getNameId("CoinText");
+	static const NameId playerCoinNameId = NameTable::getNameId("PlayerCoin");
 	check(uiGroup != nullptr);
 	shakeUI(uiGroup);
 
-	UIElement* elementText = uiGroup->findElement("CoinText", UIElementType::Text);
+	UIElement* elementText = uiGroup->findElement(coinTextNameId, UIElementType::Text);
 	if (elementText == nullptr)
 	{
 		check(false, "CoinText .");
@@ -99,16 +107,17 @@ void UIFunction::setCoinUI(UIGroup* uiGroup)
 	}
 
 	UIElementText* elementTextCasted = static_cast<UIElementText*>(elementText);
-	int coin = SMGFramework::getStageManager()->getStageScriptVariable("PlayerCoin");
+	int coin = SMGFramework::getStageManager()->getStageScriptVariable(playerCoinNameId);
 	elementTextCasted->setText(std::to_wstring(coin));
 }
 
 void UIFunction::setLifeUI(UIGroup* uiGroup)
 {
+	static const NameId lifeTextNameId = NameTable::getNameId("LifeText");
 	check(uiGroup != nullptr);
 	shakeUI(uiGroup);
 
-	UIElement* elementText = uiGroup->findElement("LifeText", UIElementType::Text);
+	UIElement* elementText = uiGroup->findElement(lifeTextNameId, UIElementType::Text);
 	if (elementText == nullptr)
 	{
 		check(false, "LifeText .");
@@ -157,8 +166,9 @@ void UIFunction::shakeUI(UIGroup* uiGroup)
 
 void UIFunction::irisOut(UIGroup* uiGroup)
 {
+	static const NameId irisNameId = NameTable::getNameId("Iris");
 	check(uiGroup != nullptr);
-	UIElement* uiElement = uiGroup->findElement("Iris", UIElementType::Iris);
+	UIElement* uiElement = uiGroup->findElement(irisNameId, UIElementType::Iris);
 	if (uiElement == nullptr)
 	{
 		check(false, "Iris .");
@@ -171,8 +181,9 @@ void UIFunction::irisOut(UIGroup* uiGroup)
 
 void UIFunction::irisIn(UIGroup* uiGroup)
 {
+	static const NameId irisNameId = NameTable::getNameId("Iris");
 	check(uiGroup != nullptr);
-	UIElement* uiElement = uiGroup->findElement("Iris", UIElementType::Iris);
+	UIElement* uiElement = uiGroup->findElement(irisNameId, UIElementType::Iris);
 	if (uiElement == nullptr)
 	{
 		check(false, "Iris .");
@@ -190,8 +201,9 @@ void UIFunction::irisIn(UIGroup* uiGroup)
 
 void UIFunction::updateIris(UIGroup* uiGroup)
 {
+	static const NameId irisNameId = NameTable::getNameId("Iris");
 	check(uiGroup != nullptr);
-	UIElement* uiElement = uiGroup->findElement("Iris", UIElementType::Iris);
+	UIElement* uiElement = uiGroup->findElement(irisNameId, UIElementType::Iris);
 	if (uiElement == nullptr)
 	{
 		check(false, "Iris .");
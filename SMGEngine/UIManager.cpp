@@ -6,17 +6,20 @@
 #include "FileHelper.h"
 #include "UIFunction.h"
 #include "MathHelper.h"
+#include "FrameSnapshot.h"
 #include <d2d1.h>
 
 
 UIManager::UIManager()
-	: _screenSize(0, 0)
+	: _uiGroupsByNameId(nullptr)
+	, _screenSize(0, 0)
 {
 }
 
 void UIManager::release(void) noexcept
 {
 	_uiGroups.clear();
+	_uiGroupsByNameId.clear();
 }
 
 void UIManager::onResize(void) noexcept
@@ -32,11 +35,11 @@ void UIManager::onResize(void) noexcept
 	_screenSize.y = static_cast<float>(SMGFramework::Get().getClientHeight());
 }
 
-void UIManager::drawUI()
+void UIManager::addDrawCommands(std::vector<UIDrawCommand>& outCommands) const
 {
 	for (const auto& e : _uiGroups)
 	{
-		e.second->draw();
+		e.second->addDrawCommands(outCommands);
 	}
 }
 
@@ -58,6 +61,7 @@ void UIManager::loadXML(const std::string& fileName)
 		{
 			ThrowErrCode(ErrCode::KeyDuplicated, name);
 		}
+		_uiGroupsByNameId.set(NameTable::getNameId(name), it.first->second.get());
 	}
 
 	onResize();
@@ -71,14 +75,9 @@ void UIManager::update()
 	}
 }
 
-UIGroup* UIManager::getGroup(const std::string& groupName) noexcept
+UIGroup* UIManager::getGroup(NameId groupName) noexcept
 {
-	auto it = _uiGroups.find(groupName);
-	if (it == _uiGroups.end())
-	{
-		return nullptr;
-	}
-	return it->second.get();
+	return _uiGroupsByNameId.get(groupName);
 }
 
 UIGroup::UIGroup(const XMLReaderNode& node)
@@ -128,16 +127,16 @@ void UIGroup::onResize(const DirectX::XMFLOAT2& sizeRate)
 	}
 }
 
-UIElement* UIGroup::findElement(const std::string& name, UIElementType typeCheck) const noexcept
+UIElement* UIGroup::findElement(NameId nameId, UIElementType typeCheck) const noexcept
 {
 	for (const auto& e : _child)
 	{
-		if (e->isNameEqual(name))
+		if (e->isNameEqual(nameId))
 		{
 			if (typeCheck != e->getType())
 			{
 				check(false, "element type error " +
-							name +
+							NameTable::getName(nameId) +
 							std::to_string(static_cast<int>(typeCheck)) +
 							std::to_string(static_cast<int>(e->getType())),
 							);
@@ -158,7 +157,7 @@ void UIGroup::update(void)
 	}
 }
 
-void UIGroup::draw(void) const noexcept
+void UIGroup::addDrawCommands(std::vector<UIDrawCommand>& outCommands) const
 {
 	if (!_isActive)
 	{
@@ -169,7 +168,7 @@ void UIGroup::draw(void) const noexcept
 	
 	for (const auto& e : _child)
 	{
-		e->draw(position);
+		e->addDrawCommand(position, outCommands);
 	}
 }
 
@@ -215,8 +214,9 @@ bool UIGroup::isMoving(void) const noexcept
 	return true;
 }
 
-UIElement::UIElement(const std::string& name, const DirectX::XMFLOAT2& position, const DirectX::XMFLOAT2& size) noexcept
+UIElement::UIElement(const std::string& name, const DirectX::XMFLOAT2& position, const DirectX::XMFLOAT2& size)
 	: _name(name)
+	, _nameId(NameTable::getNameId(name))
 	, _localPosition(position)
 	, _size(size)
 {
@@ -226,6 +226,7 @@ UIElement::UIElement(const std::string& name, const DirectX::XMFLOAT2& position,
 UIElement::UIElement(const XMLReaderNode& node)
 {
 	node.loadAttribute("Name", _name);
+	_nameId = NameTable::getNameId(_name);
 	node.loadAttribute("Position", _localPosition);
 	node.loadAttribute("Size", _size);
 }
@@ -321,11 +322,16 @@ void UIElementText::onResize(const DirectX::XMFLOAT2& resizeRate) noexcept
 
 }
 
-void UIElementText::draw(const DirectX::XMFLOAT2& parentPosition) const noexcept
+void UIElementText::addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const
 {
-	ID2D1Brush* brush = SMGFramework::Get().getD3DApp()->getTextBrush(_brushType);
-	D2D1_POINT_2F position = { _localPosition.x + parentPosition.x, _localPosition.y + parentPosition.y };
-	SMGFramework::Get().getD3DApp()->getD2dContext()->DrawTextLayout(position, _textLayout.Get(), brush);
+	UIDrawCommand command;
+	command._type = UIElementType::Text;
+	command._brushType = _brushType;
+	command._position = { _localPosition.x + parentPosition.x, _localPosition.y + parentPosition.y };
+	command._size = _size;
+	// setText layout  Ƿ ׸  layout ٲ ʴ´.
+	command._textLayout = _textLayout;
+	outCommands.push_back(std::move(command));
 }
 
 void UIElementText::setText(const std::wstring& text)
@@ -347,15 +353,15 @@ UIElementImage::UIElementImage(const XMLReaderNode& node)
 	node.loadAttribute("Resize", _resize);
 }
 
-void UIElementImage::draw(const DirectX::XMFLOAT2& parentPosition) const noexcept
+void UIElementImage::addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const
 {
-	float upperLeftX = _localPosition.x + parentPosition.x;
-	float upperLeftY = _localPosition.y + parentPosition.y;
-	float bottomRightX = upperLeftX + _size.x;
-	float bottomRightY = upperLeftY + _size.y;
-	SMGFramework::getD3DApp()->getD2dContext()->DrawBitmap(
-		_bitmapImage,
-		D2D1::RectF(upperLeftX, upperLeftY, bottomRightX, bottomRightY));
+	UIDrawCommand command;
+	command._type = UIElementType::Image;
+	command._brushType = TextBrushType::Count;
+	command._position = { _localPosition.x + parentPosition.x, _localPosition.y + parentPosition.y };
+	command._size = _size;
+	command._bitmap = _bitmapImage;
+	outCommands.push_back(std::move(command));
 }
 
 void UIElementImage::onResize(const DirectX::XMFLOAT2& resizeRate) noexcept
@@ -411,18 +417,22 @@ UIElementIris::UIElementIris(const XMLReaderNode& node)
 	));
 }
 
-void UIElementIris::draw(const DirectX::XMFLOAT2& parentPosition) const noexcept
+void UIElementIris::addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const
 {
-	ID2D1Brush* brush = SMGFramework::Get().getD3DApp()->getTextBrush(TextBrushType::Black);
 	auto transformMatrix = D2D1::Matrix3x2F::Translation(parentPosition.x, parentPosition.y);
 	WComPtr<ID2D1TransformedGeometry> transformedGeometry;
-
-	SMGFramework::getD3DApp()->getD2dFactory()->CreateTransformedGeometry(
+	ThrowIfFailed(SMGFramework::getD3DApp()->getD2dFactory()->CreateTransformedGeometry(
 		_geometryGroup.Get(),
 		transformMatrix,
-		&transformedGeometry);
-
-	SMGFramework::getD3DApp()->getD2dContext()->FillGeometry(transformedGeometry.Get(), brush);
+		&transformedGeometry));
+
+	UIDrawCommand command;
+	command._type = UIElementType::Iris;
+	command._brushType = TextBrushType::Black;
+	command._position = parentPosition;
+	command._size = _size;
+	command._geometry = transformedGeometry;
+	outCommands.push_back(std::move(command));
 }
 
 void UIElementIris::onResize(const DirectX::XMFLOAT2& resizeRate) noexcept
@@ -2,9 +2,11 @@
 #include "TypeD3d.h"
 #include "TypeUI.h"
 #include "TypeCommon.h"
+#include "NameTable.h"
 
 class Material;
 class XMLReaderNode;
+struct UIDrawCommand;
 
 
 static constexpr D2D1_BITMAP_PROPERTIES1 bitmapProperty =
@@ -19,15 +21,17 @@ class UIElement
 {
 public:
 	UIElement(const XMLReaderNode& node);
-	UIElement(const std::string& name, const DirectX::XMFLOAT2& position, const DirectX::XMFLOAT2& size) noexcept;
+	UIElement(const std::string& name, const DirectX::XMFLOAT2& position, const DirectX::XMFLOAT2& size);
 	virtual UIElementType getType(void) const noexcept = 0;
 	virtual ~UIElement() = default;
 	virtual void onResize(const DirectX::XMFLOAT2& resizeRate) noexcept = 0;
-	bool isNameEqual(const std::string& name) const noexcept { return _name == name; }
-	virtual void draw(const DirectX::XMFLOAT2& parentPosition) const noexcept = 0;
+	bool isNameEqual(NameId nameId) const noexcept { return _nameId == nameId; }
+	// 렌더 스레드가 그릴 값을 복사해서 outCommands에 추가한다.
+	virtual void addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const = 0;
 	static std::unique_ptr<UIElement> loadXMLUIElement(const XMLReaderNode& node);
 protected:
 	std::string _name;
+	NameId _nameId;
 	DirectX::XMFLOAT2 _localPosition;
 	DirectX::XMFLOAT2 _size;
 };
@@ -45,7 +49,7 @@ public:
 		TextBrushType brushType,
 		const std::wstring& text);
 	virtual void onResize(const DirectX::XMFLOAT2& resizeRate) noexcept override;
-	virtual void draw(const DirectX::XMFLOAT2& parentPosition) const noexcept override;
+	virtual void addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const override;
 	void setText(const std::wstring& text);
 private:
 	WComPtr<IDWriteTextLayout> _textLayout;
@@ -59,7 +63,7 @@ public:
 	UIElementImage(const XMLReaderNode& node);
 	virtual ~UIElementImage() = default;
 	virtual UIElementType getType(void) const noexcept override { return UIElementType::Image; }
-	virtual void draw(const DirectX::XMFLOAT2& parentPosition) const noexcept override;
+	virtual void addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const override;
 	virtual void onResize(const DirectX::XMFLOAT2& resizeRate) noexcept override;
 	void setImage(const std::string& imageName);
 private:
@@ -73,7 +77,7 @@ public:
 	UIElementIris(const XMLReaderNode& node);
 	virtual ~UIElementIris() = default;
 	virtual UIElementType getType(void) const noexcept override { return UIElementType::Iris; }
-	virtual void draw(const DirectX::XMFLOAT2& parentPosition) const noexcept override;
+	virtual void addDrawCommand(const DirectX::XMFLOAT2& parentPosition, std::vector<UIDrawCommand>& outCommands) const override;
 	virtual void onResize(const DirectX::XMFLOAT2& resizeRate) noexcept override;
 	void set(bool isIn) noexcept;
 	void update(void);
@@ -98,9 +102,9 @@ class UIGroup
 public:
 	UIGroup(const XMLReaderNode& node);
 	void onResize(const DirectX::XMFLOAT2& sizeRate);
-	UIElement* findElement(const std::string& name, UIElementType typeCheck) const noexcept;
+	UIElement* findElement(NameId nameId, UIElementType typeCheck) const noexcept;
 	void update(void);
-	void draw(void) const noexcept;
+	void addDrawCommands(std::vector<UIDrawCommand>& outCommands) const;
 	UIFunctionType getUpdateFunctionType(void) const noexcept { return _updateFunctionType; }
 	DirectX::XMFLOAT2 getCurrentPositionOffset(void) const noexcept;
 	const DirectX::XMFLOAT2 getHidePositionOffset(void) const noexcept { return _hidePositionOffset; }
@@ -131,11 +135,13 @@ public:
 	UIManager();
 	void release(void) noexcept;
 	void onResize(void) noexcept;
-	void drawUI();
+	// 시뮬레이션 스레드에서 호출한다. 렌더 스레드는 UI를 직접 읽지 않고 여기서 복사한 것만 그린다.
+	void addDrawCommands(std::vector<UIDrawCommand>& outCommands) const;
 	void loadXML(const std::string& fileName);
 	void update();
-	UIGroup* getGroup(const std::string& groupName) noexcept;
+	UIGroup* getGroup(NameId groupName) noexcept;
 private:
 	std::unordered_map<std::string, std::unique_ptr<UIGroup>> _uiGroups;
+	NameIdMap<UIGroup*> _uiGroupsByNameId;
 	DirectX::XMFLOAT2 _screenSize;
 };
\ No newline at end of file
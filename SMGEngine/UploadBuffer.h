@@ -7,6 +7,7 @@ class UploadBufferWrapper
 public:
 	UploadBufferWrapper(ID3D12Device* device, UINT elementCount, bool isConstantBuffer)
 		: _elementByteSize(sizeof(T))
+		, _elementCount(elementCount)
 	{
 		if (isConstantBuffer)
 		{
@@ -40,13 +41,27 @@ public:
 		return _uploadBuffer.Get();
 	}
 
+	UINT getElementCount(void) const noexcept
+	{
+		return _elementCount;
+	}
+
 	void copyData(int elementIndex, const T& data)
 	{
+		check(static_cast<UINT>(elementIndex) < _elementCount);
 		memcpy(&_mappedData[elementIndex * _elementByteSize], &data, sizeof(T));
 	}
 
+	// ۸ ø   ű. upload heap cpu Ƿ  þ ȣȴ.
+	void copyAllData(const UploadBufferWrapper& rhs) noexcept
+	{
+		check(_elementByteSize == rhs._elementByteSize);
+		memcpy(_mappedData, rhs._mappedData, static_cast<size_t>(std::min(_elementCount, rhs._elementCount)) * _elementByteSize);
+	}
+
 private:
 	UINT _elementByteSize;
+	UINT _elementCount;
 
 	WComPtr<ID3D12Resource> _uploadBuffer;
 	BYTE* _mappedData;
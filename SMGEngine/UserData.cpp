@@ -6,6 +6,7 @@ UserData::UserData() noexcept
 	: _starBit(0)
 	, _coin(0)
 	, _life(5)
+	, _version(0)
 {
 
 }
@@ -13,6 +14,7 @@ UserData::UserData() noexcept
 void UserData::increaseStarBit() noexcept
 {
 	++_starBit;
+	++_version;
 }
 
 bool UserData::decreaseStarBit() noexcept
@@ -22,6 +24,7 @@ bool UserData::decreaseStarBit() noexcept
 		return false;
 	}
 	--_starBit;
+	++_version;
 	return true;
 }
 
@@ -33,12 +36,14 @@ void UserData::increaseCoin() noexcept
 		_coin = 0;
 		++_life;
 	}
+	++_version;
 }
 
 void UserData::increaseLife(int count) noexcept
 {
 	check(count >= 0);
 	_life += count;
+	++_version;
 }
 
 bool UserData::decreaseLife() noexcept
@@ -48,6 +53,7 @@ bool UserData::decreaseLife() noexcept
 		return false;
 	}
 	--_life;
+	++_version;
 	return true;
 }
 
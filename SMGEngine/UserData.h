@@ -13,10 +13,13 @@ public:
 	uint32_t getStarBit() const noexcept { return _starBit; }
 	uint32_t getCoin() const noexcept { return _coin; }
 	uint32_t getLife() const noexcept { return _life; }
+	//  ٲ𶧸 ö󰣴.  ũƮ UserData  ٽ Ҷ Ѵ.
+	uint32_t getVersion() const noexcept { return _version; }
 
 private:
 	static constexpr int COIN_MAX = 100;
 	uint32_t _starBit;
 	uint32_t _coin;
 	uint32_t _life;
+	uint32_t _version;
 };
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
+#if defined(_WIN32)
 #define NOMINMAX
 #include <winerror.h>
 #include <comdef.h>
 #include <wrl.h>
+#endif
 
 #include <stdint.h>
 
@@ -14,7 +16,13 @@
 #include <string>
 #include <unordered_map>
 #include <map>
+#include <memory>
+#include <limits>
+#include <cfloat>
+#include <type_traits>
 
+// SMGTest Windows ۿ ϹǷ D3D  ϵǾ ϴ  Ʒ  ʴ´.
+#if defined(_WIN32)
 #include <dxgi1_5.h>
 #include <d3dcompiler.h>
 #include <d3d12.h>
@@ -42,5 +50,20 @@
 //#pragma comment(lib, "DShow.lib")
 #pragma comment(lib, "DInput8.lib")
 #pragma comment(lib, "DXGuid.lib")
+#else
+#if __has_include(<DirectXMath.h>)
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#endif
+// winnt.h ũ. enum class Ʈ ڸ .
+#define DEFINE_ENUM_FLAG_OPERATORS(ENUMTYPE)																		\
+inline constexpr ENUMTYPE operator|(ENUMTYPE a, ENUMTYPE b) noexcept { return ENUMTYPE(static_cast<std::underlying_type_t<ENUMTYPE>>(a) | static_cast<std::underlying_type_t<ENUMTYPE>>(b)); }	\
+inline constexpr ENUMTYPE operator&(ENUMTYPE a, ENUMTYPE b) noexcept { return ENUMTYPE(static_cast<std::underlying_type_t<ENUMTYPE>>(a) & static_cast<std::underlying_type_t<ENUMTYPE>>(b)); }	\
+inline constexpr ENUMTYPE operator^(ENUMTYPE a, ENUMTYPE b) noexcept { return ENUMTYPE(static_cast<std::underlying_type_t<ENUMTYPE>>(a) ^ static_cast<std::underlying_type_t<ENUMTYPE>>(b)); }	\
+inline constexpr ENUMTYPE operator~(ENUMTYPE a) noexcept { return ENUMTYPE(~static_cast<std::underlying_type_t<ENUMTYPE>>(a)); }	\
+inline ENUMTYPE& operator|=(ENUMTYPE& a, ENUMTYPE b) noexcept { return a = a | b; }								\
+inline ENUMTYPE& operator&=(ENUMTYPE& a, ENUMTYPE b) noexcept { return a = a & b; }								\
+inline ENUMTYPE& operator^=(ENUMTYPE& a, ENUMTYPE b) noexcept { return a = a ^ b; }
+#endif
 
 #include "PreDefines.h"
\ No newline at end of file
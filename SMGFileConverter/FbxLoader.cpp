@@ -1,7 +1,10 @@
 #include "FbxLoader.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
 
 #include <filesystem>
 #include <set>
+#include <iostream>
 
 #include "SMGEngine/SkinnedData.h"
 #include "SMGEngine/MathHelper.h"
@@ -300,11 +303,101 @@ void FbxLoader::loadFbxOptimizedMesh(const FbxMesh* mesh,
 		ThrowErrCode(ErrCode::InvalidIndexInfo);
 	}
 
-	FbxMeshInfo info(mesh->GetNode()->GetName(), std::move(vertices), std::move(skinnedVertices), std::move(indices), min, max);
+	const float meshSize = XMVectorGetX(XMVector3Length(XMLoadFloat3(&max) - XMLoadFloat3(&min)));
+	vector<vector<vector<GeoIndex>>> lodIndices(indices.size());
+	for (int i = 0; i < indices.size(); ++i)
+	{
+		const std::string subMeshName = std::string(mesh->GetNode()->GetName()) + " " + _materialsInfos[i]._name;
+		if (isSkinningMesh)
+		{
+			optimizeSubMesh(subMeshName, meshSize, skinnedVertices[i], indices[i], lodIndices[i]);
+		}
+		else
+		{
+			optimizeSubMesh(subMeshName, meshSize, vertices[i], indices[i], lodIndices[i]);
+		}
+	}
+
+	FbxMeshInfo info(mesh->GetNode()->GetName(), std::move(vertices), std::move(skinnedVertices), std::move(indices), std::move(lodIndices), min, max);
 
 	_meshInfos.emplace_back(std::move(info));
 }
 
+template<typename VertexType>
+void FbxLoader::optimizeSubMesh(const std::string& subMeshName,
+								float meshSize,
+								std::vector<VertexType>& vertices,
+								std::vector<GeoIndex>& indices,
+								std::vector<std::vector<GeoIndex>>& lodIndices)
+{
+	std::vector<DirectX::XMFLOAT3> positions(vertices.size());
+	for (int i = 0; i < vertices.size(); ++i)
+	{
+		positions[i] = vertices[i]._position;
+	}
+
+	// LOD   Ƿ   ٲٱ  .
+	generateLodIndices(positions, indices, meshSize, lodIndices);
+	std::cout << "[Lod] " << subMeshName << " triangle: " << indices.size() / 3;
+	for (const auto& lod : lodIndices)
+	{
+		std::cout << " -> " << lod.size() / 3;
+	}
+	std::cout << std::endl;
+
+	const MeshOptimizer::VertexCacheStatistics before = MeshOptimizer::analyzeVertexCache(indices, vertices.size());
+	MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+	MeshOptimizer::optimizeOverdraw(indices, positions, OVERDRAW_THRESHOLD);
+	for (auto& lod : lodIndices)
+	{
+		MeshOptimizer::optimizeVertexCache(lod, vertices.size());
+		MeshOptimizer::optimizeOverdraw(lod, positions, OVERDRAW_THRESHOLD);
+	}
+
+	//  index ó ̴   ű.
+	std::vector<GeoIndex> remap;
+	MeshOptimizer::makeVertexFetchRemap(indices, vertices.size(), remap);
+	MeshOptimizer::remapIndices(indices, remap);
+	for (auto& lod : lodIndices)
+	{
+		MeshOptimizer::remapIndices(lod, remap);
+	}
+	MeshOptimizer::remapVertices(vertices, remap);
+
+	const MeshOptimizer::VertexCacheStatistics after = MeshOptimizer::analyzeVertexCache(indices, vertices.size());
+	std::cout << "[VertexCache] " << subMeshName
+		<< " ACMR: " << before._acmr << " -> " << after._acmr
+		<< " ATVR: " << before._atvr << " -> " << after._atvr << std::endl;
+}
+
+void FbxLoader::generateLodIndices(const std::vector<DirectX::XMFLOAT3>& positions,
+									const std::vector<GeoIndex>& indices,
+									float meshSize,
+									std::vector<std::vector<GeoIndex>>& lodIndices)
+{
+	check(lodIndices.empty(), "Դϴ.");
+	if (indices.empty())
+	{
+		return;
+	}
+	//  ܰ  ̾ ̹Ƿ  ܰϼ ﰢ .
+	MeshSimplifier simplifier(positions, indices);
+	size_t prevIndexCount = indices.size();
+	for (int lod = 0; lod < LOD_COUNT; ++lod)
+	{
+		const size_t targetIndexCount = static_cast<size_t>(indices.size() * LOD_INDEX_RATIOS[lod]);
+		simplifier.simplify(targetIndexCount, meshSize * LOD_MAX_ERRORS[lod]);
+		if (simplifier.getIndexCount() == 0 || prevIndexCount * LOD_MIN_REDUCTION < simplifier.getIndexCount())
+		{
+			break;
+		}
+		prevIndexCount = simplifier.getIndexCount();
+
+		lodIndices.emplace_back();
+		simplifier.getIndices(lodIndices.back());
+	}
+}
+
 void FbxLoader::loadFbxSkin(FbxNode* node, std::vector<FbxVertexSkinningInfo>& skinningInfos)
 {
 	check(node != nullptr, "Դϴ.");
@@ -383,6 +476,7 @@ void FbxLoader::clearCachedFbxFileInfo(void) noexcept
 	_boneNames.clear();
 
 	_animations.clear();
+	_rawKeyFrames.clear();
 
 	_boneIndexMap.clear();
 	_animTimeList.clear();
@@ -406,6 +500,7 @@ void FbxLoader::loadFbxAnimations(FbxScene* fbxScene)
 	}
 	FbxAnimLayer* animLayer = animStack->GetMember<FbxAnimLayer>(0);
 	loadFbxAnimation(animLayer);
+	reportAnimationCompression();
 }
 
 void FbxLoader::writeXmlFile(const string& path, const string& fileName) const
@@ -502,9 +597,11 @@ void FbxLoader::loadFbxAnimation(FbxAnimLayer* animLayer)
 	check(!_animTimeList.empty(), "animation Time List ֽϴ.");
 
 	std::vector<std::vector<BoneAnimation>> boneAnimations(_animTimeList.size());
+	std::vector<std::vector<std::vector<KeyFrame>>> rawKeyFrames(_animTimeList.size());
 	for (int i = 0; i < _animTimeList.size(); ++i)
 	{
 		boneAnimations[i].resize(_boneIndexMap.size());
+		rawKeyFrames[i].resize(_boneIndexMap.size());
 	}
 
 	//uint32_t endFrame = 0;
@@ -527,7 +624,7 @@ void FbxLoader::loadFbxAnimation(FbxAnimLayer* animLayer)
 			for (const auto& key : clip)
 			{
 				KeyFrame keyFrame;
-				keyFrame._tick = key - (*clip.begin()); // todo frame̸    [6/4/2021 qwerw]
+				keyFrame._frame = key - (*clip.begin());
 
 				// animation ϳ϶ ư ڵ.  ִϸ̼ǿ global transform ʿϴ... [2/6/2021 qwerwy]
 				FbxTime frameTime;
@@ -547,7 +644,8 @@ void FbxLoader::loadFbxAnimation(FbxAnimLayer* animLayer)
 
 				keyFrames.emplace_back(std::move(keyFrame));
 			}
-			boneAnimations[i][bone.second] = BoneAnimation(std::move(keyFrames));
+			boneAnimations[i][bone.second] = BoneAnimation(keyFrames);
+			rawKeyFrames[i][bone.second] = std::move(keyFrames);
 		}
 	}
 
@@ -561,13 +659,104 @@ void FbxLoader::loadFbxAnimation(FbxAnimLayer* animLayer)
 		{
 			ThrowErrCode(ErrCode::KeyDuplicated, "animationName Ĩϴ. " + _animTimeList[i]._name);
 		}
+		_rawKeyFrames.emplace(_animTimeList[i]._name, std::move(rawKeyFrames[i]));
 	}	
 }
 
+void FbxLoader::reportAnimationCompression(void) const
+{
+	check(_animations.size() == _rawKeyFrames.size(), "Դϴ.");
+
+	for (const auto& anim : _animations)
+	{
+		const auto& rawKeyFrames = _rawKeyFrames.at(anim.first);
+		const std::vector<BoneAnimation>& boneAnimations = anim.second.getBoneAnimationXXX();
+		check(rawKeyFrames.size() == boneAnimations.size(), "Դϴ.");
+		check(boneAnimations.size() == _boneHierarchy.size(), "Դϴ.");
+
+		size_t rawKeyCount = 0;
+		size_t compressedKeyCount = 0;
+		for (int i = 0; i < boneAnimations.size(); ++i)
+		{
+			rawKeyCount += rawKeyFrames[i].size();
+			compressedKeyCount += boneAnimations[i].getKeyCount();
+		}
+
+		//  Ӹ  ົ bone ġ model space Ѵ.
+		float maxError = 0.f;
+		double errorSum = 0.0;
+		size_t errorCount = 0;
+		std::vector<XMMATRIX> rawToRoot(boneAnimations.size());
+		std::vector<XMMATRIX> compressedToRoot(boneAnimations.size());
+		for (uint32_t frame = 0; frame <= anim.second.getClipEndFrame(); ++frame)
+		{
+			const TickCount64 tick = frame * FRAME_TO_TICKCOUNT;
+			for (int i = 0; i < boneAnimations.size(); ++i)
+			{
+				const XMMATRIX rawToParent = sampleRawKeyFrames(rawKeyFrames[i], tick);
+				const XMMATRIX compressedToParent = boneAnimations[i].interpolate(tick);
+				if (i == 0)
+				{
+					rawToRoot[i] = rawToParent;
+					compressedToRoot[i] = compressedToParent;
+				}
+				else
+				{
+					const int parentIndex = _boneHierarchy[i];
+					check(parentIndex < i, "parent index child ۾ƾ մϴ.");
+					rawToRoot[i] = XMMatrixMultiply(rawToParent, rawToRoot[parentIndex]);
+					compressedToRoot[i] = XMMatrixMultiply(compressedToParent, compressedToRoot[parentIndex]);
+				}
+
+				const float error = XMVectorGetX(XMVector3Length(XMVectorSubtract(rawToRoot[i].r[3], compressedToRoot[i].r[3])));
+				maxError = std::max(maxError, error);
+				errorSum += error;
+				++errorCount;
+			}
+		}
+
+		const size_t rawMemorySize = rawKeyCount * sizeof(KeyFrame);
+		const size_t compressedMemorySize = anim.second.getMemorySize();
+		std::cout << "[Animation] " << anim.first
+			<< " key: " << rawKeyCount << " -> " << compressedKeyCount
+			<< " byte: " << rawMemorySize << " -> " << compressedMemorySize
+			<< " maxError: " << maxError
+			<< " avgError: " << (errorCount == 0 ? 0.0 : errorSum / errorCount) << std::endl;
+	}
+}
+
+DirectX::XMMATRIX FbxLoader::sampleRawKeyFrames(const std::vector<KeyFrame>& keyFrames, const TickCount64& tick) noexcept
+{
+	check(!keyFrames.empty(), "Դϴ.");
+	const XMVECTOR zero = XMVectorSet(0.f, 0.f, 0.f, 1.f);
+
+	size_t index1 = 0;
+	while (index1 < keyFrames.size() && keyFrames[index1]._frame * FRAME_TO_TICKCOUNT <= tick)
+	{
+		++index1;
+	}
+	if (index1 == 0 || index1 == keyFrames.size())
+	{
+		const KeyFrame& keyFrame = (index1 == 0) ? keyFrames.front() : keyFrames.back();
+		return XMMatrixAffineTransformation(XMLoadFloat3(&keyFrame._scaling), zero, XMLoadFloat4(&keyFrame._rotationQuat), XMLoadFloat3(&keyFrame._translation));
+	}
+
+	const KeyFrame& keyFrame0 = keyFrames[index1 - 1];
+	const KeyFrame& keyFrame1 = keyFrames[index1];
+	const float lerpPercent = (tick - keyFrame0._frame * FRAME_TO_TICKCOUNT) /
+		static_cast<float>((keyFrame1._frame - keyFrame0._frame) * FRAME_TO_TICKCOUNT);
+
+	const XMVECTOR S = XMVectorLerp(XMLoadFloat3(&keyFrame0._scaling), XMLoadFloat3(&keyFrame1._scaling), lerpPercent);
+	const XMVECTOR P = XMVectorLerp(XMLoadFloat3(&keyFrame0._translation), XMLoadFloat3(&keyFrame1._translation), lerpPercent);
+	const XMVECTOR Q = XMQuaternionSlerp(XMLoadFloat4(&keyFrame0._rotationQuat), XMLoadFloat4(&keyFrame1._rotationQuat), lerpPercent);
+	return XMMatrixAffineTransformation(S, zero, Q, P);
+}
+
 void FbxLoader::writeXmlMesh(XMLWriter& xmlMeshGeometry, const FbxMeshInfo& meshInfo, const string& fileName) const
 {
 	check(!fileName.empty(), "fileName ϴ.");
 	check(!meshInfo._indices.empty(), "mesh vertex index ϴ.");
+	check(meshInfo._lodIndices.size() == meshInfo._indices.size(), "Դϴ.");
 	check(!meshInfo._skinnedVertices.empty() || !meshInfo._vertices.empty(), "vertex   ϴ.");
 
 	xmlMeshGeometry.addAttribute("Name", meshInfo._name.c_str());
@@ -645,6 +834,26 @@ void FbxLoader::writeXmlMesh(XMLWriter& xmlMeshGeometry, const FbxMeshInfo& mesh
 				}
 			}
 			xmlMeshGeometry.closeChildNode();
+
+			//   Vertices  .
+			for (int lod = 0; lod < meshInfo._lodIndices[i].size(); ++lod)
+			{
+				const auto& lodIndices = meshInfo._lodIndices[i][lod];
+				xmlMeshGeometry.addNode("LodIndices");
+				xmlMeshGeometry.addAttribute("Level", lod + 1);
+				xmlMeshGeometry.addAttribute("IndexCount", lodIndices.size());
+				xmlMeshGeometry.openChildNode();
+				{
+					for (int j = 0; j < lodIndices.size(); j += 3)
+					{
+						xmlMeshGeometry.addNode("Index");
+						xmlMeshGeometry.addAttribute("_0", lodIndices[j]);
+						xmlMeshGeometry.addAttribute("_1", lodIndices[j + 1]);
+						xmlMeshGeometry.addAttribute("_2", lodIndices[j + 2]);
+					}
+				}
+				xmlMeshGeometry.closeChildNode();
+			}
 		}
 		xmlMeshGeometry.closeChildNode();
 	}
@@ -715,16 +924,19 @@ void FbxLoader::writeXmlAnimation(XMLWriter& xmlAnimation) const
 
 				xmlAnimation.openChildNode();
 				{
-					const std::vector<KeyFrame>& keyFrames = boneAnimations[i].getKeyFrameReferenceXXX();
-
-					for (int j = 0; j < keyFrames.size(); ++j)
+					for (int j = 0; j < static_cast<int>(AnimationTrackType::Count); ++j)
 					{
-						xmlAnimation.addNode("KeyFrame");
-						xmlAnimation.addAttribute("Frame", keyFrames[j]._tick); // todo [6/4/2021 qwerw]
-
-						xmlAnimation.addAttribute("Translation", keyFrames[j]._translation);
-						xmlAnimation.addAttribute("Scaling", keyFrames[j]._scaling);
-						xmlAnimation.addAttribute("RotationQuat", keyFrames[j]._rotationQuat);
+						const AnimationTrackType trackType = static_cast<AnimationTrackType>(j);
+						const AnimationTrack& track = boneAnimations[i].getTrack(trackType);
+
+						xmlAnimation.addNode(AnimationTrack::getTrackName(trackType));
+						xmlAnimation.addAttribute("Frames", D3DUtil::toHexString(track.getFramesXXX()).c_str());
+						xmlAnimation.addAttribute("Values", D3DUtil::toHexString(track.getValuesXXX()).c_str());
+						if (trackType != AnimationTrackType::Rotation)
+						{
+							xmlAnimation.addAttribute("RangeMin", track.getRangeMinXXX());
+							xmlAnimation.addAttribute("RangeExtent", track.getRangeExtentXXX());
+						}
 					}
 				}
 				xmlAnimation.closeChildNode();
@@ -1221,12 +1433,14 @@ FbxLoader::FbxMeshInfo::FbxMeshInfo(string&& name,
 	vector<vector<Vertex>>&& vertices,
 	vector<vector<SkinnedVertex>>&& skinnedVertices,
 	vector<vector<GeoIndex>>&& indices,
+	vector<vector<vector<GeoIndex>>>&& lodIndices,
 	const DirectX::XMFLOAT3& min,
 	const DirectX::XMFLOAT3& max)
 	: _name(name)
 	, _vertices(vertices)
 	, _skinnedVertices(skinnedVertices)
 	, _indices(indices)
+	, _lodIndices(lodIndices)
 	, _min(min)
 	, _max(max)
 {
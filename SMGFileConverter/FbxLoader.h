@@ -7,6 +7,7 @@
 #include "SMGEngine/TypeD3d.h"
 #include <set>
 #include "SMGEngine/PreDefines.h"
+#include "SMGEngine/TypeCommon.h"
 
 using namespace std;
 using namespace DirectX;
@@ -20,6 +21,14 @@ class FbxLoader
 {
 private:
 	static constexpr int VERTEX_PER_POLYGON = 3;
+	//   LOD ܰ躰 ǥ index   .  mesh bounding box 밢 ̿  ̴.
+	static constexpr int LOD_COUNT = MESH_LOD_COUNT_MAX - 1;
+	static constexpr std::array<float, LOD_COUNT> LOD_INDEX_RATIOS = { 0.5f, 0.25f, 0.125f };
+	static constexpr std::array<float, LOD_COUNT> LOD_MAX_ERRORS = { 0.005f, 0.015f, 0.04f };
+	//  ܰ index       ʴ´.
+	static constexpr float LOD_MIN_REDUCTION = 0.8f;
+	// overdraw ̷ index  ٲܶ ϴ ACMR  
+	static constexpr float OVERDRAW_THRESHOLD = 1.05f;
 
 	// normalIndex ÷οǴ  ־µ ð ٸ 鵵  Ͼ ʰ ĥ [6/13/2021 qwerw]
 	struct FbxPolygonVertexInfo
@@ -60,6 +69,7 @@ private:
 			vector<vector<Vertex>>&& vertices,
 			vector<vector<SkinnedVertex>>&& skinnedVertices,
 			vector<vector<GeoIndex>>&& indices,
+			vector<vector<vector<GeoIndex>>>&& lodIndices,
 			const DirectX::XMFLOAT3& min,
 			const DirectX::XMFLOAT3& max);
 
@@ -67,6 +77,8 @@ private:
 		vector<vector<Vertex>> _vertices;
 		vector<vector<SkinnedVertex>> _skinnedVertices;
 		vector<vector<GeoIndex>> _indices;
+		// ȭ LOD index. [subMesh][lod - 1], submesh ܰ  ٸ  ִ.
+		vector<vector<vector<GeoIndex>>> _lodIndices;
 		XMFLOAT3 _min;
 		XMFLOAT3 _max;
 	};
@@ -101,6 +113,9 @@ private:
 	void writeXmlMaterial(XMLWriter& xmlMaterial) const;
 	void writeXmlSkeleton(XMLWriter& xmlSkeleton) const;
 	void writeXmlAnimation(XMLWriter& xmlAnimation) const;
+	//   Ű , ޸, bone ġ  Ѵ.
+	void reportAnimationCompression(void) const;
+	static DirectX::XMMATRIX sampleRawKeyFrames(const std::vector<KeyFrame>& keyFrames, const TickCount64& tick) noexcept;
 
 	void loadFbxParseInfo(const std::string& fbxFilePath);
 public:
@@ -118,6 +133,8 @@ private:
 	std::vector<DirectX::XMFLOAT4X4> _boneOffsets;
 	std::vector<std::string> _boneNames;
 	std::unordered_map<std::string, AnimationClip> _animations;
+	//   Ȯο  Ű. [clip][bone]
+	std::unordered_map<std::string, std::vector<std::vector<KeyFrame>>> _rawKeyFrames;
 
 	std::unordered_map<FbxNode*, BoneIndex> _boneIndexMap;
 	std::vector<AnimClipTimeInfo> _animTimeList;
@@ -138,6 +155,20 @@ private:
 								const std::vector<FbxPolygonVertexInfo>& polygonVertices,
 								const std::vector<FbxVertexSkinningInfo>& skinningInfos);
 
+	// LOD   LOD index vertex cache, overdraw     ó ̴  ű.
+	//   ACMR, ATVR Ѵ.
+	template<typename VertexType>
+	static void optimizeSubMesh(const std::string& subMeshName,
+								float meshSize,
+								std::vector<VertexType>& vertices,
+								std::vector<GeoIndex>& indices,
+								std::vector<std::vector<GeoIndex>>& lodIndices);
+	// submesh  index ٿ LOD index .  ܰ躸    ű⼭ .
+	static void generateLodIndices(const std::vector<DirectX::XMFLOAT3>& positions,
+									const std::vector<GeoIndex>& indices,
+									float meshSize,
+									std::vector<std::vector<GeoIndex>>& lodIndices);
+
 	void loadFbxSkin(FbxNode* node, std::vector<FbxVertexSkinningInfo>& skinningInfos);
 
 	void loadFbxAnimations(FbxScene* fbxScene);
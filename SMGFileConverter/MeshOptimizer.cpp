@@ -0,0 +1,334 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "SMGEngine/Exception.h"
+
+using namespace DirectX;
+
+void MeshOptimizer::optimizeVertexCache(std::vector<GeoIndex>& indices, size_t vertexCount)
+{
+	check(indices.size() % 3 == 0, "ﰢ index ƴմϴ.");
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	//   ׸  ﰢ . ׸ ﰢ  ڷ    δ.
+	std::vector<uint32_t> remainingValences(vertexCount, 0);
+	for (const auto index : indices)
+	{
+		check(index < vertexCount, "index   ϴ.");
+		++remainingValences[index];
+	}
+	std::vector<uint32_t> triangleOffsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		triangleOffsets[v + 1] = triangleOffsets[v] + remainingValences[v];
+	}
+	std::vector<uint32_t> vertexTriangles(indices.size());
+	{
+		std::vector<uint32_t> fillCounts(vertexCount, 0);
+		for (uint32_t t = 0; t < triangleCount; ++t)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const GeoIndex v = indices[t * 3 + k];
+				vertexTriangles[triangleOffsets[v] + fillCounts[v]++] = t;
+			}
+		}
+	}
+
+	std::vector<int> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		vertexScores[v] = getForsythVertexScore(-1, remainingValences[v]);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+	}
+	std::vector<bool> isEmitted(triangleCount, false);
+
+	std::vector<GeoIndex> result;
+	result.reserve(indices.size());
+	std::vector<GeoIndex> cache;
+	std::vector<GeoIndex> nextCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	uint32_t bestTriangle = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	// cache ִ  ̾ ﰢ   ﰢ ã  ġ
+	uint32_t searchCursor = 0;
+	while (result.size() < indices.size())
+	{
+		if (bestTriangle == triangleCount)
+		{
+			while (isEmitted[searchCursor])
+			{
+				++searchCursor;
+			}
+			bestTriangle = searchCursor;
+		}
+		check(!isEmitted[bestTriangle], "Դϴ.");
+		isEmitted[bestTriangle] = true;
+		const GeoIndex* triangle = &indices[bestTriangle * 3];
+		result.insert(result.end(), triangle, triangle + 3);
+
+		nextCache.clear();
+		for (int k = 0; k < 3; ++k)
+		{
+			const GeoIndex v = triangle[k];
+			nextCache.push_back(v);
+			// ׸ ﰢ  Ͽ .
+			uint32_t* begin = &vertexTriangles[triangleOffsets[v]];
+			uint32_t* end = begin + remainingValences[v];
+			uint32_t* found = std::find(begin, end, bestTriangle);
+			check(found != end, "Դϴ.");
+			std::swap(*found, *(end - 1));
+			--remainingValences[v];
+		}
+		for (const auto v : cache)
+		{
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+			{
+				nextCache.push_back(v);
+			}
+		}
+
+		// cache    ٲǷ    ﰢ      ׸.
+		bestTriangle = triangleCount;
+		float bestScore = -1.f;
+		for (size_t i = 0; i < nextCache.size(); ++i)
+		{
+			const GeoIndex v = nextCache[i];
+			const int cachePosition = (i < static_cast<size_t>(FORSYTH_CACHE_SIZE)) ? static_cast<int>(i) : -1;
+			cachePositions[v] = cachePosition;
+			const float scoreDelta = getForsythVertexScore(cachePosition, remainingValences[v]) - vertexScores[v];
+			vertexScores[v] += scoreDelta;
+			for (uint32_t j = 0; j < remainingValences[v]; ++j)
+			{
+				const uint32_t t = vertexTriangles[triangleOffsets[v] + j];
+				triangleScores[t] += scoreDelta;
+				if (cachePosition != -1 && bestScore < triangleScores[t])
+				{
+					bestScore = triangleScores[t];
+					bestTriangle = t;
+				}
+			}
+		}
+		nextCache.resize(std::min(nextCache.size(), static_cast<size_t>(FORSYTH_CACHE_SIZE)));
+		cache.swap(nextCache);
+	}
+	indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<GeoIndex>& indices, const std::vector<XMFLOAT3>& positions, float threshold)
+{
+	check(indices.size() % 3 == 0, "ﰢ index ƴմϴ.");
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	//    cache  ﰢ  cache ȿ  ٲ ʴ´.
+	std::vector<uint32_t> hardBoundaries;
+	std::vector<uint32_t> cacheTimes(positions.size(), 0);
+	uint32_t time = VERTEX_CACHE_SIZE + 1;
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		if (simulateTriangleXXX(&indices[t * 3], cacheTimes, time) == 3)
+		{
+			hardBoundaries.push_back(t);
+		}
+	}
+	hardBoundaries.push_back(triangleCount);
+
+	//  ȿ   cache  ACMR  ü threshold    .
+	std::vector<uint32_t> clusterBegins;
+	for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+	{
+		const uint32_t begin = hardBoundaries[i];
+		const uint32_t end = hardBoundaries[i + 1];
+
+		time += VERTEX_CACHE_SIZE + 1;
+		uint32_t hardClusterMisses = 0;
+		for (uint32_t t = begin; t < end; ++t)
+		{
+			hardClusterMisses += simulateTriangleXXX(&indices[t * 3], cacheTimes, time);
+		}
+		const float hardClusterAcmr = static_cast<float>(hardClusterMisses) / (end - begin);
+
+		clusterBegins.push_back(begin);
+		time += VERTEX_CACHE_SIZE + 1;
+		uint32_t clusterMisses = 0;
+		uint32_t clusterBegin = begin;
+		for (uint32_t t = begin; t < end; ++t)
+		{
+			clusterMisses += simulateTriangleXXX(&indices[t * 3], cacheTimes, time);
+			if (t + 1 < end && clusterMisses <= hardClusterAcmr * threshold * (t + 1 - clusterBegin))
+			{
+				clusterBegins.push_back(t + 1);
+				clusterBegin = t + 1;
+				clusterMisses = 0;
+				time += VERTEX_CACHE_SIZE + 1;
+			}
+		}
+	}
+	clusterBegins.push_back(triangleCount);
+
+	//  ߽ mesh ߽ɿ    ּ ٱ̹Ƿ  ׸.
+	XMVECTOR meshCenter = XMVectorZero();
+	for (const auto& position : positions)
+	{
+		meshCenter += XMLoadFloat3(&position);
+	}
+	meshCenter /= static_cast<float>(std::max(positions.size(), static_cast<size_t>(1)));
+
+	const size_t clusterCount = clusterBegins.size() - 1;
+	std::vector<float> clusterSortKeys(clusterCount);
+	for (size_t c = 0; c < clusterCount; ++c)
+	{
+		XMVECTOR centerSum = XMVectorZero();
+		XMVECTOR normalSum = XMVectorZero();
+		float areaSum = 0.f;
+		for (uint32_t t = clusterBegins[c]; t < clusterBegins[c + 1]; ++t)
+		{
+			const XMVECTOR p0 = XMLoadFloat3(&positions[indices[t * 3]]);
+			const XMVECTOR p1 = XMLoadFloat3(&positions[indices[t * 3 + 1]]);
+			const XMVECTOR p2 = XMLoadFloat3(&positions[indices[t * 3 + 2]]);
+			//  ̴  ι    ȴ.
+			const XMVECTOR normal = XMVector3Cross(p1 - p0, p2 - p0);
+			const float area = XMVectorGetX(XMVector3Length(normal));
+			centerSum += (p0 + p1 + p2) * (area / 3.f);
+			normalSum += normal;
+			areaSum += area;
+		}
+		if (areaSum <= 0.f)
+		{
+			clusterSortKeys[c] = 0.f;
+			continue;
+		}
+		const XMVECTOR clusterCenter = centerSum / areaSum;
+		clusterSortKeys[c] = XMVectorGetX(XMVector3Dot(clusterCenter - meshCenter, XMVector3Normalize(normalSum)));
+	}
+
+	std::vector<uint32_t> clusterOrder(clusterCount);
+	std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](uint32_t lhs, uint32_t rhs)
+		{
+			return clusterSortKeys[lhs] > clusterSortKeys[rhs];
+		});
+
+	std::vector<GeoIndex> result;
+	result.reserve(indices.size());
+	for (const auto c : clusterOrder)
+	{
+		result.insert(result.end(), indices.begin() + clusterBegins[c] * 3, indices.begin() + clusterBegins[c + 1] * 3);
+	}
+	indices.swap(result);
+}
+
+void MeshOptimizer::makeVertexFetchRemap(const std::vector<GeoIndex>& indices, size_t vertexCount, std::vector<GeoIndex>& remap)
+{
+	check(vertexCount <= std::numeric_limits<GeoIndex>::max() + static_cast<size_t>(1), " ʹ ϴ.");
+	constexpr GeoIndex UNUSED = std::numeric_limits<GeoIndex>::max();
+	remap.assign(vertexCount, UNUSED);
+	std::vector<bool> isUsed(vertexCount, false);
+	GeoIndex nextIndex = 0;
+	for (const auto index : indices)
+	{
+		check(index < vertexCount, "index   ϴ.");
+		if (!isUsed[index])
+		{
+			isUsed[index] = true;
+			remap[index] = nextIndex++;
+		}
+	}
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		if (!isUsed[v])
+		{
+			remap[v] = nextIndex++;
+		}
+	}
+}
+
+void MeshOptimizer::remapIndices(std::vector<GeoIndex>& indices, const std::vector<GeoIndex>& remap) noexcept
+{
+	for (auto& index : indices)
+	{
+		check(index < remap.size());
+		index = remap[index];
+	}
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::analyzeVertexCache(const std::vector<GeoIndex>& indices, size_t vertexCount)
+{
+	check(indices.size() % 3 == 0, "ﰢ index ƴմϴ.");
+	VertexCacheStatistics statistics;
+	if (indices.empty())
+	{
+		return statistics;
+	}
+
+	std::vector<uint32_t> cacheTimes(vertexCount, 0);
+	std::vector<bool> isUsed(vertexCount, false);
+	uint32_t time = VERTEX_CACHE_SIZE + 1;
+	uint32_t misses = 0;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		misses += simulateTriangleXXX(&indices[i], cacheTimes, time);
+		isUsed[indices[i]] = true;
+		isUsed[indices[i + 1]] = true;
+		isUsed[indices[i + 2]] = true;
+	}
+	const size_t usedVertexCount = std::count(isUsed.begin(), isUsed.end(), true);
+	statistics._acmr = static_cast<float>(misses) / (indices.size() / 3);
+	statistics._atvr = static_cast<float>(misses) / usedVertexCount;
+	return statistics;
+}
+
+float MeshOptimizer::getForsythVertexScore(int cachePosition, uint32_t remainingValence) noexcept
+{
+	if (remainingValence == 0)
+	{
+		return -1.f;
+	}
+	float score = 0.f;
+	if (cachePosition != -1)
+	{
+		//  ﰢ   ٲ ʵ   ش.
+		if (cachePosition < 3)
+		{
+			score = FORSYTH_LAST_TRIANGLE_SCORE;
+		}
+		else
+		{
+			const float scaler = 1.f / (FORSYTH_CACHE_SIZE - 3);
+			score = std::pow(1.f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+	//  ﰢ     ߿ ȥ  ﰢ پ.
+	score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingValence), -FORSYTH_VALENCE_BOOST_POWER);
+	return score;
+}
+
+uint32_t MeshOptimizer::simulateTriangleXXX(const GeoIndex* triangle, std::vector<uint32_t>& cacheTimes, uint32_t& time) noexcept
+{
+	uint32_t misses = 0;
+	for (int k = 0; k < 3; ++k)
+	{
+		const GeoIndex v = triangle[k];
+		if (VERTEX_CACHE_SIZE <= time - cacheTimes[v])
+		{
+			cacheTimes[v] = time++;
+			++misses;
+		}
+	}
+	return misses;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "SMGEngine/TypeCommon.h"
+
+// index, vertex  GPU б  ٲ۴. submesh ϳ ﰢ Ͽ Ѵ.
+//  ﰢ  ٲ ʰ  ٲ۴.
+class MeshOptimizer
+{
+public:
+	// post transform cache ùķ̼ 
+	struct VertexCacheStatistics
+	{
+		// ﰢ ,     ̴  
+		float _acmr = 0.f;
+		float _atvr = 0.f;
+	};
+
+	// Forsyth . LRU cache ִ   ﰢ    ﰢ  ׸.
+	static void optimizeVertexCache(std::vector<GeoIndex>& indices, size_t vertexCount);
+	// cache  ĵ indices cache ȿ threshold ̻  ʴ   
+	// ٱ ϴ  ׸   ٲ㼭 overdraw δ.
+	static void optimizeOverdraw(std::vector<GeoIndex>& indices, const std::vector<DirectX::XMFLOAT3>& positions, float threshold);
+	//  indices ó ̴  ű ȣ . remap[ ȣ] =  ȣ
+	//  ʴ  ڷ .
+	static void makeVertexFetchRemap(const std::vector<GeoIndex>& indices, size_t vertexCount, std::vector<GeoIndex>& remap);
+	static void remapIndices(std::vector<GeoIndex>& indices, const std::vector<GeoIndex>& remap) noexcept;
+	template<typename T>
+	static void remapVertices(std::vector<T>& vertices, const std::vector<GeoIndex>& remap)
+	{
+		std::vector<T> remapped(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			remapped[remap[i]] = vertices[i];
+		}
+		vertices.swap(remapped);
+	}
+
+	//  VERTEX_CACHE_SIZE FIFO cache ùķ̼Ѵ. GPU   Ȯϱ  .
+	static VertexCacheStatistics analyzeVertexCache(const std::vector<GeoIndex>& indices, size_t vertexCount);
+private:
+	static constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+	// Forsyth  꿡  LRU cache ũ ġ
+	static constexpr int FORSYTH_CACHE_SIZE = 32;
+	static constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+	static constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+	static constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.f;
+	static constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+	static float getForsythVertexScore(int cachePosition, uint32_t remainingValence) noexcept;
+	// FIFO cache   ȯؾ ϴ  . cacheTimes  cache  ð
+	static uint32_t simulateTriangleXXX(const GeoIndex* triangle, std::vector<uint32_t>& cacheTimes, uint32_t& time) noexcept;
+};
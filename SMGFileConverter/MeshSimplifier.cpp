@@ -0,0 +1,272 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <map>
+#include <cstring>
+#include "SMGEngine/Exception.h"
+
+using namespace DirectX;
+
+MeshSimplifier::MeshSimplifier(const std::vector<XMFLOAT3>& positions, const std::vector<GeoIndex>& indices)
+	: _positions(positions)
+	, _indices(indices)
+	, _isTriangleRemoved(indices.size() / 3, false)
+	, _vertexTriangles(positions.size())
+	, _quadrics(positions.size())
+	, _isLocked(positions.size(), false)
+	, _versions(positions.size(), 0)
+	, _triangleCount(0)
+{
+	check(indices.size() % 3 == 0, "ﰢ index ƴմϴ.");
+	for (auto& quadric : _quadrics)
+	{
+		quadric.fill(0.0);
+	}
+
+	for (uint32_t t = 0; t < _isTriangleRemoved.size(); ++t)
+	{
+		const GeoIndex i0 = _indices[t * 3];
+		const GeoIndex i1 = _indices[t * 3 + 1];
+		const GeoIndex i2 = _indices[t * 3 + 2];
+		check(i0 < _positions.size() && i1 < _positions.size() && i2 < _positions.size(), "index   ϴ.");
+		if (i0 == i1 || i1 == i2 || i2 == i0)
+		{
+			_isTriangleRemoved[t] = true;
+			continue;
+		}
+		++_triangleCount;
+		_vertexTriangles[i0].push_back(t);
+		_vertexTriangles[i1].push_back(t);
+		_vertexTriangles[i2].push_back(t);
+
+		//  ġ  ʾƼ  ֺ  Ÿ   ȴ.
+		const XMVECTOR p0 = XMLoadFloat3(&_positions[i0]);
+		const XMVECTOR normal = XMVector3Cross(XMLoadFloat3(&_positions[i1]) - p0, XMLoadFloat3(&_positions[i2]) - p0);
+		if (XMVectorGetX(XMVector3LengthSq(normal)) <= 0.f)
+		{
+			continue;
+		}
+		XMFLOAT3 n;
+		XMStoreFloat3(&n, XMVector3Normalize(normal));
+		const double a = n.x;
+		const double b = n.y;
+		const double c = n.z;
+		const double d = -(a * _positions[i0].x + b * _positions[i0].y + c * _positions[i0].z);
+		const Quadric planeQuadric = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+		addQuadric(_quadrics[i0], planeQuadric);
+		addQuadric(_quadrics[i1], planeQuadric);
+		addQuadric(_quadrics[i2], planeQuadric);
+	}
+
+	// ġ   ´.   ̸ uv normal  seam̴.
+	std::map<std::array<uint32_t, 3>, uint32_t> positionGroupMap;
+	std::vector<uint32_t> positionGroups(_positions.size());
+	std::vector<uint32_t> groupVertexCounts;
+	for (uint32_t v = 0; v < _positions.size(); ++v)
+	{
+		std::array<uint32_t, 3> key;
+		std::memcpy(key.data(), &_positions[v], sizeof(key));
+		auto it = positionGroupMap.emplace(key, static_cast<uint32_t>(groupVertexCounts.size())).first;
+		if (it->second == groupVertexCounts.size())
+		{
+			groupVertexCounts.push_back(0);
+		}
+		positionGroups[v] = it->second;
+		++groupVertexCounts[it->second];
+	}
+
+	// ġ  ﰢ ϳ  edge  . submesh  ̹Ƿ ٸ submesh ´  ⿡ Եȴ.
+	std::map<uint64_t, uint32_t> edgeTriangleCounts;
+	for (uint32_t t = 0; t < _isTriangleRemoved.size(); ++t)
+	{
+		if (_isTriangleRemoved[t])
+		{
+			continue;
+		}
+		for (int k = 0; k < 3; ++k)
+		{
+			const uint32_t g0 = positionGroups[_indices[t * 3 + k]];
+			const uint32_t g1 = positionGroups[_indices[t * 3 + (k + 1) % 3]];
+			const uint64_t edgeKey = (static_cast<uint64_t>(std::min(g0, g1)) << 32) | std::max(g0, g1);
+			++edgeTriangleCounts[edgeKey];
+		}
+	}
+	std::vector<bool> isBorderGroup(groupVertexCounts.size(), false);
+	for (const auto& edge : edgeTriangleCounts)
+	{
+		if (edge.second == 1)
+		{
+			isBorderGroup[edge.first >> 32] = true;
+			isBorderGroup[edge.first & 0xFFFFFFFF] = true;
+		}
+	}
+	for (uint32_t v = 0; v < _positions.size(); ++v)
+	{
+		const uint32_t group = positionGroups[v];
+		_isLocked[v] = (1 < groupVertexCounts[group]) || isBorderGroup[group];
+	}
+
+	for (uint32_t v = 0; v < _positions.size(); ++v)
+	{
+		pushCollapses(v);
+	}
+}
+
+void MeshSimplifier::simplify(size_t targetIndexCount, float maxError)
+{
+	const double maxErrorSq = static_cast<double>(maxError) * maxError;
+	while (targetIndexCount < getIndexCount() && !_heap.empty())
+	{
+		std::pop_heap(_heap.begin(), _heap.end());
+		const Collapse candidate = _heap.back();
+		_heap.pop_back();
+
+		if (_versions[candidate._from] != candidate._fromVersion || _versions[candidate._to] != candidate._toVersion)
+		{
+			continue;
+		}
+		if (maxErrorSq < candidate._error)
+		{
+			//  ȣ⿡   Ŀ ̾ Ѵ.
+			_heap.push_back(candidate);
+			std::push_heap(_heap.begin(), _heap.end());
+			break;
+		}
+		const bool isAdjacent = std::any_of(_vertexTriangles[candidate._from].begin(), _vertexTriangles[candidate._from].end(),
+			[this, &candidate](uint32_t t)
+			{
+				return !_isTriangleRemoved[t] &&
+					(_indices[t * 3] == candidate._to || _indices[t * 3 + 1] == candidate._to || _indices[t * 3 + 2] == candidate._to);
+			});
+		if (!isAdjacent || !isCollapseValid(candidate._from, candidate._to))
+		{
+			continue;
+		}
+		collapse(candidate._from, candidate._to);
+	}
+}
+
+void MeshSimplifier::getIndices(std::vector<GeoIndex>& indices) const
+{
+	indices.clear();
+	indices.reserve(getIndexCount());
+	for (uint32_t t = 0; t < _isTriangleRemoved.size(); ++t)
+	{
+		if (!_isTriangleRemoved[t])
+		{
+			indices.insert(indices.end(), _indices.begin() + t * 3, _indices.begin() + t * 3 + 3);
+		}
+	}
+}
+
+void MeshSimplifier::addQuadric(Quadric& lhs, const Quadric& rhs) noexcept
+{
+	for (size_t i = 0; i < lhs.size(); ++i)
+	{
+		lhs[i] += rhs[i];
+	}
+}
+
+double MeshSimplifier::evaluateQuadric(const Quadric& q, const XMFLOAT3& position) noexcept
+{
+	const double x = position.x;
+	const double y = position.y;
+	const double z = position.z;
+	const double error = q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+		q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+		q[7] * z * z + 2 * q[8] * z +
+		q[9];
+	//      ִ.
+	return std::max(error, 0.0);
+}
+
+double MeshSimplifier::getCollapseError(uint32_t from, uint32_t to) const noexcept
+{
+	Quadric quadric = _quadrics[from];
+	addQuadric(quadric, _quadrics[to]);
+	return evaluateQuadric(quadric, _positions[to]);
+}
+
+bool MeshSimplifier::isCollapseValid(uint32_t from, uint32_t to) const noexcept
+{
+	for (const uint32_t t : _vertexTriangles[from])
+	{
+		if (_isTriangleRemoved[t])
+		{
+			continue;
+		}
+		std::array<uint32_t, 3> triangle = { _indices[t * 3], _indices[t * 3 + 1], _indices[t * 3 + 2] };
+		if (std::find(triangle.begin(), triangle.end(), to) != triangle.end())
+		{
+			// collapseϸ  ﰢ
+			continue;
+		}
+		const XMVECTOR normalBefore = XMVector3Cross(
+			XMLoadFloat3(&_positions[triangle[1]]) - XMLoadFloat3(&_positions[triangle[0]]),
+			XMLoadFloat3(&_positions[triangle[2]]) - XMLoadFloat3(&_positions[triangle[0]]));
+		std::replace(triangle.begin(), triangle.end(), from, to);
+		const XMVECTOR normalAfter = XMVector3Cross(
+			XMLoadFloat3(&_positions[triangle[1]]) - XMLoadFloat3(&_positions[triangle[0]]),
+			XMLoadFloat3(&_positions[triangle[2]]) - XMLoadFloat3(&_positions[triangle[0]]));
+		if (XMVectorGetX(XMVector3Dot(normalBefore, normalAfter)) <= 0.f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void MeshSimplifier::collapse(uint32_t from, uint32_t to)
+{
+	check(!_isLocked[from], "  ű  ϴ.");
+	for (const uint32_t t : _vertexTriangles[from])
+	{
+		if (_isTriangleRemoved[t])
+		{
+			continue;
+		}
+		GeoIndex* triangle = &_indices[t * 3];
+		if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+		{
+			_isTriangleRemoved[t] = true;
+			--_triangleCount;
+			continue;
+		}
+		std::replace(triangle, triangle + 3, static_cast<GeoIndex>(from), static_cast<GeoIndex>(to));
+		_vertexTriangles[to].push_back(t);
+	}
+	_vertexTriangles[from].clear();
+	addQuadric(_quadrics[to], _quadrics[from]);
+
+	++_versions[from];
+	++_versions[to];
+	pushCollapses(to);
+}
+
+void MeshSimplifier::pushCollapses(uint32_t vertex)
+{
+	for (const uint32_t t : _vertexTriangles[vertex])
+	{
+		if (_isTriangleRemoved[t])
+		{
+			continue;
+		}
+		for (int k = 0; k < 3; ++k)
+		{
+			const uint32_t other = _indices[t * 3 + k];
+			if (other == vertex)
+			{
+				continue;
+			}
+			if (!_isLocked[vertex])
+			{
+				_heap.push_back({ getCollapseError(vertex, other), vertex, other, _versions[vertex], _versions[other] });
+				std::push_heap(_heap.begin(), _heap.end());
+			}
+			if (!_isLocked[other])
+			{
+				_heap.push_back({ getCollapseError(other, vertex), other, vertex, _versions[other], _versions[vertex] });
+				std::push_heap(_heap.begin(), _heap.end());
+			}
+		}
+	}
+}
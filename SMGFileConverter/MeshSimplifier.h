@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include "SMGEngine/TypeCommon.h"
+
+// quadric error metric edge ϳ ּ submesh ϳ ﰢ  δ.
+//  ϳ ̿  ġ (half edge collapse)̶    Ƿ LOD vertex buffer    ִ.
+// uv, normal  seam   (ٸ submesh ´  )  ű ʾƼ ƴ  ʴ´.
+class MeshSimplifier
+{
+public:
+	MeshSimplifier(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<GeoIndex>& indices);
+	// index  targetIndexCount ϰ ǰų  collapse  maxError  δ.
+	// maxError   Ÿ̴.  ȣϸ   ̾ δ.
+	void simplify(size_t targetIndexCount, float maxError);
+	void getIndices(std::vector<GeoIndex>& indices) const;
+	size_t getIndexCount(void) const noexcept { return _triangleCount * 3; }
+private:
+	// Ī 4x4   ﰢ.  (a, b, c, d)  [a2, ab, ac, ad, b2, bc, bd, c2, cd, d2]
+	using Quadric = std::array<double, 10>;
+
+	struct Collapse
+	{
+		double _error;
+		uint32_t _from;
+		uint32_t _to;
+		//   . ٸ   ֺ ٲ ̹Ƿ ٽ Ѵ.
+		uint32_t _fromVersion;
+		uint32_t _toVersion;
+		bool operator<(const Collapse& rhs) const noexcept { return _error > rhs._error; }
+	};
+
+	static void addQuadric(Quadric& lhs, const Quadric& rhs) noexcept;
+	static double evaluateQuadric(const Quadric& quadric, const DirectX::XMFLOAT3& position) noexcept;
+	double getCollapseError(uint32_t from, uint32_t to) const noexcept;
+	// from to Ű  ﰢ  false
+	bool isCollapseValid(uint32_t from, uint32_t to) const noexcept;
+	void collapse(uint32_t from, uint32_t to);
+	// vertex  edge collapse    ִ´.
+	void pushCollapses(uint32_t vertex);
+
+	std::vector<DirectX::XMFLOAT3> _positions;
+	std::vector<GeoIndex> _indices;
+	std::vector<bool> _isTriangleRemoved;
+	//   ﰢ ȣ.  ﰢ   ִ.
+	std::vector<std::vector<uint32_t>> _vertexTriangles;
+	std::vector<Quadric> _quadrics;
+	std::vector<bool> _isLocked;
+	std::vector<uint32_t> _versions;
+	//    տ  heap
+	std::vector<Collapse> _heap;
+	size_t _triangleCount;
+};
@@ -0,0 +1,129 @@
+#include "stdafx.h"
+#include "BufferAllocator.h"
+#include "TestCommon.h"
+#include <random>
+#include <algorithm>
+
+namespace
+{
+	// 뷮    þ, ȣ    INVALID_SLOT ȯѴ.
+	void testPagedSlotAllocatorGrow(void)
+	{
+		PagedSlotAllocator allocator(4, 10);
+		TEST_CHECK(allocator.getCapacity() == 4);
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			TEST_CHECK(allocator.allocate() == i);
+		}
+		TEST_CHECK(allocator.getCapacity() == 4);
+		TEST_CHECK(allocator.allocate() == 4);
+		TEST_CHECK(allocator.getCapacity() == 8);
+		for (uint32_t i = 5; i < 10; ++i)
+		{
+			TEST_CHECK(allocator.allocate() == i);
+		}
+		TEST_CHECK(allocator.getCapacity() == 12);
+		TEST_CHECK(allocator.getUsedCount() == 10);
+		TEST_CHECK(allocator.allocate() == PagedSlotAllocator::INVALID_SLOT);
+		TEST_CHECK(allocator.getUsedCount() == 10);
+	}
+
+	//  ȯ ȣ ٽ , ϴ  뷮  ʴ´.
+	void testPagedSlotAllocatorReuse(void)
+	{
+		PagedSlotAllocator allocator(4, 100);
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			allocator.allocate();
+		}
+		const uint32_t capacity = allocator.getCapacity();
+		allocator.release(3);
+		allocator.release(7);
+		TEST_CHECK(allocator.getUsedCount() == 6);
+		TEST_CHECK(allocator.allocate() == 7);
+		TEST_CHECK(allocator.allocate() == 3);
+		TEST_CHECK(allocator.allocate() == 8);
+		TEST_CHECK(allocator.getUsedCount() == 9);
+		TEST_CHECK(capacity <= allocator.getCapacity());
+
+		//  Ҵ, ȯص ִ ȣ ġ ʰ 뷮 ȿ ־ Ѵ.
+		std::mt19937 randomEngine(45);
+		std::vector<uint32_t> liveSlots;
+		allocator.clear();
+		for (int i = 0; i < 10000; ++i)
+		{
+			if (liveSlots.empty() || randomEngine() % 3 != 0)
+			{
+				const uint32_t slot = allocator.allocate();
+				if (slot == PagedSlotAllocator::INVALID_SLOT)
+				{
+					TEST_CHECK(liveSlots.size() == 100);
+					continue;
+				}
+				TEST_CHECK(slot < allocator.getCapacity());
+				liveSlots.push_back(slot);
+			}
+			else
+			{
+				const size_t index = randomEngine() % liveSlots.size();
+				allocator.release(liveSlots[index]);
+				liveSlots[index] = liveSlots.back();
+				liveSlots.pop_back();
+			}
+			TEST_CHECK(allocator.getUsedCount() == liveSlots.size());
+		}
+		std::sort(liveSlots.begin(), liveSlots.end());
+		TEST_CHECK(std::adjacent_find(liveSlots.begin(), liveSlots.end()) == liveSlots.end());
+	}
+
+	//  ̹ þ 뷮 ϰ ȣ ó ٽ ش.
+	void testPagedSlotAllocatorClear(void)
+	{
+		PagedSlotAllocator allocator(4, 100);
+		for (uint32_t i = 0; i < 9; ++i)
+		{
+			allocator.allocate();
+		}
+		allocator.release(2);
+		TEST_CHECK(allocator.getCapacity() == 12);
+		allocator.clear();
+		TEST_CHECK(allocator.getUsedCount() == 0);
+		TEST_CHECK(allocator.getCapacity() == 12);
+		TEST_CHECK(allocator.allocate() == 0);
+		TEST_CHECK(allocator.allocate() == 1);
+	}
+
+	// Ӹ տ ְ,  뷮 ũ INVALID_OFFSET ȯѴ.
+	void testLinearAllocator(void)
+	{
+		LinearAllocator allocator;
+		TEST_CHECK(allocator.allocate(1) == LinearAllocator::INVALID_OFFSET);
+
+		allocator.reset(10);
+		TEST_CHECK(allocator.allocate(4) == 0);
+		TEST_CHECK(allocator.allocate(0) == 4);
+		TEST_CHECK(allocator.allocate(6) == 4);
+		TEST_CHECK(allocator.getUsedCount() == 10);
+		TEST_CHECK(allocator.allocate(1) == LinearAllocator::INVALID_OFFSET);
+		TEST_CHECK(allocator.getUsedCount() == 10);
+
+		allocator.reset(8);
+		TEST_CHECK(allocator.getUsedCount() == 0);
+		TEST_CHECK(allocator.getCapacity() == 8);
+		TEST_CHECK(allocator.allocate(3) == 0);
+		// ؼ ġ ū  ؾ Ѵ.
+		TEST_CHECK(allocator.allocate(std::numeric_limits<uint32_t>::max()) == LinearAllocator::INVALID_OFFSET);
+		TEST_CHECK(allocator.allocate(6) == LinearAllocator::INVALID_OFFSET);
+		TEST_CHECK(allocator.allocate(5) == 3);
+		TEST_CHECK(allocator.getUsedCount() == 8);
+	}
+}
+
+int main(void)
+{
+	testPagedSlotAllocatorGrow();
+	testPagedSlotAllocatorReuse();
+	testPagedSlotAllocatorClear();
+	testLinearAllocator();
+	return getTestFailCount();
+}
@@ -0,0 +1,129 @@
+#include "stdafx.h"
+#include "FrameSnapshotQueue.h"
+#include "TestCommon.h"
+#include <thread>
+#include <atomic>
+
+namespace
+{
+	// ׸  ùķ̼  snapshot  _frame _check ޶.
+	struct TestSnapshot
+	{
+		uint32_t _frame = 0;
+		uint32_t _check = 0;
+	};
+
+	//  忡 publish, acquire, release  Ѵ.
+	void testPublishAcquire(void)
+	{
+		FrameSnapshotQueue<TestSnapshot> queue;
+		TestSnapshot& first = queue.getWriteSnapshot();
+		first._frame = 1;
+		TEST_CHECK(queue.publish());
+		// publishϸ ٸ snapshot .
+		TEST_CHECK(&queue.getWriteSnapshot() != &first);
+		queue.getWriteSnapshot()._frame = 2;
+
+		const TestSnapshot* snapshot = queue.acquire();
+		TEST_CHECK(snapshot == &first && snapshot->_frame == 1);
+		// ׸ ̾ ٸ ĭ Ƿ ٷ publish  ִ.
+		TEST_CHECK(queue.publish());
+		TEST_CHECK(&queue.getWriteSnapshot() != snapshot);
+		queue.release();
+
+		snapshot = queue.acquire();
+		TEST_CHECK(snapshot != nullptr && snapshot->_frame == 2);
+		queue.release();
+		queue.waitIdle();
+
+		const FrameSnapshotStatistics statistics = queue.popStatistics();
+		TEST_CHECK(statistics._publishCount == 2);
+		TEST_CHECK(statistics._publishWaitCount == 0 && statistics._acquireWaitCount == 0);
+		TEST_CHECK(queue.popStatistics()._publishCount == 0);
+	}
+
+	// ùķ̼   带   publish snapshot   а,
+	// д ȿ ùķ̼  snapshot  ʴ´.
+	void testPipeline(void)
+	{
+		constexpr uint32_t FRAME_COUNT = 20000;
+		FrameSnapshotQueue<TestSnapshot> queue;
+		std::atomic<uint32_t> readCount(0);
+		std::atomic<bool> isOrdered(true);
+		std::atomic<bool> isUntouched(true);
+
+		std::thread renderThread([&]()
+			{
+				uint32_t expectedFrame = 1;
+				while (const TestSnapshot* snapshot = queue.acquire())
+				{
+					const uint32_t frame = snapshot->_frame;
+					if (frame != expectedFrame)
+					{
+						isOrdered = false;
+					}
+					std::this_thread::yield();
+					if (snapshot->_frame != frame || snapshot->_check != frame)
+					{
+						isUntouched = false;
+					}
+					++expectedFrame;
+					++readCount;
+					queue.release();
+				}
+			});
+
+		for (uint32_t frame = 1; frame <= FRAME_COUNT; ++frame)
+		{
+			TestSnapshot& snapshot = queue.getWriteSnapshot();
+			snapshot._frame = frame;
+			snapshot._check = frame;
+			TEST_CHECK(queue.publish());
+		}
+		queue.waitIdle();
+		TEST_CHECK(readCount == FRAME_COUNT);
+		queue.stop();
+		renderThread.join();
+
+		TEST_CHECK(isOrdered);
+		TEST_CHECK(isUntouched);
+		TEST_CHECK(queue.popStatistics()._publishCount == FRAME_COUNT);
+	}
+
+	// stopϸ ٸ acquire publish  ϰ  ȣ⵵ ٷ Ѵ.
+	void testStop(void)
+	{
+		{
+			FrameSnapshotQueue<TestSnapshot> queue;
+			const TestSnapshot* acquired = &queue.getWriteSnapshot();
+			std::thread renderThread([&]() { acquired = queue.acquire(); });
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			queue.stop();
+			renderThread.join();
+			TEST_CHECK(acquired == nullptr);
+			TEST_CHECK(!queue.publish());
+			TEST_CHECK(queue.acquire() == nullptr);
+			queue.waitIdle();
+		}
+		{
+			// ٸ ĭ   publish  尡   ٸ.
+			FrameSnapshotQueue<TestSnapshot> queue;
+			TEST_CHECK(queue.publish());
+			bool isPublished = true;
+			std::thread simulationThread([&]() { isPublished = queue.publish(); });
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			queue.stop();
+			simulationThread.join();
+			TEST_CHECK(!isPublished);
+			TEST_CHECK(queue.popStatistics()._publishCount == 1);
+		}
+	}
+}
+
+int main(void)
+{
+	testPublishAcquire();
+	testPipeline();
+	testStop();
+	return getTestFailCount();
+}
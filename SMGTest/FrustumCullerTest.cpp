@@ -0,0 +1,250 @@
+#include "stdafx.h"
+#include "FrustumCuller.h"
+#include "TestCommon.h"
+#include <random>
+
+namespace
+{
+	constexpr size_t BOX_COUNT = 10001;
+	constexpr int BENCHMARK_FRAME_COUNT = 100;
+
+	struct TestCamera
+	{
+		DirectX::XMFLOAT4X4 _viewProjection;
+		DirectX::BoundingFrustum _worldFrustum;
+	};
+
+	// D3DApp   projection   frustum ī޶ ġ ű.
+	void makeCamera(TestCamera& outCamera)
+	{
+		using namespace DirectX;
+		const XMVECTOR eye = XMVectorSet(0.f, 5.f, -20.f, 1.f);
+		const XMVECTOR direction = XMVector3Normalize(XMVectorSet(0.2f, -0.1f, 1.f, 0.f));
+		const XMMATRIX view = XMMatrixLookToLH(eye, direction, XMVectorSet(0.f, 1.f, 0.f, 0.f));
+		const XMMATRIX projection = XMMatrixPerspectiveFovLH(0.25f * XM_PI, 16.f / 9.f, 1.f, 500.f);
+		XMStoreFloat4x4(&outCamera._viewProjection, XMMatrixMultiply(view, projection));
+
+		BoundingFrustum localFrustum;
+		BoundingFrustum::CreateFromMatrix(localFrustum, projection);
+		localFrustum.Transform(outCamera._worldFrustum, XMMatrixInverse(nullptr, view));
+	}
+
+	void makeBoxes(size_t count, std::vector<DirectX::BoundingBox>& outBoxes)
+	{
+		std::mt19937 randomEngine(41);
+		std::uniform_real_distribution<float> centerDistribution(-300.f, 300.f);
+		std::uniform_real_distribution<float> extentDistribution(0.1f, 10.f);
+		outBoxes.resize(count);
+		for (auto& box : outBoxes)
+		{
+			box.Center = DirectX::XMFLOAT3(centerDistribution(randomEngine), centerDistribution(randomEngine), centerDistribution(randomEngine));
+			box.Extents = DirectX::XMFLOAT3(extentDistribution(randomEngine), extentDistribution(randomEngine), extentDistribution(randomEngine));
+		}
+	}
+
+	//     迡 ģ ڽ  ٲ ʵ  ڽ ũ⸦  ٲ۴.
+	DirectX::BoundingBox resizeBox(const DirectX::BoundingBox& box, float scale, float offset) noexcept
+	{
+		return DirectX::BoundingBox(box.Center, DirectX::XMFLOAT3(box.Extents.x * scale + offset,
+			box.Extents.y * scale + offset,
+			box.Extents.z * scale + offset));
+	}
+
+	// ø ̾ Ѵ.  ڽ BoundingFrustum::Contains DISJOINT̰,  ȿ ִ ڽ  ʴ´.
+	void checkAgainstContains(const FrustumCuller& culler,
+		const DirectX::BoundingFrustum& frustum,
+		const std::vector<DirectX::BoundingBox>& boxes,
+		size_t& outVisibleCount,
+		size_t& outFalseVisibleCount)
+	{
+		outVisibleCount = 0;
+		outFalseVisibleCount = 0;
+		for (uint32_t i = 0; i < boxes.size(); ++i)
+		{
+			const bool isVisible = culler.isVisible(i);
+			if (!isVisible)
+			{
+				TEST_CHECK(frustum.Contains(resizeBox(boxes[i], 0.999f, -0.001f)) == DirectX::DISJOINT);
+				continue;
+			}
+			++outVisibleCount;
+			if (frustum.Contains(boxes[i]) == DirectX::DISJOINT)
+			{
+				++outFalseVisibleCount;
+			}
+		}
+		for (uint32_t i = 0; i < boxes.size(); ++i)
+		{
+			if (frustum.Contains(resizeBox(boxes[i], 1.001f, 0.001f)) == DirectX::CONTAINS)
+			{
+				TEST_CHECK(culler.isVisible(i));
+			}
+		}
+	}
+
+	// 4 ˻ϹǷ BOX_COUNT 4  ƴ  ؼ ä ĭ ȮѴ.
+	void testAgainstBoundingFrustum(void)
+	{
+		using namespace DirectX;
+		TestCamera camera;
+		makeCamera(camera);
+		std::vector<BoundingBox> boxes;
+		makeBoxes(BOX_COUNT, boxes);
+
+		FrustumCuller frustumCuller;
+		FrustumCuller matrixCuller;
+		frustumCuller.setFrustum(camera._worldFrustum);
+		matrixCuller.setFrustum(XMLoadFloat4x4(&camera._viewProjection));
+		for (const auto& box : boxes)
+		{
+			frustumCuller.addBox(box.Center, box.Extents);
+			matrixCuller.addBox(box.Center, box.Extents);
+		}
+		TEST_CHECK(frustumCuller.getBoxCount() == BOX_COUNT);
+		frustumCuller.cull();
+		matrixCuller.cull();
+
+		size_t visibleCount;
+		size_t falseVisibleCount;
+		checkAgainstContains(frustumCuller, camera._worldFrustum, boxes, visibleCount, falseVisibleCount);
+		size_t matrixVisibleCount;
+		size_t matrixFalseVisibleCount;
+		checkAgainstContains(matrixCuller, camera._worldFrustum, boxes, matrixVisibleCount, matrixFalseVisibleCount);
+		TEST_CHECK(0 < visibleCount && visibleCount < BOX_COUNT);
+
+		size_t differentCount = 0;
+		for (uint32_t i = 0; i < BOX_COUNT; ++i)
+		{
+			if (frustumCuller.isVisible(i) != matrixCuller.isVisible(i))
+			{
+				++differentCount;
+			}
+		}
+		//  frustum ٸ  Ƿ 迡 ģ   ƾ Ѵ.
+		TEST_CHECK(differentCount * 1000 <= BOX_COUNT);
+
+		std::printf("FrustumCuller box: %zu visible: %zu (not in frustum %zu), viewProjection visible: %zu, different: %zu\n",
+			BOX_COUNT, visibleCount, falseVisibleCount, matrixVisibleCount, differentCount);
+	}
+
+	// world ķ ű ڽ 8  Űܼ  AABB ƾ Ѵ.
+	void testTransformedBox(void)
+	{
+		using namespace DirectX;
+		TestCamera camera;
+		makeCamera(camera);
+		std::vector<BoundingBox> boxes;
+		makeBoxes(1000, boxes);
+
+		FrustumCuller culler;
+		culler.setFrustum(camera._worldFrustum);
+		std::vector<BoundingBox> cornerBoxes(boxes.size());
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			const BoundingBox localBox(XMFLOAT3(0.5f, -1.f, 2.f), boxes[i].Extents);
+			const XMMATRIX world = XMMatrixScaling(1.f, 2.f, 0.5f) *
+				XMMatrixRotationY(0.37f * static_cast<float>(i)) *
+				XMMatrixTranslation(boxes[i].Center.x, boxes[i].Center.y, boxes[i].Center.z);
+			culler.addBox(localBox, world);
+
+			XMVECTOR cornerMin = XMVectorReplicate(FLT_MAX);
+			XMVECTOR cornerMax = XMVectorReplicate(-FLT_MAX);
+			for (int c = 0; c < 8; ++c)
+			{
+				const XMVECTOR corner = XMVectorSet(localBox.Center.x + ((c & 1) ? localBox.Extents.x : -localBox.Extents.x),
+					localBox.Center.y + ((c & 2) ? localBox.Extents.y : -localBox.Extents.y),
+					localBox.Center.z + ((c & 4) ? localBox.Extents.z : -localBox.Extents.z),
+					1.f);
+				const XMVECTOR worldCorner = XMVector3Transform(corner, world);
+				cornerMin = XMVectorMin(cornerMin, worldCorner);
+				cornerMax = XMVectorMax(cornerMax, worldCorner);
+			}
+			XMStoreFloat3(&cornerBoxes[i].Center, (cornerMin + cornerMax) * 0.5f);
+			XMStoreFloat3(&cornerBoxes[i].Extents, (cornerMax - cornerMin) * 0.5f);
+		}
+		culler.cull();
+
+		size_t visibleCount;
+		size_t falseVisibleCount;
+		checkAgainstContains(culler, camera._worldFrustum, cornerBoxes, visibleCount, falseVisibleCount);
+		TEST_CHECK(0 < visibleCount);
+	}
+
+	void testClearBoxes(void)
+	{
+		using namespace DirectX;
+		TestCamera camera;
+		makeCamera(camera);
+
+		FrustumCuller culler;
+		culler.setFrustum(camera._worldFrustum);
+		std::vector<BoundingBox> boxes;
+		makeBoxes(BOX_COUNT, boxes);
+		for (const auto& box : boxes)
+		{
+			culler.addBox(box.Center, box.Extents);
+		}
+		culler.cull();
+
+		// ī޶ , , 
+		culler.clearBoxes();
+		TEST_CHECK(culler.getBoxCount() == 0);
+		TEST_CHECK(culler.addBox(XMFLOAT3(4.f, 0.f, 30.f), XMFLOAT3(1.f, 1.f, 1.f)) == 0);
+		TEST_CHECK(culler.addBox(XMFLOAT3(0.f, 5.f, -60.f), XMFLOAT3(1.f, 1.f, 1.f)) == 1);
+		TEST_CHECK(culler.addBox(XMFLOAT3(20.f, 0.f, 100.f), XMFLOAT3(2.f, 2.f, 2.f)) == 2);
+		culler.cull();
+		TEST_CHECK(culler.isVisible(0));
+		TEST_CHECK(!culler.isVisible(1));
+		TEST_CHECK(culler.isVisible(2));
+	}
+
+	// ڽ BoundingFrustum::Contains ȣϴ Ͱ ѹ 4 ˻ϴ  Ѵ.
+	void benchmark(void)
+	{
+		using namespace DirectX;
+		TestCamera camera;
+		makeCamera(camera);
+		std::vector<BoundingBox> boxes;
+		makeBoxes(BOX_COUNT - 1, boxes);
+
+		FrustumCuller culler;
+		culler.setFrustum(camera._worldFrustum);
+		for (const auto& box : boxes)
+		{
+			culler.addBox(box.Center, box.Extents);
+		}
+
+		size_t cullerVisibleCount = 0;
+		TestTimer cullerTimer;
+		for (int f = 0; f < BENCHMARK_FRAME_COUNT; ++f)
+		{
+			culler.cull();
+			cullerVisibleCount += culler.isVisible(static_cast<uint32_t>(f)) ? 1 : 0;
+		}
+		const double cullerMicroSecond = cullerTimer.getMicroSecond();
+
+		size_t containsVisibleCount = 0;
+		TestTimer containsTimer;
+		for (int f = 0; f < BENCHMARK_FRAME_COUNT; ++f)
+		{
+			for (const auto& box : boxes)
+			{
+				containsVisibleCount += camera._worldFrustum.Contains(box) != DISJOINT ? 1 : 0;
+			}
+		}
+		const double containsMicroSecond = containsTimer.getMicroSecond();
+
+		std::printf("cull %zu boxes: FrustumCuller %.1fus/frame, BoundingFrustum::Contains %.1fus/frame (%zu, %zu)\n",
+			boxes.size(), cullerMicroSecond / BENCHMARK_FRAME_COUNT, containsMicroSecond / BENCHMARK_FRAME_COUNT,
+			cullerVisibleCount, containsVisibleCount);
+	}
+}
+
+int main(void)
+{
+	testAgainstBoundingFrustum();
+	testTransformedBox();
+	testClearBoxes();
+	benchmark();
+	return getTestFailCount();
+}
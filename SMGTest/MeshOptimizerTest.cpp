@@ -0,0 +1,260 @@
+#include "stdafx.h"
+#include "SMGFileConverter/MeshOptimizer.h"
+#include "TestCommon.h"
+#include <random>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+	using Triangle = std::array<GeoIndex, 3>;
+
+	//   ȣ տ      ä  ﰢ 
+	std::vector<Triangle> getSortedTriangles(const std::vector<GeoIndex>& indices)
+	{
+		std::vector<Triangle> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			Triangle triangle = { indices[i], indices[i + 1], indices[i + 2] };
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	// size x sizeĭ . ﰢ   cache ȿ  mesh .
+	void makeShuffledGrid(int size, std::vector<DirectX::XMFLOAT3>& outPositions, std::vector<GeoIndex>& outIndices)
+	{
+		outPositions.clear();
+		for (int y = 0; y <= size; ++y)
+		{
+			for (int x = 0; x <= size; ++x)
+			{
+				outPositions.emplace_back(static_cast<float>(x), 0.f, static_cast<float>(y));
+			}
+		}
+		std::vector<Triangle> triangles;
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const GeoIndex v0 = static_cast<GeoIndex>(y * (size + 1) + x);
+				const GeoIndex v1 = v0 + 1;
+				const GeoIndex v2 = static_cast<GeoIndex>(v0 + size + 1);
+				const GeoIndex v3 = v2 + 1;
+				triangles.push_back({ v0, v2, v1 });
+				triangles.push_back({ v1, v2, v3 });
+			}
+		}
+		std::shuffle(triangles.begin(), triangles.end(), std::mt19937(50));
+		outIndices.clear();
+		for (const auto& triangle : triangles)
+		{
+			outIndices.insert(outIndices.end(), triangle.begin(), triangle.end());
+		}
+	}
+
+	// Ʒ  ϴ  . ٱ  ð  ´.
+	void makeSphere(int sliceCount, int stackCount, std::vector<DirectX::XMFLOAT3>& outPositions, std::vector<GeoIndex>& outIndices)
+	{
+		using namespace DirectX;
+		outPositions.clear();
+		outPositions.emplace_back(0.f, 1.f, 0.f);
+		for (int stack = 1; stack < stackCount; ++stack)
+		{
+			const float phi = XM_PI * stack / stackCount;
+			for (int slice = 0; slice < sliceCount; ++slice)
+			{
+				const float theta = XM_PI * 2.f * slice / sliceCount;
+				outPositions.emplace_back(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+			}
+		}
+		outPositions.emplace_back(0.f, -1.f, 0.f);
+		const GeoIndex bottom = static_cast<GeoIndex>(outPositions.size() - 1);
+		const auto getRingIndex = [sliceCount](int ring, int slice)
+		{
+			return static_cast<GeoIndex>(1 + ring * sliceCount + slice % sliceCount);
+		};
+
+		outIndices.clear();
+		for (int slice = 0; slice < sliceCount; ++slice)
+		{
+			outIndices.insert(outIndices.end(), { 0, getRingIndex(0, slice + 1), getRingIndex(0, slice) });
+		}
+		for (int ring = 0; ring + 1 < stackCount - 1; ++ring)
+		{
+			for (int slice = 0; slice < sliceCount; ++slice)
+			{
+				const GeoIndex v0 = getRingIndex(ring, slice);
+				const GeoIndex v1 = getRingIndex(ring, slice + 1);
+				const GeoIndex v2 = getRingIndex(ring + 1, slice);
+				const GeoIndex v3 = getRingIndex(ring + 1, slice + 1);
+				outIndices.insert(outIndices.end(), { v0, v1, v2 });
+				outIndices.insert(outIndices.end(), { v2, v1, v3 });
+			}
+		}
+		for (int slice = 0; slice < sliceCount; ++slice)
+		{
+			outIndices.insert(outIndices.end(), { bottom, getRingIndex(stackCount - 2, slice), getRingIndex(stackCount - 2, slice + 1) });
+		}
+	}
+
+	//     ִ index FIFO cache ùķ̼ ȮѴ.
+	void testAnalyzeVertexCache(void)
+	{
+		// strip  Ǯ ù ﰢ ڷδ ﰢ   ϳ̴.
+		constexpr GeoIndex STRIP_TRIANGLE_COUNT = 100;
+		std::vector<GeoIndex> strip;
+		for (GeoIndex i = 0; i < STRIP_TRIANGLE_COUNT; ++i)
+		{
+			strip.push_back(i);
+			strip.push_back(i + 1);
+			strip.push_back(i + 2);
+		}
+		MeshOptimizer::VertexCacheStatistics statistics = MeshOptimizer::analyzeVertexCache(strip, STRIP_TRIANGLE_COUNT + 2);
+		TEST_CHECK(statistics._acmr == static_cast<float>(STRIP_TRIANGLE_COUNT + 2) / STRIP_TRIANGLE_COUNT);
+		TEST_CHECK(statistics._atvr == 1.f);
+
+		//    ʴ ﰢ  3  ȯѴ.  ʴ  atvr  ʴ´.
+		std::vector<GeoIndex> separated(30);
+		std::iota(separated.begin(), separated.end(), 0);
+		statistics = MeshOptimizer::analyzeVertexCache(separated, 40);
+		TEST_CHECK(statistics._acmr == 3.f);
+		TEST_CHECK(statistics._atvr == 1.f);
+
+		// cache  ٽ ȯ ʰ, cache ũ⺸    ٽ ȯѴ.
+		std::vector<GeoIndex> repeated = { 0, 1, 2, 0, 1, 2 };
+		statistics = MeshOptimizer::analyzeVertexCache(repeated, 3);
+		TEST_CHECK(statistics._acmr == 1.5f);
+		repeated = separated;
+		repeated.insert(repeated.end(), { 0, 1, 2 });
+		statistics = MeshOptimizer::analyzeVertexCache(repeated, 30);
+		TEST_CHECK(statistics._acmr == 3.f);
+
+		TEST_CHECK(MeshOptimizer::analyzeVertexCache({}, 0)._acmr == 0.f);
+	}
+
+	//  ٲٰ ﰢ հ   ϸ, cache ȿ  ʴ´.
+	void testOptimizeVertexCache(void)
+	{
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<GeoIndex> indices;
+		makeShuffledGrid(32, positions, indices);
+		const std::vector<Triangle> triangles = getSortedTriangles(indices);
+		const float acmrBefore = MeshOptimizer::analyzeVertexCache(indices, positions.size())._acmr;
+
+		MeshOptimizer::optimizeVertexCache(indices, positions.size());
+		TEST_CHECK(getSortedTriangles(indices) == triangles);
+		const float acmrAfter = MeshOptimizer::analyzeVertexCache(indices, positions.size())._acmr;
+		TEST_CHECK(acmrAfter <= acmrBefore);
+		// ڴ  ﰢ    ϸ 1 ۾.
+		TEST_CHECK(acmrAfter < 1.f);
+		std::printf("shuffled grid acmr: %.3f -> %.3f\n", acmrBefore, acmrAfter);
+
+		// ̹    ʴ´.
+		const std::vector<GeoIndex> optimized = indices;
+		MeshOptimizer::optimizeVertexCache(indices, positions.size());
+		TEST_CHECK(getSortedTriangles(indices) == triangles);
+		TEST_CHECK(MeshOptimizer::analyzeVertexCache(indices, positions.size())._acmr <=
+			MeshOptimizer::analyzeVertexCache(optimized, positions.size())._acmr);
+	}
+
+	// overdraw    ٲٹǷ ﰢ հ   ״̰, ACMR cache   threshold踦  ʴ´.
+	void testOptimizeOverdraw(void)
+	{
+		constexpr float THRESHOLD = 1.05f;
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<GeoIndex> indices;
+		makeSphere(48, 32, positions, indices);
+		std::vector<Triangle> shuffledTriangles;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			shuffledTriangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+		}
+		std::shuffle(shuffledTriangles.begin(), shuffledTriangles.end(), std::mt19937(51));
+		indices.clear();
+		for (const auto& triangle : shuffledTriangles)
+		{
+			indices.insert(indices.end(), triangle.begin(), triangle.end());
+		}
+		const std::vector<Triangle> triangles = getSortedTriangles(indices);
+
+		MeshOptimizer::optimizeVertexCache(indices, positions.size());
+		const float acmrCache = MeshOptimizer::analyzeVertexCache(indices, positions.size())._acmr;
+
+		MeshOptimizer::optimizeOverdraw(indices, positions, THRESHOLD);
+		TEST_CHECK(getSortedTriangles(indices) == triangles);
+		const float acmrOverdraw = MeshOptimizer::analyzeVertexCache(indices, positions.size())._acmr;
+		TEST_CHECK(acmrOverdraw <= acmrCache * THRESHOLD);
+		std::printf("sphere acmr: cache %.3f -> overdraw %.3f\n", acmrCache, acmrOverdraw);
+
+		// ﰢ  ״ д.
+		std::vector<GeoIndex> empty;
+		MeshOptimizer::optimizeOverdraw(empty, positions, THRESHOLD);
+		TEST_CHECK(empty.empty());
+	}
+
+	// remap   ѹ ű ̰, ű ڿ index  ġ Ų.
+	void testVertexFetchRemap(void)
+	{
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<GeoIndex> indices;
+		makeShuffledGrid(16, positions, indices);
+		//  ʴ  ڷ .
+		constexpr size_t UNUSED_VERTEX_COUNT = 5;
+		const size_t usedVertexCount = positions.size();
+		for (size_t i = 0; i < UNUSED_VERTEX_COUNT; ++i)
+		{
+			positions.emplace_back(-1.f, static_cast<float>(i), -1.f);
+		}
+
+		std::vector<GeoIndex> remap;
+		MeshOptimizer::makeVertexFetchRemap(indices, positions.size(), remap);
+		TEST_CHECK(remap.size() == positions.size());
+		std::vector<GeoIndex> sortedRemap = remap;
+		std::sort(sortedRemap.begin(), sortedRemap.end());
+		bool isPermutation = true;
+		for (size_t i = 0; i < sortedRemap.size(); ++i)
+		{
+			isPermutation &= sortedRemap[i] == i;
+		}
+		TEST_CHECK(isPermutation);
+		for (size_t i = usedVertexCount; i < positions.size(); ++i)
+		{
+			TEST_CHECK(usedVertexCount <= remap[i]);
+		}
+
+		std::vector<GeoIndex> remappedIndices = indices;
+		MeshOptimizer::remapIndices(remappedIndices, remap);
+		std::vector<DirectX::XMFLOAT3> remappedPositions = positions;
+		MeshOptimizer::remapVertices(remappedPositions, remap);
+		bool isSamePosition = true;
+		// ó ̴  ȣ ŰǷ  ȣ ϳ þ ó ´.
+		bool isFetchOrdered = true;
+		GeoIndex nextIndex = 0;
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			const DirectX::XMFLOAT3& before = positions[indices[i]];
+			const DirectX::XMFLOAT3& after = remappedPositions[remappedIndices[i]];
+			isSamePosition &= before.x == after.x && before.y == after.y && before.z == after.z;
+			if (nextIndex <= remappedIndices[i])
+			{
+				isFetchOrdered &= remappedIndices[i] == nextIndex;
+				++nextIndex;
+			}
+		}
+		TEST_CHECK(isSamePosition);
+		TEST_CHECK(isFetchOrdered);
+		TEST_CHECK(nextIndex == usedVertexCount);
+	}
+}
+
+int main(void)
+{
+	testAnalyzeVertexCache();
+	testOptimizeVertexCache();
+	testOptimizeOverdraw();
+	testVertexFetchRemap();
+	return getTestFailCount();
+}
@@ -0,0 +1,233 @@
+#include "stdafx.h"
+#include "SMGFileConverter/MeshSimplifier.h"
+#include "MeshLod.h"
+#include "TestCommon.h"
+#include <algorithm>
+#include <set>
+#include <cmath>
+
+namespace
+{
+	constexpr int GRID_SIZE = 32;
+	// x    uv  seam̶  ĭ  ġ ٸ  .
+	constexpr int SEAM_COLUMN = GRID_SIZE / 2;
+
+	// size x sizeĭ  . ٱ  ̰ SEAM_COLUMN seam ִ. (y+)  ð  ´.
+	// outLocked ű ȵǴ seam,  ̴.
+	void makeSeamGrid(float height, std::vector<DirectX::XMFLOAT3>& outPositions, std::vector<GeoIndex>& outIndices,
+		std::vector<bool>& outLocked)
+	{
+		outPositions.clear();
+		outLocked.clear();
+		const auto getHeight = [height](int x, int z)
+		{
+			return height * std::sin(x * 0.4f) * std::cos(z * 0.3f);
+		};
+		for (int z = 0; z <= GRID_SIZE; ++z)
+		{
+			for (int x = 0; x <= GRID_SIZE; ++x)
+			{
+				outPositions.emplace_back(static_cast<float>(x), getHeight(x, z), static_cast<float>(z));
+				outLocked.push_back(x == 0 || z == 0 || x == GRID_SIZE || z == GRID_SIZE || x == SEAM_COLUMN);
+			}
+		}
+		const GeoIndex seamBegin = static_cast<GeoIndex>(outPositions.size());
+		for (int z = 0; z <= GRID_SIZE; ++z)
+		{
+			outPositions.emplace_back(static_cast<float>(SEAM_COLUMN), getHeight(SEAM_COLUMN, z), static_cast<float>(z));
+			outLocked.push_back(true);
+		}
+		const auto getIndex = [seamBegin](int x, int z, bool isRightOfSeam)
+		{
+			if (x == SEAM_COLUMN && isRightOfSeam)
+			{
+				return static_cast<GeoIndex>(seamBegin + z);
+			}
+			return static_cast<GeoIndex>(z * (GRID_SIZE + 1) + x);
+		};
+
+		outIndices.clear();
+		for (int z = 0; z < GRID_SIZE; ++z)
+		{
+			for (int x = 0; x < GRID_SIZE; ++x)
+			{
+				const bool isRightOfSeam = (SEAM_COLUMN <= x);
+				const GeoIndex v0 = getIndex(x, z, isRightOfSeam);
+				const GeoIndex v1 = getIndex(x + 1, z, isRightOfSeam);
+				const GeoIndex v2 = getIndex(x, z + 1, isRightOfSeam);
+				const GeoIndex v3 = getIndex(x + 1, z + 1, isRightOfSeam);
+				outIndices.insert(outIndices.end(), { v0, v2, v1 });
+				outIndices.insert(outIndices.end(), { v1, v2, v3 });
+			}
+		}
+	}
+
+	// index  ﰢ ϳ  edge. ٱ  seam  .
+	std::set<std::pair<GeoIndex, GeoIndex>> getOpenEdges(const std::vector<GeoIndex>& indices)
+	{
+		std::multiset<std::pair<GeoIndex, GeoIndex>> edges;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const GeoIndex i0 = indices[i + k];
+				const GeoIndex i1 = indices[i + (k + 1) % 3];
+				edges.emplace(std::min(i0, i1), std::max(i0, i1));
+			}
+		}
+		std::set<std::pair<GeoIndex, GeoIndex>> openEdges;
+		for (const auto& edge : edges)
+		{
+			if (edges.count(edge) == 1)
+			{
+				openEdges.insert(edge);
+			}
+		}
+		return openEdges;
+	}
+
+	DirectX::XMVECTOR getTriangleNormal(const std::vector<DirectX::XMFLOAT3>& positions, const GeoIndex* triangle)
+	{
+		using namespace DirectX;
+		const XMVECTOR p0 = XMLoadFloat3(&positions[triangle[0]]);
+		return XMVector3Cross(XMLoadFloat3(&positions[triangle[1]]) - p0, XMLoadFloat3(&positions[triangle[2]]) - p0);
+	}
+
+	// ȯó 1/2, 1/4, 1/8 ǥ ̾ δ.
+	//   ״ ̰,  seam edge , ܰ踶 index  ٰ,   ﰢ  ʴ´.
+	void testLodChain(void)
+	{
+		using namespace DirectX;
+		std::vector<XMFLOAT3> positions;
+		std::vector<GeoIndex> indices;
+		std::vector<bool> isLocked;
+		makeSeamGrid(1.f, positions, indices, isLocked);
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			TEST_CHECK(0.f < XMVectorGetY(getTriangleNormal(positions, &indices[i])));
+		}
+		const std::set<std::pair<GeoIndex, GeoIndex>> openEdges = getOpenEdges(indices);
+		std::set<GeoIndex> lockedVertices;
+		for (const auto& edge : openEdges)
+		{
+			lockedVertices.insert(edge.first);
+			lockedVertices.insert(edge.second);
+		}
+		for (GeoIndex v = 0; v < isLocked.size(); ++v)
+		{
+			TEST_CHECK(isLocked[v] == (lockedVertices.count(v) == 1));
+		}
+
+		MeshSimplifier simplifier(positions, indices);
+		TEST_CHECK(simplifier.getIndexCount() == indices.size());
+		size_t previousIndexCount = indices.size();
+		std::vector<GeoIndex> lodIndices;
+		for (int lod = 1; lod < MESH_LOD_COUNT_MAX; ++lod)
+		{
+			simplifier.simplify(indices.size() >> lod, 10.f);
+			simplifier.getIndices(lodIndices);
+			TEST_CHECK(lodIndices.size() == simplifier.getIndexCount());
+			TEST_CHECK(lodIndices.size() < previousIndexCount);
+			std::printf("seam grid lod %d: %zu -> %zu indices\n", lod, indices.size(), lodIndices.size());
+			previousIndexCount = lodIndices.size();
+
+			std::set<GeoIndex> usedVertices(lodIndices.begin(), lodIndices.end());
+			bool isLockedUsed = true;
+			for (const GeoIndex v : lockedVertices)
+			{
+				isLockedUsed &= usedVertices.count(v) == 1;
+			}
+			TEST_CHECK(isLockedUsed);
+			TEST_CHECK(getOpenEdges(lodIndices) == openEdges);
+
+			//    ﰢ 踦    ־ y 0  ִ. Ʒ   ̴.
+			bool isFacingUp = true;
+			for (size_t i = 0; i < lodIndices.size(); i += 3)
+			{
+				isFacingUp &= 0.f <= XMVectorGetY(getTriangleNormal(positions, &lodIndices[i]));
+			}
+			TEST_CHECK(isFacingUp);
+		}
+	}
+
+	//  collapse  maxError  ǥ  ٿ ߰,   ø ̾ δ.
+	void testMaxError(void)
+	{
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<GeoIndex> indices;
+		std::vector<bool> isLocked;
+
+		// ϸ  Ƿ 0ε   ִ.
+		makeSeamGrid(0.f, positions, indices, isLocked);
+		MeshSimplifier flatSimplifier(positions, indices);
+		flatSimplifier.simplify(0, 0.f);
+		TEST_CHECK(flatSimplifier.getIndexCount() < indices.size() / 4);
+
+		makeSeamGrid(1.f, positions, indices, isLocked);
+		MeshSimplifier simplifier(positions, indices);
+		simplifier.simplify(0, 0.f);
+		const size_t exactIndexCount = simplifier.getIndexCount();
+		TEST_CHECK(indices.size() / 2 < exactIndexCount);
+		simplifier.simplify(0, 0.05f);
+		const size_t smallErrorIndexCount = simplifier.getIndexCount();
+		TEST_CHECK(smallErrorIndexCount < exactIndexCount);
+		simplifier.simplify(0, 10.f);
+		TEST_CHECK(simplifier.getIndexCount() < smallErrorIndexCount);
+		std::printf("seam grid maxError 0: %zu, 0.05: %zu, 10: %zu indices\n",
+			exactIndexCount, smallErrorIndexCount, simplifier.getIndexCount());
+
+		// ٰ ̾   ó     Ͱ .
+		MeshSimplifier smallErrorSimplifier(positions, indices);
+		smallErrorSimplifier.simplify(0, 0.05f);
+		TEST_CHECK(smallErrorSimplifier.getIndexCount() == smallErrorIndexCount);
+	}
+
+	// ذ LOD_HYSTERESIS ȿ  ʿ Ե  ܰ踦 ϰ,  ٷ ٲ.
+	void testSelectLodLevelHysteresis(void)
+	{
+		constexpr uint8_t LOD_COUNT = MESH_LOD_COUNT_MAX;
+		constexpr int STEP_COUNT = 20;
+		for (uint8_t level = 1; level < LOD_COUNT; ++level)
+		{
+			const float threshold = MeshLod::LOD_SCREEN_SIZES[level];
+			const float low = threshold * (1.f - MeshLod::LOD_HYSTERESIS);
+			const float high = threshold * (1.f + MeshLod::LOD_HYSTERESIS);
+			bool isStable = true;
+			for (int i = 1; i < STEP_COUNT; ++i)
+			{
+				const float screenSize = low + (high - low) * i / STEP_COUNT;
+				isStable &= MeshLod::selectLodLevel(screenSize, level - 1, LOD_COUNT) == level - 1;
+				isStable &= MeshLod::selectLodLevel(screenSize, level, LOD_COUNT) == level;
+			}
+			TEST_CHECK(isStable);
+			TEST_CHECK(MeshLod::selectLodLevel(low * 0.99f, level - 1, LOD_COUNT) >= level);
+			TEST_CHECK(MeshLod::selectLodLevel(high * 1.01f, level, LOD_COUNT) <= level - 1);
+
+			// ذ     ܰ谡 ٲ ʴ´.
+			uint8_t currentLevel = level;
+			int changeCount = 0;
+			for (int frame = 0; frame < 100; ++frame)
+			{
+				const float screenSize = threshold * ((frame % 2 == 0) ? 1.1f : 0.9f);
+				const uint8_t nextLevel = MeshLod::selectLodLevel(screenSize, currentLevel, LOD_COUNT);
+				changeCount += (nextLevel != currentLevel) ? 1 : 0;
+				currentLevel = nextLevel;
+			}
+			TEST_CHECK(changeCount == 0);
+		}
+
+		// ָ   ѹ  ܰ踦 ǳʶٰ,  ܰ  ʴ´.
+		TEST_CHECK(MeshLod::selectLodLevel(1.f, LOD_COUNT - 1, LOD_COUNT) == 0);
+		TEST_CHECK(MeshLod::selectLodLevel(0.001f, 0, LOD_COUNT) == LOD_COUNT - 1);
+		TEST_CHECK(MeshLod::selectLodLevel(0.001f, 0, 2) == 1);
+		TEST_CHECK(MeshLod::selectLodLevel(0.001f, 3, 1) == 0);
+	}
+}
+
+int main(void)
+{
+	testLodChain();
+	testMaxError();
+	testSelectLodLevelHysteresis();
+	return getTestFailCount();
+}
@@ -0,0 +1,369 @@
+#include "stdafx.h"
+#include "RenderQueue.h"
+#include "RecordWorkerPool.h"
+#include "TestCommon.h"
+#include <random>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+	constexpr uint16_t NOT_SKINNED = std::numeric_limits<uint16_t>::max();
+	constexpr uint8_t PRIMITIVE_TRIANGLE = 4;
+	constexpr uint8_t SKINNED_PSO_TYPE = 3;
+
+	// RenderQueue mesh ͷθ ϹǷ  ʴ ּҸ mesh  .
+	alignas(16) char meshStorage[4][16];
+	const MeshGeometry* getTestMesh(int index) noexcept
+	{
+		return reinterpret_cast<const MeshGeometry*>(meshStorage[index]);
+	}
+
+	DrawPacket makePacket(uint8_t psoType,
+		const MeshGeometry* mesh,
+		uint32_t materialCBIndex,
+		uint8_t subMeshIndex,
+		uint8_t lodLevel,
+		uint32_t objectCBIndex,
+		uint16_t skinnedCBIndex,
+		float depth) noexcept
+	{
+		DrawPacket packet;
+		packet._mesh = mesh;
+		packet._objectCBIndex = objectCBIndex;
+		packet._materialCBIndex = materialCBIndex;
+		packet._skinnedCBIndex = skinnedCBIndex;
+		packet._psoType = psoType;
+		packet._primitive = PRIMITIVE_TRIANGLE;
+		packet._subMeshIndex = subMeshIndex;
+		packet._lodLevel = lodLevel;
+		packet._sortKey = RenderQueue::makeSortKey(0, psoType, mesh, materialCBIndex, subMeshIndex, lodLevel, depth, false);
+		return packet;
+	}
+
+	// radix sort  Ű ߰  ϴ stable sort ƾ Ѵ.
+	void testSort(void)
+	{
+		std::mt19937 randomEngine(43);
+		std::uniform_int_distribution<int> smallDistribution(0, 3);
+		std::uniform_real_distribution<float> depthDistribution(0.f, 1.f);
+		RenderQueue renderQueue;
+		std::vector<DrawPacket> packets;
+		for (uint32_t i = 0; i < 5000; ++i)
+		{
+			DrawPacket packet = makePacket(smallDistribution(randomEngine), getTestMesh(smallDistribution(randomEngine)),
+				smallDistribution(randomEngine), smallDistribution(randomEngine), smallDistribution(randomEngine), i, NOT_SKINNED,
+				depthDistribution(randomEngine));
+			if (i % 7 == 0)
+			{
+				packet._sortKey = RenderQueue::makeSortKey(1, packet._psoType, packet._mesh, packet._materialCBIndex,
+					packet._subMeshIndex, packet._lodLevel, depthDistribution(randomEngine), true);
+			}
+			packets.push_back(packet);
+			renderQueue.addPacket(packet);
+		}
+		renderQueue.sort();
+		std::stable_sort(packets.begin(), packets.end(),
+			[](const DrawPacket& lhs, const DrawPacket& rhs) { return lhs._sortKey < rhs._sortKey; });
+
+		const auto& sorted = renderQueue.getPackets();
+		TEST_CHECK(sorted.size() == packets.size());
+		bool isSame = true;
+		for (size_t i = 0; i < sorted.size(); ++i)
+		{
+			isSame &= sorted[i]._sortKey == packets[i]._sortKey && sorted[i]._objectCBIndex == packets[i]._objectCBIndex;
+		}
+		TEST_CHECK(isSame);
+
+		// layer  ̰,  layer  ͺ ׸.
+		const DrawPacket opaquePacket = makePacket(3, getTestMesh(3), 3, 3, 3, 0, NOT_SKINNED, 1.f);
+		TEST_CHECK(opaquePacket._sortKey < RenderQueue::makeSortKey(1, 0, getTestMesh(0), 0, 0, 0, 0.9f, true));
+		TEST_CHECK(RenderQueue::makeSortKey(1, 0, getTestMesh(0), 0, 0, 0, 0.9f, true) <
+			RenderQueue::makeSortKey(1, 0, getTestMesh(0), 0, 0, 0, 0.1f, true));
+	}
+
+	// pso 2, material 2, submesh 2 ո object 4  ִ´.
+	// ո draw ѹ ǰ, ٲ ¸ backend ؾ Ѵ.
+	void testStateChange(void)
+	{
+		const uint8_t psoTypes[2] = { 1, 2 };
+		const uint32_t materialCBIndices[2] = { 3, 5 };
+		constexpr uint32_t OBJECT_PER_GROUP = 4;
+
+		std::vector<DrawPacket> packets;
+		uint32_t objectCBIndex = 0;
+		for (const auto psoType : psoTypes)
+		{
+			for (const auto materialCBIndex : materialCBIndices)
+			{
+				for (uint8_t subMeshIndex = 0; subMeshIndex < 2; ++subMeshIndex)
+				{
+					for (uint32_t i = 0; i < OBJECT_PER_GROUP; ++i)
+					{
+						packets.push_back(makePacket(psoType, getTestMesh(0), materialCBIndex, subMeshIndex, 0, objectCBIndex++, NOT_SKINNED,
+							static_cast<float>(i) / OBJECT_PER_GROUP));
+					}
+				}
+			}
+		}
+		std::shuffle(packets.begin(), packets.end(), std::mt19937(430));
+
+		RenderQueue renderQueue;
+		renderQueue.addPackets(packets);
+		renderQueue.sort();
+		std::vector<RenderQueueRange> ranges;
+		renderQueue.split(1, ranges);
+		TEST_CHECK(ranges.size() == 1);
+
+		RecordingRenderBackend backend;
+		RenderQueueStatistics statistics;
+		renderQueue.submit(backend, ranges[0], 0, statistics);
+
+		const auto& drawCalls = backend.getDrawCalls();
+		TEST_CHECK(drawCalls.size() == 8);
+		TEST_CHECK(statistics._drawCallCount == drawCalls.size());
+		TEST_CHECK(statistics._packetCount == packets.size());
+		TEST_CHECK(statistics._submitCount == 1);
+		// pso 2, mesh primitive 1, material pso 2
+		TEST_CHECK(backend.getStateChangeCount() == 8);
+		TEST_CHECK(statistics._stateChangeCount == backend.getStateChangeCount());
+		// draw pso, mesh, primitive, material 4 ȮѴ.
+		TEST_CHECK(statistics._stateChangeCount + statistics._skippedStateChangeCount == drawCalls.size() * 4);
+
+		uint32_t instanceOffset = 0;
+		for (size_t i = 0; i < drawCalls.size(); ++i)
+		{
+			const auto& drawCall = drawCalls[i];
+			TEST_CHECK(drawCall._psoType == psoTypes[i / 4]);
+			TEST_CHECK(drawCall._materialCBIndex == materialCBIndices[(i / 2) % 2]);
+			TEST_CHECK(drawCall._subMeshIndex == i % 2);
+			TEST_CHECK(drawCall._mesh == getTestMesh(0) && drawCall._stateMesh == drawCall._mesh);
+			TEST_CHECK(drawCall._primitive == PRIMITIVE_TRIANGLE);
+			TEST_CHECK(drawCall._skinnedCBIndex == NOT_SKINNED);
+			TEST_CHECK(drawCall._objectCBIndices.size() == OBJECT_PER_GROUP);
+			TEST_CHECK(drawCall._instanceOffset == instanceOffset);
+			instanceOffset += static_cast<uint32_t>(drawCall._objectCBIndices.size());
+		}
+	}
+
+	//    object ٸ packet ߰  ϳ , lod skinned ȷƮ ٸ  ʴ´.
+	void testInstanceGrouping(void)
+	{
+		constexpr uint8_t SKINNED_PSO = 2;
+		RenderQueue renderQueue;
+		for (uint32_t i = 0; i < 6; ++i)
+		{
+			renderQueue.addPacket(makePacket(1, getTestMesh(1), 7, 0, 0, 100 + i, NOT_SKINNED, 0.5f));
+		}
+		renderQueue.addPacket(makePacket(1, getTestMesh(1), 7, 0, 1, 200, NOT_SKINNED, 0.5f));
+		renderQueue.addPacket(makePacket(1, getTestMesh(1), 7, 0, 1, 201, NOT_SKINNED, 0.5f));
+		for (uint16_t i = 0; i < 3; ++i)
+		{
+			renderQueue.addPacket(makePacket(SKINNED_PSO, getTestMesh(2), 7, 0, 0, 300 + i, i, 0.5f));
+		}
+		renderQueue.sort();
+
+		std::vector<RenderQueueRange> ranges;
+		renderQueue.split(1, ranges);
+		RecordingRenderBackend backend;
+		RenderQueueStatistics statistics;
+		renderQueue.submit(backend, ranges[0], 0, statistics);
+
+		const auto& drawCalls = backend.getDrawCalls();
+		TEST_CHECK(drawCalls.size() == 5);
+		TEST_CHECK(statistics._drawCallCount == 5 && statistics._packetCount == 11);
+		if (drawCalls.size() != 5)
+		{
+			return;
+		}
+		TEST_CHECK((drawCalls[0]._objectCBIndices == std::vector<uint32_t>{ 100, 101, 102, 103, 104, 105 }));
+		TEST_CHECK(drawCalls[0]._lodLevel == 0 && drawCalls[0]._instanceOffset == 0);
+		TEST_CHECK((drawCalls[1]._objectCBIndices == std::vector<uint32_t>{ 200, 201 }));
+		TEST_CHECK(drawCalls[1]._lodLevel == 1 && drawCalls[1]._instanceOffset == 6);
+		for (uint16_t i = 0; i < 3; ++i)
+		{
+			const auto& drawCall = drawCalls[2 + i];
+			TEST_CHECK(drawCall._psoType == SKINNED_PSO);
+			TEST_CHECK(drawCall._skinnedCBIndex == i);
+			TEST_CHECK((drawCall._objectCBIndices == std::vector<uint32_t>{ 300u + i }));
+			TEST_CHECK(drawCall._instanceOffset == 8u + i);
+		}
+
+		//  ƹ ߰  ̴ packet ̴ ڸ ʴ´.
+		const auto& packets = renderQueue.getPackets();
+		for (uint32_t chunkCount = 1; chunkCount <= 16; ++chunkCount)
+		{
+			renderQueue.split(chunkCount, ranges);
+			TEST_CHECK(ranges.size() <= chunkCount);
+			TEST_CHECK(ranges.front()._begin == 0 && ranges.back()._end == packets.size());
+			for (size_t i = 1; i < ranges.size(); ++i)
+			{
+				const uint32_t boundary = ranges[i]._begin;
+				TEST_CHECK(ranges[i - 1]._end == boundary);
+				const DrawPacket& lhs = packets[boundary - 1];
+				const DrawPacket& rhs = packets[boundary];
+				TEST_CHECK(!(lhs._psoType == rhs._psoType && lhs._mesh == rhs._mesh && lhs._lodLevel == rhs._lodLevel &&
+					lhs._skinnedCBIndex == rhs._skinnedCBIndex));
+			}
+		}
+	}
+
+	//    worker ٸ backend ص    ѹ  Ͱ ƾ Ѵ.
+	void testChunkedSubmit(void)
+	{
+		std::mt19937 randomEngine(47);
+		std::uniform_int_distribution<int> smallDistribution(0, 2);
+		std::uniform_real_distribution<float> depthDistribution(0.f, 1.f);
+		RenderQueue renderQueue;
+		uint16_t skinnedCBIndex = 0;
+		for (uint32_t i = 0; i < 3000; ++i)
+		{
+			const bool isSkinned = (i % 11 == 0);
+			renderQueue.addPacket(makePacket(isSkinned ? SKINNED_PSO_TYPE : smallDistribution(randomEngine),
+				getTestMesh(smallDistribution(randomEngine)), smallDistribution(randomEngine), smallDistribution(randomEngine),
+				smallDistribution(randomEngine), i, isSkinned ? skinnedCBIndex++ : NOT_SKINNED, depthDistribution(randomEngine)));
+		}
+		renderQueue.sort();
+
+		constexpr uint32_t INSTANCE_OFFSET = 100;
+		std::vector<RenderQueueRange> ranges;
+		renderQueue.split(1, ranges);
+		RecordingRenderBackend expectedBackend;
+		RenderQueueStatistics expectedStatistics;
+		renderQueue.submit(expectedBackend, ranges[0], INSTANCE_OFFSET, expectedStatistics);
+		const auto& expected = expectedBackend.getDrawCalls();
+
+		RecordWorkerPool recordWorkerPool(4);
+		for (uint32_t chunkCount = 1; chunkCount <= 16; ++chunkCount)
+		{
+			renderQueue.split(chunkCount, ranges);
+			TEST_CHECK(!ranges.empty() && ranges.size() <= chunkCount);
+			TEST_CHECK(ranges.front()._begin == 0 && ranges.back()._end == renderQueue.getPackets().size());
+
+			std::vector<RecordingRenderBackend> backends(ranges.size());
+			std::vector<RenderQueueStatistics> statistics(ranges.size());
+			recordWorkerPool.run(static_cast<uint32_t>(ranges.size()), [&](uint32_t taskIndex)
+				{
+					renderQueue.submit(backends[taskIndex], ranges[taskIndex], INSTANCE_OFFSET, statistics[taskIndex]);
+				});
+
+			RenderQueueStatistics total;
+			std::vector<RecordingRenderBackend::DrawCall> drawCalls;
+			for (size_t i = 0; i < ranges.size(); ++i)
+			{
+				total._submitCount += statistics[i]._submitCount;
+				total._packetCount += statistics[i]._packetCount;
+				total._drawCallCount += statistics[i]._drawCallCount;
+				drawCalls.insert(drawCalls.end(), backends[i].getDrawCalls().begin(), backends[i].getDrawCalls().end());
+			}
+			TEST_CHECK(total._submitCount == 1);
+			TEST_CHECK(total._packetCount == expectedStatistics._packetCount);
+			TEST_CHECK(total._drawCallCount == expectedStatistics._drawCallCount);
+			TEST_CHECK(drawCalls.size() == expected.size());
+			if (drawCalls.size() != expected.size())
+			{
+				continue;
+			}
+			bool isSame = true;
+			for (size_t i = 0; i < drawCalls.size(); ++i)
+			{
+				const auto& lhs = drawCalls[i];
+				const auto& rhs = expected[i];
+				isSame &= lhs._psoType == rhs._psoType &&
+					lhs._stateMesh == rhs._stateMesh &&
+					lhs._primitive == rhs._primitive &&
+					lhs._materialCBIndex == rhs._materialCBIndex &&
+					lhs._mesh == rhs._mesh &&
+					lhs._subMeshIndex == rhs._subMeshIndex &&
+					lhs._lodLevel == rhs._lodLevel &&
+					lhs._instanceOffset == rhs._instanceOffset &&
+					lhs._objectCBIndices == rhs._objectCBIndices;
+				// skinned ƴ draw ȷƮ  ʴ´.     ȷƮ   Ƿ skinned϶ Ѵ.
+				if (lhs._psoType == SKINNED_PSO_TYPE)
+				{
+					isSame &= lhs._skinnedCBIndex == rhs._skinnedCBIndex;
+				}
+			}
+			TEST_CHECK(isSame);
+		}
+	}
+
+	// ĵ ū queue worker  ٲ㰡 Ѵ. worker ŭ    backend  .
+	void benchmarkRecordWorkerPool(void)
+	{
+		constexpr uint32_t PACKET_COUNT = 100000;
+		constexpr int BENCHMARK_FRAME_COUNT = 20;
+		std::mt19937 randomEngine(53);
+		std::uniform_int_distribution<int> meshDistribution(0, 3);
+		std::uniform_int_distribution<int> psoDistribution(0, 2);
+		std::uniform_int_distribution<uint32_t> materialDistribution(0, 63);
+		std::uniform_int_distribution<int> subMeshDistribution(0, 7);
+		std::uniform_real_distribution<float> depthDistribution(0.f, 1.f);
+		RenderQueue renderQueue;
+		uint16_t skinnedCBIndex = 0;
+		for (uint32_t i = 0; i < PACKET_COUNT; ++i)
+		{
+			const bool isSkinned = (i % 17 == 0);
+			renderQueue.addPacket(makePacket(isSkinned ? SKINNED_PSO_TYPE : psoDistribution(randomEngine),
+				getTestMesh(meshDistribution(randomEngine)), materialDistribution(randomEngine), subMeshDistribution(randomEngine),
+				0, i, isSkinned ? skinnedCBIndex++ : NOT_SKINNED, depthDistribution(randomEngine)));
+		}
+		renderQueue.sort();
+
+		std::vector<uint32_t> threadCounts = { 1, 2, 4 };
+		const uint32_t hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		if (std::find(threadCounts.begin(), threadCounts.end(), hardwareThreadCount) == threadCounts.end())
+		{
+			threadCounts.push_back(hardwareThreadCount);
+		}
+
+		uint64_t expectedDrawCallCount = 0;
+		std::vector<RenderQueueRange> ranges;
+		for (const uint32_t threadCount : threadCounts)
+		{
+			RecordWorkerPool recordWorkerPool(threadCount);
+			renderQueue.split(threadCount, ranges);
+			std::vector<RecordingRenderBackend> backends(ranges.size());
+			std::vector<RenderQueueStatistics> statistics(ranges.size());
+			const auto recordFrame = [&](uint32_t taskIndex)
+			{
+				backends[taskIndex].clear();
+				renderQueue.submit(backends[taskIndex], ranges[taskIndex], 0, statistics[taskIndex]);
+			};
+
+			// ù  backend Ҵ ̹Ƿ  ʴ´.
+			recordWorkerPool.run(static_cast<uint32_t>(ranges.size()), recordFrame);
+			uint64_t drawCallCount = 0;
+			for (const auto& backend : backends)
+			{
+				drawCallCount += backend.getDrawCalls().size();
+			}
+			if (expectedDrawCallCount == 0)
+			{
+				expectedDrawCallCount = drawCallCount;
+			}
+			TEST_CHECK(drawCallCount == expectedDrawCallCount);
+
+			TestTimer timer;
+			for (int f = 0; f < BENCHMARK_FRAME_COUNT; ++f)
+			{
+				recordWorkerPool.run(static_cast<uint32_t>(ranges.size()), recordFrame);
+			}
+			const double microSecond = timer.getMicroSecond();
+
+			std::printf("record %u packets, %llu draws: %u threads (%zu chunks) %.1fus/frame\n",
+				PACKET_COUNT, static_cast<unsigned long long>(drawCallCount), threadCount, ranges.size(),
+				microSecond / BENCHMARK_FRAME_COUNT);
+		}
+	}
+}
+
+int main(void)
+{
+	testSort();
+	testStateChange();
+	testInstanceGrouping();
+	testChunkedSubmit();
+	benchmarkRecordWorkerPool();
+	return getTestFailCount();
+}
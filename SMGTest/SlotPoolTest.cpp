@@ -0,0 +1,180 @@
+#include "stdafx.h"
+#include "SlotPool.h"
+#include "TestCommon.h"
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+	// ڿ Ҹ ȣ       ü
+	struct StarBit
+	{
+		StarBit(int id, int& aliveCount)
+			: _id(id)
+			, _aliveCount(aliveCount)
+		{
+			++_aliveCount;
+		}
+		~StarBit()
+		{
+			--_aliveCount;
+		}
+		int _id;
+		int& _aliveCount;
+	};
+
+	struct ThrowOnCreate
+	{
+		ThrowOnCreate(bool isThrow)
+		{
+			if (isThrow)
+			{
+				throw std::runtime_error("create fail");
+			}
+		}
+	};
+
+	void testCreateDestroy(void)
+	{
+		int aliveCount = 0;
+		SlotPool<StarBit> pool;
+		StarBit* a = pool.create(0, aliveCount);
+		StarBit* b = pool.create(1, aliveCount);
+		StarBit* c = pool.create(2, aliveCount);
+		TEST_CHECK(pool.size() == 3 && aliveCount == 3);
+
+		pool.destroy(a);
+		TEST_CHECK(pool.size() == 2 && aliveCount == 2);
+		TEST_CHECK(std::find(pool.begin(), pool.end(), a) == pool.end());
+		TEST_CHECK(b->_id == 1 && c->_id == 2);
+
+		//   slot ٽ .
+		StarBit* d = pool.create(3, aliveCount);
+		TEST_CHECK(d == a);
+		TEST_CHECK(d->_id == 3);
+
+		pool.clear();
+		TEST_CHECK(pool.empty() && aliveCount == 0);
+		TEST_CHECK(pool.getCapacity() != 0);
+	}
+
+	//  ü handle  slot ٸ ü ٽ ᵵ nullptr ȴ.
+	void testStaleHandle(void)
+	{
+		int aliveCount = 0;
+		SlotPool<StarBit> pool;
+		StarBit* player = pool.create(0, aliveCount);
+		StarBit* other = pool.create(1, aliveCount);
+		const SlotHandle playerHandle = pool.getHandle(player);
+		const SlotHandle otherHandle = pool.getHandle(other);
+		TEST_CHECK(playerHandle != otherHandle);
+		TEST_CHECK(pool.get(playerHandle) == player);
+
+		pool.destroy(player);
+		TEST_CHECK(pool.get(playerHandle) == nullptr);
+		StarBit* reused = pool.create(2, aliveCount);
+		// ͷ ־ٸ  ü Ų.
+		TEST_CHECK(reused == player);
+		TEST_CHECK(pool.get(playerHandle) == nullptr);
+		TEST_CHECK(pool.get(pool.getHandle(reused)) == reused);
+		TEST_CHECK(pool.getHandle(reused) != playerHandle);
+		TEST_CHECK(pool.get(otherHandle) == other);
+
+		// clear ڿ  handle ã Ѵ.
+		pool.clear();
+		TEST_CHECK(pool.get(otherHandle) == nullptr);
+		TEST_CHECK(pool.get(SlotHandle()) == nullptr);
+		SlotHandle outOfRange;
+		outOfRange._index = static_cast<uint32_t>(pool.getCapacity());
+		TEST_CHECK(pool.get(outOfRange) == nullptr);
+	}
+
+	void testCreateThrow(void)
+	{
+		SlotPool<ThrowOnCreate> pool;
+		pool.create(false);
+		const size_t capacity = pool.getCapacity();
+		for (int i = 0; i < 1000; ++i)
+		{
+			try
+			{
+				pool.create(true);
+				TEST_CHECK(false);
+			}
+			catch (const std::runtime_error&)
+			{
+			}
+		}
+		TEST_CHECK(pool.size() == 1);
+		TEST_CHECK(pool.getCapacity() == capacity);
+	}
+
+	// 60  ʴ 6000  30 ڿ   .
+	void testSpawnKillStress(void)
+	{
+		constexpr int FRAME_COUNT = 600;
+		constexpr int SPAWN_PER_FRAME = 100;
+		constexpr int LIFE_FRAME = 30;
+
+		std::mt19937 random(1019);
+		int aliveCount = 0;
+		SlotPool<StarBit> pool;
+		std::vector<std::vector<StarBit*>> spawnedByFrame(FRAME_COUNT);
+		size_t peakSize = 0;
+		int nextId = 0;
+		bool isValid = true;
+
+		TestTimer timer;
+		for (int frame = 0; frame < FRAME_COUNT; ++frame)
+		{
+			for (int i = 0; i < SPAWN_PER_FRAME; ++i)
+			{
+				spawnedByFrame[frame].push_back(pool.create(nextId++, aliveCount));
+			}
+			peakSize = std::max(peakSize, pool.size());
+			if (LIFE_FRAME <= frame)
+			{
+				auto& killList = spawnedByFrame[frame - LIFE_FRAME];
+				std::shuffle(killList.begin(), killList.end(), random);
+				for (const auto& starBit : killList)
+				{
+					pool.destroy(starBit);
+				}
+				killList.clear();
+			}
+
+			// ִ ü ּҿ  ٲ ʾҴ ȮѴ.
+			const int firstAliveFrame = std::max(0, frame - LIFE_FRAME + 1);
+			for (int f = firstAliveFrame; f <= frame; ++f)
+			{
+				for (int i = 0; i < SPAWN_PER_FRAME; ++i)
+				{
+					isValid &= (spawnedByFrame[f][i]->_id == f * SPAWN_PER_FRAME + i);
+				}
+			}
+			isValid &= (static_cast<int>(pool.size()) == aliveCount);
+		}
+		const double microSecond = timer.getMicroSecond();
+
+		TEST_CHECK(isValid);
+		TEST_CHECK(peakSize == (LIFE_FRAME + 1) * SPAWN_PER_FRAME);
+		//  slot ϹǷ ÿ ִ ִ ŭ ҴѴ.
+		TEST_CHECK(pool.getCapacity() < peakSize + 64);
+
+		pool.clear();
+		TEST_CHECK(aliveCount == 0);
+
+		const double operationCount = static_cast<double>(FRAME_COUNT) * SPAWN_PER_FRAME * 2;
+		std::printf("[SlotPool] spawn/kill %.0f ops, %.1f ns/op (include validation)\n", operationCount, microSecond * 1000.0 / operationCount);
+	}
+}
+
+int main()
+{
+	testCreateDestroy();
+	testStaleHandle();
+	testCreateThrow();
+	testSpawnKillStress();
+	return getTestFailCount();
+}
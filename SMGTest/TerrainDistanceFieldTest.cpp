@@ -0,0 +1,148 @@
+#include "stdafx.h"
+#include "TerrainDistanceField.h"
+#include "MathHelper.h"
+#include "TestCommon.h"
+#include <random>
+#include <string>
+
+namespace
+{
+	constexpr float PLANET_RADIUS = 10.f;
+
+	// ȸü   PLANET_RADIUS    mesh. ༺   .
+	void makePlanet(int subdivisionCount, std::vector<DirectX::XMFLOAT3>& outTriangles)
+	{
+		using namespace DirectX;
+		const XMFLOAT3 axis[6] = { {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1} };
+		const int faces[8][3] = { {0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4}, {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5} };
+		std::vector<XMFLOAT3> triangles;
+		for (const auto& face : faces)
+		{
+			triangles.push_back(axis[face[0]]);
+			triangles.push_back(axis[face[1]]);
+			triangles.push_back(axis[face[2]]);
+		}
+		auto middle = [](const XMFLOAT3& lhs, const XMFLOAT3& rhs)
+		{
+			XMFLOAT3 rv;
+			XMStoreFloat3(&rv, XMVector3Normalize(XMLoadFloat3(&lhs) + XMLoadFloat3(&rhs)));
+			return rv;
+		};
+		for (int s = 0; s < subdivisionCount; ++s)
+		{
+			std::vector<XMFLOAT3> subdivided;
+			subdivided.reserve(triangles.size() * 4);
+			for (size_t i = 0; i < triangles.size(); i += 3)
+			{
+				const XMFLOAT3& a = triangles[i];
+				const XMFLOAT3& b = triangles[i + 1];
+				const XMFLOAT3& c = triangles[i + 2];
+				const XMFLOAT3 ab = middle(a, b);
+				const XMFLOAT3 bc = middle(b, c);
+				const XMFLOAT3 ca = middle(c, a);
+				const XMFLOAT3 added[12] = { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca };
+				subdivided.insert(subdivided.end(), added, added + 12);
+			}
+			triangles.swap(subdivided);
+		}
+		for (auto& point : triangles)
+		{
+			XMStoreFloat3(&point, XMLoadFloat3(&point) * PLANET_RADIUS);
+		}
+		outTriangles.swap(triangles);
+	}
+
+	float getDistanceBruteForce(const DirectX::XMFLOAT3& position, const std::vector<DirectX::XMFLOAT3>& triangles) noexcept
+	{
+		using namespace DirectX;
+		const XMVECTOR point = XMLoadFloat3(&position);
+		float distanceSq = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < triangles.size(); i += 3)
+		{
+			distanceSq = std::min(distanceSq, MathHelper::getDistanceSqPointTriangle(point,
+				XMLoadFloat3(&triangles[i]), XMLoadFloat3(&triangles[i + 1]), XMLoadFloat3(&triangles[i + 2])));
+		}
+		return std::sqrt(distanceSq);
+	}
+
+	void makeQueryPoints(float maxOffset, size_t count, std::vector<DirectX::XMFLOAT3>& outPoints)
+	{
+		std::mt19937 randomEngine(38);
+		std::normal_distribution<float> directionDistribution(0.f, 1.f);
+		std::uniform_real_distribution<float> offsetDistribution(-maxOffset, maxOffset);
+		outPoints.clear();
+		outPoints.reserve(count);
+		while (outPoints.size() < count)
+		{
+			const float x = directionDistribution(randomEngine);
+			const float y = directionDistribution(randomEngine);
+			const float z = directionDistribution(randomEngine);
+			const float length = std::sqrt(x * x + y * y + z * z);
+			if (length < 0.001f)
+			{
+				continue;
+			}
+			const float radius = PLANET_RADIUS + offsetDistribution(randomEngine);
+			outPoints.emplace_back(x / length * radius, y / length * radius, z / length * radius);
+		}
+	}
+
+	// ǥ ó getMaxError() ̳ ¾ƾ ϰ, 𼭵  Ÿ getMaxError() Ѱ ũ  ȴ.
+	void testErrorAndBenchmark(void)
+	{
+		std::vector<DirectX::XMFLOAT3> triangles;
+		makePlanet(4, triangles);
+		const DirectX::XMFLOAT3 min(-PLANET_RADIUS, -PLANET_RADIUS, -PLANET_RADIUS);
+		const DirectX::XMFLOAT3 max(PLANET_RADIUS, PLANET_RADIUS, PLANET_RADIUS);
+
+		TestTimer buildTimer;
+		TerrainDistanceField distanceField;
+		distanceField.build(min, max, triangles);
+		const double buildMicroSecond = buildTimer.getMicroSecond();
+		TEST_CHECK(distanceField.isBuilt());
+
+		std::vector<DirectX::XMFLOAT3> points;
+		makeQueryPoints(distanceField.getBandWidth() * 2.f, 2000, points);
+
+		std::vector<float> exactDistances(points.size());
+		TestTimer bruteForceTimer;
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			exactDistances[i] = getDistanceBruteForce(points[i], triangles);
+		}
+		const double bruteForceMicroSecond = bruteForceTimer.getMicroSecond();
+
+		std::vector<float> fieldDistances(points.size());
+		TestTimer fieldTimer;
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			fieldDistances[i] = distanceField.getDistance(points[i]);
+		}
+		const double fieldMicroSecond = fieldTimer.getMicroSecond();
+
+		const float maxError = distanceField.getMaxError();
+		const float epsilon = 0.0001f * PLANET_RADIUS;
+		float observedMaxError = 0.f;
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			TEST_CHECK(fieldDistances[i] <= exactDistances[i] + maxError + epsilon);
+			if (exactDistances[i] + maxError < distanceField.getBandWidth())
+			{
+				const float error = std::abs(fieldDistances[i] - exactDistances[i]);
+				TEST_CHECK(error <= maxError + epsilon);
+				observedMaxError = std::max(observedMaxError, error);
+			}
+		}
+
+		std::printf("TerrainDistanceField triangle: %zu build: %.0fus maxError: %f (bound %f)\n",
+			triangles.size() / 3, buildMicroSecond, observedMaxError, maxError);
+		std::printf("query %zu: distanceField %.3fus/query, triangle %.3fus/query\n",
+			points.size(), fieldMicroSecond / points.size(), bruteForceMicroSecond / points.size());
+	}
+}
+
+int main(void)
+{
+	testErrorAndBenchmark();
+	return getTestFailCount();
+}
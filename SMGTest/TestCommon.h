@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdio>
+#include <chrono>
+
+// ϸ ġ ϰ  Ѵ. main getTestFailCount() ȯѴ.
+inline int& getTestFailCount(void) noexcept
+{
+	static int failCount = 0;
+	return failCount;
+}
+
+#define TEST_CHECK(_val)															\
+{																					\
+	if((_val) == false)																\
+	{																				\
+		std::printf("Fail! %s: line %d\n%s\n", __FILE__, __LINE__, #_val);			\
+		++getTestFailCount();														\
+	}																				\
+}
+
+// ġũ  
+class TestTimer
+{
+public:
+	TestTimer(void) noexcept : _start(std::chrono::steady_clock::now()) {}
+	double getMicroSecond(void) const noexcept
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start).count();
+	}
+private:
+	std::chrono::steady_clock::time_point _start;
+};
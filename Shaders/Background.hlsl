@@ -16,17 +16,18 @@ struct VertexOut
 	float2 _textureCoord : TEXTURE;
 };
 
-VertexOut BackgroundVertexShader(VertexIn vIn)
+VertexOut BackgroundVertexShader(VertexIn vIn, uint instanceID : SV_InstanceID)
 {
+	ObjectData objectData = getObjectData(instanceID);
 	VertexOut vOut;
 
-	float4 posWorld = mul(float4(vIn._posLocal, 1.0f), gWorld);
+	float4 posWorld = mul(float4(vIn._posLocal, 1.0f), objectData._world);
 	//vOut._posWorld = posWorld.xyz;
 	vOut._posHCS = mul(posWorld, gViewProj);
-	float4 textureCoord = mul(float4(vIn._textureCoord, 0.f, 1.f), gTextureTransform);
+	float4 textureCoord = mul(float4(vIn._textureCoord, 0.f, 1.f), objectData._textureTransform);
 	vOut._textureCoord = mul(textureCoord, gMaterialTransform).xy;
 	// ü鿡 յʳ ̵  ʾǷ ġ İ Ƽ ״ Ѵ.
-	//vOut._normalWorld = mul(vIn._normalLocal, (float3x3)gWorld);
+	//vOut._normalWorld = mul(vIn._normalLocal, (float3x3)objectData._world);
 	//vOut._shadowPosHCS = mul(posWorld, gShadowTransform);
 	return vOut;
 }
@@ -37,11 +37,26 @@ struct InstanceData
 };
 StructuredBuffer<InstanceData> gInstanceData : register(t1, space1);
 #else
-cbuffer cbPerObject : register(b0)
+// object constant buffer ״ Ƿ ũ⸦ constant buffer ũ(256) .
+struct ObjectData
 {
-	float4x4 gWorld;
-	float4x4 gTextureTransform;
+	float4x4 _world;
+	float4x4 _textureTransform;
+	float4x4 _pad0;
+	float4x4 _pad1;
 };
+StructuredBuffer<ObjectData> gObjectData : register(t2, space1);
+//  ׸ instance object ȣ
+StructuredBuffer<uint> gInstanceObjectIndices : register(t3, space1);
+cbuffer cbInstance : register(b4)
+{
+	uint gInstanceOffset;
+};
+
+ObjectData getObjectData(uint instanceID)
+{
+	return gObjectData[gInstanceObjectIndices[gInstanceOffset + instanceID]];
+}
 #endif
 
 #ifdef SKINNED
@@ -17,8 +17,9 @@ struct VertexOut
 	float2 _textureCoord : TEXTURE;
 };
 
-VertexOut ShadowVertexShader(VertexIn vIn)
+VertexOut ShadowVertexShader(VertexIn vIn, uint instanceID : SV_InstanceID)
 {
+	ObjectData objectData = getObjectData(instanceID);
 #ifdef SKINNED
 	float weights[4] = { 0.f, 0.f, 0.f, 0.f };
 	weights[0] = vIn._boneWeights.x;
@@ -41,10 +42,10 @@ VertexOut ShadowVertexShader(VertexIn vIn)
 #endif
 	VertexOut vOut = (VertexOut)0.0f;;
 
-	float4 posWorld = mul(float4(vIn._posLocal, 1.0f), gWorld);
+	float4 posWorld = mul(float4(vIn._posLocal, 1.0f), objectData._world);
 
 	vOut._posHCS = mul(posWorld, gViewProj);
-	float4 textureCoord = mul(float4(vIn._textureCoord, 0.f, 1.f), gTextureTransform);
+	float4 textureCoord = mul(float4(vIn._textureCoord, 0.f, 1.f), objectData._textureTransform);
 	vOut._textureCoord = mul(textureCoord, gMaterialTransform).xy;
 	return vOut;
 }